@@ -12,13 +12,19 @@
 namespace aeon::compression::internal
 {
 
+[[nodiscard]] inline auto window_bits(const zlib_format format) noexcept -> int
+{
+    // The maximum window size; zlib selects the gzip format if 16 is added to it.
+    return (format == zlib_format::gzip) ? MAX_WBITS + 16 : MAX_WBITS;
+}
+
 class zlib_compress final
 {
 public:
-    explicit zlib_compress(const int level)
+    explicit zlib_compress(const int level, const zlib_format format)
         : zstream_{}
     {
-        if (deflateInit(&zstream_, level) != Z_OK)
+        if (deflateInit2(&zstream_, level, Z_DEFLATED, window_bits(format), 8, Z_DEFAULT_STRATEGY) != Z_OK)
             throw zlib_compress_exception{};
     }
 
@@ -45,10 +51,10 @@ private:
 class zlib_decompress final
 {
 public:
-    explicit zlib_decompress()
+    explicit zlib_decompress(const zlib_format format)
         : zstream_{}
     {
-        if (inflateInit(&zstream_) != Z_OK)
+        if (inflateInit2(&zstream_, window_bits(format)) != Z_OK)
             throw zlib_compress_exception{};
     }
 
@@ -23,12 +23,23 @@ enum class zlib_compression_mode : int
     fastest = 1
 };
 
+/*!
+ * The framing of deflate compressed data: with a zlib header and trailer (RFC 1950), or with a gzip header and trailer
+ * (RFC 1952). These are the "deflate" and "gzip" content codings of HTTP.
+ */
+enum class zlib_format
+{
+    zlib,
+    gzip
+};
+
 class zlib_compress final
 {
 public:
     using write_callback = std::function<std::streamsize(const std::byte *, const std::streamsize)>;
 
-    explicit zlib_compress(const zlib_compression_mode mode, const int buffer_size = 256);
+    explicit zlib_compress(const zlib_compression_mode mode, const int buffer_size = 256,
+                           const zlib_format format = zlib_format::zlib);
     ~zlib_compress();
 
     zlib_compress(zlib_compress &&) noexcept;
@@ -39,6 +50,12 @@ public:
 
     void write(const std::byte *data, const std::streamsize size, const write_callback &cb);
 
+    /*!
+     * End the compressed data; writes the remaining compressed data and the trailer. Nothing can be written after this.
+     * Data that is never finished can only be decompressed up to the last write.
+     */
+    void finish(const write_callback &cb);
+
 private:
     std::unique_ptr<internal::zlib_compress> compress_;
     std::vector<std::byte> buffer_;
@@ -49,7 +66,7 @@ class zlib_decompress final
 public:
     using read_callback = std::function<std::streamsize(std::byte *, const std::streamsize)>;
 
-    explicit zlib_decompress(const int buffer_size = 256);
+    explicit zlib_decompress(const int buffer_size = 256, const zlib_format format = zlib_format::zlib);
     ~zlib_decompress();
 
     zlib_decompress(zlib_decompress &&) noexcept;
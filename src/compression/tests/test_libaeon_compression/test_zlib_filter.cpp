@@ -7,6 +7,7 @@
 #include <aeon/common/string.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 
 using namespace aeon;
 
@@ -66,3 +67,89 @@ TEST(test_streams, test_zlib_compress_filter_read_write_basic)
     test_decompress_data(pipeline.device().data(), static_cast<int>(std::size(data)), data);
     test_decompress_data(pipeline.device().data(), static_cast<int>(std::size(data) * 2), data);
 }
+
+TEST(test_streams, test_zlib_compress_finish)
+{
+    const common::string data =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut "
+        "labore et dolore magna aliqua. Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+        "tempor incididunt ut labore et dolore magna aliqua.";
+
+    std::vector<std::byte> compressed;
+    const auto write = [&compressed](const std::byte *data, const std::streamsize size)
+    {
+        compressed.insert(std::end(compressed), data, data + size);
+        return size;
+    };
+
+    compression::zlib_compress compress{compression::zlib_compression_mode::best};
+    compress.write(reinterpret_cast<const std::byte *>(std::data(data)), std::size(data), write);
+    compress.finish(write);
+
+    EXPECT_LT(std::size(compressed), std::size(data));
+
+    std::size_t offset = 0;
+    const auto read = [&compressed, &offset](std::byte *data, const std::streamsize size)
+    {
+        const auto read_size = std::min(static_cast<std::size_t>(size), std::size(compressed) - offset);
+        std::copy_n(std::data(compressed) + offset, read_size, data);
+        offset += read_size;
+        return static_cast<std::streamsize>(read_size);
+    };
+
+    // Reading past the end of the compressed data only returns the data up to the end.
+    common::string decompressed;
+    decompressed.resize(std::size(data) * 2);
+
+    compression::zlib_decompress decompress{16};
+    const auto size =
+        decompress.read(reinterpret_cast<std::byte *>(std::data(decompressed)), std::size(decompressed), read);
+
+    ASSERT_EQ(static_cast<std::streamsize>(std::size(data)), size);
+    EXPECT_EQ(data, decompressed.substr(0, size));
+}
+
+TEST(test_streams, test_zlib_compress_finish_gzip)
+{
+    const common::string data =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut "
+        "labore et dolore magna aliqua. Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+        "tempor incididunt ut labore et dolore magna aliqua.";
+
+    std::vector<std::byte> compressed;
+    const auto write = [&compressed](const std::byte *data, const std::streamsize size)
+    {
+        compressed.insert(std::end(compressed), data, data + size);
+        return size;
+    };
+
+    compression::zlib_compress compress{compression::zlib_compression_mode::best, 256,
+                                        compression::zlib_format::gzip};
+    compress.write(reinterpret_cast<const std::byte *>(std::data(data)), std::size(data), write);
+    compress.finish(write);
+
+    ASSERT_GT(std::size(compressed), 2u);
+    EXPECT_EQ(std::byte{0x1f}, compressed[0]);
+    EXPECT_EQ(std::byte{0x8b}, compressed[1]);
+    EXPECT_LT(std::size(compressed), std::size(data));
+
+    std::size_t offset = 0;
+    const auto read = [&compressed, &offset](std::byte *data, const std::streamsize size)
+    {
+        const auto read_size = std::min(static_cast<std::size_t>(size), std::size(compressed) - offset);
+        std::copy_n(std::data(compressed) + offset, read_size, data);
+        offset += read_size;
+        return static_cast<std::streamsize>(read_size);
+    };
+
+    // Reading past the end of the compressed data only returns the data up to the end.
+    common::string decompressed;
+    decompressed.resize(std::size(data) * 2);
+
+    compression::zlib_decompress decompress{16, compression::zlib_format::gzip};
+    const auto size =
+        decompress.read(reinterpret_cast<std::byte *>(std::data(decompressed)), std::size(decompressed), read);
+
+    ASSERT_EQ(static_cast<std::streamsize>(std::size(data)), size);
+    EXPECT_EQ(data, decompressed.substr(0, size));
+}
@@ -3,3 +3,5 @@
 depend_on(common)
 depend_on(streams)
 depend_on(ptree)
+depend_on(compression)
+depend_on(crypto)
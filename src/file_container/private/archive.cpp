@@ -0,0 +1,544 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/file_container/archive.h>
+#include <aeon/file_container/exception.h>
+#include <aeon/compression/zlib.h>
+#include <aeon/compression/exception.h>
+#include <aeon/common/fourcc.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <cstring>
+
+namespace aeon::file_container
+{
+
+namespace internal
+{
+
+static constexpr std::uint32_t archive_magic = common::fourcc('A', 'F', 'A', '1');
+static constexpr std::uint32_t archive_version = 1;
+static constexpr std::size_t archive_block_size = 64 * 1024;
+
+// The uncompressed size of an entry comes from the directory, so it is not trusted when reserving memory. At most this
+// many times the stored size is reserved up front; the buffer grows beyond that as the data is decompressed.
+static constexpr std::uint64_t archive_reserve_ratio = 4;
+
+static constexpr std::uint8_t archive_record_flag_sha256 = 0x01;
+
+struct archive_header final
+{
+    std::uint32_t magic = archive_magic;
+    std::uint32_t version = archive_version;
+};
+
+static_assert(sizeof(archive_header) == 8);
+
+/*!
+ * A directory record as stored in the archive. The records are fixed size so that they can be binary searched in
+ * place, without parsing the directory first.
+ */
+struct archive_record final
+{
+    std::uint64_t name_hash = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t stored_size = 0;
+    std::uint64_t size = 0;
+    std::uint32_t name_offset = 0;
+    std::uint32_t name_size = 0;
+    archive_compression compression = archive_compression::none;
+    std::uint8_t flags = 0;
+    std::uint16_t reserved1 = 0;
+    std::uint32_t reserved2 = 0;
+    crypto::sha256_hash hash{};
+};
+
+static_assert(sizeof(archive_record) == 80);
+
+struct archive_footer final
+{
+    std::uint32_t magic = archive_magic;
+    std::uint32_t alignment = 0;
+    std::uint64_t entry_count = 0;
+    std::uint64_t directory_offset = 0;
+    std::uint64_t names_size = 0;
+};
+
+static_assert(sizeof(archive_footer) == 32);
+
+/*!
+ * 64-bit FNV-1a. The hash is stored in the archive, so unlike std::hash it must be the same on every platform.
+ */
+[[nodiscard]] static auto hash_name(const common::string_view name) noexcept -> std::uint64_t
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (const auto c : name)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+[[nodiscard]] static auto is_power_of_two(const std::uint32_t value) noexcept
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace internal
+
+archive_writer::archive_writer(streams::idynamic_stream &stream, const std::uint32_t alignment)
+    : stream_{&stream}
+    , alignment_{alignment}
+    , offset_{0}
+    , records_{}
+    , names_{}
+    , finished_{false}
+{
+    if (!internal::is_power_of_two(alignment_))
+        throw archive_exception{};
+
+    const internal::archive_header header;
+    write(reinterpret_cast<const std::byte *>(&header), sizeof(header));
+}
+
+archive_writer::~archive_writer() = default;
+
+void archive_writer::add(const common::string_view name, const std::span<const std::byte> data,
+                         const archive_compression compression, const common::flags<archive_entry_flags> flags)
+{
+    if (finished_ || std::empty(name) || std::size(name) > std::numeric_limits<std::uint32_t>::max())
+        throw archive_exception{};
+
+    write_padding();
+
+    internal::archive_record record;
+    record.name_hash = internal::hash_name(name);
+    record.offset = offset_;
+    record.stored_size = std::size(data);
+    record.size = std::size(data);
+    record.name_offset = static_cast<std::uint32_t>(std::size(names_));
+    record.name_size = static_cast<std::uint32_t>(std::size(name));
+
+    if (flags.is_set(archive_entry_flags::sha256))
+    {
+        crypto::sha256 hasher;
+        hasher.write(std::data(data), static_cast<std::streamsize>(std::size(data)));
+        record.hash = hasher.finalize();
+        record.flags |= internal::archive_record_flag_sha256;
+    }
+
+    // zlib works on 32-bit sizes; larger entries are always stored as-is.
+    if (compression == archive_compression::zlib && std::size(data) <= std::numeric_limits<std::uint32_t>::max())
+    {
+        std::vector<std::byte> compressed;
+        compressed.reserve(std::size(data));
+
+        const auto write_compressed = [&compressed](const std::byte *compressed_data, const std::streamsize size)
+        {
+            compressed.insert(std::end(compressed), compressed_data, compressed_data + size);
+            return size;
+        };
+
+        compression::zlib_compress compress{compression::zlib_compression_mode::balanced,
+                                            static_cast<int>(internal::archive_block_size)};
+        compress.write(std::data(data), static_cast<std::streamsize>(std::size(data)), write_compressed);
+        compress.finish(write_compressed);
+
+        if (std::size(compressed) < std::size(data))
+        {
+            record.compression = archive_compression::zlib;
+            record.stored_size = std::size(compressed);
+            write(std::data(compressed), std::size(compressed));
+        }
+    }
+
+    if (record.compression == archive_compression::none)
+        write(std::data(data), std::size(data));
+
+    names_ += name;
+    records_.push_back(record);
+}
+
+void archive_writer::finish()
+{
+    if (finished_)
+        throw archive_exception{};
+
+    std::sort(std::begin(records_), std::end(records_),
+              [this](const internal::archive_record &lhs, const internal::archive_record &rhs)
+              {
+                  if (lhs.name_hash != rhs.name_hash)
+                      return lhs.name_hash < rhs.name_hash;
+
+                  return common::string_view{std::data(names_) + lhs.name_offset, lhs.name_size} <
+                         common::string_view{std::data(names_) + rhs.name_offset, rhs.name_size};
+              });
+
+    // Equal names have equal hashes, so after sorting duplicates are always adjacent.
+    const auto duplicate =
+        std::adjacent_find(std::begin(records_), std::end(records_),
+                           [this](const internal::archive_record &lhs, const internal::archive_record &rhs)
+                           {
+                               return common::string_view{std::data(names_) + lhs.name_offset, lhs.name_size} ==
+                                      common::string_view{std::data(names_) + rhs.name_offset, rhs.name_size};
+                           });
+
+    if (duplicate != std::end(records_))
+        throw archive_exception{};
+
+    write_padding();
+
+    internal::archive_footer footer;
+    footer.alignment = alignment_;
+    footer.entry_count = std::size(records_);
+    footer.directory_offset = offset_;
+    footer.names_size = std::size(names_);
+
+    write(reinterpret_cast<const std::byte *>(std::data(records_)),
+          std::size(records_) * sizeof(internal::archive_record));
+    write(reinterpret_cast<const std::byte *>(std::data(names_)), std::size(names_));
+    write(reinterpret_cast<const std::byte *>(&footer), sizeof(footer));
+
+    finished_ = true;
+}
+
+void archive_writer::write(const std::byte *data, const std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    if (stream_->write(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size))
+        throw archive_exception{};
+
+    offset_ += size;
+}
+
+void archive_writer::write_padding()
+{
+    static constexpr std::array<std::byte, 256> padding{};
+
+    auto padding_size = (alignment_ - (offset_ & (alignment_ - 1))) & (alignment_ - 1);
+
+    while (padding_size > 0)
+    {
+        const auto size = std::min<std::uint64_t>(padding_size, std::size(padding));
+        write(std::data(padding), size);
+        padding_size -= size;
+    }
+}
+
+archive::archive(const std::span<const std::byte> data)
+    : data_{data}
+    , stream_{nullptr}
+    , directory_storage_{}
+    , directory_{}
+    , names_{}
+    , entry_count_{0}
+    , directory_offset_{0}
+{
+    open();
+}
+
+archive::archive(streams::idynamic_stream &stream)
+    : data_{}
+    , stream_{&stream}
+    , directory_storage_{}
+    , directory_{}
+    , names_{}
+    , entry_count_{0}
+    , directory_offset_{0}
+{
+    if (!stream_->is_input_seekable() || !stream_->has_size())
+        throw archive_exception{};
+
+    open();
+}
+
+archive::~archive() = default;
+
+auto archive::size() const noexcept -> std::size_t
+{
+    return entry_count_;
+}
+
+auto archive::at(const std::size_t index) const -> archive_entry
+{
+    if (index >= entry_count_)
+        throw archive_exception{};
+
+    return to_entry(record(index));
+}
+
+auto archive::find(const common::string_view name) const noexcept -> std::optional<archive_entry>
+{
+    const auto name_hash = internal::hash_name(name);
+
+    // Binary search for the first record with a matching hash.
+    std::size_t first = 0;
+    std::size_t count = entry_count_;
+
+    while (count > 0)
+    {
+        const auto step = count / 2;
+        const auto index = first + step;
+
+        if (record(index).name_hash < name_hash)
+        {
+            first = index + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    for (; first < entry_count_; ++first)
+    {
+        const auto current = record(first);
+
+        if (current.name_hash != name_hash)
+            break;
+
+        auto entry = to_entry(current);
+
+        if (entry.name == name)
+            return entry;
+    }
+
+    return std::nullopt;
+}
+
+auto archive::contains(const common::string_view name) const noexcept -> bool
+{
+    return find(name).has_value();
+}
+
+auto archive::view(const archive_entry &entry) const -> std::span<const std::byte>
+{
+    if (stream_ || entry.compression != archive_compression::none || entry.offset > directory_offset_ ||
+        entry.stored_size > directory_offset_ - entry.offset)
+        throw archive_exception{};
+
+    return data_.subspan(entry.offset, entry.stored_size);
+}
+
+auto archive::read(const archive_entry &entry) const -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> data;
+    data.reserve(
+        std::min(entry.size, std::min(entry.stored_size, directory_offset_) * internal::archive_reserve_ratio));
+
+    read_entry(entry,
+               [&data](const std::byte *block, const std::size_t size)
+               {
+                   const auto block_data = reinterpret_cast<const std::uint8_t *>(block);
+                   data.insert(std::end(data), block_data, block_data + size);
+               });
+
+    return data;
+}
+
+void archive::read(const archive_entry &entry, streams::idynamic_stream &output) const
+{
+    read_entry(entry,
+               [&output](const std::byte *block, const std::size_t size)
+               {
+                   if (output.write(block, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size))
+                       throw archive_exception{};
+               });
+}
+
+void archive::open()
+{
+    const auto archive_size = static_cast<std::uint64_t>(stream_ ? stream_->size() : std::ssize(data_));
+
+    if (archive_size < sizeof(internal::archive_header) + sizeof(internal::archive_footer))
+        throw archive_exception{};
+
+    internal::archive_header header;
+    read_stored(0, reinterpret_cast<std::byte *>(&header), sizeof(header));
+
+    if (header.magic != internal::archive_magic || header.version != internal::archive_version)
+        throw archive_exception{};
+
+    internal::archive_footer footer;
+    read_stored(archive_size - sizeof(footer), reinterpret_cast<std::byte *>(&footer), sizeof(footer));
+
+    if (footer.magic != internal::archive_magic || !internal::is_power_of_two(footer.alignment))
+        throw archive_exception{};
+
+    // Make sure the directory exactly fills the space between its offset and the footer. This also guarantees that
+    // the calculations below can not overflow.
+    const auto directory_space = archive_size - sizeof(footer);
+
+    if (footer.directory_offset > directory_space || footer.names_size > directory_space ||
+        footer.entry_count > directory_space / sizeof(internal::archive_record))
+        throw archive_exception{};
+
+    const auto records_size = footer.entry_count * sizeof(internal::archive_record);
+    const auto directory_size = records_size + footer.names_size;
+
+    if (footer.directory_offset + directory_size != directory_space)
+        throw archive_exception{};
+
+    if (stream_)
+    {
+        directory_storage_.resize(directory_size);
+        read_stored(footer.directory_offset, std::data(directory_storage_), directory_size);
+        directory_ = directory_storage_;
+    }
+    else
+    {
+        directory_ = data_.subspan(footer.directory_offset, directory_size);
+    }
+
+    names_ = common::string_view{reinterpret_cast<const char *>(std::data(directory_)) + records_size,
+                                 footer.names_size};
+    entry_count_ = footer.entry_count;
+    directory_offset_ = footer.directory_offset;
+}
+
+auto archive::record(const std::size_t index) const noexcept -> internal::archive_record
+{
+    // The directory is not guaranteed to be suitably aligned to be accessed as an array of records directly.
+    internal::archive_record result;
+    std::memcpy(&result, std::data(directory_) + index * sizeof(internal::archive_record), sizeof(result));
+    return result;
+}
+
+auto archive::to_entry(const internal::archive_record &record) const noexcept -> archive_entry
+{
+    archive_entry entry;
+
+    // A name outside of the name table can only occur in a corrupt archive; report it as an empty name.
+    if (record.name_offset <= std::size(names_) && record.name_size <= std::size(names_) - record.name_offset)
+        entry.name = common::string_view{std::data(names_) + record.name_offset, record.name_size};
+
+    entry.offset = record.offset;
+    entry.stored_size = record.stored_size;
+    entry.size = record.size;
+    entry.compression = record.compression;
+
+    if (record.flags & internal::archive_record_flag_sha256)
+        entry.hash = record.hash;
+
+    return entry;
+}
+
+void archive::read_stored(const std::uint64_t offset, std::byte *data, const std::size_t size) const
+{
+    if (!stream_)
+    {
+        if (offset > std::size(data_) || size > std::size(data_) - offset)
+            throw archive_exception{};
+
+        std::memcpy(data, std::data(data_) + offset, size);
+        return;
+    }
+
+    if (!stream_->seekg(static_cast<std::streamoff>(offset), streams::seek_direction::begin))
+        throw archive_exception{};
+
+    std::size_t total = 0;
+
+    while (total < size)
+    {
+        const auto result = stream_->read(data + total, static_cast<std::streamsize>(size - total));
+
+        if (result <= 0)
+            throw archive_exception{};
+
+        total += static_cast<std::size_t>(result);
+    }
+}
+
+void archive::read_entry(const archive_entry &entry,
+                         const std::function<void(const std::byte *, const std::size_t)> &callback) const
+{
+    if (entry.offset > directory_offset_ || entry.stored_size > directory_offset_ - entry.offset)
+        throw archive_exception{};
+
+    crypto::sha256 hasher;
+
+    const auto emit = [&entry, &hasher, &callback](const std::byte *data, const std::size_t size)
+    {
+        if (entry.hash)
+            hasher.write(data, static_cast<std::streamsize>(size));
+
+        callback(data, size);
+    };
+
+    if (entry.compression == archive_compression::none)
+    {
+        if (entry.stored_size != entry.size)
+            throw archive_exception{};
+
+        if (!stream_)
+        {
+            emit(std::data(data_) + entry.offset, entry.stored_size);
+        }
+        else
+        {
+            std::vector<std::byte> block(std::min<std::uint64_t>(entry.stored_size, internal::archive_block_size));
+
+            for (std::uint64_t offset = 0; offset < entry.stored_size;)
+            {
+                const auto size = std::min<std::uint64_t>(entry.stored_size - offset, std::size(block));
+                read_stored(entry.offset + offset, std::data(block), size);
+                emit(std::data(block), size);
+                offset += size;
+            }
+        }
+    }
+    else if (entry.compression == archive_compression::zlib)
+    {
+        auto stored_offset = entry.offset;
+        auto stored_remaining = entry.stored_size;
+
+        const auto read_compressed = [this, &stored_offset, &stored_remaining](std::byte *data,
+                                                                               const std::streamsize size)
+        {
+            const auto read_size = std::min<std::uint64_t>(stored_remaining, static_cast<std::uint64_t>(size));
+            read_stored(stored_offset, data, read_size);
+            stored_offset += read_size;
+            stored_remaining -= read_size;
+            return static_cast<std::streamsize>(read_size);
+        };
+
+        try
+        {
+            compression::zlib_decompress decompress{static_cast<int>(internal::archive_block_size)};
+            std::vector<std::byte> block(std::min<std::uint64_t>(entry.size, internal::archive_block_size));
+
+            for (auto remaining = entry.size; remaining > 0;)
+            {
+                const auto size = std::min<std::uint64_t>(remaining, std::size(block));
+                const auto result =
+                    decompress.read(std::data(block), static_cast<std::streamsize>(size), read_compressed);
+
+                if (result <= 0)
+                    throw archive_exception{};
+
+                emit(std::data(block), static_cast<std::size_t>(result));
+                remaining -= static_cast<std::uint64_t>(result);
+            }
+        }
+        catch (const compression::zlib_decompress_exception &)
+        {
+            throw archive_exception{};
+        }
+    }
+    else
+    {
+        throw archive_exception{};
+    }
+
+    if (entry.hash && hasher.finalize() != *entry.hash)
+        throw archive_exception{};
+}
+
+} // namespace aeon::file_container
@@ -0,0 +1,194 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/crypto/sha256.h>
+#include <aeon/streams/idynamic_stream.h>
+#include <aeon/common/flags.h>
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::file_container
+{
+
+namespace internal
+{
+struct archive_record;
+} // namespace internal
+
+enum class archive_compression : std::uint8_t
+{
+    none = 0,
+    zlib = 1
+};
+
+enum class archive_entry_flags : std::uint8_t
+{
+    none = 0x00,
+    sha256 = 0x01 // Store a sha256 hash of the uncompressed contents, which is verified when the entry is read.
+};
+
+aeon_declare_flag_operators(archive_entry_flags)
+
+/*!
+ * Description of a single entry in an archive. The name points into the directory of the archive it was obtained
+ * from, and is only valid for as long as that archive exists.
+ */
+struct archive_entry final
+{
+    common::string_view name;
+
+    // Offset of the stored data from the start of the archive. Always a multiple of the archive alignment.
+    std::uint64_t offset = 0;
+
+    // Size of the data as it is stored in the archive (after compression).
+    std::uint64_t stored_size = 0;
+
+    // Size of the data after decompression.
+    std::uint64_t size = 0;
+
+    archive_compression compression = archive_compression::none;
+
+    std::optional<crypto::sha256_hash> hash;
+};
+
+/*!
+ * Writes a multi-entry archive. Entries are written sequentially as they are added; the directory is written by
+ * finish(). An archive is not valid until finish() was called.
+ *
+ * Layout:
+ *   header     - magic and version
+ *   entries    - the stored data of all entries, each starting at a multiple of the alignment
+ *   directory  - one fixed size record per entry, sorted by the hash of the name
+ *   names      - the names of all entries
+ *   footer     - magic, alignment, entry count and the offset of the directory
+ *
+ * The output stream does not need to be seekable.
+ */
+class archive_writer final
+{
+public:
+    static constexpr std::uint32_t default_alignment = 16;
+
+    explicit archive_writer(streams::idynamic_stream &stream, const std::uint32_t alignment = default_alignment);
+    ~archive_writer();
+
+    archive_writer(archive_writer &&) = delete;
+    auto operator=(archive_writer &&) -> archive_writer & = delete;
+
+    archive_writer(const archive_writer &) = delete;
+    auto operator=(const archive_writer &) -> archive_writer & = delete;
+
+    /*!
+     * Add an entry to the archive. Names must be unique. When zlib compression is requested but does not make the
+     * entry smaller, the entry is stored uncompressed.
+     */
+    void add(const common::string_view name, const std::span<const std::byte> data,
+             const archive_compression compression = archive_compression::none,
+             const common::flags<archive_entry_flags> flags = archive_entry_flags::none);
+
+    /*!
+     * Write the directory and footer. No entries can be added afterwards.
+     */
+    void finish();
+
+private:
+    void write(const std::byte *data, const std::size_t size);
+    void write_padding();
+
+    streams::idynamic_stream *stream_;
+    std::uint32_t alignment_;
+    std::uint64_t offset_;
+    std::vector<internal::archive_record> records_;
+    common::string names_;
+    bool finished_;
+};
+
+/*!
+ * Read access to an archive written by archive_writer.
+ *
+ * Opening an archive only reads the fixed size footer; entries are looked up through a binary search over the
+ * hashed names in the directory. An archive can be opened on a block of memory (for example a memory mapped file),
+ * in which case uncompressed entries can be accessed without copying through view(). Alternatively an archive can be
+ * opened on a seekable stream, in which case only the directory is loaded in memory, and entries are read on demand.
+ */
+class archive final
+{
+public:
+    /*!
+     * Open an archive in memory. The given data is not copied and must outlive the archive.
+     */
+    explicit archive(const std::span<const std::byte> data);
+
+    /*!
+     * Open an archive on a seekable stream. The stream must outlive the archive. Reading entries changes the read
+     * position of the stream, so a stream based archive can not be read from multiple threads at once.
+     */
+    explicit archive(streams::idynamic_stream &stream);
+
+    ~archive();
+
+    archive(archive &&) noexcept = default;
+    auto operator=(archive &&) noexcept -> archive & = default;
+
+    archive(const archive &) = delete;
+    auto operator=(const archive &) -> archive & = delete;
+
+    /*!
+     * The amount of entries in the archive.
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /*!
+     * Get an entry by index. The order of the entries is unspecified.
+     */
+    [[nodiscard]] auto at(const std::size_t index) const -> archive_entry;
+
+    /*!
+     * Find an entry by name.
+     */
+    [[nodiscard]] auto find(const common::string_view name) const noexcept -> std::optional<archive_entry>;
+
+    [[nodiscard]] auto contains(const common::string_view name) const noexcept -> bool;
+
+    /*!
+     * Get direct access to the data of an uncompressed entry without copying. Only available if the archive was
+     * opened in memory. The hash of the entry (if any) is not verified.
+     */
+    [[nodiscard]] auto view(const archive_entry &entry) const -> std::span<const std::byte>;
+
+    /*!
+     * Read and decompress the contents of an entry. If the entry has a hash, it is verified.
+     */
+    [[nodiscard]] auto read(const archive_entry &entry) const -> std::vector<std::uint8_t>;
+
+    /*!
+     * Read and decompress the contents of an entry into the given stream in blocks, so that large entries don't
+     * have to fit in memory. If the entry has a hash, it is verified after all data was written.
+     */
+    void read(const archive_entry &entry, streams::idynamic_stream &output) const;
+
+private:
+    void open();
+    [[nodiscard]] auto record(const std::size_t index) const noexcept -> internal::archive_record;
+    [[nodiscard]] auto to_entry(const internal::archive_record &record) const noexcept -> archive_entry;
+    void read_stored(const std::uint64_t offset, std::byte *data, const std::size_t size) const;
+    void read_entry(const archive_entry &entry,
+                    const std::function<void(const std::byte *, const std::size_t)> &callback) const;
+
+    std::span<const std::byte> data_;
+    streams::idynamic_stream *stream_;
+    std::vector<std::byte> directory_storage_;
+    std::span<const std::byte> directory_;
+    common::string_view names_;
+    std::uint64_t entry_count_;
+    std::uint64_t directory_offset_;
+};
+
+} // namespace aeon::file_container
@@ -11,4 +11,8 @@ class resource_file_exception : public std::exception
 {
 };
 
+class archive_exception : public resource_file_exception
+{
+};
+
 } // namespace aeon::file_container
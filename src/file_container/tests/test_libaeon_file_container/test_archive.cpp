@@ -0,0 +1,224 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/file_container/archive.h>
+#include <aeon/file_container/exception.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <aeon/streams/devices/memory_device.h>
+#include <aeon/streams/devices/memory_view_device.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <string>
+#include <algorithm>
+#include <cstring>
+
+using namespace aeon;
+
+namespace internal
+{
+
+[[nodiscard]] static auto to_bytes(const std::string &str)
+{
+    return std::as_bytes(std::span{str});
+}
+
+[[nodiscard]] static auto to_string(const std::vector<std::uint8_t> &data)
+{
+    return std::string{std::begin(data), std::end(data)};
+}
+
+[[nodiscard]] static auto to_string(const std::span<const std::byte> data)
+{
+    return std::string{reinterpret_cast<const char *>(std::data(data)), std::size(data)};
+}
+
+[[nodiscard]] static auto
+    create_test_archive(const std::uint32_t alignment = file_container::archive_writer::default_alignment)
+        -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> data;
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+
+    const std::string compressible(10000, 'a');
+
+    file_container::archive_writer writer{stream, alignment};
+    writer.add("textures/stone.png", to_bytes("stone"));
+    writer.add("textures/grass.png", to_bytes("grass"), file_container::archive_compression::none,
+               file_container::archive_entry_flags::sha256);
+    writer.add("data/compressed.bin", to_bytes(compressible), file_container::archive_compression::zlib,
+               file_container::archive_entry_flags::sha256);
+    writer.add("data/incompressible.bin", to_bytes("xyz"), file_container::archive_compression::zlib);
+    writer.add("empty", {});
+    writer.finish();
+
+    return data;
+}
+
+} // namespace internal
+
+TEST(test_archive, read_from_memory)
+{
+    const auto data = internal::create_test_archive();
+    const file_container::archive archive{std::as_bytes(std::span{data})};
+
+    ASSERT_EQ(5u, archive.size());
+
+    const auto stone = archive.find("textures/stone.png");
+    ASSERT_TRUE(stone.has_value());
+    EXPECT_EQ("textures/stone.png", stone->name);
+    EXPECT_EQ(5u, stone->size);
+    EXPECT_FALSE(stone->hash.has_value());
+    EXPECT_EQ("stone", internal::to_string(archive.view(*stone)));
+    EXPECT_EQ("stone", internal::to_string(archive.read(*stone)));
+
+    const auto grass = archive.find("textures/grass.png");
+    ASSERT_TRUE(grass.has_value());
+    EXPECT_TRUE(grass->hash.has_value());
+    EXPECT_EQ("grass", internal::to_string(archive.read(*grass)));
+
+    const auto compressed = archive.find("data/compressed.bin");
+    ASSERT_TRUE(compressed.has_value());
+    EXPECT_EQ(file_container::archive_compression::zlib, compressed->compression);
+    EXPECT_LT(compressed->stored_size, compressed->size);
+    EXPECT_EQ(std::string(10000, 'a'), internal::to_string(archive.read(*compressed)));
+    EXPECT_THROW([[maybe_unused]] const auto result = archive.view(*compressed), file_container::archive_exception);
+
+    // The stored data is a complete zlib stream that can be decompressed without this library.
+    std::string uncompressed(compressed->size, '\0');
+    auto uncompressed_size = static_cast<uLongf>(std::size(uncompressed));
+    EXPECT_EQ(Z_OK, uncompress(reinterpret_cast<Bytef *>(std::data(uncompressed)), &uncompressed_size,
+                               reinterpret_cast<const Bytef *>(std::data(data) + compressed->offset),
+                               static_cast<uLong>(compressed->stored_size)));
+    EXPECT_EQ(compressed->size, uncompressed_size);
+    EXPECT_EQ(std::string(10000, 'a'), uncompressed);
+
+    const auto incompressible = archive.find("data/incompressible.bin");
+    ASSERT_TRUE(incompressible.has_value());
+    EXPECT_EQ(file_container::archive_compression::none, incompressible->compression);
+    EXPECT_EQ("xyz", internal::to_string(archive.read(*incompressible)));
+
+    const auto empty = archive.find("empty");
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(archive.read(*empty).empty());
+
+    EXPECT_FALSE(archive.find("does/not/exist").has_value());
+    EXPECT_FALSE(archive.contains("textures"));
+    EXPECT_TRUE(archive.contains("empty"));
+}
+
+TEST(test_archive, entries_are_aligned)
+{
+    const auto data = internal::create_test_archive(64);
+    const file_container::archive archive{std::as_bytes(std::span{data})};
+
+    for (auto i = 0u; i < archive.size(); ++i)
+        EXPECT_EQ(0u, archive.at(i).offset % 64);
+}
+
+TEST(test_archive, read_from_stream)
+{
+    auto data = internal::create_test_archive();
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    const file_container::archive archive{stream};
+
+    ASSERT_EQ(5u, archive.size());
+
+    const auto compressed = archive.find("data/compressed.bin");
+    ASSERT_TRUE(compressed.has_value());
+
+    std::vector<std::uint8_t> output;
+    auto output_stream = streams::make_dynamic_stream(streams::memory_view_device{output});
+    archive.read(*compressed, output_stream);
+    EXPECT_EQ(std::string(10000, 'a'), internal::to_string(output));
+
+    const auto grass = archive.find("textures/grass.png");
+    ASSERT_TRUE(grass.has_value());
+    EXPECT_EQ("grass", internal::to_string(archive.read(*grass)));
+
+    EXPECT_THROW([[maybe_unused]] const auto result = archive.view(*grass), file_container::archive_exception);
+}
+
+TEST(test_archive, detects_corrupt_content)
+{
+    auto data = internal::create_test_archive();
+
+    {
+        const file_container::archive archive{std::as_bytes(std::span{data})};
+        const auto grass = archive.find("textures/grass.png");
+        ASSERT_TRUE(grass.has_value());
+        data[grass->offset] = static_cast<std::uint8_t>('G');
+    }
+
+    const file_container::archive archive{std::as_bytes(std::span{data})};
+    const auto grass = archive.find("textures/grass.png");
+    ASSERT_TRUE(grass.has_value());
+
+    // The view is not verified, but a read is.
+    EXPECT_EQ("Grass", internal::to_string(archive.view(*grass)));
+    EXPECT_THROW([[maybe_unused]] const auto result = archive.read(*grass), file_container::archive_exception);
+}
+
+TEST(test_archive, detects_corrupt_directory)
+{
+    auto data = internal::create_test_archive();
+
+    file_container::archive_entry compressed;
+
+    {
+        const file_container::archive archive{std::as_bytes(std::span{data})};
+        compressed = *archive.find("data/compressed.bin");
+    }
+
+    // Find the directory record of the entry by its offset, stored size and size, and change the size to one that can
+    // not be allocated.
+    const std::uint64_t sizes[] = {compressed.offset, compressed.stored_size, compressed.size};
+    const auto bytes = std::as_bytes(std::span{sizes});
+    const auto record =
+        std::search(std::begin(data), std::end(data), std::begin(bytes), std::end(bytes),
+                    [](const std::uint8_t lhs, const std::byte rhs) { return std::byte{lhs} == rhs; });
+    ASSERT_NE(std::end(data), record);
+
+    const std::uint64_t corrupt_size = 1ull << 60;
+    std::memcpy(&*record + sizeof(std::uint64_t) * 2, &corrupt_size, sizeof(corrupt_size));
+
+    const file_container::archive archive{std::as_bytes(std::span{data})};
+    const auto corrupt = archive.find("data/compressed.bin");
+    ASSERT_TRUE(corrupt.has_value());
+    EXPECT_EQ(corrupt_size, corrupt->size);
+
+    // The stored data ends long before the size in the directory.
+    EXPECT_THROW([[maybe_unused]] const auto result = archive.read(*corrupt), file_container::archive_exception);
+}
+
+TEST(test_archive, invalid_archives)
+{
+    std::vector<std::uint8_t> garbage(100, 0xcc);
+    EXPECT_THROW(file_container::archive{std::as_bytes(std::span{garbage})}, file_container::archive_exception);
+
+    auto data = internal::create_test_archive();
+    data.pop_back();
+    EXPECT_THROW(file_container::archive{std::as_bytes(std::span{data})}, file_container::archive_exception);
+}
+
+TEST(test_archive, duplicate_names_throw)
+{
+    std::vector<std::uint8_t> data;
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+
+    file_container::archive_writer writer{stream};
+    writer.add("name", internal::to_bytes("a"));
+    writer.add("name", internal::to_bytes("b"));
+    EXPECT_THROW(writer.finish(), file_container::archive_exception);
+}
+
+TEST(test_archive, empty_archive)
+{
+    std::vector<std::uint8_t> data;
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+
+    file_container::archive_writer writer{stream};
+    writer.finish();
+
+    const file_container::archive archive{std::as_bytes(std::span{data})};
+    EXPECT_EQ(0u, archive.size());
+    EXPECT_FALSE(archive.contains("anything"));
+}
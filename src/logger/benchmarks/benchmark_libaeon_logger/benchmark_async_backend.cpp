@@ -0,0 +1,103 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/async_sink_backend.h>
+#include <aeon/logger/multithreaded_sink_backend.h>
+#include <aeon/logger/log_sink.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class null_sink final : public logger::log_sink
+{
+public:
+    null_sink() = default;
+    ~null_sink() final = default;
+
+    null_sink(const null_sink &) = delete;
+    auto operator=(const null_sink &) noexcept -> null_sink & = delete;
+
+    null_sink(null_sink &&) = delete;
+    auto operator=(null_sink &&) noexcept -> null_sink & = delete;
+
+    void log(const common::string_view message, [[maybe_unused]] const common::string_view module,
+             [[maybe_unused]] const logger::log_level level) final
+    {
+        benchmark::DoNotOptimize(message.data());
+    }
+};
+
+static null_sink sink;
+static std::unique_ptr<logger::base_backend> backend;
+
+template <typename backend_t>
+static void create_backend(std::unique_ptr<backend_t> b)
+{
+    b->add_sink(&sink);
+    backend = std::move(b);
+}
+
+static void setup_multithreaded_backend(const benchmark::State &)
+{
+    create_backend(std::make_unique<logger::multithreaded_sink_backend>(logger::log_level::message));
+}
+
+template <logger::async_full_policy policy>
+static void setup_async_backend(const benchmark::State &)
+{
+    create_backend(std::make_unique<logger::async_sink_backend>(logger::log_level::message,
+                                                                logger::async_sink_backend::default_ring_size, policy));
+}
+
+static void teardown_backend(const benchmark::State &)
+{
+    backend.reset();
+}
+
+} // namespace internal
+
+// Measures the time a producing thread spends per message; the background thread writes to a sink that discards all
+// messages. The backend is created before and destroyed (and thus drained) after the measured loop.
+static void BM_logger_backend_log(benchmark::State &state)
+{
+    const common::string message{"The quick brown fox jumps over the lazy dog."};
+    const common::string module{"Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        internal::backend->log(message, module, logger::log_level::message);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_logger_backend_log)
+    ->Name("BM_multithreaded_sink_backend")
+    ->Setup(internal::setup_multithreaded_backend)
+    ->Teardown(internal::teardown_backend)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_logger_backend_log)
+    ->Name("BM_async_sink_backend_block")
+    ->Setup(internal::setup_async_backend<logger::async_full_policy::block>)
+    ->Teardown(internal::teardown_backend)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_logger_backend_log)
+    ->Name("BM_async_sink_backend_drop")
+    ->Setup(internal::setup_async_backend<logger::async_full_policy::drop>)
+    ->Teardown(internal::teardown_backend)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_logger_backend_log)
+    ->Name("BM_async_sink_backend_overwrite")
+    ->Setup(internal::setup_async_backend<logger::async_full_policy::overwrite>)
+    ->Teardown(internal::teardown_backend)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
@@ -0,0 +1,64 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/async_sink_backend.h>
+#include <aeon/logger/log_sink.h>
+#include <benchmark/benchmark.h>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class discarding_sink final : public logger::log_sink
+{
+public:
+    discarding_sink() = default;
+    ~discarding_sink() final = default;
+
+    discarding_sink(const discarding_sink &) = delete;
+    auto operator=(const discarding_sink &) noexcept -> discarding_sink & = delete;
+
+    discarding_sink(discarding_sink &&) = delete;
+    auto operator=(discarding_sink &&) noexcept -> discarding_sink & = delete;
+
+    void log(const common::string_view message, [[maybe_unused]] const common::string_view module,
+             [[maybe_unused]] const logger::log_level level) final
+    {
+        benchmark::DoNotOptimize(message.data());
+    }
+};
+
+} // namespace internal
+
+// Time spent on the calling thread when formatting through the logger stream.
+static void BM_logger_async_stream_format(benchmark::State &state)
+{
+    internal::discarding_sink sink;
+    logger::async_sink_backend backend;
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        AEON_LOG_MESSAGE(log) << "Frame " << 1234 << " took " << 16.667 << " ms on " << "render" << std::endl;
+    }
+}
+
+BENCHMARK(BM_logger_async_stream_format);
+
+// Time spent on the calling thread when the formatting is deferred to the background thread.
+static void BM_logger_async_deferred_format(benchmark::State &state)
+{
+    internal::discarding_sink sink;
+    logger::async_sink_backend backend;
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        AEON_LOG_DEFERRED_MESSAGE(log, "Frame {} took {} ms on {}", 1234, 16.667, "render");
+    }
+}
+
+BENCHMARK(BM_logger_async_deferred_format);
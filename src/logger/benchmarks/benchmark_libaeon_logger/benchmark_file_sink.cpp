@@ -0,0 +1,63 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/simple_sink_backend.h>
+#include <aeon/logger/stream_sink.h>
+#include <aeon/logger/file_sink.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <aeon/streams/devices/file_device.h>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+using namespace aeon;
+
+namespace internal
+{
+
+[[nodiscard]] static auto benchmark_log_path() -> std::filesystem::path
+{
+    return std::filesystem::temp_directory_path() / "benchmark_libaeon_logger.log";
+}
+
+} // namespace internal
+
+// Every fragment of every message is written to the file separately.
+static void BM_logger_stream_sink_file(benchmark::State &state)
+{
+    {
+        auto stream = streams::make_dynamic_stream(streams::file_sink_device{internal::benchmark_log_path()});
+        logger::stream_sink sink{stream};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Benchmark"};
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AEON_LOG_MESSAGE(log) << "Frame " << 1234 << " took " << 16.667 << " ms" << std::endl;
+        }
+    }
+
+    std::filesystem::remove(internal::benchmark_log_path());
+}
+
+BENCHMARK(BM_logger_stream_sink_file);
+
+// Messages are collected in a buffer and written by a background thread.
+static void BM_logger_file_sink(benchmark::State &state)
+{
+    {
+        logger::file_sink sink{internal::benchmark_log_path()};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Benchmark"};
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AEON_LOG_MESSAGE(log) << "Frame " << 1234 << " took " << 16.667 << " ms" << std::endl;
+        }
+    }
+
+    std::filesystem::remove(internal::benchmark_log_path());
+}
+
+BENCHMARK(BM_logger_file_sink);
@@ -0,0 +1,75 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/base_backend.h>
+#include <benchmark/benchmark.h>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class null_backend final : public logger::base_backend
+{
+public:
+    explicit null_backend(const logger::log_level level)
+        : base_backend{level}
+    {
+    }
+
+    ~null_backend() final = default;
+
+    null_backend(const null_backend &) = delete;
+    auto operator=(const null_backend &) noexcept -> null_backend & = delete;
+
+    null_backend(null_backend &&) = delete;
+    auto operator=(null_backend &&) noexcept -> null_backend & = delete;
+
+    void log(const common::string_view message, [[maybe_unused]] const common::string_view module,
+             [[maybe_unused]] const logger::log_level level) final
+    {
+        benchmark::DoNotOptimize(message.data());
+    }
+};
+
+} // namespace internal
+
+static void BM_logger_disabled_level(benchmark::State &state)
+{
+    internal::null_backend backend{logger::log_level::message};
+    logger::logger log{backend, "Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        AEON_LOG_TRACE(log) << "Value: " << 42 << " " << 3.14 << std::endl;
+    }
+}
+
+BENCHMARK(BM_logger_disabled_level);
+
+// The same disabled log statement without the macro; the stream is created, but nothing is formatted.
+static void BM_logger_disabled_level_without_macro(benchmark::State &state)
+{
+    internal::null_backend backend{logger::log_level::message};
+    logger::logger log{backend, "Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        log(logger::log_level::trace) << "Value: " << 42 << " " << 3.14 << std::endl;
+    }
+}
+
+BENCHMARK(BM_logger_disabled_level_without_macro);
+
+static void BM_logger_enabled_level(benchmark::State &state)
+{
+    internal::null_backend backend{logger::log_level::trace};
+    logger::logger log{backend, "Benchmark"};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        AEON_LOG_TRACE(log) << "Value: " << 42 << " " << 3.14 << std::endl;
+    }
+}
+
+BENCHMARK(BM_logger_enabled_level);
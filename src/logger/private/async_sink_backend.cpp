@@ -0,0 +1,407 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/async_sink_backend.h>
+#include <aeon/logger/log_sink.h>
+#include "log_ring.h"
+#include <algorithm>
+#include <utility>
+
+namespace aeon::logger
+{
+
+namespace internal
+{
+
+[[nodiscard]] static auto next_backend_id() noexcept -> std::uint64_t
+{
+    static std::atomic<std::uint64_t> id{0};
+    return ++id;
+}
+
+[[nodiscard]] static auto round_up_to_power_of_two(const std::size_t value) noexcept -> std::size_t
+{
+    std::size_t result = 2;
+
+    while (result < value)
+        result <<= 1;
+
+    return result;
+}
+
+/*!
+ * The rings of the calling thread, by backend id. When the thread exits, its rings are marked as released so that the
+ * backends can reuse them.
+ */
+class thread_rings final
+{
+public:
+    thread_rings() = default;
+
+    ~thread_rings()
+    {
+        for (const auto &[id, ring] : rings)
+            ring->released.store(true, std::memory_order_release);
+    }
+
+    thread_rings(const thread_rings &) = delete;
+    auto operator=(const thread_rings &) -> thread_rings & = delete;
+
+    thread_rings(thread_rings &&) = delete;
+    auto operator=(thread_rings &&) -> thread_rings & = delete;
+
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<thread_log_ring>>> rings;
+};
+
+} // namespace internal
+
+async_sink_backend::async_sink_backend()
+    : async_sink_backend{log_level::message}
+{
+}
+
+async_sink_backend::async_sink_backend(const log_level level, const std::size_t ring_size,
+                                       const async_full_policy policy)
+    : base_backend{level}
+    , id_{internal::next_backend_id()}
+    , ring_size_{internal::round_up_to_power_of_two(ring_size)}
+    , policy_{policy}
+    , rings_mutex_{}
+    , rings_{}
+    , free_rings_{}
+    , drain_rings_{}
+    , formatted_message_{}
+    , sink_mutex_{}
+    , sinks_{}
+    , room_mutex_{}
+    , room_available_{}
+    , waiting_{0}
+    , signal_{0}
+    , running_{true}
+    , sleeping_{false}
+    , dropped_{0}
+    , thread_{}
+{
+    handle_background_thread();
+}
+
+async_sink_backend::~async_sink_backend()
+{
+    stop();
+}
+
+void async_sink_backend::add_sink(log_sink *sink)
+{
+    std::scoped_lock lock{sink_mutex_};
+
+    if (std::find(std::begin(sinks_), std::end(sinks_), sink) == std::end(sinks_))
+        sinks_.push_back(sink);
+}
+
+void async_sink_backend::remove_all_sinks()
+{
+    std::scoped_lock lock{sink_mutex_};
+    sinks_.clear();
+}
+
+void async_sink_backend::stop()
+{
+    if (!running_.exchange(false, std::memory_order_seq_cst))
+        return;
+
+    // Threads that wait for room in a full ring discard their message instead.
+    {
+        std::scoped_lock lock{room_mutex_};
+    }
+
+    room_available_.notify_all();
+
+    wake();
+    thread_.join();
+
+    // A push that started before running_ was cleared may have ended up in a ring after the final drain.
+    std::scoped_lock lock{rings_mutex_};
+
+    for (const auto &ring : rings_)
+    {
+        while (ring->pushing.load(std::memory_order_seq_cst))
+            std::this_thread::yield();
+
+        while (ring->messages.try_pop([](const internal::log_ring::slot &) {}))
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+auto async_sink_backend::dropped_count() const noexcept -> std::uint64_t
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void async_sink_backend::log(const common::string_view message, const common::string_view module, const log_level level)
+{
+    push(
+        [message, module, level](internal::log_ring::slot &slot)
+        {
+            slot.level = level;
+            slot.format = nullptr;
+            slot.message = message;
+            slot.module = module;
+        });
+}
+
+void async_sink_backend::log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                                      const common::string_view module)
+{
+    push(
+        [&format, arguments, module](internal::log_ring::slot &slot)
+        {
+            slot.level = format.level();
+            slot.format = &format;
+            slot.message.clear();
+            slot.message.append(reinterpret_cast<const char *>(std::data(arguments)), std::size(arguments));
+            slot.module = module;
+        });
+}
+
+template <typename func_t>
+void async_sink_backend::push(func_t &&fill)
+{
+    if (!running_.load(std::memory_order_relaxed))
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto &ring = get_ring();
+
+    // Pairs with stop(): either stop() sees that this thread is pushing and waits for it, or this thread sees that the
+    // backend was stopped.
+    ring.pushing.store(true, std::memory_order_seq_cst);
+
+    if (!running_.load(std::memory_order_seq_cst))
+    {
+        ring.pushing.store(false, std::memory_order_release);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!ring.messages.try_push(fill))
+    {
+        switch (policy_)
+        {
+            case async_full_policy::block:
+            {
+                waiting_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                {
+                    std::unique_lock lock{room_mutex_};
+
+                    while (!ring.messages.try_push(fill))
+                    {
+                        if (!running_.load(std::memory_order_relaxed))
+                        {
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                            break;
+                        }
+
+                        wake();
+                        room_available_.wait(lock);
+                    }
+                }
+
+                waiting_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            break;
+            case async_full_policy::drop:
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+            case async_full_policy::overwrite:
+            {
+                do
+                {
+                    // The background thread may have made room in the meantime, in which case nothing is discarded.
+                    if (ring.messages.try_pop([](const internal::log_ring::slot &) {}))
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                } while (!ring.messages.try_push(fill));
+            }
+            break;
+        }
+    }
+
+    ring.pushing.store(false, std::memory_order_release);
+    wake_if_sleeping();
+}
+
+auto async_sink_backend::get_ring() -> internal::thread_log_ring &
+{
+    // Backend ids are never reused, so entries of backends that no longer exist are never matched.
+    thread_local internal::thread_rings thread_rings;
+
+    for (const auto &[id, ring] : thread_rings.rings)
+    {
+        if (id == id_)
+            return *ring;
+    }
+
+    // Forget the rings of backends that were destroyed; this thread holds the last reference to them.
+    std::erase_if(thread_rings.rings, [](const auto &entry) { return entry.second.use_count() == 1; });
+
+    std::scoped_lock lock{rings_mutex_};
+
+    std::shared_ptr<internal::thread_log_ring> ring;
+
+    if (!std::empty(free_rings_))
+    {
+        ring = std::move(free_rings_.back());
+        free_rings_.pop_back();
+    }
+    else
+    {
+        ring = rings_.emplace_back(std::make_shared<internal::thread_log_ring>(ring_size_));
+    }
+
+    thread_rings.rings.emplace_back(id_, ring);
+    return *ring;
+}
+
+void async_sink_backend::release_ring(internal::thread_log_ring &ring)
+{
+    std::scoped_lock lock{rings_mutex_};
+
+    ring.released.store(false, std::memory_order_relaxed);
+
+    const auto result = std::find_if(std::begin(rings_), std::end(rings_),
+                                     [&ring](const auto &r) { return r.get() == &ring; });
+    free_rings_.push_back(*result);
+}
+
+auto async_sink_backend::drain() -> bool
+{
+    {
+        std::scoped_lock lock{rings_mutex_};
+
+        for (auto i = std::size(drain_rings_); i < std::size(rings_); ++i)
+            drain_rings_.push_back(rings_[i].get());
+    }
+
+    std::scoped_lock lock{sink_mutex_};
+
+    auto processed = false;
+
+    for (const auto ring : drain_rings_)
+    {
+        // Checked before draining, so that all messages of a thread that has exited are seen.
+        const auto released = ring->released.load(std::memory_order_acquire);
+        auto empty = false;
+
+        // Limit the batch size per ring, so that a single busy thread can not starve the others.
+        for (std::size_t i = 0; i < ring_size_; ++i)
+        {
+            const auto result = ring->messages.try_pop(
+                [this](const internal::log_ring::slot &slot)
+                {
+                    if (!slot.format)
+                    {
+                        for (const auto sink : sinks_)
+                            sink->log(slot.message, slot.module, slot.level);
+
+                        return;
+                    }
+
+                    const std::span arguments{reinterpret_cast<const std::byte *>(std::data(slot.message)),
+                                              std::size(slot.message)};
+
+                    formatted_message_.clear();
+                    format_binary_log(slot.format->format(), arguments, formatted_message_);
+
+                    for (const auto sink : sinks_)
+                        sink->log(formatted_message_, slot.module, slot.level);
+                });
+
+            if (!result)
+            {
+                empty = true;
+                break;
+            }
+
+            processed = true;
+        }
+
+        if (released && empty)
+            release_ring(*ring);
+    }
+
+    return processed;
+}
+
+void async_sink_backend::notify_waiting_threads()
+{
+    // Pairs with the fence in push(): either the waiting thread sees the room that was just made, or this thread sees
+    // that it is waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (waiting_.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // Taking the mutex ensures that a thread that just found its ring full is waiting before it is notified.
+    {
+        std::scoped_lock lock{room_mutex_};
+    }
+
+    room_available_.notify_all();
+}
+
+void async_sink_backend::wake_if_sleeping() noexcept
+{
+    // Pairs with the fence in the background thread: either this thread sees that the background thread is going to
+    // sleep, or the background thread sees the message that was just pushed.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Only the first thread that sees the background thread sleeping needs to wake it up.
+    if (sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false, std::memory_order_relaxed))
+        wake();
+}
+
+void async_sink_backend::wake() noexcept
+{
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+}
+
+void async_sink_backend::handle_background_thread()
+{
+    thread_ = std::thread(
+        [this]()
+        {
+            while (true)
+            {
+                const auto running = running_.load(std::memory_order_acquire);
+
+                if (drain())
+                {
+                    notify_waiting_threads();
+                    continue;
+                }
+
+                if (!running)
+                    break;
+
+                const auto signal = signal_.load(std::memory_order_acquire);
+                sleeping_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // Check again after announcing that this thread is going to sleep, so that a message that was pushed
+                // in the meantime is not left waiting for the next one.
+                if (drain())
+                    notify_waiting_threads();
+                else if (running_.load(std::memory_order_acquire))
+                    signal_.wait(signal, std::memory_order_acquire);
+
+                sleeping_.store(false, std::memory_order_relaxed);
+            }
+        });
+}
+
+} // namespace aeon::logger
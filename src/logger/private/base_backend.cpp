@@ -17,18 +17,36 @@ base_backend::base_backend(const log_level level)
 
 void base_backend::set_log_level(const log_level level)
 {
-    level_ = level;
+    level_.store(level, std::memory_order_relaxed);
 }
 
 auto base_backend::get_log_level() const -> log_level
 {
-    return level_;
+    return level_.load(std::memory_order_relaxed);
 }
 
-void base_backend::handle_log(const common::string &message, const common::string &module, const log_level level)
+void base_backend::handle_log(const common::string_view message, const common::string_view module,
+                              const log_level level)
 {
-    if (level >= level_)
+    if (is_enabled(level))
         log(message, module, level);
 }
 
+void base_backend::log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                                const common::string_view module)
+{
+    // Reused for every message of the thread, so that its capacity only grows to the longest message.
+    thread_local common::string message;
+    message.clear();
+    format_binary_log(format.format(), arguments, message);
+    log(message, module, format.level());
+}
+
+void base_backend::handle_log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                                       const common::string_view module)
+{
+    if (is_enabled(format.level()))
+        log_deferred(format, arguments, module);
+}
+
 } // namespace aeon::logger
@@ -0,0 +1,144 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/binary_file_backend.h>
+#include "binary_log_file_format.h"
+#include <chrono>
+
+namespace aeon::logger
+{
+
+namespace internal
+{
+
+[[nodiscard]] static auto current_timestamp() noexcept -> std::uint64_t
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+} // namespace internal
+
+binary_file_backend::binary_file_backend(streams::idynamic_stream &stream, const log_level level,
+                                         const std::size_t buffer_size)
+    : base_backend{level}
+    , mutex_{}
+    , stream_{&stream}
+    , buffer_size_{buffer_size}
+    , buffer_{}
+    , written_formats_{}
+{
+    buffer_.reserve(buffer_size_);
+
+    append(&internal::binary_log_magic, sizeof(internal::binary_log_magic));
+    append(&internal::binary_log_version, sizeof(internal::binary_log_version));
+}
+
+binary_file_backend::~binary_file_backend()
+{
+    flush();
+}
+
+void binary_file_backend::flush()
+{
+    std::scoped_lock lock{mutex_};
+    flush_buffer();
+
+    if (stream_->is_flushable())
+        stream_->flush();
+}
+
+void binary_file_backend::log(const common::string_view message, const common::string_view module,
+                              const log_level level)
+{
+    const auto timestamp = internal::current_timestamp();
+
+    std::scoped_lock lock{mutex_};
+
+    constexpr auto type = internal::binary_log_record_type::message;
+    const auto level_value = static_cast<std::uint8_t>(level);
+
+    append(&type, sizeof(type));
+    append(&level_value, sizeof(level_value));
+    append(&timestamp, sizeof(timestamp));
+    append_string(module);
+    append_string(message);
+
+    flush_if_full();
+}
+
+void binary_file_backend::log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                                       const common::string_view module)
+{
+    const auto timestamp = internal::current_timestamp();
+
+    std::scoped_lock lock{mutex_};
+
+    write_format(format);
+
+    constexpr auto type = internal::binary_log_record_type::deferred_message;
+    const auto id = format.id();
+    const auto arguments_size = static_cast<std::uint32_t>(std::size(arguments));
+
+    append(&type, sizeof(type));
+    append(&id, sizeof(id));
+    append(&timestamp, sizeof(timestamp));
+    append_string(module);
+    append(&arguments_size, sizeof(arguments_size));
+    append(std::data(arguments), std::size(arguments));
+
+    flush_if_full();
+}
+
+void binary_file_backend::write_format(const binary_log_format &format)
+{
+    const auto id = format.id();
+
+    if (id < std::size(written_formats_) && written_formats_[id])
+        return;
+
+    if (id >= std::size(written_formats_))
+        written_formats_.resize(id + 1);
+
+    written_formats_[id] = true;
+
+    constexpr auto type = internal::binary_log_record_type::format;
+    const auto level = static_cast<std::uint8_t>(format.level());
+    const auto line = format.line();
+
+    append(&type, sizeof(type));
+    append(&id, sizeof(id));
+    append(&level, sizeof(level));
+    append(&line, sizeof(line));
+    append_string(format.file());
+    append_string(format.format());
+}
+
+void binary_file_backend::append(const void *data, const std::size_t size)
+{
+    const auto bytes = static_cast<const std::byte *>(data);
+    buffer_.insert(std::end(buffer_), bytes, bytes + size);
+}
+
+void binary_file_backend::append_string(const common::string_view str)
+{
+    const auto size = static_cast<std::uint32_t>(std::size(str));
+    append(&size, sizeof(size));
+    append(std::data(str), size);
+}
+
+void binary_file_backend::flush_if_full()
+{
+    if (std::size(buffer_) >= buffer_size_)
+        flush_buffer();
+}
+
+void binary_file_backend::flush_buffer()
+{
+    if (std::empty(buffer_))
+        return;
+
+    stream_->write(std::data(buffer_), static_cast<std::streamsize>(std::size(buffer_)));
+    buffer_.clear();
+}
+
+} // namespace aeon::logger
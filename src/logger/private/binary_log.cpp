@@ -0,0 +1,220 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/binary_log.h>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+
+namespace aeon::logger
+{
+
+namespace internal
+{
+
+[[nodiscard]] static auto next_format_id() noexcept -> std::uint32_t
+{
+    static std::atomic<std::uint32_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
+
+class binary_log_argument_decoder final
+{
+public:
+    explicit binary_log_argument_decoder(const std::span<const std::byte> arguments) noexcept
+        : arguments_{arguments}
+        , offset_{0}
+    {
+    }
+
+    [[nodiscard]] auto empty() const noexcept
+    {
+        return offset_ >= std::size(arguments_);
+    }
+
+    /*!
+     * Decode the next argument and append it to the result. Returns false if the argument is malformed.
+     */
+    [[nodiscard]] auto decode_next(common::string &result) noexcept -> bool
+    {
+        binary_log_argument_type type;
+        if (!read(&type, sizeof(type)))
+            return false;
+
+        switch (type)
+        {
+            case binary_log_argument_type::boolean:
+            {
+                std::uint8_t value = 0;
+                if (!read(&value, sizeof(value)))
+                    return false;
+
+                result += (value != 0) ? "true" : "false";
+                return true;
+            }
+            case binary_log_argument_type::character:
+            {
+                char value = 0;
+                if (!read(&value, sizeof(value)))
+                    return false;
+
+                result += value;
+                return true;
+            }
+            case binary_log_argument_type::int8:
+                return decode_number<std::int8_t>(result);
+            case binary_log_argument_type::uint8:
+                return decode_number<std::uint8_t>(result);
+            case binary_log_argument_type::int16:
+                return decode_number<std::int16_t>(result);
+            case binary_log_argument_type::uint16:
+                return decode_number<std::uint16_t>(result);
+            case binary_log_argument_type::int32:
+                return decode_number<std::int32_t>(result);
+            case binary_log_argument_type::uint32:
+                return decode_number<std::uint32_t>(result);
+            case binary_log_argument_type::int64:
+                return decode_number<std::int64_t>(result);
+            case binary_log_argument_type::uint64:
+                return decode_number<std::uint64_t>(result);
+            case binary_log_argument_type::float32:
+                return decode_number<float>(result);
+            case binary_log_argument_type::float64:
+                return decode_number<double>(result);
+            case binary_log_argument_type::string:
+            {
+                std::uint32_t size = 0;
+                if (!read(&size, sizeof(size)) || size > std::size(arguments_) - offset_)
+                    return false;
+
+                result.append(reinterpret_cast<const char *>(std::data(arguments_)) + offset_, size);
+                offset_ += size;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+private:
+    [[nodiscard]] auto read(void *data, const std::size_t size) noexcept -> bool
+    {
+        if (size > std::size(arguments_) - offset_)
+            return false;
+
+        std::memcpy(data, std::data(arguments_) + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    template <typename T>
+    [[nodiscard]] auto decode_number(common::string &result) noexcept -> bool
+    {
+        T value{};
+        if (!read(&value, sizeof(value)))
+            return false;
+
+        std::array<char, 32> buffer{};
+        const auto [end, ec] = std::to_chars(std::data(buffer), std::data(buffer) + std::size(buffer), value);
+
+        if (ec != std::errc{})
+            return false;
+
+        result.append(std::data(buffer), static_cast<std::size_t>(end - std::data(buffer)));
+        return true;
+    }
+
+    std::span<const std::byte> arguments_;
+    std::size_t offset_;
+};
+
+} // namespace internal
+
+binary_log_format::binary_log_format(const log_level level, const char *const format, const char *const file,
+                                     const std::uint32_t line) noexcept
+    : id_{internal::next_format_id()}
+    , level_{level}
+    , format_{format}
+    , file_{file}
+    , line_{line}
+{
+}
+
+void binary_log_arguments::append_raw(const void *data, const std::size_t size)
+{
+    if (std::empty(heap_) && size_ + size <= inline_capacity)
+    {
+        std::memcpy(std::data(inline_) + size_, data, size);
+        size_ += size;
+        return;
+    }
+
+    if (std::empty(heap_))
+        heap_.assign(std::begin(inline_), std::begin(inline_) + static_cast<std::ptrdiff_t>(size_));
+
+    const auto bytes = static_cast<const std::byte *>(data);
+    heap_.insert(std::end(heap_), bytes, bytes + size);
+    size_ += size;
+}
+
+void binary_log_arguments::append_string(const std::string_view str)
+{
+    const auto size = static_cast<std::uint32_t>(std::size(str));
+    append_type(binary_log_argument_type::string);
+    append_raw(&size, sizeof(size));
+    append_raw(std::data(str), size);
+}
+
+void format_binary_log(const common::string_view format, const std::span<const std::byte> arguments,
+                       common::string &result)
+{
+    internal::binary_log_argument_decoder decoder{arguments};
+    auto valid = true;
+
+    const auto size = std::size(format);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto c = format[i];
+
+        if (c == '{' && i + 1 < size && format[i + 1] == '{')
+        {
+            result += '{';
+            ++i;
+        }
+        else if (c == '}' && i + 1 < size && format[i + 1] == '}')
+        {
+            result += '}';
+            ++i;
+        }
+        else if (c == '{')
+        {
+            const auto end = format.find('}', i);
+
+            if (end == common::string_view::npos)
+            {
+                result.append(std::data(format) + i, size - i);
+                return;
+            }
+
+            if (valid && !decoder.empty())
+            {
+                valid = decoder.decode_next(result);
+
+                if (!valid)
+                    result += "<invalid>";
+            }
+            else
+            {
+                result.append(std::data(format) + i, end - i + 1);
+            }
+
+            i = end;
+        }
+        else
+        {
+            result += c;
+        }
+    }
+}
+
+} // namespace aeon::logger
@@ -0,0 +1,33 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/common/fourcc.h>
+#include <cstdint>
+
+namespace aeon::logger::internal
+{
+
+/*!
+ * Binary log file layout. All values are stored in native byte order. Strings are stored as a 32-bit length followed
+ * by the characters.
+ *
+ * header:           u32 magic, u32 version
+ * format record:    u8 type, u32 format id, u8 level, u32 line, string file, string format
+ * deferred record:  u8 type, u32 format id, u64 timestamp, string module, u32 size, encoded arguments
+ * message record:   u8 type, u8 level, u64 timestamp, string module, string message
+ *
+ * A format record is written once, before the first deferred record that refers to it. Timestamps are in nanoseconds
+ * since the system clock epoch.
+ */
+static constexpr std::uint32_t binary_log_magic = common::fourcc('A', 'B', 'L', '1');
+static constexpr std::uint32_t binary_log_version = 1;
+
+enum class binary_log_record_type : std::uint8_t
+{
+    format = 1,
+    deferred_message = 2,
+    message = 3
+};
+
+} // namespace aeon::logger::internal
@@ -0,0 +1,195 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/binary_log_reader.h>
+#include <aeon/logger/binary_log.h>
+#include <aeon/logger/exception.h>
+#include "binary_log_file_format.h"
+#include <span>
+#include <algorithm>
+
+namespace aeon::logger
+{
+
+namespace internal
+{
+
+// Fields are read in blocks of this size if the size of the stream is not known.
+static constexpr std::size_t read_block_size = 64 * 1024;
+
+} // namespace internal
+
+binary_log_reader::binary_log_reader(streams::idynamic_stream &stream)
+    : stream_{&stream}
+    , formats_{}
+    , arguments_{}
+{
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+
+    if (!try_read(&magic, sizeof(magic)) || magic != internal::binary_log_magic)
+        throw binary_log_exception{};
+
+    read(&version, sizeof(version));
+
+    if (version != internal::binary_log_version)
+        throw binary_log_exception{};
+}
+
+binary_log_reader::~binary_log_reader() = default;
+
+auto binary_log_reader::read(binary_log_entry &entry) -> bool
+{
+    while (true)
+    {
+        internal::binary_log_record_type type;
+
+        if (!try_read(&type, sizeof(type)))
+            return false;
+
+        switch (type)
+        {
+            case internal::binary_log_record_type::format:
+            {
+                std::uint32_t id = 0;
+                read(&id, sizeof(id));
+
+                format_info info;
+                info.level = read_level();
+                read(&info.line, sizeof(info.line));
+                read_string(info.file);
+                read_string(info.format);
+
+                formats_.insert_or_assign(id, std::move(info));
+            }
+            break;
+            case internal::binary_log_record_type::deferred_message:
+            {
+                std::uint32_t id = 0;
+                read(&id, sizeof(id));
+
+                const auto format = formats_.find(id);
+
+                if (format == std::end(formats_))
+                    throw binary_log_exception{};
+
+                entry.timestamp = read_timestamp();
+                read_string(entry.module);
+
+                std::uint32_t arguments_size = 0;
+                read(&arguments_size, sizeof(arguments_size));
+                read_sized(arguments_, arguments_size);
+
+                entry.level = format->second.level;
+                entry.message.clear();
+                format_binary_log(format->second.format, arguments_, entry.message);
+                entry.file = format->second.file;
+                entry.line = format->second.line;
+                return true;
+            }
+            case internal::binary_log_record_type::message:
+            {
+                entry.level = read_level();
+                entry.timestamp = read_timestamp();
+                read_string(entry.module);
+                read_string(entry.message);
+                entry.file.clear();
+                entry.line = 0;
+                return true;
+            }
+            default:
+                throw binary_log_exception{};
+        }
+    }
+}
+
+auto binary_log_reader::try_read(void *data, const std::size_t size) -> bool
+{
+    auto *bytes = static_cast<std::byte *>(data);
+    std::size_t total = 0;
+
+    while (total < size)
+    {
+        const auto result = stream_->read(bytes + total, static_cast<std::streamsize>(size - total));
+
+        if (result <= 0)
+            break;
+
+        total += static_cast<std::size_t>(result);
+    }
+
+    if (total == 0)
+        return false;
+
+    // A record that was cut off halfway means the log was truncated.
+    if (total != size)
+        throw binary_log_exception{};
+
+    return true;
+}
+
+void binary_log_reader::read(void *data, const std::size_t size)
+{
+    if (size != 0 && !try_read(data, size))
+        throw binary_log_exception{};
+}
+
+void binary_log_reader::read_string(common::string &str)
+{
+    std::uint32_t size = 0;
+    read(&size, sizeof(size));
+
+    read_sized(str, size);
+}
+
+template <typename T>
+void binary_log_reader::read_sized(T &buffer, const std::uint32_t size)
+{
+    // Sizes are read from the log, so they are checked before allocating; a corrupt size must not cause a huge
+    // allocation.
+    if (stream_->has_size())
+    {
+        if (static_cast<std::streamoff>(size) > stream_->size() - stream_->tellg())
+            throw binary_log_exception{};
+
+        buffer.resize(size);
+        read(std::data(buffer), size);
+        return;
+    }
+
+    // Without a known size, the buffer grows as the data is read, so it never gets much larger than the data that is
+    // actually in the stream.
+    buffer.clear();
+
+    std::size_t offset = 0;
+
+    while (offset < size)
+    {
+        const auto block_size = std::min(static_cast<std::size_t>(size) - offset, internal::read_block_size);
+        buffer.resize(offset + block_size);
+        read(std::data(buffer) + offset, block_size);
+        offset += block_size;
+    }
+}
+
+auto binary_log_reader::read_level() -> log_level
+{
+    std::uint8_t level = 0;
+    read(&level, sizeof(level));
+
+    if (level > static_cast<std::uint8_t>(log_level::fatal))
+        throw binary_log_exception{};
+
+    return static_cast<log_level>(level);
+}
+
+auto binary_log_reader::read_timestamp() -> std::chrono::system_clock::time_point
+{
+    std::uint64_t timestamp = 0;
+    read(&timestamp, sizeof(timestamp));
+
+    const auto duration = std::chrono::nanoseconds{static_cast<std::int64_t>(timestamp)};
+    return std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(duration)};
+}
+
+} // namespace aeon::logger
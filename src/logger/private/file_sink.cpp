@@ -0,0 +1,525 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/file_sink.h>
+#include <aeon/compression/zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <vector>
+#include <system_error>
+
+namespace aeon::logger
+{
+
+namespace internal
+{
+
+static constexpr std::size_t compress_block_size = 64 * 1024;
+
+[[nodiscard]] static auto today() noexcept -> std::chrono::sys_days
+{
+    return std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+}
+
+/*!
+ * Write a value as decimal digits, padded with zeros to the given width.
+ */
+static auto write_padded(char *destination, unsigned int value, const int width) noexcept -> char *
+{
+    for (auto i = width - 1; i >= 0; --i)
+    {
+        destination[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+
+    return destination + width;
+}
+
+/*!
+ * Write a date in the form of YYYY-MM-DD.
+ */
+static auto write_date(char *destination, const std::chrono::year_month_day &date) noexcept -> char *
+{
+    destination = write_padded(destination, static_cast<unsigned int>(static_cast<int>(date.year())), 4);
+    *destination++ = '-';
+    destination = write_padded(destination, static_cast<unsigned int>(date.month()), 2);
+    *destination++ = '-';
+    return write_padded(destination, static_cast<unsigned int>(date.day()), 2);
+}
+
+[[nodiscard]] static auto format_date(const std::chrono::sys_days day) -> std::string
+{
+    std::array<char, 16> buffer{};
+    const auto end = write_date(std::data(buffer), std::chrono::year_month_day{day});
+    return std::string{std::data(buffer), end};
+}
+
+[[nodiscard]] static auto last_write_day(const std::filesystem::path &path) -> std::optional<std::chrono::sys_days>
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+
+    if (ec)
+        return std::nullopt;
+
+    return std::chrono::floor<std::chrono::days>(std::chrono::file_clock::to_sys(time));
+}
+
+[[nodiscard]] static auto exists(const std::filesystem::path &path) noexcept -> bool
+{
+    std::error_code ec;
+    return std::filesystem::exists(path, ec);
+}
+
+static void rename_if_exists(const std::filesystem::path &from, const std::filesystem::path &to) noexcept
+{
+    std::error_code ec;
+    if (std::filesystem::exists(from, ec))
+        std::filesystem::rename(from, to, ec);
+}
+
+} // namespace internal
+
+file_sink::file_sink(std::filesystem::path path)
+    : file_sink{std::move(path), file_sink_settings{}}
+{
+}
+
+file_sink::file_sink(std::filesystem::path path, file_sink_settings settings)
+    : path_{std::move(path)}
+    , settings_{std::move(settings)}
+    , mutex_{}
+    , writer_signal_{}
+    , flushed_signal_{}
+    , buffer_{}
+    , flush_requested_{false}
+    , stop_{false}
+    , requested_generation_{0}
+    , written_generation_{0}
+    , cached_second_{}
+    , cached_timestamp_{}
+    , cached_timestamp_size_{0}
+    , write_buffer_{}
+    , file_{}
+    , file_size_{0}
+    , file_day_{internal::last_write_day(path_).value_or(internal::today())}
+    , failed_writes_{0}
+    , compress_mutex_{}
+    , compress_signal_{}
+    , compress_path_{}
+    , compress_stop_{false}
+    , compress_thread_{}
+    , thread_{}
+{
+    buffer_.reserve(settings_.buffer_size);
+    write_buffer_.reserve(settings_.buffer_size);
+
+    open_file();
+
+    if (settings_.compress_rotated_files)
+        compress_thread_ = std::thread{[this]() { compress_thread_main(); }};
+
+    thread_ = std::thread{[this]() { thread_main(); }};
+}
+
+file_sink::~file_sink()
+{
+    {
+        std::scoped_lock lock{mutex_};
+        stop_ = true;
+    }
+
+    writer_signal_.notify_one();
+    thread_.join();
+
+    // The writer is stopped, so no more files are rotated. A file that is still being compressed is finished first.
+    if (compress_thread_.joinable())
+    {
+        {
+            std::scoped_lock lock{compress_mutex_};
+            compress_stop_ = true;
+        }
+
+        compress_signal_.notify_all();
+        compress_thread_.join();
+    }
+}
+
+void file_sink::flush()
+{
+    std::unique_lock lock{mutex_};
+    const auto generation = ++requested_generation_;
+    flush_requested_ = true;
+    writer_signal_.notify_one();
+    flushed_signal_.wait(lock, [this, generation]() { return written_generation_ >= generation; });
+}
+
+auto file_sink::path() const noexcept -> const std::filesystem::path &
+{
+    return path_;
+}
+
+auto file_sink::failed_write_count() const noexcept -> std::uint64_t
+{
+    return failed_writes_.load(std::memory_order_relaxed);
+}
+
+void file_sink::log(const common::string_view message, const common::string_view module, const log_level level)
+{
+    const auto now = std::chrono::system_clock::now();
+    auto notify = false;
+
+    {
+        std::scoped_lock lock{mutex_};
+
+        format_timestamp(now);
+        buffer_ += " [";
+        buffer_ += module;
+        buffer_ += "] [";
+        buffer_ += log_level_str[static_cast<int>(level)];
+        buffer_ += "]: ";
+        buffer_ += message;
+        buffer_ += '\n';
+
+        if (!flush_requested_ && (std::size(buffer_) >= settings_.buffer_size || level >= settings_.flush_level))
+        {
+            flush_requested_ = true;
+            notify = true;
+        }
+    }
+
+    if (notify)
+        writer_signal_.notify_one();
+}
+
+void file_sink::format_timestamp(const std::chrono::system_clock::time_point time)
+{
+    const auto second = std::chrono::floor<std::chrono::seconds>(time);
+
+    if (second != cached_second_ || cached_timestamp_size_ == 0)
+    {
+        const auto day = std::chrono::floor<std::chrono::days>(second);
+        const std::chrono::hh_mm_ss time_of_day{second - day};
+
+        auto end = internal::write_date(std::data(cached_timestamp_), std::chrono::year_month_day{day});
+        *end++ = ' ';
+        end = internal::write_padded(end, static_cast<unsigned int>(time_of_day.hours().count()), 2);
+        *end++ = ':';
+        end = internal::write_padded(end, static_cast<unsigned int>(time_of_day.minutes().count()), 2);
+        *end++ = ':';
+        end = internal::write_padded(end, static_cast<unsigned int>(time_of_day.seconds().count()), 2);
+
+        cached_second_ = second;
+        cached_timestamp_size_ = static_cast<std::size_t>(end - std::data(cached_timestamp_));
+    }
+
+    std::array<char, 4> milliseconds{'.'};
+    internal::write_padded(std::data(milliseconds) + 1,
+                           static_cast<unsigned int>(
+                               std::chrono::duration_cast<std::chrono::milliseconds>(time - second).count()),
+                           3);
+
+    buffer_ += '[';
+    buffer_.append(std::data(cached_timestamp_), cached_timestamp_size_);
+    buffer_.append(std::data(milliseconds), std::size(milliseconds));
+    buffer_ += ']';
+}
+
+void file_sink::thread_main()
+{
+    std::unique_lock lock{mutex_};
+
+    while (true)
+    {
+        writer_signal_.wait_for(lock, settings_.flush_interval, [this]() { return flush_requested_ || stop_; });
+
+        const auto stop = stop_;
+        const auto generation = requested_generation_;
+        flush_requested_ = false;
+        std::swap(buffer_, write_buffer_);
+
+        // Producers can continue filling the other buffer while this one is written.
+        lock.unlock();
+        write_pending();
+        lock.lock();
+
+        written_generation_ = generation;
+        flushed_signal_.notify_all();
+
+        if (stop)
+            return;
+    }
+}
+
+void file_sink::write_pending()
+{
+    if (std::empty(write_buffer_))
+        return;
+
+    std::optional<std::filesystem::path> rotated_file;
+
+    try
+    {
+        if (!file_)
+            open_file();
+
+        if (should_rotate(std::size(write_buffer_)))
+        {
+            // Rotating renames and removes rotated files, so the previously rotated file must be fully compressed.
+            wait_for_compression();
+            rotated_file = rotate();
+        }
+    }
+    catch (const std::exception &)
+    {
+        // The file could not be (re)opened; the messages are lost, but logging must not bring down the application.
+    }
+
+    if (file_ && write_file())
+        file_size_ += std::size(write_buffer_);
+    else
+        failed_writes_.fetch_add(1, std::memory_order_relaxed);
+
+    write_buffer_.clear();
+
+    if (rotated_file)
+        start_compression(std::move(*rotated_file));
+}
+
+auto file_sink::write_file() -> bool
+{
+    const auto size = static_cast<std::streamsize>(std::size(write_buffer_));
+
+    if (file_->write(reinterpret_cast<const std::byte *>(std::data(write_buffer_)), size) == size)
+    {
+        file_->flush();
+
+        if (!file_->fail())
+            return true;
+    }
+
+    // The stream stays in a failed state, so the file is reopened on the next write. This also gets the actual size of
+    // the file, since an unknown part of the messages may have been written.
+    file_.reset();
+    return false;
+}
+
+auto file_sink::should_rotate(const std::size_t size) const -> bool
+{
+    switch (settings_.rotation)
+    {
+        case file_sink_rotation::size:
+            return file_size_ > 0 && file_size_ + size > settings_.max_file_size;
+        case file_sink_rotation::daily:
+            return internal::today() != file_day_;
+        case file_sink_rotation::none:
+        default:
+            return false;
+    }
+}
+
+auto file_sink::rotate() -> std::optional<std::filesystem::path>
+{
+    file_.reset();
+
+    auto rotated_file = (settings_.rotation == file_sink_rotation::daily) ? rotate_by_date() : rotate_by_size();
+
+    file_day_ = internal::today();
+    open_file();
+
+    if (!settings_.compress_rotated_files)
+        return std::nullopt;
+
+    return rotated_file;
+}
+
+auto file_sink::rotate_by_size() -> std::filesystem::path
+{
+    auto last = settings_.max_files;
+
+    if (last == 0)
+    {
+        // Keep all files, so find the oldest file to start shifting from.
+        last = 1;
+        while (internal::exists(rotated_file_path(last)) ||
+               internal::exists(compressed_file_path(rotated_file_path(last))))
+            ++last;
+    }
+    else
+    {
+        std::error_code ec;
+        std::filesystem::remove(rotated_file_path(last), ec);
+        std::filesystem::remove(compressed_file_path(rotated_file_path(last)), ec);
+    }
+
+    for (auto i = last - 1; i >= 1; --i)
+    {
+        internal::rename_if_exists(rotated_file_path(i), rotated_file_path(i + 1));
+        internal::rename_if_exists(compressed_file_path(rotated_file_path(i)),
+                                   compressed_file_path(rotated_file_path(i + 1)));
+    }
+
+    auto rotated_file = rotated_file_path(1);
+    std::filesystem::rename(path_, rotated_file);
+    return rotated_file;
+}
+
+auto file_sink::rotate_by_date() -> std::filesystem::path
+{
+    const auto stem = path_.stem().string() + '.' + internal::format_date(file_day_);
+    const auto extension = path_.extension().string();
+
+    auto rotated_file = path_;
+    rotated_file.replace_filename(stem + extension);
+
+    // The application may have been restarted on the same day, in which case a file for that day already exists.
+    for (auto i = 1; internal::exists(rotated_file) || internal::exists(compressed_file_path(rotated_file)); ++i)
+        rotated_file.replace_filename(stem + '.' + std::to_string(i) + extension);
+
+    std::filesystem::rename(path_, rotated_file);
+    remove_old_dated_files();
+    return rotated_file;
+}
+
+void file_sink::remove_old_dated_files() const
+{
+    if (settings_.max_files == 0)
+        return;
+
+    const auto prefix = path_.stem().string() + '.';
+    const auto extension = path_.extension().string();
+    const auto compressed_extension = extension + ".z";
+
+    auto directory = path_.parent_path();
+    if (directory.empty())
+        directory = ".";
+
+    std::vector<std::filesystem::path> files;
+
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator{directory, ec})
+    {
+        const auto filename = entry.path().filename().string();
+
+        // Only consider files in the form of <stem>.YYYY-MM-DD...
+        if (!filename.starts_with(prefix) || std::size(filename) <= std::size(prefix) ||
+            !std::isdigit(static_cast<unsigned char>(filename[std::size(prefix)])))
+            continue;
+
+        if (filename.ends_with(extension) || filename.ends_with(compressed_extension))
+            files.push_back(entry.path());
+    }
+
+    if (std::size(files) <= settings_.max_files)
+        return;
+
+    // The dates in the names make the oldest files sort first.
+    std::ranges::sort(files);
+
+    for (auto i = 0u; i < std::size(files) - settings_.max_files; ++i)
+        std::filesystem::remove(files[i], ec);
+}
+
+void file_sink::open_file()
+{
+    file_ = std::make_unique<streams::file_sink_device>(path_, streams::file_mode::binary, streams::file_flag::append);
+
+    std::error_code ec;
+    file_size_ = std::filesystem::file_size(path_, ec);
+
+    if (ec)
+        file_size_ = 0;
+}
+
+auto file_sink::rotated_file_path(const std::size_t index) const -> std::filesystem::path
+{
+    auto path = path_;
+    path += '.' + std::to_string(index);
+    return path;
+}
+
+auto file_sink::compressed_file_path(const std::filesystem::path &path) -> std::filesystem::path
+{
+    auto compressed_path = path;
+    compressed_path += ".z";
+    return compressed_path;
+}
+
+void file_sink::compress_thread_main()
+{
+    std::unique_lock lock{compress_mutex_};
+
+    while (true)
+    {
+        compress_signal_.wait(lock, [this]() { return compress_path_.has_value() || compress_stop_; });
+
+        if (!compress_path_)
+            return;
+
+        const auto path = *compress_path_;
+
+        lock.unlock();
+        compress_file(path);
+        lock.lock();
+
+        compress_path_.reset();
+        compress_signal_.notify_all();
+    }
+}
+
+void file_sink::start_compression(std::filesystem::path path)
+{
+    {
+        std::scoped_lock lock{compress_mutex_};
+        compress_path_ = std::move(path);
+    }
+
+    compress_signal_.notify_all();
+}
+
+void file_sink::wait_for_compression()
+{
+    std::unique_lock lock{compress_mutex_};
+    compress_signal_.wait(lock, [this]() { return !compress_path_.has_value(); });
+}
+
+void file_sink::compress_file(const std::filesystem::path &path)
+{
+    const auto compressed_path = compressed_file_path(path);
+
+    try
+    {
+        {
+            streams::file_source_device source{path};
+            streams::file_sink_device sink{compressed_path, streams::file_mode::binary, streams::file_flag::truncate};
+            compression::zlib_compress compress{compression::zlib_compression_mode::balanced,
+                                                static_cast<int>(internal::compress_block_size)};
+
+            const auto write = [&sink](const std::byte *data, const std::streamsize compressed_size)
+            { return sink.write(data, compressed_size); };
+
+            std::vector<std::byte> buffer(internal::compress_block_size);
+
+            while (true)
+            {
+                const auto size = source.read(std::data(buffer), static_cast<std::streamsize>(std::size(buffer)));
+
+                if (size <= 0)
+                    break;
+
+                compress.write(std::data(buffer), size, write);
+            }
+
+            compress.finish(write);
+        }
+
+        std::filesystem::remove(path);
+    }
+    catch (const std::exception &)
+    {
+        // Keep the uncompressed file instead.
+        std::error_code ec;
+        std::filesystem::remove(compressed_path, ec);
+    }
+}
+
+} // namespace aeon::logger
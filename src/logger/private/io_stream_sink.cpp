@@ -3,20 +3,87 @@
 #include <aeon/logger/io_stream_sink.h>
 #include <aeon/streams/stream_writer.h>
 
+#if (!AEON_PLATFORM_OS_WINDOWS)
+#include <aeon/common/term_colors.h>
+#endif
+
 namespace aeon::logger
 {
 
+#if (!AEON_PLATFORM_OS_WINDOWS)
+namespace internal
+{
+
+/*!
+ * Equivalent of stdio_device::set_color, but appends the color codes to a string instead of writing them directly.
+ */
+static void append_color(common::string &str, const streams::color color)
+{
+    str += AEON_TERM_COLOR_RESET;
+
+    switch (color)
+    {
+        case streams::color::black:
+            str += AEON_TERM_COLOR_BLACK;
+            break;
+        case streams::color::red:
+            str += AEON_TERM_COLOR_RED;
+            break;
+        case streams::color::green:
+            str += AEON_TERM_COLOR_GREEN;
+            break;
+        case streams::color::yellow:
+            str += AEON_TERM_COLOR_YELLOW;
+            break;
+        case streams::color::blue:
+            str += AEON_TERM_COLOR_BLUE;
+            break;
+        case streams::color::magenta:
+            str += AEON_TERM_COLOR_MAGENTA;
+            break;
+        case streams::color::cyan:
+            str += AEON_TERM_COLOR_CYAN;
+            break;
+        case streams::color::white:
+            str += AEON_TERM_COLOR_WHITE;
+            break;
+    }
+}
+
+} // namespace internal
+#endif
+
 io_stream_sink::io_stream_sink(streams::stdio_device &stream)
     : stream_(stream)
+#if (!AEON_PLATFORM_OS_WINDOWS)
+    , line_{}
+#endif
 {
 }
 
-void io_stream_sink::log(const common::string &message, const common::string &module, const log_level level)
+void io_stream_sink::log(const common::string_view message, const common::string_view module, const log_level level)
 {
+#if (!AEON_PLATFORM_OS_WINDOWS)
+    // On terminals the colors are just escape codes, so the whole line can be written at once.
+    line_.clear();
+    internal::append_color(line_, streams::color::white);
+    line_ += '[';
+    internal::append_color(line_, streams::color::cyan);
+    line_ += module;
+    internal::append_color(line_, streams::color::white);
+    line_ += "] [";
+    internal::append_color(line_, log_level_to_color(level));
+    line_ += log_level_str[static_cast<int>(level)];
+    internal::append_color(line_, streams::color::white);
+    line_ += "]: ";
+    line_ += message;
+    line_ += '\n';
+
+    stream_.write(reinterpret_cast<const std::byte *>(std::data(line_)),
+                  static_cast<std::streamsize>(std::size(line_)));
+#else
     streams::stream_writer writer(stream_);
 
-    // TODO: This should be optimized with a string formatter. Perhaps a stream filter can help.
-
     stream_.set_color(aeon::streams::color::white);
     writer << '[';
 
@@ -37,6 +104,7 @@ void io_stream_sink::log(const common::string &message, const common::string &mo
     writer << "]: ";
     writer << message;
     writer << '\n';
+#endif
 }
 
 [[nodiscard]] auto io_stream_sink::log_level_to_color(const log_level level) const -> streams::color
@@ -0,0 +1,95 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/log_message_stream.h>
+#include <cstring>
+
+namespace aeon::logger::internal
+{
+
+log_message_buffer::log_message_buffer() noexcept
+    : buffer_{}
+    , overflow_{}
+{
+    reset();
+}
+
+void log_message_buffer::reset() noexcept
+{
+    // Clearing keeps the capacity of the overflow string, so that it can be reused.
+    overflow_.clear();
+    setp(std::data(buffer_), std::data(buffer_) + std::size(buffer_));
+}
+
+auto log_message_buffer::view() -> common::string_view
+{
+    if (std::empty(overflow_))
+        return common::string_view{pbase(), static_cast<std::size_t>(pptr() - pbase())};
+
+    spill();
+    return overflow_;
+}
+
+auto log_message_buffer::overflow(const int_type c) -> int_type
+{
+    spill();
+
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+auto log_message_buffer::xsputn(const char_type *str, const std::streamsize size) -> std::streamsize
+{
+    const auto count = static_cast<std::size_t>(size);
+
+    if (count <= static_cast<std::size_t>(epptr() - pptr()))
+    {
+        std::memcpy(pptr(), str, count);
+        pbump(static_cast<int>(count));
+        return size;
+    }
+
+    spill();
+    overflow_.append(str, count);
+    return size;
+}
+
+void log_message_buffer::spill()
+{
+    overflow_.append(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+    setp(std::data(buffer_), std::data(buffer_) + std::size(buffer_));
+}
+
+log_message_stream::log_message_stream()
+    : buffer_{}
+    , stream_{&buffer_}
+    , in_use_{false}
+{
+}
+
+auto log_message_stream::acquire(std::optional<log_message_stream> &fallback) -> log_message_stream &
+{
+    thread_local log_message_stream thread_stream;
+
+    auto &stream = thread_stream.in_use_ ? fallback.emplace() : thread_stream;
+    stream.reset();
+    stream.in_use_ = true;
+    return stream;
+}
+
+void log_message_stream::reset()
+{
+    buffer_.reset();
+
+    // A previous message may have changed the formatting (std::hex, std::setprecision, etc.)
+    stream_.clear();
+    stream_.flags(std::ios_base::skipws | std::ios_base::dec);
+    stream_.width(0);
+    stream_.precision(6);
+    stream_.fill(' ');
+}
+
+} // namespace aeon::logger::internal
@@ -0,0 +1,168 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/log_level.h>
+#include <aeon/logger/binary_log.h>
+#include <aeon/common/string.h>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace aeon::logger::internal
+{
+
+/*!
+ * Bounded lock-free ring buffer of log messages, based on the array queue by Dmitry Vyukov. Every slot has a sequence
+ * number that tells producers and consumers whether the slot is free or filled, so that no locks are needed.
+ *
+ * Each producing thread gets its own ring, so pushes are normally uncontended. Popping is safe from multiple threads,
+ * which allows a producer to discard the oldest message when the ring is full.
+ *
+ * The strings in the slots are reused, so once a slot has held a message of a certain length, storing a message of
+ * the same or smaller length does not allocate.
+ */
+class log_ring final
+{
+public:
+    struct slot final
+    {
+        std::atomic<std::size_t> sequence{0};
+        log_level level{log_level::message};
+
+        // Set for a deferred message, in which case message contains the encoded arguments instead of the text.
+        const binary_log_format *format{nullptr};
+
+        common::string message;
+        common::string module;
+    };
+
+    explicit log_ring(const std::size_t capacity)
+        : slots_{std::make_unique<slot[]>(capacity)}
+        , mask_{capacity - 1}
+        , enqueue_position_{0}
+        , dequeue_position_{0}
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~log_ring() = default;
+
+    log_ring(const log_ring &) = delete;
+    auto operator=(const log_ring &) -> log_ring & = delete;
+
+    log_ring(log_ring &&) = delete;
+    auto operator=(log_ring &&) -> log_ring & = delete;
+
+    /*!
+     * Claim a free slot and pass it to the given function to be filled in. The slot only becomes visible to consumers
+     * after the function returns. Returns false if the ring is full.
+     */
+    template <typename func_t>
+    [[nodiscard]] auto try_push(func_t &&func) -> bool
+    {
+        auto position = enqueue_position_.load(std::memory_order_relaxed);
+        slot *s = nullptr;
+
+        while (true)
+        {
+            s = &slots_[position & mask_];
+            const auto sequence = s->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        func(*s);
+        s->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * Take the oldest message from the ring and pass it to the given function. The slot is only reused after the
+     * function returns. Returns false if the ring is empty.
+     */
+    template <typename func_t>
+    auto try_pop(func_t &&func) -> bool
+    {
+        auto position = dequeue_position_.load(std::memory_order_relaxed);
+        slot *s = nullptr;
+
+        while (true)
+        {
+            s = &slots_[position & mask_];
+            const auto sequence = s->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0)
+            {
+                if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        func(*s);
+        s->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t cache_line_size = 64;
+
+    std::unique_ptr<slot[]> slots_;
+    std::size_t mask_;
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_position_;
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_position_;
+};
+
+/*!
+ * The ring buffer of a single logging thread, with the state that the background thread needs to manage it.
+ */
+struct thread_log_ring final
+{
+    explicit thread_log_ring(const std::size_t capacity)
+        : messages{capacity}
+        , pushing{false}
+        , released{false}
+    {
+    }
+
+    ~thread_log_ring() = default;
+
+    thread_log_ring(const thread_log_ring &) = delete;
+    auto operator=(const thread_log_ring &) -> thread_log_ring & = delete;
+
+    thread_log_ring(thread_log_ring &&) = delete;
+    auto operator=(thread_log_ring &&) -> thread_log_ring & = delete;
+
+    log_ring messages;
+
+    // Set by the owning thread while it pushes a message, so that stopping the backend can wait for it.
+    std::atomic<bool> pushing;
+
+    // Set when the owning thread exits. Once drained, the ring is reused for another thread.
+    std::atomic<bool> released;
+};
+
+} // namespace aeon::logger::internal
@@ -103,10 +103,11 @@ void multithreaded_sink_backend::handle_background_thread()
         });
 }
 
-void multithreaded_sink_backend::log(const common::string &message, const common::string &module, const log_level level)
+void multithreaded_sink_backend::log(const common::string_view message, const common::string_view module,
+                                     const log_level level)
 {
     std::scoped_lock lock(queue_mutex_);
-    log_queue_.push_back({message, module, level});
+    log_queue_.push_back({common::string{message}, common::string{module}, level});
     cv_.notify_one();
 }
 
@@ -6,7 +6,7 @@
 namespace aeon::logger
 {
 
-void simple_backend::log(const common::string &message, const common::string &module, const log_level level)
+void simple_backend::log(const common::string_view message, const common::string_view module, const log_level level)
 {
     std::cout << "[" << log_level_str[static_cast<int>(level)] << "] [" << module << "]: " << message << std::endl;
 }
@@ -0,0 +1,131 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/base_backend.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::logger
+{
+
+class log_sink;
+
+namespace internal
+{
+struct thread_log_ring;
+} // namespace internal
+
+/*!
+ * Determines what happens when a thread logs a message while its ring buffer is full.
+ */
+enum class async_full_policy
+{
+    block,    // Wait until the background thread has made room. No messages are lost, unless the backend is stopped.
+    drop,     // Discard the new message.
+    overwrite // Discard the oldest message in the ring buffer of the logging thread.
+};
+
+/*!
+ * Asynchronous backend that passes messages to the background thread through lock-free ring buffers.
+ *
+ * Every thread that logs through this backend gets its own ring buffer with a fixed amount of preallocated slots, so
+ * logging threads do not contend with each other or with the background thread. The background thread drains all
+ * ring buffers in batches and writes them to the sinks, without copying the sink list or the messages. When a thread
+ * exits, its ring buffer is reused for the next thread that logs through this backend.
+ *
+ * Deferred messages (see AEON_LOG_DEFERRED) are formatted on the background thread, so that the logging thread only
+ * copies the raw arguments.
+ *
+ * Messages of a single thread are written in order. There is no ordering between messages of different threads.
+ */
+class async_sink_backend final : public base_backend
+{
+public:
+    static constexpr std::size_t default_ring_size = 1024;
+
+    async_sink_backend();
+
+    explicit async_sink_backend(const log_level level, const std::size_t ring_size = default_ring_size,
+                                const async_full_policy policy = async_full_policy::block);
+
+    ~async_sink_backend() final;
+
+    async_sink_backend(const async_sink_backend &) = delete;
+    auto operator=(const async_sink_backend &) noexcept -> async_sink_backend & = delete;
+
+    async_sink_backend(async_sink_backend &&) = delete;
+    auto operator=(async_sink_backend &&) noexcept -> async_sink_backend & = delete;
+
+    void add_sink(log_sink *sink);
+
+    void remove_all_sinks();
+
+    /*!
+     * Write all pending messages and stop the background thread. Messages logged after or while stopping are discarded
+     * and counted in dropped_count().
+     */
+    void stop();
+
+    /*!
+     * The amount of messages that were discarded because a ring buffer was full (drop and overwrite policy) or because
+     * the backend was stopped.
+     */
+    [[nodiscard]] auto dropped_count() const noexcept -> std::uint64_t;
+
+private:
+    void log(const common::string_view message, const common::string_view module, const log_level level) final;
+
+    void log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                      const common::string_view module) final;
+
+    template <typename func_t>
+    void push(func_t &&fill);
+
+    [[nodiscard]] auto get_ring() -> internal::thread_log_ring &;
+    void release_ring(internal::thread_log_ring &ring);
+    [[nodiscard]] auto drain() -> bool;
+    void notify_waiting_threads();
+    void wake_if_sleeping() noexcept;
+    void wake() noexcept;
+    void handle_background_thread();
+
+    std::uint64_t id_;
+    std::size_t ring_size_;
+    async_full_policy policy_;
+
+    // The rings are shared with the threads that use them, so that a thread that outlives the backend can still
+    // release its ring.
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<internal::thread_log_ring>> rings_;
+    std::vector<std::shared_ptr<internal::thread_log_ring>> free_rings_;
+
+    // Only accessed by the background thread, so that rings_mutex_ is only held briefly when a new ring was added.
+    std::vector<internal::thread_log_ring *> drain_rings_;
+
+    // Only accessed by the background thread; reused to format deferred messages.
+    common::string formatted_message_;
+
+    std::mutex sink_mutex_;
+    std::vector<log_sink *> sinks_;
+
+    // Threads that wait for room in a full ring (block policy) are woken up after every batch that was drained.
+    std::mutex room_mutex_;
+    std::condition_variable room_available_;
+    std::atomic<std::uint32_t> waiting_;
+
+    std::atomic<std::uint32_t> signal_;
+    std::atomic<bool> running_;
+    std::atomic<bool> sleeping_;
+    std::atomic<std::uint64_t> dropped_;
+    std::thread thread_;
+};
+
+} // namespace aeon::logger
@@ -3,7 +3,11 @@
 #pragma once
 
 #include <aeon/logger/log_level.h>
-#include <aeon/common/string.h>
+#include <aeon/logger/binary_log.h>
+#include <aeon/common/string_view.h>
+#include <atomic>
+#include <span>
+#include <cstddef>
 
 namespace aeon::logger
 {
@@ -11,6 +15,7 @@ namespace aeon::logger
 class base_backend
 {
     friend class logger_stream;
+    friend class logger;
 
 public:
     base_backend();
@@ -29,12 +34,31 @@ public:
 
     [[nodiscard]] auto get_log_level() const -> log_level;
 
-    virtual void log(const common::string &message, const common::string &module, const log_level level) = 0;
+    /*!
+     * Returns true if messages of the given level are passed on to log(). This is a single relaxed atomic load, so that
+     * it can be used to skip formatting a log message entirely.
+     */
+    [[nodiscard]] auto is_enabled(const log_level level) const noexcept -> bool
+    {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
+
+    virtual void log(const common::string_view message, const common::string_view module, const log_level level) = 0;
+
+    /*!
+     * Log a message of which the formatting was deferred; the arguments are still encoded as raw bytes. The default
+     * implementation formats the message immediately and passes it to log(). Backends can override this to format on
+     * a background thread or to store the raw message.
+     */
+    virtual void log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                              const common::string_view module);
 
 private:
-    void handle_log(const common::string &message, const common::string &module, const log_level level);
+    void handle_log(const common::string_view message, const common::string_view module, const log_level level);
+    void handle_log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                             const common::string_view module);
 
-    log_level level_;
+    std::atomic<log_level> level_;
 };
 
 } // namespace aeon::logger
@@ -0,0 +1,66 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/base_backend.h>
+#include <aeon/logger/binary_log.h>
+#include <aeon/streams/idynamic_stream.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <mutex>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+namespace aeon::logger
+{
+
+/*!
+ * Backend that writes log messages to a stream in a compact binary format, to be decoded offline with
+ * binary_log_reader or the aeon_binary_log_decoder tool.
+ *
+ * Deferred messages (see AEON_LOG_DEFERRED) are stored with their raw arguments and are never formatted by this
+ * backend; the format string of every call site is only written once. Regular messages are stored as text. Records
+ * are collected in a buffer and written to the stream when the buffer is full, on flush() and on destruction.
+ */
+class binary_file_backend final : public base_backend
+{
+public:
+    static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+    explicit binary_file_backend(streams::idynamic_stream &stream, const log_level level = log_level::message,
+                                 const std::size_t buffer_size = default_buffer_size);
+
+    ~binary_file_backend() final;
+
+    binary_file_backend(const binary_file_backend &) = delete;
+    auto operator=(const binary_file_backend &) noexcept -> binary_file_backend & = delete;
+
+    binary_file_backend(binary_file_backend &&) = delete;
+    auto operator=(binary_file_backend &&) noexcept -> binary_file_backend & = delete;
+
+    /*!
+     * Write all buffered records to the stream.
+     */
+    void flush();
+
+private:
+    void log(const common::string_view message, const common::string_view module, const log_level level) final;
+
+    void log_deferred(const binary_log_format &format, const std::span<const std::byte> arguments,
+                      const common::string_view module) final;
+
+    void write_format(const binary_log_format &format);
+    void append(const void *data, const std::size_t size);
+    void append_string(const common::string_view str);
+    void flush_if_full();
+    void flush_buffer();
+
+    std::mutex mutex_;
+    streams::idynamic_stream *stream_;
+    std::size_t buffer_size_;
+    std::vector<std::byte> buffer_;
+    std::vector<bool> written_formats_;
+};
+
+} // namespace aeon::logger
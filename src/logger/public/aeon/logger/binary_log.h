@@ -0,0 +1,207 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/log_level.h>
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <array>
+#include <vector>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::logger
+{
+
+/*!
+ * Type tag that precedes every encoded argument of a deferred log message, so that the arguments can be decoded
+ * without knowing the types used at the call site.
+ */
+enum class binary_log_argument_type : std::uint8_t
+{
+    boolean,
+    character,
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float32,
+    float64,
+    string
+};
+
+/*!
+ * Static description of a deferred log statement. One instance exists per call site (created by the
+ * AEON_LOG_DEFERRED* macros), and gets a process-wide unique id on construction. The format string uses {} as
+ * placeholder for the next argument; {{ and }} produce a literal brace.
+ */
+class binary_log_format final
+{
+public:
+    binary_log_format(const log_level level, const char *const format, const char *const file,
+                      const std::uint32_t line) noexcept;
+    ~binary_log_format() = default;
+
+    binary_log_format(const binary_log_format &) = delete;
+    auto operator=(const binary_log_format &) -> binary_log_format & = delete;
+
+    binary_log_format(binary_log_format &&) = delete;
+    auto operator=(binary_log_format &&) -> binary_log_format & = delete;
+
+    [[nodiscard]] auto id() const noexcept
+    {
+        return id_;
+    }
+
+    [[nodiscard]] auto level() const noexcept
+    {
+        return level_;
+    }
+
+    [[nodiscard]] auto format() const noexcept
+    {
+        return common::string_view{format_};
+    }
+
+    [[nodiscard]] auto file() const noexcept
+    {
+        return common::string_view{file_};
+    }
+
+    [[nodiscard]] auto line() const noexcept
+    {
+        return line_;
+    }
+
+private:
+    std::uint32_t id_;
+    log_level level_;
+    const char *format_;
+    const char *file_;
+    std::uint32_t line_;
+};
+
+/*!
+ * The raw encoded arguments of a deferred log message. Encoding only copies the bytes of the arguments; for small
+ * messages no memory is allocated.
+ */
+class binary_log_arguments final
+{
+public:
+    static constexpr std::size_t inline_capacity = 256;
+
+    template <typename... args_t>
+    explicit binary_log_arguments(const args_t &...args)
+        : inline_{}
+        , heap_{}
+        , size_{0}
+    {
+        (append(args), ...);
+    }
+
+    ~binary_log_arguments() = default;
+
+    binary_log_arguments(const binary_log_arguments &) = delete;
+    auto operator=(const binary_log_arguments &) -> binary_log_arguments & = delete;
+
+    binary_log_arguments(binary_log_arguments &&) = delete;
+    auto operator=(binary_log_arguments &&) -> binary_log_arguments & = delete;
+
+    [[nodiscard]] auto data() const noexcept -> std::span<const std::byte>
+    {
+        if (std::empty(heap_))
+            return {std::data(inline_), size_};
+
+        return {std::data(heap_), size_};
+    }
+
+private:
+    void append_raw(const void *data, const std::size_t size);
+
+    void append_type(const binary_log_argument_type type)
+    {
+        append_raw(&type, sizeof(type));
+    }
+
+    void append_string(const std::string_view str);
+
+    template <typename T>
+    void append(const T &value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            const auto byte = static_cast<std::uint8_t>(value ? 1 : 0);
+            append_type(binary_log_argument_type::boolean);
+            append_raw(&byte, sizeof(byte));
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+            append_type(binary_log_argument_type::character);
+            append_raw(&value, sizeof(value));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            constexpr auto type = integral_type<T>();
+            append_type(type);
+            append_raw(&value, sizeof(value));
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            append_type(binary_log_argument_type::float32);
+            append_raw(&value, sizeof(value));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            append_type(binary_log_argument_type::float64);
+            append_raw(&value, sizeof(value));
+        }
+        else if constexpr (std::is_same_v<T, common::string> || std::is_same_v<T, common::string_view>)
+        {
+            append_string(value.as_std_string_view());
+        }
+        else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            append_string(std::string_view{value});
+        }
+        else
+        {
+            static_assert(!sizeof(T), "Unsupported argument type for deferred logging.");
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] static consteval auto integral_type() noexcept -> binary_log_argument_type
+    {
+        constexpr auto is_signed = std::is_signed_v<T>;
+
+        if constexpr (sizeof(T) == 1)
+            return is_signed ? binary_log_argument_type::int8 : binary_log_argument_type::uint8;
+        else if constexpr (sizeof(T) == 2)
+            return is_signed ? binary_log_argument_type::int16 : binary_log_argument_type::uint16;
+        else if constexpr (sizeof(T) == 4)
+            return is_signed ? binary_log_argument_type::int32 : binary_log_argument_type::uint32;
+        else
+            return is_signed ? binary_log_argument_type::int64 : binary_log_argument_type::uint64;
+    }
+
+    std::array<std::byte, inline_capacity> inline_;
+    std::vector<std::byte> heap_;
+    std::size_t size_;
+};
+
+/*!
+ * Format a deferred log message by replacing the {} placeholders in the format string with the encoded arguments.
+ * The result is appended to the given string. Placeholders without a matching argument are kept as-is; malformed
+ * arguments are replaced by "<invalid>".
+ */
+void format_binary_log(const common::string_view format, const std::span<const std::byte> arguments,
+                       common::string &result);
+
+} // namespace aeon::logger
@@ -0,0 +1,77 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/log_level.h>
+#include <aeon/streams/idynamic_stream.h>
+#include <aeon/common/string.h>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace aeon::logger
+{
+
+struct binary_log_entry final
+{
+    std::chrono::system_clock::time_point timestamp;
+    log_level level = log_level::message;
+    common::string module;
+    common::string message;
+
+    // The source location of a deferred message. Empty for regular messages.
+    common::string file;
+    std::uint32_t line = 0;
+};
+
+/*!
+ * Reads and formats the messages of a binary log written by binary_file_backend.
+ */
+class binary_log_reader final
+{
+public:
+    /*!
+     * Throws binary_log_exception if the stream does not contain a binary log.
+     */
+    explicit binary_log_reader(streams::idynamic_stream &stream);
+    ~binary_log_reader();
+
+    binary_log_reader(const binary_log_reader &) = delete;
+    auto operator=(const binary_log_reader &) -> binary_log_reader & = delete;
+
+    binary_log_reader(binary_log_reader &&) noexcept = default;
+    auto operator=(binary_log_reader &&) noexcept -> binary_log_reader & = default;
+
+    /*!
+     * Read the next message. Returns false at the end of the log. Throws binary_log_exception if the log is
+     * truncated or corrupt.
+     */
+    [[nodiscard]] auto read(binary_log_entry &entry) -> bool;
+
+private:
+    struct format_info final
+    {
+        log_level level = log_level::message;
+        std::uint32_t line = 0;
+        common::string file;
+        common::string format;
+    };
+
+    [[nodiscard]] auto try_read(void *data, const std::size_t size) -> bool;
+    void read(void *data, const std::size_t size);
+    void read_string(common::string &str);
+
+    template <typename T>
+    void read_sized(T &buffer, const std::uint32_t size);
+
+    [[nodiscard]] auto read_level() -> log_level;
+    [[nodiscard]] auto read_timestamp() -> std::chrono::system_clock::time_point;
+
+    streams::idynamic_stream *stream_;
+    std::unordered_map<std::uint32_t, format_info> formats_;
+    std::vector<std::byte> arguments_;
+};
+
+} // namespace aeon::logger
@@ -0,0 +1,18 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <stdexcept>
+
+namespace aeon::logger
+{
+
+class logger_exception : public std::exception
+{
+};
+
+class binary_log_exception : public logger_exception
+{
+};
+
+} // namespace aeon::logger
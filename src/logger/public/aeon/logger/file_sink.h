@@ -0,0 +1,169 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/logger/log_sink.h>
+#include <aeon/logger/log_level.h>
+#include <aeon/streams/devices/file_device.h>
+#include <aeon/common/string.h>
+#include <filesystem>
+#include <chrono>
+#include <optional>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::logger
+{
+
+enum class file_sink_rotation
+{
+    // Never rotate; the log file grows indefinitely.
+    none,
+
+    // Rotate when writing would make the file larger than max_file_size. Rotated files are named
+    // <file>.1, <file>.2, etc. where 1 is the most recent.
+    size,
+
+    // Rotate when the first message of a new day (UTC) is written. Rotated files are named
+    // <stem>.YYYY-MM-DD<extension> after the day of the messages they contain.
+    daily
+};
+
+struct file_sink_settings final
+{
+    file_sink_settings() = default;
+    ~file_sink_settings() = default;
+
+    file_sink_settings(file_sink_settings &&) = default;
+    auto operator=(file_sink_settings &&) -> file_sink_settings & = default;
+
+    file_sink_settings(const file_sink_settings &) = default;
+    auto operator=(const file_sink_settings &) -> file_sink_settings & = default;
+
+    // When this many bytes of formatted messages are buffered, they are handed to the writer thread.
+    std::size_t buffer_size = 64 * 1024;
+
+    // Buffered messages are written at least this often, even if the buffer is not full.
+    std::chrono::milliseconds flush_interval{1000};
+
+    // Messages of this level or higher cause the buffer to be written right away.
+    log_level flush_level = log_level::error;
+
+    file_sink_rotation rotation = file_sink_rotation::none;
+
+    // The maximum size of a log file when rotating by size.
+    std::uint64_t max_file_size = 16 * 1024 * 1024;
+
+    // The amount of rotated files to keep. Older files are removed. 0 keeps all files.
+    std::size_t max_files = 8;
+
+    // Compress rotated files with zlib. The compressed file gets a .z extension appended.
+    bool compress_rotated_files = false;
+};
+
+/*!
+ * Sink that writes log messages to a file, with a timestamp in front of every message.
+ *
+ * Messages are formatted into a memory buffer, which is written to the file by a background thread in one go. Logging
+ * a message therefore never waits for the disk. Rotation is done by the writer thread as well. Rotated files are
+ * compressed by a separate thread, so the writer keeps writing messages meanwhile; it only waits for a compression when
+ * the next rotation is due before it has finished.
+ */
+class file_sink final : public log_sink
+{
+public:
+    explicit file_sink(std::filesystem::path path);
+    explicit file_sink(std::filesystem::path path, file_sink_settings settings);
+
+    /*!
+     * Writes all buffered messages before returning.
+     */
+    ~file_sink() final;
+
+    file_sink(const file_sink &) = delete;
+    auto operator=(const file_sink &) noexcept -> file_sink & = delete;
+
+    file_sink(file_sink &&) = delete;
+    auto operator=(file_sink &&) noexcept -> file_sink & = delete;
+
+    /*!
+     * Block until all messages logged before this call are written to the file.
+     */
+    void flush();
+
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path &;
+
+    /*!
+     * The amount of times buffered messages could not be written to the file, for example because the file could not
+     * be opened or the disk is full. The messages of a failed write are lost.
+     */
+    [[nodiscard]] auto failed_write_count() const noexcept -> std::uint64_t;
+
+private:
+    void log(const common::string_view message, const common::string_view module, const log_level level) final;
+
+    void format_timestamp(const std::chrono::system_clock::time_point time);
+
+    void thread_main();
+    void write_pending();
+    [[nodiscard]] auto write_file() -> bool;
+
+    [[nodiscard]] auto should_rotate(const std::size_t size) const -> bool;
+    [[nodiscard]] auto rotate() -> std::optional<std::filesystem::path>;
+    [[nodiscard]] auto rotate_by_size() -> std::filesystem::path;
+    [[nodiscard]] auto rotate_by_date() -> std::filesystem::path;
+    void remove_old_dated_files() const;
+    void open_file();
+
+    [[nodiscard]] auto rotated_file_path(const std::size_t index) const -> std::filesystem::path;
+    [[nodiscard]] static auto compressed_file_path(const std::filesystem::path &path) -> std::filesystem::path;
+
+    void compress_thread_main();
+    void start_compression(std::filesystem::path path);
+    void wait_for_compression();
+    static void compress_file(const std::filesystem::path &path);
+
+    std::filesystem::path path_;
+    file_sink_settings settings_;
+
+    // Protects the members below; the writer thread holds it only to swap the buffers.
+    std::mutex mutex_;
+    std::condition_variable writer_signal_;
+    std::condition_variable flushed_signal_;
+    common::string buffer_;
+    bool flush_requested_;
+    bool stop_;
+    std::uint64_t requested_generation_;
+    std::uint64_t written_generation_;
+
+    // The timestamp text of the current second, which is reused for all messages logged within that second.
+    std::chrono::sys_seconds cached_second_;
+    std::array<char, 32> cached_timestamp_;
+    std::size_t cached_timestamp_size_;
+
+    // Only used by the writer thread.
+    common::string write_buffer_;
+    std::unique_ptr<streams::file_sink_device> file_;
+    std::uint64_t file_size_;
+    std::chrono::sys_days file_day_;
+
+    // Counted by the writer thread, read by failed_write_count().
+    std::atomic<std::uint64_t> failed_writes_;
+
+    // The rotated file that is being compressed; cleared by the compression thread when it is done.
+    std::mutex compress_mutex_;
+    std::condition_variable compress_signal_;
+    std::optional<std::filesystem::path> compress_path_;
+    bool compress_stop_;
+    std::thread compress_thread_;
+
+    std::thread thread_;
+};
+
+} // namespace aeon::logger
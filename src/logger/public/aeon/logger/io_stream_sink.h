@@ -23,10 +23,15 @@ public:
     auto operator=(io_stream_sink &&) noexcept -> io_stream_sink & = delete;
 
 private:
-    void log(const common::string &message, const common::string &module, const log_level level) final;
+    void log(const common::string_view message, const common::string_view module, const log_level level) final;
     [[nodiscard]] auto log_level_to_color(const log_level level) const -> streams::color;
 
     streams::stdio_device &stream_;
+
+#if (!AEON_PLATFORM_OS_WINDOWS)
+    // The full line including color codes, so that it can be written to the device in one go.
+    common::string line_;
+#endif
 };
 
 } // namespace aeon::logger
@@ -0,0 +1,98 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <streambuf>
+#include <ostream>
+#include <optional>
+#include <array>
+#include <cstddef>
+
+namespace aeon::logger::internal
+{
+
+/*!
+ * Stream buffer that formats into a fixed-size array. A message that does not fit continues in an overflow string.
+ * Since the buffer is reused for every message of a thread, the overflow string only allocates when a message is
+ * longer than any message before it.
+ */
+class log_message_buffer final : public std::streambuf
+{
+public:
+    static constexpr std::size_t capacity = 512;
+
+    log_message_buffer() noexcept;
+    ~log_message_buffer() final = default;
+
+    log_message_buffer(const log_message_buffer &) = delete;
+    auto operator=(const log_message_buffer &) -> log_message_buffer & = delete;
+
+    log_message_buffer(log_message_buffer &&) = delete;
+    auto operator=(log_message_buffer &&) -> log_message_buffer & = delete;
+
+    void reset() noexcept;
+
+    /*!
+     * The message formatted so far. Only valid until the next write or reset.
+     */
+    [[nodiscard]] auto view() -> common::string_view;
+
+protected:
+    auto overflow(int_type c) -> int_type final;
+    auto xsputn(const char_type *str, std::streamsize size) -> std::streamsize final;
+
+private:
+    void spill();
+
+    std::array<char, capacity> buffer_;
+    common::string overflow_;
+};
+
+/*!
+ * A std::ostream on top of a log_message_buffer. One instance is kept per thread, so that formatting a message does
+ * not construct a stream or allocate memory.
+ */
+class log_message_stream final
+{
+public:
+    log_message_stream();
+    ~log_message_stream() = default;
+
+    log_message_stream(const log_message_stream &) = delete;
+    auto operator=(const log_message_stream &) -> log_message_stream & = delete;
+
+    log_message_stream(log_message_stream &&) = delete;
+    auto operator=(log_message_stream &&) -> log_message_stream & = delete;
+
+    /*!
+     * Returns the stream of the calling thread, cleared and with the default formatting flags. If it is already in
+     * use (for example when formatting an argument logs a message itself), the given fallback is used instead.
+     */
+    [[nodiscard]] static auto acquire(std::optional<log_message_stream> &fallback) -> log_message_stream &;
+
+    void release() noexcept
+    {
+        in_use_ = false;
+    }
+
+    [[nodiscard]] auto stream() noexcept -> std::ostream &
+    {
+        return stream_;
+    }
+
+    [[nodiscard]] auto view() -> common::string_view
+    {
+        return buffer_.view();
+    }
+
+private:
+    void reset();
+
+    log_message_buffer buffer_;
+    std::ostream stream_;
+    bool in_use_;
+};
+
+} // namespace aeon::logger::internal
@@ -4,31 +4,146 @@
 
 #include <aeon/logger/base_backend.h>
 #include <aeon/logger/log_level.h>
+#include <aeon/logger/binary_log.h>
+#include <aeon/logger/log_message_stream.h>
 #include <aeon/common/string.h>
-#include <sstream>
-
-#define AEON_LOG(log, level) log(level)
+#include <aeon/common/string_view.h>
+#include <ostream>
+#include <optional>
+
+/*!
+ * Log statements with a level below this minimum are removed at compile time. The arguments of a removed statement are
+ * still type checked, but never evaluated. The value corresponds to aeon::logger::log_level (0 = trace, 5 = fatal).
+ */
+#ifndef AEON_LOGGER_MIN_LEVEL
+#define AEON_LOGGER_MIN_LEVEL 0
+#endif
+
+/*!
+ * The level is checked before the logger_stream is created, so that the arguments of a disabled log statement are not
+ * evaluated or formatted at all.
+ */
+#define AEON_LOG(log, level)                                                                                           \
+    if (!(log).is_enabled(level))                                                                                      \
+    {                                                                                                                  \
+    }                                                                                                                  \
+    else                                                                                                               \
+        (log)(level)
+
+#define AEON_LOG_STRIPPED(log, level)                                                                                  \
+    if constexpr (true)                                                                                                \
+    {                                                                                                                  \
+    }                                                                                                                  \
+    else                                                                                                               \
+        (log)(level)
+
+/*!
+ * Deferred logging: only the arguments are captured as raw bytes on the calling thread, together with a reference to a
+ * static description of the call site. The message is formatted later by the backend (for example on a background
+ * thread), or stored in binary form to be formatted offline. The format string uses {} as placeholders. The level must
+ * be a constant expression.
+ */
+#define AEON_LOG_DEFERRED_CALL(log, level, format, ...)                                                                \
+    (log).log_deferred(                                                                                                \
+        []() -> const aeon::logger::binary_log_format &                                                                \
+        {                                                                                                              \
+            static const aeon::logger::binary_log_format log_format{level, format, __FILE__, __LINE__};                \
+            return log_format;                                                                                         \
+        }() __VA_OPT__(, ) __VA_ARGS__)
+
+#define AEON_LOG_DEFERRED(log, level, format, ...)                                                                     \
+    if (!(log).is_enabled(level))                                                                                      \
+    {                                                                                                                  \
+    }                                                                                                                  \
+    else                                                                                                               \
+        AEON_LOG_DEFERRED_CALL(log, level, format __VA_OPT__(, ) __VA_ARGS__)
+
+#define AEON_LOG_DEFERRED_STRIPPED(log, level, format, ...)                                                            \
+    if constexpr (true)                                                                                                \
+    {                                                                                                                  \
+    }                                                                                                                  \
+    else                                                                                                               \
+        AEON_LOG_DEFERRED_CALL(log, level, format __VA_OPT__(, ) __VA_ARGS__)
+
+#if (AEON_LOGGER_MIN_LEVEL > 5)
+#define AEON_LOG_FATAL(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::fatal)
+#define AEON_LOG_DEFERRED_FATAL(log, ...) AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::fatal, __VA_ARGS__)
+#else
 #define AEON_LOG_FATAL(log) AEON_LOG(log, aeon::logger::log_level::fatal)
+#define AEON_LOG_DEFERRED_FATAL(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::fatal, __VA_ARGS__)
+#endif
+
+#if (AEON_LOGGER_MIN_LEVEL > 4)
+#define AEON_LOG_ERROR(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::error)
+#define AEON_LOG_DEFERRED_ERROR(log, ...) AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::error, __VA_ARGS__)
+#else
 #define AEON_LOG_ERROR(log) AEON_LOG(log, aeon::logger::log_level::error)
+#define AEON_LOG_DEFERRED_ERROR(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::error, __VA_ARGS__)
+#endif
+
+#if (AEON_LOGGER_MIN_LEVEL > 3)
+#define AEON_LOG_WARNING(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::warning)
+#define AEON_LOG_DEFERRED_WARNING(log, ...)                                                                            \
+    AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::warning, __VA_ARGS__)
+#else
 #define AEON_LOG_WARNING(log) AEON_LOG(log, aeon::logger::log_level::warning)
+#define AEON_LOG_DEFERRED_WARNING(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::warning, __VA_ARGS__)
+#endif
+
+#if (AEON_LOGGER_MIN_LEVEL > 2)
+#define AEON_LOG_MESSAGE(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::message)
+#define AEON_LOG_DEFERRED_MESSAGE(log, ...)                                                                            \
+    AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::message, __VA_ARGS__)
+#else
 #define AEON_LOG_MESSAGE(log) AEON_LOG(log, aeon::logger::log_level::message)
+#define AEON_LOG_DEFERRED_MESSAGE(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::message, __VA_ARGS__)
+#endif
+
+#if (AEON_LOGGER_MIN_LEVEL > 1)
+#define AEON_LOG_DEBUG(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::debug)
+#define AEON_LOG_DEFERRED_DEBUG(log, ...) AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::debug, __VA_ARGS__)
+#else
 #define AEON_LOG_DEBUG(log) AEON_LOG(log, aeon::logger::log_level::debug)
+#define AEON_LOG_DEFERRED_DEBUG(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::debug, __VA_ARGS__)
+#endif
+
+#if (AEON_LOGGER_MIN_LEVEL > 0)
+#define AEON_LOG_TRACE(log) AEON_LOG_STRIPPED(log, aeon::logger::log_level::trace)
+#define AEON_LOG_DEFERRED_TRACE(log, ...) AEON_LOG_DEFERRED_STRIPPED(log, aeon::logger::log_level::trace, __VA_ARGS__)
+#else
 #define AEON_LOG_TRACE(log) AEON_LOG(log, aeon::logger::log_level::trace)
+#define AEON_LOG_DEFERRED_TRACE(log, ...) AEON_LOG_DEFERRED(log, aeon::logger::log_level::trace, __VA_ARGS__)
+#endif
 
 namespace aeon::logger
 {
 
+/*!
+ * Collects a single log message. The message is formatted only if the level is enabled in the backend at the time the
+ * stream is created, and is passed to the backend when std::endl (or any other manipulator) is streamed in.
+ *
+ * Messages are formatted into a fixed-size buffer that is reused by all log statements of a thread, so logging a
+ * typical message does not allocate any memory.
+ */
 class logger_stream final
 {
 public:
-    logger_stream(base_backend &backend, common::string module, const log_level level)
+    logger_stream(base_backend &backend, const common::string_view module, const log_level level)
         : backend_{backend}
-        , module_{std::move(module)}
+        , module_{module}
         , level_{level}
+        , stream_{nullptr}
+        , fallback_stream_{}
     {
+        if (backend_.is_enabled(level_))
+            stream_ = &internal::log_message_stream::acquire(fallback_stream_);
     }
 
-    ~logger_stream() = default;
+    ~logger_stream()
+    {
+        if (stream_)
+            stream_->release();
+    }
 
     logger_stream(const logger_stream &) noexcept = delete;
     auto operator=(const logger_stream &) noexcept -> logger_stream & = delete;
@@ -38,22 +153,27 @@ public:
 
     void operator<<(std::ostream &(std::ostream &)) const
     {
-        const auto message = stream_.str();
-        backend_.handle_log(message, module_, level_);
+        if (!stream_)
+            return;
+
+        backend_.handle_log(stream_->view(), module_, level_);
     }
 
     template <typename T>
     auto &operator<<(const T &data)
     {
-        stream_ << data;
+        if (stream_)
+            stream_->stream() << data;
+
         return *this;
     }
 
 private:
     base_backend &backend_;
-    common::string module_;
+    common::string_view module_;
     log_level level_;
-    std::stringstream stream_;
+    internal::log_message_stream *stream_;
+    std::optional<internal::log_message_stream> fallback_stream_;
 };
 
 class logger final
@@ -67,11 +187,31 @@ public:
 
     ~logger() = default;
 
+    /*!
+     * Create a stream for a single log message. The returned stream refers to this logger and must not outlive it.
+     * Prefer the AEON_LOG_* macros, which skip creating the stream entirely if the level is disabled.
+     */
     auto operator()(const log_level level) const -> logger_stream
     {
         return {*backend_, module_, level};
     }
 
+    [[nodiscard]] auto is_enabled(const log_level level) const noexcept -> bool
+    {
+        return backend_->is_enabled(level);
+    }
+
+    /*!
+     * Log a message of which the formatting is deferred to the backend. Prefer the AEON_LOG_DEFERRED_* macros, which
+     * create the static format description for the call site.
+     */
+    template <typename... args_t>
+    void log_deferred(const binary_log_format &format, const args_t &...args) const
+    {
+        const binary_log_arguments arguments{args...};
+        backend_->handle_log_deferred(format, arguments.data(), module_);
+    }
+
     logger(const logger &) noexcept = delete;
     auto operator=(const logger &) noexcept -> logger & = delete;
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <aeon/logger/base_backend.h>
+#include <aeon/common/string.h>
 #include <vector>
 #include <set>
 #include <mutex>
@@ -49,7 +50,7 @@ public:
 private:
     void handle_background_thread();
 
-    void log(const common::string &message, const common::string &module, const log_level level) final;
+    void log(const common::string_view message, const common::string_view module, const log_level level) final;
 
     std::thread thread_;
     std::mutex signal_mutex_;
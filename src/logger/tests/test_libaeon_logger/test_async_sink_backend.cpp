@@ -0,0 +1,300 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/async_sink_backend.h>
+#include <aeon/logger/log_sink.h>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace aeon;
+
+namespace internal
+{
+
+/*!
+ * Records all messages. When paused, the background thread of the backend is held up in the first message it writes,
+ * so that the ring buffers fill up.
+ */
+class pausable_sink final : public logger::log_sink
+{
+public:
+    pausable_sink() = default;
+    ~pausable_sink() final = default;
+
+    pausable_sink(const pausable_sink &) = delete;
+    auto operator=(const pausable_sink &) noexcept -> pausable_sink & = delete;
+
+    pausable_sink(pausable_sink &&) = delete;
+    auto operator=(pausable_sink &&) noexcept -> pausable_sink & = delete;
+
+    void log(const common::string_view message, [[maybe_unused]] const common::string_view module,
+             [[maybe_unused]] const logger::log_level level) final
+    {
+        std::unique_lock lock{mutex_};
+        messages_.emplace_back(message.as_std_string_view());
+        signal_.notify_all();
+        signal_.wait(lock, [this]() { return !paused_; });
+    }
+
+    void pause()
+    {
+        std::scoped_lock lock{mutex_};
+        paused_ = true;
+    }
+
+    void resume()
+    {
+        std::scoped_lock lock{mutex_};
+        paused_ = false;
+        signal_.notify_all();
+    }
+
+    void wait_for_messages(const std::size_t count)
+    {
+        std::unique_lock lock{mutex_};
+        signal_.wait(lock, [this, count]() { return std::size(messages_) >= count; });
+    }
+
+    [[nodiscard]] auto messages() -> std::vector<std::string>
+    {
+        std::scoped_lock lock{mutex_};
+        return messages_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable signal_;
+    bool paused_ = false;
+    std::vector<std::string> messages_;
+};
+
+} // namespace internal
+
+TEST(test_async_sink_backend, writes_messages_in_order)
+{
+    internal::pausable_sink sink;
+    logger::async_sink_backend backend{logger::log_level::message, 16};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        if (i % 2 == 0)
+            AEON_LOG_MESSAGE(log) << "Message " << i << std::endl;
+        else
+            AEON_LOG_DEFERRED_MESSAGE(log, "Message {}", i);
+    }
+
+    backend.stop();
+
+    const auto messages = sink.messages();
+    ASSERT_EQ(1000u, std::size(messages));
+
+    for (auto i = 0; i < 1000; ++i)
+        EXPECT_EQ("Message " + std::to_string(i), messages[i]);
+
+    EXPECT_EQ(0u, backend.dropped_count());
+}
+
+TEST(test_async_sink_backend, drop_policy)
+{
+    constexpr std::size_t ring_size = 4;
+
+    internal::pausable_sink sink;
+    logger::async_sink_backend backend{logger::log_level::message, ring_size, logger::async_full_policy::drop};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    sink.pause();
+    AEON_LOG_MESSAGE(log) << "First" << std::endl;
+    sink.wait_for_messages(1);
+
+    // The background thread holds on to the slot of the first message while writing it, so the ring is full after
+    // ring_size - 1 more messages.
+    for (auto i = 0u; i < ring_size - 1 + 5; ++i)
+        AEON_LOG_MESSAGE(log) << "Message " << i << std::endl;
+
+    EXPECT_EQ(5u, backend.dropped_count());
+
+    sink.resume();
+    backend.stop();
+
+    const auto messages = sink.messages();
+    ASSERT_EQ(ring_size, std::size(messages));
+    EXPECT_EQ("First", messages[0]);
+
+    for (auto i = 0u; i < ring_size - 1; ++i)
+        EXPECT_EQ("Message " + std::to_string(i), messages[i + 1]);
+
+    // Messages logged after stop() are discarded.
+    AEON_LOG_MESSAGE(log) << "Stopped" << std::endl;
+    EXPECT_EQ(6u, backend.dropped_count());
+    EXPECT_EQ(ring_size, std::size(sink.messages()));
+}
+
+TEST(test_async_sink_backend, block_policy)
+{
+    constexpr std::size_t ring_size = 4;
+    constexpr auto count = 100u;
+
+    internal::pausable_sink sink;
+    logger::async_sink_backend backend{logger::log_level::message, ring_size, logger::async_full_policy::block};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    sink.pause();
+    AEON_LOG_MESSAGE(log) << "First" << std::endl;
+    sink.wait_for_messages(1);
+
+    std::atomic<bool> done{false};
+    std::thread thread{[&log, &done]()
+                       {
+                           for (auto i = 0u; i < count; ++i)
+                               AEON_LOG_MESSAGE(log) << "Message " << i << std::endl;
+
+                           done = true;
+                       }};
+
+    // The logging thread can not finish while the background thread is held up.
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(done);
+
+    sink.resume();
+    thread.join();
+    backend.stop();
+
+    const auto messages = sink.messages();
+    ASSERT_EQ(count + 1, std::size(messages));
+
+    for (auto i = 0u; i < count; ++i)
+        EXPECT_EQ("Message " + std::to_string(i), messages[i + 1]);
+
+    EXPECT_EQ(0u, backend.dropped_count());
+}
+
+TEST(test_async_sink_backend, many_threads)
+{
+    constexpr auto thread_count = 8;
+    constexpr auto count = 1000;
+
+    internal::pausable_sink sink;
+    logger::async_sink_backend backend{logger::log_level::message, 64};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    std::vector<std::thread> threads;
+
+    for (auto t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back(
+            [&log, t]()
+            {
+                for (auto i = 0; i < count; ++i)
+                    AEON_LOG_DEFERRED_MESSAGE(log, "{} {}", t, i);
+            });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    backend.stop();
+
+    const auto messages = sink.messages();
+    ASSERT_EQ(static_cast<std::size_t>(thread_count * count), std::size(messages));
+
+    // Messages of a single thread are written in order.
+    std::vector<int> next(thread_count, 0);
+
+    for (const auto &message : messages)
+    {
+        const auto separator = message.find(' ');
+        const auto t = std::stoi(message.substr(0, separator));
+        EXPECT_EQ(next[t]++, std::stoi(message.substr(separator + 1)));
+    }
+
+    EXPECT_EQ(0u, backend.dropped_count());
+}
+
+TEST(test_async_sink_backend, threads_that_exit)
+{
+    constexpr auto thread_count = 100;
+    constexpr auto count = 10;
+
+    internal::pausable_sink sink;
+    logger::async_sink_backend backend{logger::log_level::message, 16};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    // The rings of threads that have exited are reused by the threads that follow.
+    for (auto t = 0; t < thread_count; ++t)
+    {
+        std::thread thread{[&log, t]()
+                           {
+                               for (auto i = 0; i < count; ++i)
+                                   AEON_LOG_DEFERRED_MESSAGE(log, "{} {}", t, i);
+                           }};
+        thread.join();
+    }
+
+    backend.stop();
+
+    const auto messages = sink.messages();
+    ASSERT_EQ(static_cast<std::size_t>(thread_count * count), std::size(messages));
+    EXPECT_EQ(0u, backend.dropped_count());
+
+    // A thread may have logged while the ring it got from a previous thread was still being drained.
+    std::vector<int> next(thread_count, 0);
+
+    for (const auto &message : messages)
+    {
+        const auto separator = message.find(' ');
+        const auto t = std::stoi(message.substr(0, separator));
+        EXPECT_EQ(next[t]++, std::stoi(message.substr(separator + 1)));
+    }
+}
+
+TEST(test_async_sink_backend, stop_while_logging)
+{
+    constexpr auto thread_count = 4;
+
+    for (const auto policy : {logger::async_full_policy::block, logger::async_full_policy::drop})
+    {
+        internal::pausable_sink sink;
+        logger::async_sink_backend backend{logger::log_level::message, 16, policy};
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Test"};
+
+        std::atomic<bool> stopped{false};
+        std::atomic<std::uint64_t> logged{0};
+        std::vector<std::thread> threads;
+
+        for (auto t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                [&log, &stopped, &logged]()
+                {
+                    while (!stopped)
+                    {
+                        AEON_LOG_MESSAGE(log) << "Message" << std::endl;
+                        ++logged;
+                    }
+                });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        backend.stop();
+        stopped = true;
+
+        for (auto &thread : threads)
+            thread.join();
+
+        // Every message is either written or counted as dropped, including those that raced with stop().
+        EXPECT_EQ(logged.load(), std::size(sink.messages()) + backend.dropped_count());
+    }
+}
@@ -0,0 +1,184 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/binary_file_backend.h>
+#include <aeon/logger/binary_log_reader.h>
+#include <aeon/logger/exception.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <aeon/streams/devices/memory_view_device.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+
+using namespace aeon;
+
+namespace internal
+{
+
+template <typename T>
+static void append(std::vector<std::uint8_t> &data, const T value)
+{
+    const auto offset = std::size(data);
+    data.resize(offset + sizeof(T));
+    std::memcpy(std::data(data) + offset, &value, sizeof(T));
+}
+
+static void append_string(std::vector<std::uint8_t> &data, const std::string &str)
+{
+    append(data, static_cast<std::uint32_t>(std::size(str)));
+    data.insert(std::end(data), std::begin(str), std::end(str));
+}
+
+/*!
+ * Write a binary log with a regular message, followed by a message or deferred message record of which the size of the
+ * message or arguments is the given size. The record ends right after the size.
+ */
+[[nodiscard]] static auto create_log_with_invalid_size(const bool deferred, const std::uint32_t size)
+    -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> data;
+
+    {
+        auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+        logger::binary_file_backend backend{stream};
+        logger::logger log{backend, "Test"};
+        AEON_LOG_MESSAGE(log) << "Message" << std::endl;
+    }
+
+    if (!deferred)
+    {
+        // A message record of which the size of the message is invalid.
+        append(data, std::uint8_t{3});
+        append(data, std::uint8_t{0});
+        append(data, std::uint64_t{0});
+        append_string(data, "Test");
+        append(data, size);
+        return data;
+    }
+
+    // A format record, followed by a deferred message of which the size of the arguments is invalid.
+    append(data, std::uint8_t{1});
+    append(data, std::uint32_t{1});
+    append(data, std::uint8_t{0});
+    append(data, std::uint32_t{1});
+    append_string(data, "file.cpp");
+    append_string(data, "{}");
+
+    append(data, std::uint8_t{2});
+    append(data, std::uint32_t{1});
+    append(data, std::uint64_t{0});
+    append_string(data, "Test");
+    append(data, size);
+    return data;
+}
+
+} // namespace internal
+
+TEST(test_binary_log, format_binary_log)
+{
+    const logger::binary_log_arguments arguments{42, -7ll, 2.5, true, 'c', "text", std::uint8_t{255}};
+
+    common::string result;
+    logger::format_binary_log("{} {} {} {} {} {} {} {{}} {}", arguments.data(), result);
+    EXPECT_EQ("42 -7 2.5 true c text 255 {} {}", result);
+}
+
+TEST(test_binary_log, write_and_read)
+{
+    std::vector<std::uint8_t> data;
+    const auto before = std::chrono::system_clock::now();
+
+    {
+        auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+        logger::binary_file_backend backend{stream, logger::log_level::debug};
+        logger::logger log{backend, "Test"};
+
+        AEON_LOG_MESSAGE(log) << "Regular message " << 1 << std::endl;
+        AEON_LOG_DEFERRED_WARNING(log, "Deferred message {} of {}", 2, "test");
+
+        // The format of a call site is only written once.
+        for (auto i = 0; i < 2; ++i)
+            AEON_LOG_DEFERRED_ERROR(log, "Repeated {}", i);
+
+        // Disabled; not written at all.
+        AEON_LOG_TRACE(log) << "Trace" << std::endl;
+        AEON_LOG_DEFERRED_TRACE(log, "Trace {}", 1);
+    }
+
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    logger::binary_log_reader reader{stream};
+    logger::binary_log_entry entry;
+
+    ASSERT_TRUE(reader.read(entry));
+    EXPECT_EQ(logger::log_level::message, entry.level);
+    EXPECT_EQ("Test", entry.module);
+    EXPECT_EQ("Regular message 1", entry.message);
+    EXPECT_TRUE(std::empty(entry.file));
+    EXPECT_EQ(0u, entry.line);
+    EXPECT_GE(entry.timestamp, before - std::chrono::seconds{1});
+
+    ASSERT_TRUE(reader.read(entry));
+    EXPECT_EQ(logger::log_level::warning, entry.level);
+    EXPECT_EQ("Test", entry.module);
+    EXPECT_EQ("Deferred message 2 of test", entry.message);
+    EXPECT_TRUE(entry.file.as_std_string_view().ends_with("test_binary_log.cpp"));
+    EXPECT_NE(0u, entry.line);
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(reader.read(entry));
+        EXPECT_EQ(logger::log_level::error, entry.level);
+        EXPECT_EQ("Repeated " + std::to_string(i), entry.message.str());
+    }
+
+    EXPECT_FALSE(reader.read(entry));
+}
+
+TEST(test_binary_log, read_invalid)
+{
+    std::vector<std::uint8_t> data{'n', 'o', 't', ' ', 'a', ' ', 'l', 'o', 'g'};
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    EXPECT_THROW(logger::binary_log_reader{stream}, logger::binary_log_exception);
+}
+
+TEST(test_binary_log, read_truncated)
+{
+    std::vector<std::uint8_t> data;
+
+    {
+        auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+        logger::binary_file_backend backend{stream};
+        logger::logger log{backend, "Test"};
+        AEON_LOG_DEFERRED_MESSAGE(log, "Truncated {}", 1);
+    }
+
+    data.pop_back();
+
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    logger::binary_log_reader reader{stream};
+    logger::binary_log_entry entry;
+    EXPECT_THROW([[maybe_unused]] const auto result = reader.read(entry), logger::binary_log_exception);
+}
+
+TEST(test_binary_log, read_invalid_size)
+{
+    for (const auto deferred : {false, true})
+    {
+        for (const auto size : {std::numeric_limits<std::uint32_t>::max(), 1024u * 1024u * 1024u, 5u})
+        {
+            auto data = internal::create_log_with_invalid_size(deferred, size);
+            auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+            logger::binary_log_reader reader{stream};
+            logger::binary_log_entry entry;
+
+            ASSERT_TRUE(reader.read(entry));
+            EXPECT_EQ("Message", entry.message);
+
+            // The size is rejected before anything is allocated for it.
+            EXPECT_THROW([[maybe_unused]] const auto result = reader.read(entry), logger::binary_log_exception);
+        }
+    }
+}
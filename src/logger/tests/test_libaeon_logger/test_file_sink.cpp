@@ -0,0 +1,233 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/file_sink.h>
+#include <aeon/logger/simple_sink_backend.h>
+#include <aeon/compression/zlib.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+using namespace aeon;
+
+namespace internal
+{
+
+[[nodiscard]] static auto read_file(const std::filesystem::path &path) -> std::string
+{
+    std::ifstream file{path, std::ios::binary};
+    std::stringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+[[nodiscard]] static auto decompress_file(const std::filesystem::path &path) -> std::string
+{
+    const auto compressed = read_file(path);
+    std::size_t offset = 0;
+
+    const auto read = [&compressed, &offset](std::byte *buffer, const std::streamsize size)
+    {
+        const auto read_size = std::min(static_cast<std::size_t>(size), std::size(compressed) - offset);
+        std::copy_n(reinterpret_cast<const std::byte *>(std::data(compressed)) + offset, read_size, buffer);
+        offset += read_size;
+        return static_cast<std::streamsize>(read_size);
+    };
+
+    std::string result(64 * 1024, '\0');
+    compression::zlib_decompress decompress;
+    result.resize(static_cast<std::size_t>(
+        decompress.read(reinterpret_cast<std::byte *>(std::data(result)), std::size(result), read)));
+    return result;
+}
+
+/*!
+ * Returns true if the file contains a complete zlib stream. zlib rejects a stream that was never finished as truncated.
+ */
+[[nodiscard]] static auto is_complete_zlib_stream(const std::filesystem::path &path, const std::size_t size) -> bool
+{
+    const auto compressed = read_file(path);
+    std::string result(size, '\0');
+    auto result_size = static_cast<uLongf>(size);
+
+    return uncompress(reinterpret_cast<Bytef *>(std::data(result)), &result_size,
+                      reinterpret_cast<const Bytef *>(std::data(compressed)),
+                      static_cast<uLong>(std::size(compressed))) == Z_OK;
+}
+
+class test_file_sink : public ::testing::Test
+{
+protected:
+    test_file_sink()
+        : directory{std::filesystem::temp_directory_path() / "aeon_test_file_sink"}
+        , path{directory / "test.log"}
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    ~test_file_sink() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+
+    std::filesystem::path directory;
+    std::filesystem::path path;
+};
+
+} // namespace internal
+
+using internal::test_file_sink;
+
+TEST_F(test_file_sink, writes_messages)
+{
+    {
+        logger::file_sink sink{path};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Test"};
+
+        AEON_LOG_MESSAGE(log) << "First message" << std::endl;
+        AEON_LOG_WARNING(log) << "Second message" << std::endl;
+        sink.flush();
+
+        EXPECT_NE(std::string::npos, internal::read_file(path).find("[Test] [Message]: First message\n"));
+    }
+
+    const auto content = internal::read_file(path);
+    EXPECT_NE(std::string::npos, content.find("[Test] [Message]: First message\n"));
+    EXPECT_NE(std::string::npos, content.find("[Test] [Warning]: Second message\n"));
+    EXPECT_EQ('[', content.front());
+}
+
+TEST_F(test_file_sink, rotates_by_size)
+{
+    logger::file_sink_settings settings;
+    settings.rotation = logger::file_sink_rotation::size;
+    settings.max_file_size = 100;
+    settings.max_files = 2;
+
+    {
+        logger::file_sink sink{path, settings};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Test"};
+
+        // Every message is written separately; two of them do not fit in a single file.
+        for (auto i = 0; i < 5; ++i)
+        {
+            AEON_LOG_MESSAGE(log) << "Message " << i << ' ' << std::string(40, 'x') << std::endl;
+            sink.flush();
+        }
+    }
+
+    EXPECT_NE(std::string::npos, internal::read_file(path).find("Message 4"));
+    EXPECT_NE(std::string::npos, internal::read_file(directory / "test.log.1").find("Message 3"));
+    EXPECT_NE(std::string::npos, internal::read_file(directory / "test.log.2").find("Message 2"));
+
+    // Only max_files rotated files are kept.
+    EXPECT_FALSE(std::filesystem::exists(directory / "test.log.3"));
+
+    for (const auto &file : {path, directory / "test.log.1", directory / "test.log.2"})
+        EXPECT_LE(std::filesystem::file_size(file), settings.max_file_size);
+}
+
+TEST_F(test_file_sink, compresses_rotated_files)
+{
+    logger::file_sink_settings settings;
+    settings.rotation = logger::file_sink_rotation::size;
+    settings.max_file_size = 1024;
+    settings.compress_rotated_files = true;
+
+    std::string first_file_content;
+
+    {
+        logger::file_sink sink{path, settings};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Test"};
+
+        for (auto i = 0; i < 10; ++i)
+            AEON_LOG_MESSAGE(log) << "Message " << i << ' ' << std::string(40, 'x') << std::endl;
+
+        sink.flush();
+        first_file_content = internal::read_file(path);
+
+        AEON_LOG_MESSAGE(log) << "Last message " << std::string(1000, 'y') << std::endl;
+    }
+
+    const auto compressed_path = directory / "test.log.1.z";
+    ASSERT_TRUE(std::filesystem::exists(compressed_path));
+    EXPECT_FALSE(std::filesystem::exists(directory / "test.log.1"));
+    EXPECT_LT(std::filesystem::file_size(compressed_path), std::size(first_file_content));
+
+    EXPECT_TRUE(internal::is_complete_zlib_stream(compressed_path, std::size(first_file_content)));
+    EXPECT_EQ(first_file_content, internal::decompress_file(compressed_path));
+    EXPECT_NE(std::string::npos, internal::read_file(path).find("Last message"));
+}
+
+TEST_F(test_file_sink, compresses_every_rotated_file)
+{
+    logger::file_sink_settings settings;
+    settings.rotation = logger::file_sink_rotation::size;
+    settings.max_file_size = 100;
+    settings.max_files = 0;
+    settings.compress_rotated_files = true;
+
+    {
+        logger::file_sink sink{path, settings};
+        logger::simple_sink_backend backend;
+        backend.add_sink(&sink);
+        logger::logger log{backend, "Test"};
+
+        // Every flush rotates, so files are rotated again while the previous one may still be compressed.
+        for (auto i = 0; i < 6; ++i)
+        {
+            AEON_LOG_MESSAGE(log) << "Message " << i << ' ' << std::string(40, 'x') << std::endl;
+            sink.flush();
+        }
+    }
+
+    EXPECT_NE(std::string::npos, internal::read_file(path).find("Message 5"));
+
+    for (auto i = 1; i <= 5; ++i)
+    {
+        const auto compressed_path = directory / ("test.log." + std::to_string(i) + ".z");
+        ASSERT_TRUE(std::filesystem::exists(compressed_path));
+        EXPECT_FALSE(std::filesystem::exists(directory / ("test.log." + std::to_string(i))));
+        EXPECT_NE(std::string::npos,
+                  internal::decompress_file(compressed_path).find("Message " + std::to_string(5 - i)));
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(directory / "test.log.6.z"));
+}
+
+TEST_F(test_file_sink, counts_failed_writes)
+{
+    // Every write to /dev/full fails because there is no space left.
+    const std::filesystem::path full_device{"/dev/full"};
+
+    if (!std::filesystem::exists(full_device))
+        GTEST_SKIP() << "/dev/full is not available on this platform.";
+
+    logger::file_sink sink{full_device};
+    logger::simple_sink_backend backend;
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    EXPECT_EQ(0u, sink.failed_write_count());
+
+    AEON_LOG_MESSAGE(log) << "Lost message" << std::endl;
+    sink.flush();
+    EXPECT_EQ(1u, sink.failed_write_count());
+
+    // The file is reopened for the next write, which fails again.
+    AEON_LOG_MESSAGE(log) << "Another lost message" << std::endl;
+    sink.flush();
+    EXPECT_EQ(2u, sink.failed_write_count());
+}
@@ -0,0 +1,125 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/logger/logger.h>
+#include <aeon/logger/log_message_stream.h>
+#include <aeon/logger/simple_sink_backend.h>
+#include <aeon/logger/log_sink.h>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class recording_sink final : public logger::log_sink
+{
+public:
+    recording_sink() = default;
+    ~recording_sink() final = default;
+
+    recording_sink(const recording_sink &) = delete;
+    auto operator=(const recording_sink &) noexcept -> recording_sink & = delete;
+
+    recording_sink(recording_sink &&) = delete;
+    auto operator=(recording_sink &&) noexcept -> recording_sink & = delete;
+
+    void log(const common::string_view message, [[maybe_unused]] const common::string_view module,
+             [[maybe_unused]] const logger::log_level level) final
+    {
+        messages.emplace_back(message.as_std_string_view());
+    }
+
+    std::vector<std::string> messages;
+};
+
+} // namespace internal
+
+TEST(test_logger, log_message_stream_overflow)
+{
+    std::optional<logger::internal::log_message_stream> fallback;
+    auto &stream = logger::internal::log_message_stream::acquire(fallback);
+
+    // A message longer than the fixed buffer continues in the overflow string and is not truncated.
+    const std::string first(logger::internal::log_message_buffer::capacity - 1, 'a');
+    const std::string second(3 * logger::internal::log_message_buffer::capacity, 'b');
+    stream.stream() << first << 'c' << 'd' << second << 42;
+
+    EXPECT_EQ(first + "cd" + second + "42", stream.view());
+    stream.release();
+
+    // The buffer is reused for the next message.
+    auto &next_stream = logger::internal::log_message_stream::acquire(fallback);
+    EXPECT_EQ(&stream, &next_stream);
+    next_stream.stream() << "short";
+    EXPECT_EQ("short", next_stream.view());
+    next_stream.release();
+}
+
+TEST(test_logger, log_message_stream_resets_formatting)
+{
+    std::optional<logger::internal::log_message_stream> fallback;
+
+    auto &stream = logger::internal::log_message_stream::acquire(fallback);
+    stream.stream() << std::hex << std::setprecision(2) << std::setfill('0') << std::setw(4) << 255 << ' ' << 1.2345;
+    EXPECT_EQ("00ff 1.2", stream.view());
+    stream.release();
+
+    auto &next_stream = logger::internal::log_message_stream::acquire(fallback);
+    next_stream.stream() << std::setw(4) << 255 << ' ' << 1.2345;
+    EXPECT_EQ(" 255 1.2345", next_stream.view());
+    next_stream.release();
+}
+
+TEST(test_logger, log_message_stream_in_use)
+{
+    std::optional<logger::internal::log_message_stream> fallback;
+    std::optional<logger::internal::log_message_stream> nested_fallback;
+
+    auto &stream = logger::internal::log_message_stream::acquire(fallback);
+    stream.stream() << "outer";
+
+    // Logging while formatting a message (for example from an operator<<) uses a separate stream.
+    auto &nested_stream = logger::internal::log_message_stream::acquire(nested_fallback);
+    EXPECT_NE(&stream, &nested_stream);
+    EXPECT_EQ(&*nested_fallback, &nested_stream);
+    nested_stream.stream() << "inner";
+    EXPECT_EQ("inner", nested_stream.view());
+    nested_stream.release();
+
+    EXPECT_EQ("outer", stream.view());
+    stream.release();
+}
+
+TEST(test_logger, disabled_levels_are_not_formatted)
+{
+    internal::recording_sink sink;
+    logger::simple_sink_backend backend{logger::log_level::warning};
+    backend.add_sink(&sink);
+    logger::logger log{backend, "Test"};
+
+    auto evaluated = 0;
+    const auto argument = [&evaluated]()
+    {
+        ++evaluated;
+        return evaluated;
+    };
+
+    AEON_LOG_DEBUG(log) << "Debug " << argument() << std::endl;
+    AEON_LOG_DEFERRED_MESSAGE(log, "Message {}", argument());
+    EXPECT_EQ(0, evaluated);
+
+    AEON_LOG_WARNING(log) << "Warning " << argument() << std::endl;
+    AEON_LOG_DEFERRED_ERROR(log, "Error {}", argument());
+    EXPECT_EQ(2, evaluated);
+
+    backend.set_log_level(logger::log_level::trace);
+    AEON_LOG_DEBUG(log) << "Debug " << argument() << std::endl;
+
+    ASSERT_EQ(3u, std::size(sink.messages));
+    EXPECT_EQ("Warning 1", sink.messages[0]);
+    EXPECT_EQ("Error 2", sink.messages[1]);
+    EXPECT_EQ("Debug 3", sink.messages[2]);
+}
@@ -0,0 +1,150 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <benchmark/benchmark.h>
+
+#include <aeon/ptree/reflection.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+#include <aeon/ptree/serialization/serialization_abf.h>
+#include <aeon/reflection/reflection.h>
+#include <vector>
+
+using namespace aeon;
+
+class benchmark_class final : public reflection::reflection_object
+{
+    AEON_REFLECTION_BEGIN(benchmark_class)
+    AEON_REFLECTION_FIELD(std::int64_t, id)
+    AEON_REFLECTION_FIELD(int, count)
+    AEON_REFLECTION_FIELD(double, x)
+    AEON_REFLECTION_FIELD(double, y)
+    AEON_REFLECTION_FIELD(float, weight)
+    AEON_REFLECTION_FIELD(bool, enabled)
+    AEON_REFLECTION_FIELD(aeon::common::string, name)
+    AEON_REFLECTION_END()
+
+public:
+    std::int64_t id = 0;
+    int count = 0;
+    double x = 0.0;
+    double y = 0.0;
+    float weight = 0.0f;
+    bool enabled = false;
+    common::string name;
+};
+
+[[nodiscard]] static auto make_objects(const std::int64_t count) -> std::vector<benchmark_class>
+{
+    std::vector<benchmark_class> objects(static_cast<std::size_t>(count));
+
+    for (std::int64_t i = 0; i < count; ++i)
+    {
+        auto &obj = objects[static_cast<std::size_t>(i)];
+        obj.id = i;
+        obj.count = static_cast<int>(i * 2);
+        obj.x = static_cast<double>(i) * 0.5;
+        obj.y = static_cast<double>(i) * 0.25;
+        obj.weight = 1.5f;
+        obj.enabled = (i % 2) == 0;
+        obj.name = "object";
+    }
+
+    return objects;
+}
+
+static void benchmark_reflection_from_reflection_object_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &obj : objects)
+            benchmark::DoNotOptimize(ptree::from_reflection_object(obj, benchmark_class::reflection_info()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_from_reflection_object_array)->Arg(1000)->Arg(10000);
+
+static void benchmark_reflection_to_reflection_object_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    std::vector<ptree::property_tree> pts;
+    pts.reserve(std::size(objects));
+
+    for (const auto &obj : objects)
+        pts.push_back(ptree::from_reflection_object(obj, benchmark_class::reflection_info()));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &pt : pts)
+            benchmark::DoNotOptimize(ptree::to_reflection_object<benchmark_class>(pt));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_to_reflection_object_array)->Arg(1000)->Arg(10000);
+
+static void benchmark_reflection_to_json_via_ptree_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &obj : objects)
+            benchmark::DoNotOptimize(
+                ptree::serialization::to_json(ptree::from_reflection_object(obj, benchmark_class::reflection_info())));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_to_json_via_ptree_array)->Arg(1000)->Arg(10000);
+
+static void benchmark_reflection_to_json_direct_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &obj : objects)
+            benchmark::DoNotOptimize(ptree::serialization::to_json(obj, benchmark_class::reflection_info()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_to_json_direct_array)->Arg(1000)->Arg(10000);
+
+static void benchmark_reflection_to_abf_via_ptree_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &obj : objects)
+            benchmark::DoNotOptimize(
+                ptree::serialization::to_abf(ptree::from_reflection_object(obj, benchmark_class::reflection_info())));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_to_abf_via_ptree_array)->Arg(1000)->Arg(10000);
+
+static void benchmark_reflection_to_abf_direct_array(benchmark::State &state)
+{
+    const auto objects = make_objects(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto &obj : objects)
+            benchmark::DoNotOptimize(ptree::serialization::to_abf(obj, benchmark_class::reflection_info()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_reflection_to_abf_direct_array)->Arg(1000)->Arg(10000);
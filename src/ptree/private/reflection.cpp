@@ -1,10 +1,123 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/ptree/reflection.h>
+#include <aeon/reflection/visit_field.h>
+#include <algorithm>
+#include <concepts>
+#include <utility>
 
 namespace aeon::ptree
 {
 
+namespace internal
+{
+
+template <std::integral T>
+static void load_field(const property_tree &pt, T &value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        if (!pt.is_bool())
+            throw ptree_exception{};
+
+        value = pt.bool_value();
+    }
+    else
+    {
+        // Values that do not fit in the field (like a negative value for an unsigned field) are rejected.
+        if (!pt.is_integer() || !std::in_range<T>(pt.integer_value()))
+            throw ptree_exception{};
+
+        value = static_cast<T>(pt.integer_value());
+    }
+}
+
+template <std::floating_point T>
+static void load_field(const property_tree &pt, T &value)
+{
+    if (!pt.is_double())
+        throw ptree_exception{};
+
+    value = static_cast<T>(pt.double_value());
+}
+
+static void load_field(const property_tree &pt, common::string &value)
+{
+    if (!pt.is_string())
+        throw ptree_exception{};
+
+    value = pt.string_value();
+}
+
+static void load_field(const property_tree &pt, std::string &value)
+{
+    if (!pt.is_string())
+        throw ptree_exception{};
+
+    value = pt.string_value().str();
+}
+
+static void load_field(const property_tree &pt, common::uuid &value)
+{
+    if (!pt.is_uuid())
+        throw ptree_exception{};
+
+    value = pt.uuid_value();
+}
+
+static void load_field(const property_tree &pt, blob &value)
+{
+    if (!pt.is_blob())
+        throw ptree_exception{};
+
+    value = pt.blob_value();
+}
+
+template <std::integral T>
+[[nodiscard]] static auto store_field(const T value) -> property_tree
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return value;
+    }
+    else
+    {
+        // Integers are stored as int64; unsigned 64-bit values above INT64_MAX can not be represented.
+        if (!std::in_range<std::int64_t>(value))
+            throw ptree_exception{};
+
+        return static_cast<std::int64_t>(value);
+    }
+}
+
+template <std::floating_point T>
+[[nodiscard]] static auto store_field(const T value) -> property_tree
+{
+    return static_cast<double>(value);
+}
+
+[[nodiscard]] static auto store_field(const common::string &value) -> property_tree
+{
+    return value;
+}
+
+[[nodiscard]] static auto store_field(const std::string &value) -> property_tree
+{
+    return common::string{value};
+}
+
+[[nodiscard]] static auto store_field(const common::uuid &value) -> property_tree
+{
+    return value;
+}
+
+[[nodiscard]] static auto store_field(const blob &value) -> property_tree
+{
+    return value;
+}
+
+} // namespace internal
+
 [[nodiscard]] auto to_reflection_object(const reflection::reflection_info &reflection_info, const property_tree &pt)
     -> std::unique_ptr<reflection::reflection_object>
 {
@@ -22,70 +135,23 @@ namespace aeon::ptree
 
     for (const auto &field : field_info)
     {
-        const auto field_name_str = field.name();
-        const auto result = pt_object.find(common::string{field_name_str});
+        const auto field_name = field.name();
+        const auto result = std::find_if(std::begin(pt_object), std::end(pt_object),
+                                         [field_name](const auto &pair) { return pair.first == field_name; });
 
         if (result == std::end(pt_object))
             continue;
 
-        if (field.type() == "std::int64_t")
-        {
-            if (!result->second.is_integer())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.integer_value());
-        }
-        else if (field.type() == "int")
-        {
-            if (!result->second.is_integer())
-                throw ptree_exception{};
-
-            field.set(*obj, static_cast<int>(result->second.integer_value()));
-        }
-        else if (field.type() == "float")
-        {
-            if (!result->second.is_double())
-                throw ptree_exception{};
-
-            field.set(*obj, static_cast<float>(result->second.double_value()));
-        }
-        else if (field.type() == "double")
-        {
-            if (!result->second.is_double())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.double_value());
-        }
-        else if (field.type() == "bool")
-        {
-            if (!result->second.is_bool())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.bool_value());
-        }
-        else if (field.type() == "aeon::common::string")
+        try
         {
-            if (!result->second.is_string())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.string_value());
-        }
-        else if (field.type() == "aeon::common::uuid")
-        {
-            if (!result->second.is_uuid())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.uuid_value());
+            reflection::visit_field(field, *obj,
+                                    [&value = result->second](auto &field_value)
+                                    { internal::load_field(value, field_value); });
         }
-        else if (field.type() == "std::vector<std::uint8_t>")
+        catch (const reflection::reflection_exception &)
         {
-            if (!result->second.is_blob())
-                throw ptree_exception{};
-
-            field.set(*obj, result->second.blob_value());
-        }
-        else
             throw ptree_exception{};
+        }
     }
 
     return obj;
@@ -100,42 +166,19 @@ auto from_reflection_object(const reflection::reflection_object &obj,
 
     for (const auto &field : field_info)
     {
-        const auto field_name = common::string{field.name()};
-
-        if (field.type() == "std::int64_t")
-        {
-            pt_obj.insert(field_name, field.get<std::int64_t>(obj));
-        }
-        else if (field.type() == "int")
+        try
         {
-            pt_obj.insert(field_name, field.get<int>(obj));
+            reflection::visit_field(field, obj,
+                                    [&pt_obj, &field](const auto &field_value)
+                                    {
+                                        pt_obj.push_back(common::string{field.name()},
+                                                         internal::store_field(field_value));
+                                    });
         }
-        else if (field.type() == "float")
+        catch (const reflection::reflection_exception &)
         {
-            pt_obj.insert(field_name, field.get<float>(obj));
-        }
-        else if (field.type() == "double")
-        {
-            pt_obj.insert(field_name, field.get<double>(obj));
-        }
-        else if (field.type() == "bool")
-        {
-            pt_obj.insert(field_name, field.get<bool>(obj));
-        }
-        else if (field.type() == "aeon::common::string")
-        {
-            pt_obj.insert(field_name, field.get<common::string>(obj));
-        }
-        else if (field.type() == "aeon::common::uuid")
-        {
-            pt_obj.insert(field_name, field.get<common::uuid>(obj));
-        }
-        else if (field.type() == "std::vector<std::uint8_t>")
-        {
-            pt_obj.insert(field_name, field.get<std::vector<std::uint8_t>>(obj));
-        }
-        else
             throw ptree_exception{};
+        }
     }
 
     return pt_obj;
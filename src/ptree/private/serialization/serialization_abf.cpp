@@ -2,6 +2,8 @@
 
 #include <aeon/ptree/serialization/serialization_abf.h>
 #include <aeon/ptree/serialization/exception.h>
+#include <aeon/ptree/reflection.h>
+#include <aeon/reflection/visit_field.h>
 #include <aeon/streams/devices/memory_view_device.h>
 #include <aeon/streams/dynamic_stream.h>
 #include <aeon/streams/stream_writer.h>
@@ -9,6 +11,7 @@
 #include <aeon/streams/length_prefix_string.h>
 #include <aeon/streams/uuid_stream.h>
 #include <aeon/common/fourcc.h>
+#include <utility>
 
 namespace aeon::ptree::serialization
 {
@@ -126,6 +129,35 @@ static void to_abf(const blob &val, streams::idynamic_stream &stream)
     writer.vector_write(val);
 }
 
+template <typename T>
+static void field_to_abf(const T &value, streams::idynamic_stream &stream)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        to_abf(value, stream);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        // Written as int64, like integers in a property tree.
+        if (!std::in_range<std::int64_t>(value))
+            throw ptree_serialization_exception{};
+
+        to_abf(static_cast<std::int64_t>(value), stream);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        to_abf(static_cast<double>(value), stream);
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        to_abf(common::string{value}, stream);
+    }
+    else
+    {
+        to_abf(value, stream);
+    }
+}
+
 class abf_parser final
 {
 public:
@@ -274,6 +306,51 @@ void to_abf(const property_tree &ptree, streams::idynamic_stream &stream)
     return data;
 }
 
+void to_abf(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info,
+            streams::idynamic_stream &stream)
+{
+    internal::write_header(stream);
+
+    const auto &field_info = reflection_info.get_field_info();
+
+    streams::stream_writer writer{stream};
+    writer << internal::chunk_type_object;
+    writer << static_cast<std::uint64_t>(std::size(field_info));
+
+    for (const auto &field : field_info)
+    {
+        // Equivalent to writing a length_prefix_string, without copying the name into a string first.
+        const auto name = field.name();
+        writer << streams::varint{std::size(name)};
+        writer << name;
+
+        try
+        {
+            reflection::visit_field(field, obj,
+                                    [&stream](const auto &value) { internal::field_to_abf(value, stream); });
+        }
+        catch (const reflection::reflection_exception &)
+        {
+            throw ptree_serialization_exception{};
+        }
+    }
+}
+
+[[nodiscard]] auto to_abf(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info)
+    -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> data;
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    to_abf(obj, reflection_info, stream);
+    return data;
+}
+
+[[nodiscard]] auto from_abf(streams::idynamic_stream &stream, const reflection::reflection_info &reflection_info)
+    -> std::unique_ptr<reflection::reflection_object>
+{
+    return to_reflection_object(reflection_info, from_abf(stream));
+}
+
 void from_abf(streams::idynamic_stream &stream, property_tree &ptree, const abf_deserialize_mode mode)
 {
     internal::abf_parser parser{stream, mode};
@@ -2,6 +2,8 @@
 
 #include <aeon/ptree/serialization/serialization_json.h>
 #include <aeon/ptree/serialization/exception.h>
+#include <aeon/ptree/reflection.h>
+#include <aeon/reflection/visit_field.h>
 #include <aeon/unicode/utf_string_view.h>
 #include <aeon/unicode/stringutils.h>
 #include <aeon/streams/devices/memory_view_device.h>
@@ -11,7 +13,17 @@
 #include <aeon/common/type_traits.h>
 #include <aeon/common/lexical_parse.h>
 #include <variant>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <string_view>
+#include <algorithm>
 #include <cctype>
+#include <utility>
 
 namespace aeon::ptree::serialization
 {
@@ -125,6 +137,35 @@ static void to_json([[maybe_unused]] const blob &val, [[maybe_unused]] streams::
     throw ptree_serialization_exception{};
 }
 
+template <typename T>
+static void field_to_json(const T &value, streams::idynamic_stream &stream)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        to_json(value, stream);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        // Written as int64, like integers in a property tree.
+        if (!std::in_range<std::int64_t>(value))
+            throw ptree_serialization_exception{};
+
+        to_json(static_cast<std::int64_t>(value), stream);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        to_json(static_cast<double>(value), stream);
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        to_json(common::string{value}, stream);
+    }
+    else
+    {
+        to_json(value, stream);
+    }
+}
+
 class json_parser final
 {
 public:
@@ -166,7 +207,7 @@ public:
 private:
     void consume_whitespace() noexcept
     {
-        while ((*itr_ == ' ' || *itr_ == '\r' || *itr_ == '\n' || *itr_ == '\t') && itr_ != std::end(view_))
+        while (itr_ != std::end(view_) && (*itr_ == ' ' || *itr_ == '\r' || *itr_ == '\n' || *itr_ == '\t'))
             ++itr_;
     }
 
@@ -359,6 +400,235 @@ private:
     unicode::utf_string_view<common::string_view>::iterator prev_itr_;
 };
 
+struct json_lines_chunk final
+{
+    std::string_view view;
+    array documents;
+    std::exception_ptr error;
+};
+
+[[nodiscard]] static auto json_lines_concurrency(const json_lines_options &options) noexcept -> unsigned int
+{
+    if (options.concurrency != 0)
+        return options.concurrency;
+
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/*!
+ * Split the given view into chunks of roughly equal size, ending on a line boundary.
+ */
+[[nodiscard]] static auto split_json_lines(const std::string_view view, const json_lines_options &options)
+    -> std::vector<json_lines_chunk>
+{
+    // Create more chunks than threads so that a chunk with many large documents doesn't stall the other threads.
+    static constexpr auto chunks_per_thread = 4;
+
+    const auto chunk_count = static_cast<std::size_t>(json_lines_concurrency(options)) * chunks_per_thread;
+    const auto chunk_size = std::max(std::size(view) / chunk_count, std::max<std::size_t>(options.min_chunk_size, 1));
+
+    std::vector<json_lines_chunk> chunks;
+    chunks.reserve(std::size(view) / chunk_size + 1);
+
+    std::size_t begin = 0;
+    while (begin < std::size(view))
+    {
+        auto end = std::min(begin + chunk_size, std::size(view));
+
+        if (end < std::size(view))
+        {
+            const auto newline = view.find('\n', end);
+            end = (newline == std::string_view::npos) ? std::size(view) : newline + 1;
+        }
+
+        chunks.push_back(json_lines_chunk{view.substr(begin, end - begin), {}, {}});
+        begin = end;
+    }
+
+    return chunks;
+}
+
+template <typename func_t>
+static void parse_json_lines(const std::string_view view, func_t &&func)
+{
+    std::size_t begin = 0;
+    while (begin < std::size(view))
+    {
+        const auto newline = view.find('\n', begin);
+        const auto end = (newline == std::string_view::npos) ? std::size(view) : newline;
+        const auto line = view.substr(begin, end - begin);
+        begin = end + 1;
+
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+            continue;
+
+        json_parser parser{common::string_view{line}};
+        func(parser.parse());
+    }
+}
+
+/*!
+ * A pool of threads that parse the chunks of JSON Lines input. The threads are kept alive between batches, so that a
+ * stream that is parsed in many batches does not start new threads for every batch. Threads are only started once a
+ * batch has more than one chunk, up to the configured concurrency.
+ */
+class json_lines_worker_pool final
+{
+public:
+    explicit json_lines_worker_pool(const json_lines_options &options)
+        : options_{options}
+        , mutex_{}
+        , work_signal_{}
+        , done_signal_{}
+        , chunks_{nullptr}
+        , parse_chunk_{}
+        , next_chunk_{0}
+        , active_workers_{0}
+        , generation_{0}
+        , stop_{false}
+        , threads_{}
+    {
+    }
+
+    ~json_lines_worker_pool()
+    {
+        {
+            std::scoped_lock lock{mutex_};
+            stop_ = true;
+        }
+
+        work_signal_.notify_all();
+
+        for (auto &thread : threads_)
+            thread.join();
+    }
+
+    json_lines_worker_pool(const json_lines_worker_pool &) = delete;
+    auto operator=(const json_lines_worker_pool &) -> json_lines_worker_pool & = delete;
+
+    json_lines_worker_pool(json_lines_worker_pool &&) = delete;
+    auto operator=(json_lines_worker_pool &&) -> json_lines_worker_pool & = delete;
+
+    [[nodiscard]] auto options() const noexcept -> const json_lines_options &
+    {
+        return options_;
+    }
+
+    /*!
+     * Parse all chunks. Every thread, including the calling thread, takes the next unparsed chunk until all chunks are
+     * parsed. The first error that occurred is rethrown on the calling thread.
+     */
+    template <typename func_t>
+    void parse(std::vector<json_lines_chunk> &chunks, func_t &&func)
+    {
+        const auto thread_count =
+            std::min(static_cast<std::size_t>(json_lines_concurrency(options_)), std::size(chunks));
+
+        {
+            std::scoped_lock lock{mutex_};
+
+            while (std::size(threads_) + 1 < thread_count)
+                threads_.emplace_back([this, generation = generation_]() { thread_main(generation); });
+
+            chunks_ = &chunks;
+            parse_chunk_ = [&func](json_lines_chunk &chunk)
+            { parse_json_lines(chunk.view, [&chunk, &func](property_tree &&pt) { func(chunk, std::move(pt)); }); };
+            next_chunk_ = 0;
+            active_workers_ = std::size(threads_);
+            ++generation_;
+        }
+
+        work_signal_.notify_all();
+        work();
+
+        {
+            std::unique_lock lock{mutex_};
+            done_signal_.wait(lock, [this]() { return active_workers_ == 0; });
+            chunks_ = nullptr;
+            parse_chunk_ = nullptr;
+        }
+
+        for (const auto &chunk : chunks)
+        {
+            if (chunk.error)
+                std::rethrow_exception(chunk.error);
+        }
+    }
+
+private:
+    void thread_main(std::uint64_t generation)
+    {
+        std::unique_lock lock{mutex_};
+
+        while (true)
+        {
+            work_signal_.wait(lock, [this, generation]() { return stop_ || generation_ != generation; });
+
+            if (stop_)
+                return;
+
+            generation = generation_;
+
+            lock.unlock();
+            work();
+            lock.lock();
+
+            if (--active_workers_ == 0)
+                done_signal_.notify_one();
+        }
+    }
+
+    void work()
+    {
+        auto &chunks = *chunks_;
+
+        for (auto i = next_chunk_++; i < std::size(chunks); i = next_chunk_++)
+        {
+            auto &chunk = chunks[i];
+
+            try
+            {
+                parse_chunk_(chunk);
+            }
+            catch (...)
+            {
+                chunk.error = std::current_exception();
+            }
+        }
+    }
+
+    json_lines_options options_;
+
+    // Protects the members below, except for next_chunk_. The current batch is only changed while no thread works on
+    // it.
+    std::mutex mutex_;
+    std::condition_variable work_signal_;
+    std::condition_variable done_signal_;
+    std::vector<json_lines_chunk> *chunks_;
+    std::function<void(json_lines_chunk &)> parse_chunk_;
+    std::atomic<std::size_t> next_chunk_;
+    std::size_t active_workers_;
+    std::uint64_t generation_;
+    bool stop_;
+
+    std::vector<std::thread> threads_;
+};
+
+static void from_json_lines(const std::string_view view, json_lines_worker_pool &pool, array &documents)
+{
+    auto chunks = split_json_lines(view, pool.options());
+    pool.parse(chunks, [](json_lines_chunk &chunk, property_tree &&pt) { chunk.documents.push_back(std::move(pt)); });
+
+    std::size_t total = std::size(documents);
+    for (const auto &chunk : chunks)
+        total += std::size(chunk.documents);
+
+    documents.reserve(total);
+
+    for (auto &chunk : chunks)
+        std::move(std::begin(chunk.documents), std::end(chunk.documents), std::back_inserter(documents));
+}
+
 } // namespace internal
 
 void to_json(const property_tree &ptree, streams::idynamic_stream &stream)
@@ -374,6 +644,55 @@ void to_json(const property_tree &ptree, streams::idynamic_stream &stream)
     return str;
 }
 
+void to_json(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info,
+             streams::idynamic_stream &stream)
+{
+    streams::stream_writer writer{stream};
+    writer << '{';
+
+    bool first = true;
+
+    for (const auto &field : reflection_info.get_field_info())
+    {
+        if (first)
+            first = false;
+        else
+            writer << ',';
+
+        // Field names are C++ identifiers, so they never need to be escaped.
+        writer << '"';
+        writer << field.name();
+        writer << "\":";
+
+        try
+        {
+            reflection::visit_field(field, obj,
+                                    [&stream](const auto &value) { internal::field_to_json(value, stream); });
+        }
+        catch (const reflection::reflection_exception &)
+        {
+            throw ptree_serialization_exception{};
+        }
+    }
+
+    writer << '}';
+}
+
+[[nodiscard]] auto to_json(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info)
+    -> common::string
+{
+    common::string str;
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+    to_json(obj, reflection_info, stream);
+    return str;
+}
+
+[[nodiscard]] auto from_json(streams::idynamic_stream &stream, const reflection::reflection_info &reflection_info)
+    -> std::unique_ptr<reflection::reflection_object>
+{
+    return to_reflection_object(reflection_info, from_json(stream));
+}
+
 void from_json(streams::idynamic_stream &stream, property_tree &ptree)
 {
     streams::stream_reader reader{stream};
@@ -395,4 +714,55 @@ void from_json(streams::idynamic_stream &stream, property_tree &ptree)
     return from_json(stream);
 }
 
+auto from_json_lines(const common::string_view &str, const json_lines_options &options) -> array
+{
+    array documents;
+    internal::json_lines_worker_pool pool{options};
+    internal::from_json_lines(str.as_std_string_view(), pool, documents);
+    return documents;
+}
+
+auto from_json_lines(streams::idynamic_stream &stream, const json_lines_options &options) -> array
+{
+    array documents;
+    std::vector<char> buffer;
+    std::size_t remainder = 0;
+
+    // The same threads parse all batches.
+    internal::json_lines_worker_pool pool{options};
+
+    while (true)
+    {
+        buffer.resize(remainder + options.stream_batch_size);
+
+        const auto result = stream.read(reinterpret_cast<std::byte *>(std::data(buffer) + remainder),
+                                        static_cast<std::streamsize>(options.stream_batch_size));
+        const auto size = remainder + static_cast<std::size_t>(std::max<std::streamsize>(result, 0));
+        const std::string_view view{std::data(buffer), size};
+
+        if (result <= 0)
+        {
+            internal::from_json_lines(view, pool, documents);
+            return documents;
+        }
+
+        // Only parse up until the last complete line; the rest is moved to the front of the buffer for the next batch.
+        const auto last_newline = view.rfind('\n');
+        const auto parse_size = (last_newline == std::string_view::npos) ? 0 : last_newline + 1;
+
+        internal::from_json_lines(view.substr(0, parse_size), pool, documents);
+
+        remainder = size - parse_size;
+        std::copy(std::data(buffer) + parse_size, std::data(buffer) + size, std::data(buffer));
+    }
+}
+
+void from_json_lines_unordered(const common::string_view &str, const std::function<void(property_tree &&)> &callback,
+                               const json_lines_options &options)
+{
+    auto chunks = internal::split_json_lines(str.as_std_string_view(), options);
+    internal::json_lines_worker_pool pool{options};
+    pool.parse(chunks, [&callback](internal::json_lines_chunk &, property_tree &&pt) { callback(std::move(pt)); });
+}
+
 } // namespace aeon::ptree::serialization
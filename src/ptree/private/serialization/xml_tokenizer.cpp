@@ -0,0 +1,516 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/ptree/serialization/xml_tokenizer.h>
+#include <aeon/unicode/encoding.h>
+#include <aeon/common/from_chars.h>
+#include <aeon/common/bom.h>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+#include <bit>
+
+#if (!defined(AEON_DISABLE_SSE))
+#include <aeon/common/intrinsics.h>
+#endif
+
+namespace aeon::ptree::serialization
+{
+
+namespace internal
+{
+
+static constexpr auto cdata_begin = "<![CDATA[";
+static constexpr auto cdata_end = "]]>";
+
+static constexpr auto comment_begin = "<!--";
+static constexpr auto comment_end = "-->";
+
+static constexpr auto declaration_begin = "<?";
+static constexpr auto declaration_end = "?>";
+
+static constexpr auto dtd_begin = "<!";
+
+static constexpr auto element_closing_begin = "</";
+static constexpr auto element_self_closing_end = "/>";
+
+static constexpr auto npos = static_cast<std::size_t>(-1);
+
+[[nodiscard]] static auto is_whitespace(const int c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+[[nodiscard]] static auto is_name_char(const int c) noexcept
+{
+    // Bytes >= 0x80 are part of a multi-byte UTF-8 sequence, which are allowed in names.
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+           c == '.' || c == ':' || c >= 0x80;
+}
+
+/*!
+ * Find the first occurrence of either a or b in the range [first, last). Returns last if neither was found.
+ */
+[[nodiscard]] static auto find_first_of(const char *first, const char *last, const char a, const char b) noexcept
+    -> const char *
+{
+#if (!defined(AEON_DISABLE_SSE))
+    const auto a_mask = _mm_set1_epi8(a);
+    const auto b_mask = _mm_set1_epi8(b);
+
+    while (last - first >= 16)
+    {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        const auto matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, a_mask), _mm_cmpeq_epi8(chunk, b_mask));
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+
+        if (mask != 0)
+            return first + std::countr_zero(mask);
+
+        first += 16;
+    }
+#endif
+
+    for (; first != last; ++first)
+    {
+        if (*first == a || *first == b)
+            return first;
+    }
+
+    return last;
+}
+
+} // namespace internal
+
+xml_tokenizer::xml_tokenizer(streams::idynamic_stream &stream, const std::streamsize block_size)
+    : stream_{&stream}
+    , block_size_{block_size}
+    , buffer_(static_cast<std::size_t>(block_size))
+    , begin_{0}
+    , end_{0}
+    , consumed_{0}
+    , eof_{false}
+    , state_{state::content}
+    , token_{}
+{
+}
+
+xml_tokenizer::~xml_tokenizer() = default;
+
+auto xml_tokenizer::next() -> const xml_token &
+{
+    token_ = xml_token{};
+
+    switch (state_)
+    {
+        case state::content:
+            if (offset() == 0)
+                skip_byte_order_marker();
+
+            read_content();
+            break;
+        case state::start_tag:
+            read_tag_contents(internal::element_self_closing_end, xml_token_type::element_self_close);
+            break;
+        case state::declaration:
+            read_tag_contents(internal::declaration_end, xml_token_type::declaration_end);
+            break;
+        case state::finished:
+            break;
+    }
+
+    return token_;
+}
+
+auto xml_tokenizer::offset() const noexcept -> std::streamoff
+{
+    return consumed_ + static_cast<std::streamoff>(begin_);
+}
+
+auto xml_tokenizer::available() const noexcept -> std::size_t
+{
+    return end_ - begin_;
+}
+
+auto xml_tokenizer::cursor() const noexcept -> const char *
+{
+    return std::data(buffer_) + begin_;
+}
+
+auto xml_tokenizer::fill() -> bool
+{
+    if (eof_)
+        return false;
+
+    // Move the unconsumed data to the front of the buffer. This invalidates all views into the buffer, which is why
+    // positions are always tracked relative to the cursor while a token is being read.
+    if (begin_ > 0)
+    {
+        std::memmove(std::data(buffer_), cursor(), available());
+        consumed_ += static_cast<std::streamoff>(begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    // The token being read does not fit in the buffer; grow it.
+    if (end_ == std::size(buffer_))
+        buffer_.resize(std::size(buffer_) + static_cast<std::size_t>(block_size_));
+
+    const auto result = stream_->read(reinterpret_cast<std::byte *>(std::data(buffer_) + end_),
+                                      static_cast<std::streamsize>(std::size(buffer_) - end_));
+
+    if (result <= 0)
+    {
+        eof_ = true;
+        return false;
+    }
+
+    end_ += static_cast<std::size_t>(result);
+    return true;
+}
+
+auto xml_tokenizer::ensure(const std::size_t size) -> bool
+{
+    while (available() < size)
+    {
+        if (!fill())
+            return false;
+    }
+
+    return true;
+}
+
+auto xml_tokenizer::peek(const std::size_t index) -> int
+{
+    if (!ensure(index + 1))
+        return -1;
+
+    return static_cast<unsigned char>(cursor()[index]);
+}
+
+auto xml_tokenizer::starts_with(const common::string_view str) -> bool
+{
+    const auto size = std::size(str);
+
+    if (!ensure(size))
+        return false;
+
+    return std::memcmp(cursor(), std::data(str), size) == 0;
+}
+
+auto xml_tokenizer::find(const char delimiter, const std::size_t from, bool &found_entity) -> std::size_t
+{
+    auto index = from;
+
+    while (true)
+    {
+        const auto first = cursor() + index;
+        const auto last = cursor() + available();
+        const auto result = internal::find_first_of(first, last, delimiter, '&');
+
+        if (result != last)
+        {
+            index = static_cast<std::size_t>(result - cursor());
+
+            if (*result == delimiter)
+                return index;
+
+            found_entity = true;
+            ++index;
+            continue;
+        }
+
+        index = available();
+
+        if (!fill())
+            return internal::npos;
+    }
+}
+
+auto xml_tokenizer::find(const common::string_view delimiter, const std::size_t from) -> std::size_t
+{
+    const auto delimiter_size = std::size(delimiter);
+    auto index = from;
+
+    while (true)
+    {
+        const std::string_view view{cursor(), available()};
+        const auto result = view.find(delimiter.as_std_string_view(), index);
+
+        if (result != std::string_view::npos)
+            return result;
+
+        // The delimiter may be split over the current and the next block.
+        if (available() >= delimiter_size)
+            index = std::max(index, available() - delimiter_size + 1);
+
+        if (!fill())
+            return internal::npos;
+    }
+}
+
+auto xml_tokenizer::skip_whitespace(std::size_t index) -> std::size_t
+{
+    while (internal::is_whitespace(peek(index)))
+        ++index;
+
+    return index;
+}
+
+auto xml_tokenizer::name_length(const std::size_t from) -> std::size_t
+{
+    auto index = from;
+
+    while (internal::is_name_char(peek(index)))
+        ++index;
+
+    return index - from;
+}
+
+void xml_tokenizer::advance(const std::size_t size) noexcept
+{
+    begin_ += size;
+}
+
+void xml_tokenizer::skip_byte_order_marker()
+{
+    const auto &signature = common::bom::utf8::signature;
+    const common::string_view bom{reinterpret_cast<const char *>(std::data(signature)), std::size(signature)};
+
+    if (starts_with(bom))
+        advance(std::size(bom));
+}
+
+void xml_tokenizer::read_content()
+{
+    if (available() == 0 && !fill())
+    {
+        token_.type = xml_token_type::end_of_stream;
+        state_ = state::finished;
+        return;
+    }
+
+    if (*cursor() == '<')
+    {
+        read_markup();
+        return;
+    }
+
+    // Text extends until the next element, or until the end of the stream.
+    auto length = find('<', 0, token_.has_entities);
+
+    if (length == internal::npos)
+        length = available();
+
+    token_.type = xml_token_type::text;
+    token_.value = common::string_view{cursor(), length};
+    advance(length);
+}
+
+void xml_tokenizer::read_markup()
+{
+    if (starts_with(internal::comment_begin))
+    {
+        const auto begin_size = std::strlen(internal::comment_begin);
+        const auto end = find(internal::comment_end, begin_size);
+
+        if (end == internal::npos)
+            throw_error("Unmatched comment section.");
+
+        token_.type = xml_token_type::comment;
+        token_.value = common::string_view{cursor() + begin_size, end - begin_size};
+        advance(end + std::strlen(internal::comment_end));
+    }
+    else if (starts_with(internal::cdata_begin))
+    {
+        const auto begin_size = std::strlen(internal::cdata_begin);
+        const auto end = find(internal::cdata_end, begin_size);
+
+        if (end == internal::npos)
+            throw_error("Expected ]]>.");
+
+        token_.type = xml_token_type::cdata;
+        token_.value = common::string_view{cursor() + begin_size, end - begin_size};
+        advance(end + std::strlen(internal::cdata_end));
+    }
+    else if (starts_with(internal::dtd_begin))
+    {
+        throw_error("DTD is not yet supported.");
+    }
+    else if (starts_with(internal::element_closing_begin))
+    {
+        bool found_entity = false;
+        const auto end = find('>', 0, found_entity);
+
+        if (end == internal::npos)
+            throw_error("Expected '>'.");
+
+        const auto begin_size = std::strlen(internal::element_closing_begin);
+        const auto length = name_length(begin_size);
+
+        if (length == 0)
+            throw_error("Expected element name.");
+
+        if (skip_whitespace(begin_size + length) != end)
+            throw_error("Expected '>'.");
+
+        token_.type = xml_token_type::element_end;
+        token_.name = common::string_view{cursor() + begin_size, length};
+        advance(end + 1);
+    }
+    else if (starts_with(internal::declaration_begin))
+    {
+        const auto begin_size = std::strlen(internal::declaration_begin);
+        const auto length = name_length(begin_size);
+
+        if (length == 0)
+            throw_error("Expected declaration name.");
+
+        token_.type = xml_token_type::declaration_begin;
+        token_.name = common::string_view{cursor() + begin_size, length};
+        advance(begin_size + length);
+        state_ = state::declaration;
+    }
+    else
+    {
+        const auto length = name_length(1);
+
+        if (length == 0)
+            throw_error("Expected element name.");
+
+        token_.type = xml_token_type::element_begin;
+        token_.name = common::string_view{cursor() + 1, length};
+        advance(1 + length);
+        state_ = state::start_tag;
+    }
+}
+
+void xml_tokenizer::read_tag_contents(const common::string_view end, const xml_token_type end_type)
+{
+    advance(skip_whitespace(0));
+
+    if (available() == 0)
+        throw_error("Unexpected end of stream.");
+
+    if (starts_with(end))
+    {
+        token_.type = end_type;
+        advance(std::size(end));
+        state_ = state::content;
+        return;
+    }
+
+    if (state_ == state::start_tag && *cursor() == '>')
+    {
+        token_.type = xml_token_type::element_open_end;
+        advance(1);
+        state_ = state::content;
+        return;
+    }
+
+    read_attribute();
+}
+
+void xml_tokenizer::read_attribute()
+{
+    const auto length = name_length(0);
+
+    if (length == 0)
+        throw_error("Expected attribute name.");
+
+    auto index = skip_whitespace(length);
+
+    if (peek(index) != '=')
+        throw_error("Expected '='.");
+
+    index = skip_whitespace(index + 1);
+
+    const auto quote = peek(index);
+
+    if (quote != '"' && quote != '\'')
+        throw_error("Expected '\"'.");
+
+    const auto value_begin = index + 1;
+    const auto value_end = find(static_cast<char>(quote), value_begin, token_.has_entities);
+
+    if (value_end == internal::npos)
+        throw_error("Expected value closed by '\"'.");
+
+    // All positions are known now, and the buffer will not be modified anymore until the next token is read.
+    token_.type = xml_token_type::attribute;
+    token_.name = common::string_view{cursor(), length};
+    token_.value = common::string_view{cursor() + value_begin, value_end - value_begin};
+    advance(value_end + 1);
+}
+
+void xml_tokenizer::throw_error(const char *message) const
+{
+    throw xml_tokenizer_exception{message, offset()};
+}
+
+auto xml_unescape(const common::string_view &str) -> common::string
+{
+    const auto view = str.as_std_string_view();
+
+    common::string result;
+    result.reserve(std::size(view));
+
+    std::size_t index = 0;
+    while (index < std::size(view))
+    {
+        const auto entity_begin = view.find('&', index);
+
+        if (entity_begin == std::string_view::npos)
+        {
+            result.append(std::data(view) + index, std::size(view) - index);
+            break;
+        }
+
+        result.append(std::data(view) + index, entity_begin - index);
+
+        const auto entity_end = view.find(';', entity_begin);
+
+        // Not a valid entity reference; keep the text as-is.
+        if (entity_end == std::string_view::npos)
+        {
+            result.append(std::data(view) + entity_begin, std::size(view) - entity_begin);
+            break;
+        }
+
+        const auto entity = view.substr(entity_begin + 1, entity_end - entity_begin - 1);
+
+        if (entity == "lt")
+            result.append("<");
+        else if (entity == "gt")
+            result.append(">");
+        else if (entity == "amp")
+            result.append("&");
+        else if (entity == "quot")
+            result.append("\"");
+        else if (entity == "apos")
+            result.append("'");
+        else if (std::size(entity) > 1 && entity[0] == '#')
+        {
+            const auto is_hex = entity[1] == 'x' || entity[1] == 'X';
+            const auto digits = entity.substr(is_hex ? 2 : 1);
+
+            std::uint32_t codepoint = 0;
+            const auto [ptr, ec] = common::from_chars(std::data(digits), std::data(digits) + std::size(digits),
+                                                      codepoint, is_hex ? 16 : 10);
+
+            if (ec == std::errc{} && ptr == std::data(digits) + std::size(digits))
+                result.append(unicode::utf32::to_utf8(static_cast<char32_t>(codepoint)));
+            else
+                result.append(std::data(view) + entity_begin, entity_end - entity_begin + 1);
+        }
+        else
+        {
+            result.append(std::data(view) + entity_begin, entity_end - entity_begin + 1);
+        }
+
+        index = entity_end + 1;
+    }
+
+    return result;
+}
+
+} // namespace aeon::ptree::serialization
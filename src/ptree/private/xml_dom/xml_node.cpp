@@ -7,6 +7,41 @@
 namespace aeon::ptree::xml_dom
 {
 
+namespace internal
+{
+
+[[nodiscard]] static auto find_attributes(const property_tree *pt, const common::string &attribute_placeholder) noexcept
+    -> const object *
+{
+    if (!pt || !pt->is_array())
+        return nullptr;
+
+    for (const auto &pt_child : pt->array_value())
+    {
+        if (!pt_child.is_object())
+            continue;
+
+        const auto &pt_object = pt_child.object_value();
+
+        if (std::size(pt_object) != 1)
+            continue;
+
+        const auto &[name, pt_attrib_value] = *pt_object.begin();
+
+        if (!pt_attrib_value.is_object())
+            continue;
+
+        if (name != attribute_placeholder)
+            continue;
+
+        return &pt_attrib_value.object_value();
+    }
+
+    return nullptr;
+}
+
+} // namespace internal
+
 xml_node::~xml_node() noexcept = default;
 
 xml_node::xml_node(const xml_node &) noexcept = default;
@@ -131,43 +166,51 @@ auto xml_node::attributes() const -> std::map<common::string, variant::convertin
     if (type_ != xml_node_type::element)
         return {};
 
-    if (!pt_ || !pt_->is_array())
+    const auto pt_attributes = internal::find_attributes(pt_, document_->attribute_placeholder());
+
+    if (!pt_attributes)
         return {};
 
-    const auto &pt_children = pt_->array_value();
-    for (const auto &pt_child : pt_children)
+    std::map<common::string, variant::converting_variant> attributes;
+    for (const auto &[key, value] : *pt_attributes)
     {
-        if (pt_child.is_object())
-        {
-            const auto &pt_object = pt_child.object_value();
+        if (!value.is_string())
+            throw xml_dom_exception{};
 
-            if (std::size(pt_object) != 1)
-                continue;
+        attributes.emplace(key, value.string_value());
+    }
 
-            const auto &[name, pt_attrib_value] = *pt_object.begin();
+    return attributes;
+}
 
-            if (!pt_attrib_value.is_object())
-                continue;
+auto xml_node::children_range(const common::string_view child_name) const noexcept -> xml_node_range
+{
+    if (type_ != xml_node_type::document && type_ != xml_node_type::element)
+        return {};
 
-            if (name != document_->attribute_placeholder())
-                continue;
+    if (!pt_ || !pt_->is_array())
+        return {};
 
-            const auto &pt_attributes = pt_attrib_value.object_value();
+    const auto &pt_children = pt_->array_value();
+    const auto begin = std::data(pt_children);
+    const auto end = begin + std::size(pt_children);
 
-            std::map<common::string, variant::converting_variant> attributes;
-            for (const auto &[key, value] : pt_attributes)
-            {
-                if (!value.is_string())
-                    throw xml_dom_exception{};
+    return xml_node_range{xml_node_iterator{*document_, begin, end, child_name},
+                          xml_node_iterator{*document_, end, end, child_name}};
+}
 
-                attributes.emplace(key, value.string_value());
-            }
+auto xml_node::attributes_range() const noexcept -> xml_attribute_range
+{
+    if (type_ != xml_node_type::element)
+        return {};
 
-            return attributes;
-        }
-    }
+    const auto pt_attributes = internal::find_attributes(pt_, document_->attribute_placeholder());
+
+    if (!pt_attributes)
+        return {};
 
-    return {};
+    return xml_attribute_range{xml_attribute_iterator{pt_attributes->begin()},
+                               xml_attribute_iterator{pt_attributes->end()}};
 }
 
 auto xml_node::value_impl() const -> const common::string &
@@ -203,4 +246,83 @@ xml_node::xml_node(const xml_document &document, const property_tree &pt, const
 {
 }
 
+xml_node_iterator::xml_node_iterator() noexcept
+    : document_{nullptr}
+    , current_{nullptr}
+    , end_{nullptr}
+    , child_name_{}
+{
+}
+
+xml_node_iterator::xml_node_iterator(const xml_document &document, const property_tree *current,
+                                     const property_tree *end, const common::string_view child_name) noexcept
+    : document_{&document}
+    , current_{current}
+    , end_{end}
+    , child_name_{child_name}
+{
+    skip_unmatched();
+}
+
+auto xml_node_iterator::operator*() const noexcept -> xml_node
+{
+    if (current_->is_string())
+        return xml_node{*document_, *current_, xml_node_type::text};
+
+    const auto &[name, value] = *current_->object_value().begin();
+    return xml_node{*document_, value, name, xml_node_type::element};
+}
+
+auto xml_node_iterator::operator++() noexcept -> xml_node_iterator &
+{
+    ++current_;
+    skip_unmatched();
+    return *this;
+}
+
+auto xml_node_iterator::operator++(int) noexcept -> xml_node_iterator
+{
+    auto itr = *this;
+    ++(*this);
+    return itr;
+}
+
+auto xml_node_iterator::operator==(const xml_node_iterator &other) const noexcept -> bool
+{
+    return current_ == other.current_;
+}
+
+void xml_node_iterator::skip_unmatched() noexcept
+{
+    for (; current_ != end_; ++current_)
+    {
+        if (std::empty(child_name_) && current_->is_string())
+            return;
+
+        if (!current_->is_object())
+            continue;
+
+        const auto &pt_object = current_->object_value();
+
+        if (std::size(pt_object) != 1)
+            continue;
+
+        const auto &name = pt_object.begin()->first;
+
+        if (name == document_->attribute_placeholder())
+            continue;
+
+        if (std::empty(child_name_) || name == child_name_)
+            return;
+    }
+}
+
+auto xml_attribute::value_impl() const -> const common::string &
+{
+    if (!value_->is_string())
+        throw xml_dom_exception{};
+
+    return value_->string_value();
+}
+
 } // namespace aeon::ptree::xml_dom
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <aeon/ptree/ptree.h>
+#include <aeon/reflection/reflection_info.h>
+#include <aeon/reflection/reflection_object.h>
 #include <aeon/streams/idynamic_stream.h>
 
 namespace aeon::ptree::serialization
@@ -22,4 +24,19 @@ void from_abf(streams::idynamic_stream &stream, property_tree &ptree,
 [[nodiscard]] auto from_abf(streams::idynamic_stream &stream,
                             const abf_deserialize_mode mode = abf_deserialize_mode::all) -> property_tree;
 
+/*!
+ * Serialize a reflection object directly to ABF, without creating an intermediate ptree. The output is identical to
+ * to_abf(from_reflection_object(obj, reflection_info)).
+ */
+void to_abf(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info,
+            streams::idynamic_stream &stream);
+[[nodiscard]] auto to_abf(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info)
+    -> std::vector<std::uint8_t>;
+
+/*!
+ * Deserialize ABF into a new instance of the given reflected class.
+ */
+[[nodiscard]] auto from_abf(streams::idynamic_stream &stream, const reflection::reflection_info &reflection_info)
+    -> std::unique_ptr<reflection::reflection_object>;
+
 } // namespace aeon::ptree::serialization
@@ -3,7 +3,12 @@
 #pragma once
 
 #include <aeon/ptree/ptree.h>
+#include <aeon/reflection/reflection_info.h>
+#include <aeon/reflection/reflection_object.h>
 #include <aeon/streams/idynamic_stream.h>
+#include <aeon/common/string_view.h>
+#include <functional>
+#include <cstddef>
 
 namespace aeon::ptree::serialization
 {
@@ -33,4 +38,62 @@ void from_json(streams::idynamic_stream &stream, property_tree &ptree);
  */
 [[nodiscard]] auto from_json(const common::string &str) -> property_tree;
 
+/*!
+ * Serialize a reflection object directly to json, without creating an intermediate ptree. The output is identical to
+ * to_json(from_reflection_object(obj, reflection_info)).
+ */
+void to_json(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info,
+             streams::idynamic_stream &stream);
+
+/*!
+ * Serialize a reflection object directly to json, without creating an intermediate ptree.
+ */
+[[nodiscard]] auto to_json(const reflection::reflection_object &obj, const reflection::reflection_info &reflection_info)
+    -> common::string;
+
+/*!
+ * Deserialize json into a new instance of the given reflected class.
+ */
+[[nodiscard]] auto from_json(streams::idynamic_stream &stream, const reflection::reflection_info &reflection_info)
+    -> std::unique_ptr<reflection::reflection_object>;
+
+struct json_lines_options final
+{
+    /*!
+     * The amount of threads used for parsing, including the calling thread. 0 means std::thread::hardware_concurrency.
+     */
+    unsigned int concurrency = 0;
+
+    /*!
+     * The minimum amount of bytes handed to a single worker. Input smaller than this is parsed on the calling thread.
+     */
+    std::size_t min_chunk_size = 256 * 1024;
+
+    /*!
+     * The amount of bytes read from a stream and parsed at once. Only used when parsing from a stream.
+     */
+    std::size_t stream_batch_size = 64 * 1024 * 1024;
+};
+
+/*!
+ * Deserialize JSON Lines (NDJSON); one JSON document per line. The input is split on line boundaries into chunks which
+ * are parsed in parallel; every chunk is parsed into its own array so that workers never share state. The returned
+ * array contains the documents in the order in which they appear in the input. Empty lines are skipped.
+ */
+[[nodiscard]] auto from_json_lines(const common::string_view &str, const json_lines_options &options = {}) -> array;
+
+/*!
+ * Deserialize JSON Lines (NDJSON) from a stream. The stream is read in batches of options.stream_batch_size bytes,
+ * which are split on line boundaries and parsed in parallel. The returned array contains the documents in order.
+ */
+[[nodiscard]] auto from_json_lines(streams::idynamic_stream &stream, const json_lines_options &options = {}) -> array;
+
+/*!
+ * Deserialize JSON Lines (NDJSON) without preserving order. The callback is invoked concurrently from all parsing
+ * threads as soon as a document is parsed, in no particular order, so it must be thread safe. This avoids holding all
+ * documents in memory at once.
+ */
+void from_json_lines_unordered(const common::string_view &str, const std::function<void(property_tree &&)> &callback,
+                               const json_lines_options &options = {});
+
 } // namespace aeon::ptree::serialization
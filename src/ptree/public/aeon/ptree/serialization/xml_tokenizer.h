@@ -0,0 +1,151 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/ptree/serialization/exception.h>
+#include <aeon/streams/idynamic_stream.h>
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <cstddef>
+
+namespace aeon::ptree::serialization
+{
+
+class xml_tokenizer_exception final : public ptree_serialization_exception
+{
+public:
+    explicit xml_tokenizer_exception(common::string message, const std::streamoff offset)
+        : message_{std::move(message)}
+        , offset_{offset}
+    {
+    }
+
+    [[nodiscard]] const auto &message() const noexcept
+    {
+        return message_;
+    }
+
+    /*!
+     * The byte offset in the input stream at which the error was detected.
+     */
+    [[nodiscard]] auto offset() const noexcept
+    {
+        return offset_;
+    }
+
+private:
+    common::string message_;
+    std::streamoff offset_;
+};
+
+enum class xml_token_type
+{
+    end_of_stream,      // No more tokens are available.
+    declaration_begin,  // <?name (name is "xml" for the xml header). Zero or more attributes follow.
+    declaration_end,    // ?>
+    element_begin,      // <name. Zero or more attributes follow.
+    attribute,          // name="value". Only occurs after declaration_begin or element_begin.
+    element_open_end,   // > at the end of a start tag. The children of the element follow.
+    element_self_close, // /> at the end of a start tag. The element has no children.
+    element_end,        // </name>
+    text,               // Text between elements. Not trimmed; whitespace between elements is also reported.
+    cdata,              // The contents of <![CDATA[ ]]>
+    comment             // The contents of <!-- -->
+};
+
+struct xml_token final
+{
+    xml_token_type type = xml_token_type::end_of_stream;
+
+    // The element, declaration or attribute name.
+    common::string_view name;
+
+    // The text, cdata or comment contents, or the attribute value (without quotes). Entities are not decoded.
+    common::string_view value;
+
+    // True if value contains one or more '&' characters and may need to be decoded through xml_unescape.
+    bool has_entities = false;
+};
+
+/*!
+ * Incremental, pull-based XML tokenizer. Data is read from the given stream in blocks, so that large XML documents can
+ * be processed in bounded memory; the internal buffer only grows beyond the block size when a single token does not
+ * fit into it.
+ *
+ * A UTF-8 byte order marker at the start of the stream is skipped.
+ *
+ * The views in the returned token point into the internal buffer and are only valid until the next call to next().
+ */
+class xml_tokenizer final
+{
+public:
+    static constexpr std::streamsize default_block_size = 64 * 1024;
+
+    explicit xml_tokenizer(streams::idynamic_stream &stream, const std::streamsize block_size = default_block_size);
+    ~xml_tokenizer();
+
+    xml_tokenizer(const xml_tokenizer &) = delete;
+    auto operator=(const xml_tokenizer &) -> xml_tokenizer & = delete;
+
+    xml_tokenizer(xml_tokenizer &&) noexcept = default;
+    auto operator=(xml_tokenizer &&) noexcept -> xml_tokenizer & = default;
+
+    /*!
+     * Read the next token from the stream. Throws xml_tokenizer_exception on malformed input.
+     */
+    [[nodiscard]] auto next() -> const xml_token &;
+
+    /*!
+     * The current byte offset in the input stream.
+     */
+    [[nodiscard]] auto offset() const noexcept -> std::streamoff;
+
+private:
+    enum class state
+    {
+        content,     // Between elements
+        start_tag,   // Inside <element ...
+        declaration, // Inside <?name ...
+        finished
+    };
+
+    [[nodiscard]] auto available() const noexcept -> std::size_t;
+    [[nodiscard]] auto cursor() const noexcept -> const char *;
+
+    auto fill() -> bool;
+    auto ensure(const std::size_t size) -> bool;
+    [[nodiscard]] auto peek(const std::size_t index) -> int;
+    [[nodiscard]] auto starts_with(const common::string_view str) -> bool;
+    [[nodiscard]] auto find(const char delimiter, const std::size_t from, bool &found_entity) -> std::size_t;
+    [[nodiscard]] auto find(const common::string_view delimiter, const std::size_t from) -> std::size_t;
+    [[nodiscard]] auto skip_whitespace(std::size_t index) -> std::size_t;
+    [[nodiscard]] auto name_length(const std::size_t from) -> std::size_t;
+    void advance(const std::size_t size) noexcept;
+    void skip_byte_order_marker();
+
+    void read_content();
+    void read_markup();
+    void read_tag_contents(const common::string_view end, const xml_token_type end_type);
+    void read_attribute();
+
+    [[noreturn]] void throw_error(const char *message) const;
+
+    streams::idynamic_stream *stream_;
+    std::streamsize block_size_;
+    std::vector<char> buffer_;
+    std::size_t begin_;
+    std::size_t end_;
+    std::streamoff consumed_;
+    bool eof_;
+    state state_;
+    xml_token token_;
+};
+
+/*!
+ * Decode the predefined XML entities (&lt; &gt; &amp; &quot; &apos;) and numeric character references (&#N; &#xN;) in
+ * the given string.
+ */
+[[nodiscard]] auto xml_unescape(const common::string_view &str) -> common::string;
+
+} // namespace aeon::ptree::serialization
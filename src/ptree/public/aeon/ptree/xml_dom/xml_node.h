@@ -6,6 +6,7 @@
 #include <aeon/variant/converting_variant.h>
 #include <vector>
 #include <map>
+#include <iterator>
 #include <type_traits>
 
 namespace aeon::ptree::xml_dom
@@ -21,6 +22,8 @@ enum class xml_node_type
 };
 
 class xml_document;
+class xml_node_range;
+class xml_attribute_range;
 
 class xml_node
 {
@@ -70,6 +73,17 @@ public:
 
     [[nodiscard]] auto attributes() const -> std::map<common::string, variant::converting_variant>;
 
+    /*!
+     * Iterate over the children of this node without allocating. The given name must outlive the returned range.
+     * Pass an empty name to iterate over all children, including text nodes.
+     */
+    [[nodiscard]] auto children_range(const common::string_view child_name = "") const noexcept -> xml_node_range;
+
+    /*!
+     * Iterate over the attributes of this node without allocating.
+     */
+    [[nodiscard]] auto attributes_range() const noexcept -> xml_attribute_range;
+
 protected:
     explicit xml_node(const xml_document &document) noexcept;
     explicit xml_node(const xml_document &document, const property_tree &pt, const xml_node_type type) noexcept;
@@ -79,10 +93,180 @@ protected:
     [[nodiscard]] auto value_impl() const -> const common::string &;
 
 private:
+    friend class xml_node_iterator;
+
     const xml_document *document_;
     const property_tree *pt_;
     const common::string *name_;
     xml_node_type type_;
 };
 
+class xml_node_iterator final
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = xml_node;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = xml_node;
+
+    xml_node_iterator() noexcept;
+    explicit xml_node_iterator(const xml_document &document, const property_tree *current, const property_tree *end,
+                               const common::string_view child_name) noexcept;
+
+    [[nodiscard]] auto operator*() const noexcept -> xml_node;
+
+    auto operator++() noexcept -> xml_node_iterator &;
+    auto operator++(int) noexcept -> xml_node_iterator;
+
+    [[nodiscard]] auto operator==(const xml_node_iterator &other) const noexcept -> bool;
+
+private:
+    void skip_unmatched() noexcept;
+
+    const xml_document *document_;
+    const property_tree *current_;
+    const property_tree *end_;
+    common::string_view child_name_;
+};
+
+class xml_node_range final
+{
+public:
+    xml_node_range() noexcept = default;
+    explicit xml_node_range(const xml_node_iterator begin, const xml_node_iterator end) noexcept
+        : begin_{begin}
+        , end_{end}
+    {
+    }
+
+    [[nodiscard]] auto begin() const noexcept
+    {
+        return begin_;
+    }
+
+    [[nodiscard]] auto end() const noexcept
+    {
+        return end_;
+    }
+
+    [[nodiscard]] auto empty() const noexcept
+    {
+        return begin_ == end_;
+    }
+
+private:
+    xml_node_iterator begin_;
+    xml_node_iterator end_;
+};
+
+class xml_attribute final
+{
+public:
+    explicit xml_attribute(const common::string &name, const property_tree &value) noexcept
+        : name_{&name}
+        , value_{&value}
+    {
+    }
+
+    [[nodiscard]] auto name() const noexcept -> const common::string &
+    {
+        return *name_;
+    }
+
+    template <typename T = common::string>
+    [[nodiscard]] auto value() const
+    {
+        if constexpr (std::is_same_v<T, common::string>)
+        {
+            return value_impl();
+        }
+        else
+        {
+            variant::converting_variant value{value_impl()};
+            return value.get_value<T>();
+        }
+    }
+
+private:
+    [[nodiscard]] auto value_impl() const -> const common::string &;
+
+    const common::string *name_;
+    const property_tree *value_;
+};
+
+class xml_attribute_iterator final
+{
+public:
+    using object_iterator = decltype(std::declval<const object &>().begin());
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = xml_attribute;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = xml_attribute;
+
+    xml_attribute_iterator() noexcept = default;
+    explicit xml_attribute_iterator(const object_iterator itr) noexcept
+        : itr_{itr}
+    {
+    }
+
+    [[nodiscard]] auto operator*() const noexcept
+    {
+        return xml_attribute{itr_->first, itr_->second};
+    }
+
+    auto operator++() noexcept -> xml_attribute_iterator &
+    {
+        ++itr_;
+        return *this;
+    }
+
+    auto operator++(int) noexcept -> xml_attribute_iterator
+    {
+        auto itr = *this;
+        ++itr_;
+        return itr;
+    }
+
+    [[nodiscard]] auto operator==(const xml_attribute_iterator &other) const noexcept -> bool
+    {
+        return itr_ == other.itr_;
+    }
+
+private:
+    object_iterator itr_;
+};
+
+class xml_attribute_range final
+{
+public:
+    xml_attribute_range() noexcept = default;
+    explicit xml_attribute_range(const xml_attribute_iterator begin, const xml_attribute_iterator end) noexcept
+        : begin_{begin}
+        , end_{end}
+    {
+    }
+
+    [[nodiscard]] auto begin() const noexcept
+    {
+        return begin_;
+    }
+
+    [[nodiscard]] auto end() const noexcept
+    {
+        return end_;
+    }
+
+    [[nodiscard]] auto empty() const noexcept
+    {
+        return begin_ == end_;
+    }
+
+private:
+    xml_attribute_iterator begin_;
+    xml_attribute_iterator end_;
+};
+
 } // namespace aeon::ptree::xml_dom
@@ -0,0 +1,143 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/ptree/ptree.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+#include <aeon/ptree/serialization/exception.h>
+#include <aeon/streams/devices/memory_view_device.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+
+using namespace aeon;
+
+namespace internal
+{
+
+[[nodiscard]] static auto make_json_lines(const int count) -> common::string
+{
+    common::string str;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const ptree::property_tree pt{ptree::object{{"id", i}, {"name", "record"}, {"values", ptree::array{1, 2, 3}}}};
+        str += ptree::serialization::to_json(pt);
+        str += "\n";
+    }
+
+    return str;
+}
+
+} // namespace internal
+
+TEST(test_ptree, json_lines_parse_in_order)
+{
+    const auto str = internal::make_json_lines(1000);
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 4;
+    options.min_chunk_size = 128;
+
+    const auto documents = ptree::serialization::from_json_lines(str, options);
+    ASSERT_EQ(1000u, std::size(documents));
+
+    for (std::size_t i = 0; i < std::size(documents); ++i)
+        EXPECT_EQ(static_cast<std::int64_t>(i), documents[i].at("id").integer_value());
+}
+
+TEST(test_ptree, json_lines_skips_empty_lines_and_handles_missing_newline)
+{
+    const common::string str = "{\"a\":1}\r\n\n   \n[1,2]\r\n\"last\"";
+    const auto documents = ptree::serialization::from_json_lines(str);
+
+    ASSERT_EQ(3u, std::size(documents));
+    EXPECT_EQ(1, documents[0].at("a"));
+    EXPECT_EQ((ptree::array{1, 2}), documents[1]);
+    EXPECT_EQ("last", documents[2]);
+}
+
+TEST(test_ptree, json_lines_parse_from_stream_in_batches)
+{
+    const auto str = internal::make_json_lines(500);
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 3;
+    options.min_chunk_size = 64;
+    options.stream_batch_size = 100; // Smaller than a single line
+
+    const auto documents = ptree::serialization::from_json_lines(stream, options);
+    ASSERT_EQ(500u, std::size(documents));
+
+    for (std::size_t i = 0; i < std::size(documents); ++i)
+        EXPECT_EQ(static_cast<std::int64_t>(i), documents[i].at("id").integer_value());
+}
+
+TEST(test_ptree, json_lines_parse_from_stream_in_parallel_batches)
+{
+    const auto str = internal::make_json_lines(2000);
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 4;
+    options.min_chunk_size = 64;
+    options.stream_batch_size = 4096; // Many batches, each split over all threads
+
+    const auto documents = ptree::serialization::from_json_lines(stream, options);
+    ASSERT_EQ(2000u, std::size(documents));
+
+    for (std::size_t i = 0; i < std::size(documents); ++i)
+        EXPECT_EQ(static_cast<std::int64_t>(i), documents[i].at("id").integer_value());
+}
+
+TEST(test_ptree, json_lines_parse_error_in_later_stream_batch_is_rethrown)
+{
+    auto str = internal::make_json_lines(1000);
+    str += "{\"b\":\n";
+    str += internal::make_json_lines(10);
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 4;
+    options.min_chunk_size = 64;
+    options.stream_batch_size = 4096;
+
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::serialization::from_json_lines(stream, options),
+                 ptree::serialization::ptree_serialization_exception);
+}
+
+TEST(test_ptree, json_lines_parse_unordered)
+{
+    const auto str = internal::make_json_lines(1000);
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 4;
+    options.min_chunk_size = 128;
+
+    std::mutex mutex;
+    std::vector<bool> seen(1000);
+
+    ptree::serialization::from_json_lines_unordered(
+        str,
+        [&mutex, &seen](ptree::property_tree &&pt)
+        {
+            std::scoped_lock lock{mutex};
+            seen.at(static_cast<std::size_t>(pt.at("id").integer_value())) = true;
+        },
+        options);
+
+    EXPECT_TRUE(std::all_of(std::begin(seen), std::end(seen), [](const bool v) { return v; }));
+}
+
+TEST(test_ptree, json_lines_parse_error_is_rethrown)
+{
+    const common::string str = "{\"a\":1}\n{\"b\":\n{\"c\":3}\n";
+
+    ptree::serialization::json_lines_options options;
+    options.concurrency = 2;
+    options.min_chunk_size = 1;
+
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::serialization::from_json_lines(str, options),
+                 ptree::serialization::ptree_serialization_exception);
+}
@@ -1,9 +1,15 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/ptree/reflection.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+#include <aeon/ptree/serialization/serialization_abf.h>
+#include <aeon/ptree/serialization/exception.h>
 #include <aeon/reflection/reflection.h>
+#include <aeon/streams/devices/memory_view_device.h>
+#include <aeon/streams/dynamic_stream.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <limits>
 
 using namespace aeon;
 
@@ -89,3 +95,228 @@ TEST(test_ptree, ptree_from_reflection_object2)
 
     EXPECT_EQ(test_class_pt, pt);
 }
+
+class test_class_all_types final : public reflection::reflection_object
+{
+    AEON_REFLECTION_BEGIN(test_class_all_types)
+    AEON_REFLECTION_FIELD(bool, bool_value)
+    AEON_REFLECTION_FIELD(int, int_value)
+    AEON_REFLECTION_FIELD(std::uint16_t, uint16_value)
+    AEON_REFLECTION_FIELD(float, float_value)
+    AEON_REFLECTION_FIELD(std::string, std_string_value)
+    AEON_REFLECTION_FIELD(aeon::common::string, string_value)
+    AEON_REFLECTION_END()
+
+public:
+    bool bool_value = false;
+    int int_value = 0;
+    std::uint16_t uint16_value = 0;
+    float float_value = 0.0f;
+    std::string std_string_value;
+    common::string string_value;
+};
+
+TEST(test_ptree, ptree_reflection_object_all_types_roundtrip)
+{
+    test_class_all_types test;
+    test.bool_value = true;
+    test.int_value = -12;
+    test.uint16_value = 1234;
+    test.float_value = 1.5f;
+    test.std_string_value = "std";
+    test.string_value = "aeon";
+
+    const auto pt = ptree::from_reflection_object(test, test_class_all_types::reflection_info());
+    EXPECT_EQ(true, pt.at("bool_value").bool_value());
+    EXPECT_EQ(-12, pt.at("int_value").integer_value());
+    EXPECT_EQ(1234, pt.at("uint16_value").integer_value());
+    EXPECT_EQ(1.5, pt.at("float_value").double_value());
+    EXPECT_EQ("std", pt.at("std_string_value").string_value());
+
+    const auto result = ptree::to_reflection_object<test_class_all_types>(pt);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(test.bool_value, result->bool_value);
+    EXPECT_EQ(test.int_value, result->int_value);
+    EXPECT_EQ(test.uint16_value, result->uint16_value);
+    EXPECT_EQ(test.float_value, result->float_value);
+    EXPECT_EQ(test.std_string_value, result->std_string_value);
+    EXPECT_EQ(test.string_value, result->string_value);
+}
+
+TEST(test_ptree, ptree_to_reflection_object_wrong_type_throws)
+{
+    const ptree::property_tree pt{ptree::object{{"integer_value", "not an integer"}}};
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::to_reflection_object<test_class>(pt),
+                 ptree::ptree_exception);
+}
+
+class test_class_unsigned final : public reflection::reflection_object
+{
+    AEON_REFLECTION_BEGIN(test_class_unsigned)
+    AEON_REFLECTION_FIELD(std::uint8_t, uint8_value)
+    AEON_REFLECTION_FIELD(std::uint64_t, uint64_value)
+    AEON_REFLECTION_END()
+
+public:
+    std::uint8_t uint8_value = 0;
+    std::uint64_t uint64_value = 0;
+};
+
+TEST(test_ptree, ptree_reflection_object_out_of_range_throws)
+{
+    test_class_unsigned test;
+    test.uint8_value = 255;
+    test.uint64_value = std::numeric_limits<std::int64_t>::max();
+
+    const auto pt = ptree::from_reflection_object(test, test_class_unsigned::reflection_info());
+    EXPECT_EQ(std::numeric_limits<std::int64_t>::max(), pt.at("uint64_value").integer_value());
+
+    // Integers are stored as int64, so larger unsigned values can not be represented.
+    test.uint64_value = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1;
+    EXPECT_THROW([[maybe_unused]] const auto result =
+                     ptree::from_reflection_object(test, test_class_unsigned::reflection_info()),
+                 ptree::ptree_exception);
+    EXPECT_THROW([[maybe_unused]] const auto result =
+                     ptree::serialization::to_json(test, test_class_unsigned::reflection_info()),
+                 ptree::serialization::ptree_serialization_exception);
+    EXPECT_THROW([[maybe_unused]] const auto result =
+                     ptree::serialization::to_abf(test, test_class_unsigned::reflection_info()),
+                 ptree::serialization::ptree_serialization_exception);
+
+    // Values that do not fit in the field are not truncated.
+    for (const auto value : {256, -1})
+    {
+        const ptree::property_tree out_of_range{ptree::object{{"uint8_value", value}}};
+        EXPECT_THROW([[maybe_unused]] const auto result =
+                         ptree::to_reflection_object<test_class_unsigned>(out_of_range),
+                     ptree::ptree_exception);
+    }
+
+    const ptree::property_tree negative{ptree::object{{"uint64_value", -1}}};
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::to_reflection_object<test_class_unsigned>(negative),
+                 ptree::ptree_exception);
+}
+
+TEST(test_ptree, ptree_reflection_object_to_json_matches_ptree)
+{
+    test_class_all_types test;
+    test.bool_value = true;
+    test.int_value = 42;
+    test.float_value = 2.0f;
+    test.std_string_value = "Hello\tWorld";
+    test.string_value = "aeon";
+
+    const auto expected =
+        ptree::serialization::to_json(ptree::from_reflection_object(test, test_class_all_types::reflection_info()));
+    const auto str = ptree::serialization::to_json(test, test_class_all_types::reflection_info());
+    EXPECT_EQ(expected, str);
+
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+    const auto result = common::dynamic_unique_ptr_cast<test_class_all_types>(
+        ptree::serialization::from_json(stream, test_class_all_types::reflection_info()));
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(42, result->int_value);
+    EXPECT_EQ("Hello\tWorld", result->std_string_value);
+}
+
+TEST(test_ptree, ptree_reflection_object_to_abf_matches_ptree)
+{
+    test_class test;
+    test.base_integer_value = 42;
+    test.integer_value = 3;
+    test.double_value = 2.0;
+    test.string_value = "Hello";
+    test.blob_value = {0x10, 0x20, 0x30};
+
+    const auto expected =
+        ptree::serialization::to_abf(ptree::from_reflection_object(test, test_class::reflection_info()));
+    auto data = ptree::serialization::to_abf(test, test_class::reflection_info());
+    EXPECT_EQ(expected, data);
+
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{data});
+    const auto result = common::dynamic_unique_ptr_cast<test_class>(
+        ptree::serialization::from_abf(stream, test_class::reflection_info()));
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(test.blob_value, result->blob_value);
+    EXPECT_EQ(test.string_value, result->string_value);
+}
+
+namespace internal
+{
+
+class handwritten_class final : public reflection::reflection_object
+{
+public:
+    int int_value = 0;
+    float float_value = 0.0f;
+    std::int64_t int64_value = 0;
+    common::string string_value;
+};
+
+template <typename T>
+[[nodiscard]] static auto offset_of(const handwritten_class &instance, const T &member) -> std::ptrdiff_t
+{
+    return reinterpret_cast<const std::uint8_t *>(&member) - reinterpret_cast<const std::uint8_t *>(&instance);
+}
+
+/*!
+ * A reflection_info implemented by hand, with fields that only have a type name.
+ */
+class handwritten_reflection_info final : public reflection::reflection_info
+{
+public:
+    [[nodiscard]] auto create() const -> std::unique_ptr<reflection::reflection_object> override
+    {
+        return std::make_unique<handwritten_class>();
+    }
+
+    [[nodiscard]] auto get_field_info() const noexcept -> const std::vector<reflection::field_info> & override
+    {
+        static const handwritten_class instance;
+        static const std::vector<reflection::field_info> info{
+            {"int_value", "int", offset_of(instance, instance.int_value)},
+            {"float_value", "float", offset_of(instance, instance.float_value)},
+            {"int64_value", "std::int64_t", offset_of(instance, instance.int64_value)},
+            {"string_value", "aeon::common::string", offset_of(instance, instance.string_value)}};
+        return info;
+    }
+};
+
+} // namespace internal
+
+TEST(test_ptree, ptree_reflection_object_handwritten_reflection_info_roundtrip)
+{
+    const internal::handwritten_reflection_info info;
+
+    internal::handwritten_class test;
+    test.int_value = 42;
+    test.float_value = 1.5f;
+    test.int64_value = 1234567890123;
+    test.string_value = "Hello";
+
+    const auto pt = ptree::from_reflection_object(test, info);
+    EXPECT_EQ(42, pt.at("int_value").integer_value());
+    EXPECT_EQ(1.5, pt.at("float_value").double_value());
+    EXPECT_EQ(1234567890123, pt.at("int64_value").integer_value());
+    EXPECT_EQ("Hello", pt.at("string_value").string_value());
+
+    const auto result = common::dynamic_unique_ptr_cast<internal::handwritten_class>(
+        ptree::to_reflection_object(info, pt));
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(test.int_value, result->int_value);
+    EXPECT_EQ(test.float_value, result->float_value);
+    EXPECT_EQ(test.int64_value, result->int64_value);
+    EXPECT_EQ(test.string_value, result->string_value);
+
+    const auto str = ptree::serialization::to_json(test, info);
+    EXPECT_EQ(ptree::serialization::to_json(pt), str);
+
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+    const auto json_result =
+        common::dynamic_unique_ptr_cast<internal::handwritten_class>(ptree::serialization::from_json(stream, info));
+    ASSERT_NE(nullptr, json_result);
+    EXPECT_EQ(test.int64_value, json_result->int64_value);
+    EXPECT_EQ(test.string_value, json_result->string_value);
+
+    EXPECT_EQ(ptree::serialization::to_abf(pt), ptree::serialization::to_abf(test, info));
+}
@@ -5,6 +5,7 @@
 #include <aeon/ptree/xml_dom/xml_document.h>
 #include <aeon/streams/dynamic_stream.h>
 #include <aeon/streams/devices/file_device.h>
+#include <aeon/common/bom.h>
 #include <gtest/gtest.h>
 
 #include <ptree_unittest_data.h>
@@ -79,3 +80,74 @@ TEST(test_ptree, serialize_xml_parse_simple_xml_with_floats)
     EXPECT_EQ(34.1f, document["statistics"]["max"].child().value<float>());
     EXPECT_EQ(300.2f, document["statistics"]["avg"].child().value<float>());
 }
+
+TEST(test_ptree, serialize_xml_parse_from_string)
+{
+    const auto result = ptree::serialization::from_xml(
+        R"(<?xml version="1.0"?><root><!-- comment --><a x='1' y="2"/><b>text</b><![CDATA[data]]></root>)");
+
+    ptree::xml_dom::xml_document document{result};
+    const auto root = document["root"];
+    EXPECT_EQ(ptree::xml_dom::xml_node_type::element, root.type());
+    EXPECT_EQ(3u, std::size(root.children()));
+    EXPECT_EQ("1", root["a"].attributes().at("x").get_value<common::string>());
+    EXPECT_EQ("text", root["b"].child().value());
+}
+
+TEST(test_ptree, serialize_xml_parse_with_byte_order_marker)
+{
+    const auto result = ptree::serialization::from_xml("\xEF\xBB\xBF<?xml version=\"1.0\"?><root><a/></root>");
+    EXPECT_EQ(ptree::serialization::from_xml(R"(<?xml version="1.0"?><root><a/></root>)"), result);
+
+    // The byte order marker is not reported as text before the root element.
+    ptree::xml_dom::xml_document document{result};
+    for (const auto &child : document.children())
+        EXPECT_NE(ptree::xml_dom::xml_node_type::text, child.type());
+
+    EXPECT_EQ(ptree::serialization::from_xml("<root><a/></root>"),
+              ptree::serialization::from_xml(common::bom::utf8::string() + "<root><a/></root>"));
+}
+
+TEST(test_ptree, serialize_xml_parse_mismatched_closing_tag_throws)
+{
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::serialization::from_xml("<a><b></a></b>"),
+                 ptree::serialization::ptree_xml_deserialize_exception);
+    EXPECT_THROW([[maybe_unused]] const auto result = ptree::serialization::from_xml("<a><b></b>"),
+                 ptree::serialization::ptree_xml_deserialize_exception);
+}
+
+TEST(test_ptree, xml_node_children_range)
+{
+    auto stream =
+        streams::make_dynamic_stream(streams::file_source_device{AEON_PTREE_UNITTEST_DATA_PATH "simple_xml.xml"});
+    const auto result = ptree::serialization::from_xml(stream);
+
+    ptree::xml_dom::xml_document document{result};
+    const auto values_node = document["test_xml"]["values"];
+
+    std::size_t count = 0;
+    for (const auto &node : values_node.children_range("value"))
+    {
+        EXPECT_EQ("value", node.name());
+        ++count;
+    }
+
+    EXPECT_EQ(std::size(values_node.children("value")), count);
+    EXPECT_TRUE(values_node.children_range("does_not_exist").empty());
+
+    const auto first_value = *values_node.children_range("value").begin();
+
+    std::size_t attribute_count = 0;
+    for (const auto &attribute : first_value.attributes_range())
+    {
+        if (attribute.name() == "a")
+            EXPECT_EQ(3, attribute.value<int>());
+        else
+            EXPECT_EQ("4", attribute.value());
+
+        ++attribute_count;
+    }
+
+    EXPECT_EQ(2u, attribute_count);
+    EXPECT_EQ("Something", (*first_value.children_range().begin()).value());
+}
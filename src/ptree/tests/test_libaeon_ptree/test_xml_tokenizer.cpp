@@ -0,0 +1,127 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/ptree/serialization/xml_tokenizer.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <aeon/streams/devices/memory_view_device.h>
+#include <aeon/common/bom.h>
+#include <gtest/gtest.h>
+#include <vector>
+#include <tuple>
+
+using namespace aeon;
+
+namespace internal
+{
+
+using token_tuple = std::tuple<ptree::serialization::xml_token_type, common::string, common::string>;
+
+[[nodiscard]] auto tokenize(const common::string &str, const std::streamsize block_size) -> std::vector<token_tuple>
+{
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+    ptree::serialization::xml_tokenizer tokenizer{stream, block_size};
+
+    std::vector<token_tuple> tokens;
+
+    while (true)
+    {
+        const auto &token = tokenizer.next();
+
+        if (token.type == ptree::serialization::xml_token_type::end_of_stream)
+            break;
+
+        tokens.emplace_back(token.type, common::string{token.name}, common::string{token.value});
+    }
+
+    return tokens;
+}
+
+} // namespace internal
+
+TEST(test_xml_tokenizer, tokenize_simple_document)
+{
+    using ptree::serialization::xml_token_type;
+
+    const auto tokens =
+        internal::tokenize(R"(<?xml version="1.0"?><a b="c"><!--x--><d/>text<![CDATA[<e>]]></a>)", 4096);
+
+    const std::vector<internal::token_tuple> expected{
+        {xml_token_type::declaration_begin, "xml", ""},
+        {xml_token_type::attribute, "version", "1.0"},
+        {xml_token_type::declaration_end, "", ""},
+        {xml_token_type::element_begin, "a", ""},
+        {xml_token_type::attribute, "b", "c"},
+        {xml_token_type::element_open_end, "", ""},
+        {xml_token_type::comment, "", "x"},
+        {xml_token_type::element_begin, "d", ""},
+        {xml_token_type::element_self_close, "", ""},
+        {xml_token_type::text, "", "text"},
+        {xml_token_type::cdata, "", "<e>"},
+        {xml_token_type::element_end, "a", ""}};
+
+    EXPECT_EQ(expected, tokens);
+}
+
+TEST(test_xml_tokenizer, tokenize_with_small_blocks_matches_large_blocks)
+{
+    common::string str = "<root>";
+    for (int i = 0; i < 100; ++i)
+        str += R"(<item id="abcdefghijklmnopqrstuvwxyz" other = 'value &amp; more'>Some longer text</item>)";
+    str += "<!-- a comment spanning several blocks --></root>";
+
+    const auto expected = internal::tokenize(str, 64 * 1024);
+
+    for (const auto block_size : {1, 2, 3, 7, 16, 31})
+        EXPECT_EQ(expected, internal::tokenize(str, block_size));
+}
+
+TEST(test_xml_tokenizer, tokenize_skips_byte_order_marker)
+{
+    using ptree::serialization::xml_token_type;
+
+    const std::vector<internal::token_tuple> expected{{xml_token_type::element_begin, "a", ""},
+                                                      {xml_token_type::element_self_close, "", ""}};
+
+    for (const auto block_size : {1, 2, 4096})
+        EXPECT_EQ(expected, internal::tokenize(common::bom::utf8::string() + "<a/>", block_size));
+
+    // Only at the start of the stream.
+    const std::vector<internal::token_tuple> expected_text{
+        {xml_token_type::text, "", common::string{"x"} + common::bom::utf8::string()}};
+
+    EXPECT_EQ(expected_text, internal::tokenize(common::string{"x"} + common::bom::utf8::string(), 4096));
+}
+
+TEST(test_xml_tokenizer, tokenize_reports_entities)
+{
+    const common::string str = R"(<a b="1 &lt; 2">x &amp; y</a>)";
+    auto stream = streams::make_dynamic_stream(streams::memory_view_device{str});
+    ptree::serialization::xml_tokenizer tokenizer{stream};
+
+    EXPECT_EQ(ptree::serialization::xml_token_type::element_begin, tokenizer.next().type);
+
+    const auto &attribute = tokenizer.next();
+    EXPECT_TRUE(attribute.has_entities);
+    EXPECT_EQ("1 < 2", ptree::serialization::xml_unescape(attribute.value));
+
+    EXPECT_EQ(ptree::serialization::xml_token_type::element_open_end, tokenizer.next().type);
+
+    const auto &text = tokenizer.next();
+    EXPECT_TRUE(text.has_entities);
+    EXPECT_EQ("x & y", ptree::serialization::xml_unescape(text.value));
+}
+
+TEST(test_xml_tokenizer, unescape)
+{
+    EXPECT_EQ("<>&\"'", ptree::serialization::xml_unescape("&lt;&gt;&amp;&quot;&apos;"));
+    EXPECT_EQ("AB", ptree::serialization::xml_unescape("&#65;&#x42;"));
+    EXPECT_EQ("&unknown; &", ptree::serialization::xml_unescape("&unknown; &"));
+    EXPECT_EQ("no entities", ptree::serialization::xml_unescape("no entities"));
+}
+
+TEST(test_xml_tokenizer, malformed_input_throws)
+{
+    EXPECT_THROW(std::ignore = internal::tokenize("<a b=c>", 4096), ptree::serialization::xml_tokenizer_exception);
+    EXPECT_THROW(std::ignore = internal::tokenize("<!-- unterminated", 4096),
+                 ptree::serialization::xml_tokenizer_exception);
+    EXPECT_THROW(std::ignore = internal::tokenize("<a", 4096), ptree::serialization::xml_tokenizer_exception);
+}
@@ -0,0 +1,45 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/reflection/field_index.h>
+#include <algorithm>
+#include <string_view>
+#include <functional>
+
+namespace aeon::reflection
+{
+
+field_index::field_index(const std::vector<field_info> &fields)
+    : entries_{}
+{
+    entries_.reserve(std::size(fields));
+
+    for (const auto &field : fields)
+        entries_.push_back(entry{hash(field.name()), &field});
+
+    std::sort(std::begin(entries_), std::end(entries_),
+              [](const entry &lhs, const entry &rhs) { return lhs.hash < rhs.hash; });
+}
+
+auto field_index::find(const common::string_view name) const noexcept -> const field_info *
+{
+    const auto name_hash = hash(name);
+
+    auto itr = std::lower_bound(std::begin(entries_), std::end(entries_), name_hash,
+                                [](const entry &lhs, const std::size_t rhs) { return lhs.hash < rhs; });
+
+    // Multiple names may share the same hash; compare the names of all entries with a matching hash.
+    for (; itr != std::end(entries_) && itr->hash == name_hash; ++itr)
+    {
+        if (itr->field->name() == name)
+            return itr->field;
+    }
+
+    return nullptr;
+}
+
+auto field_index::hash(const common::string_view name) noexcept -> std::size_t
+{
+    return std::hash<std::string_view>{}(name.as_std_string_view());
+}
+
+} // namespace aeon::reflection
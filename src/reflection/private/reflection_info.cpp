@@ -11,14 +11,31 @@ reflection_info::~reflection_info() = default;
 
 auto reflection_info::get_field_type(const char *const name) const -> common::string_view
 {
-    const auto &field_info = get_field_info();
-    for (const auto &field : field_info)
+    const auto field = find_field(name);
+
+    if (!field)
+        throw reflection_exception{};
+
+    return field->type();
+}
+
+auto reflection_info::find_field(const common::string_view name) const -> const field_info *
+{
+    if (const auto index = get_field_index(); index)
+        return index->find(name);
+
+    for (const auto &field : get_field_info())
     {
         if (field.name() == name)
-            return field.type();
+            return &field;
     }
 
-    throw reflection_exception{};
+    return nullptr;
+}
+
+auto reflection_info::get_field_index() const -> const field_index *
+{
+    return nullptr;
 }
 
 } // namespace aeon::reflection
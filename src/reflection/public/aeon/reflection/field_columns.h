@@ -0,0 +1,87 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/reflection/exception.h>
+#include <aeon/reflection/field_info.h>
+#include <aeon/reflection/field_type.h>
+#include <aeon/reflection/reflection_info.h>
+#include <aeon/reflection/reflection_object.h>
+#include <aeon/reflection/visit_field.h>
+#include <aeon/common/string.h>
+#include <aeon/common/uuid.h>
+#include <variant>
+#include <vector>
+#include <string>
+#include <span>
+#include <cstdint>
+
+namespace aeon::reflection
+{
+
+/*!
+ * A single field of many instances stored contiguously (structure of arrays). The active alternative corresponds to
+ * the field_type of the field; std::monostate is never used for a filled column.
+ */
+using field_column =
+    std::variant<std::monostate, std::vector<bool>, std::vector<std::int8_t>, std::vector<std::uint8_t>,
+                 std::vector<std::int16_t>, std::vector<std::uint16_t>, std::vector<std::int32_t>,
+                 std::vector<std::uint32_t>, std::vector<std::int64_t>, std::vector<std::uint64_t>, std::vector<float>,
+                 std::vector<double>, std::vector<common::string>, std::vector<std::string>,
+                 std::vector<common::uuid>, std::vector<std::vector<std::uint8_t>>>;
+
+/*!
+ * Copy the given field of all instances into a column. The type U must match the type of the field exactly.
+ * The type check is done once for the whole column rather than per instance.
+ *
+ * Throws reflection_exception if the type does not match.
+ */
+template <typename U, reflection_object_implementation T>
+void copy_field_column(const field_info &field, const std::span<const T> instances, std::vector<U> &column)
+{
+    if (field.type_id() != field_type_of<U>())
+        throw reflection_exception{};
+
+    column.reserve(std::size(column) + std::size(instances));
+
+    for (const auto &instance : instances)
+        column.push_back(field.get<U>(instance));
+}
+
+/*!
+ * Copy the given field of all instances into a new column.
+ */
+template <typename U, reflection_object_implementation T>
+[[nodiscard]] auto copy_field_column(const field_info &field, const std::span<const T> instances) -> std::vector<U>
+{
+    std::vector<U> column;
+    copy_field_column(field, instances, column);
+    return column;
+}
+
+/*!
+ * Copy all fields of all instances into columns; one column per field, in the order of get_field_info(). The type
+ * of every field is resolved once per column, not once per value.
+ *
+ * Throws reflection_exception if one of the fields has an unknown type.
+ */
+template <reflection_object_implementation T>
+[[nodiscard]] auto to_field_columns(const reflection_info &info, const std::span<const T> instances)
+    -> std::vector<field_column>
+{
+    const auto &fields = info.get_field_info();
+
+    std::vector<field_column> columns;
+    columns.reserve(std::size(fields));
+
+    for (const auto &field : fields)
+    {
+        visit_field_type(field.type_id(),
+                         [&field, &instances, &columns]<typename U>(const std::type_identity<U>)
+                         { columns.emplace_back(copy_field_column<U>(field, instances)); });
+    }
+
+    return columns;
+}
+
+} // namespace aeon::reflection
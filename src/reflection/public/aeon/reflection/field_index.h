@@ -0,0 +1,47 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/reflection/field_info.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <cstddef>
+
+namespace aeon::reflection
+{
+
+/*!
+ * Name index over the fields of a reflected class. The fields are sorted by the hash of their name, so that a lookup
+ * is a binary search over integers followed by (typically) a single string comparison instead of a linear scan with a
+ * string comparison per field. The index is built once per reflected class by the AEON_REFLECTION_* macros.
+ */
+class field_index final
+{
+public:
+    explicit field_index(const std::vector<field_info> &fields);
+    ~field_index() = default;
+
+    field_index(const field_index &) = default;
+    auto operator=(const field_index &) -> field_index & = default;
+
+    field_index(field_index &&) noexcept = default;
+    auto operator=(field_index &&) noexcept -> field_index & = default;
+
+    /*!
+     * Find a field by name. Returns nullptr if there is no field with the given name.
+     */
+    [[nodiscard]] auto find(const common::string_view name) const noexcept -> const field_info *;
+
+private:
+    struct entry final
+    {
+        std::size_t hash;
+        const field_info *field;
+    };
+
+    [[nodiscard]] static auto hash(const common::string_view name) noexcept -> std::size_t;
+
+    std::vector<entry> entries_;
+};
+
+} // namespace aeon::reflection
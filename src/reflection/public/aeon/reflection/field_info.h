@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <aeon/reflection/field_type.h>
 #include <aeon/reflection/reflection_object.h>
 #include <aeon/common/string.h>
 #include <cstddef>
@@ -12,9 +13,20 @@ namespace aeon::reflection
 class field_info final
 {
 public:
+    /*!
+     * Create a field_info for a type given by name only. The type id is looked up from the name through
+     * field_type_from_name.
+     */
     field_info(const common::string_view name, const common::string_view type, const std::ptrdiff_t offset)
+        : field_info{name, type, field_type_from_name(type), offset}
+    {
+    }
+
+    field_info(const common::string_view name, const common::string_view type, const field_type type_id,
+               const std::ptrdiff_t offset)
         : name_{name}
         , type_{type}
+        , type_id_{type_id}
         , offset_{offset}
     {
     }
@@ -37,6 +49,11 @@ public:
         return type_;
     }
 
+    [[nodiscard]] auto type_id() const noexcept
+    {
+        return type_id_;
+    }
+
     [[nodiscard]] auto offset() const noexcept
     {
         return offset_;
@@ -57,6 +74,7 @@ public:
 private:
     common::string_view name_;
     common::string_view type_;
+    field_type type_id_;
     std::ptrdiff_t offset_;
 };
 
@@ -0,0 +1,120 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <aeon/common/uuid.h>
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <cstdint>
+
+namespace aeon::reflection
+{
+
+/*!
+ * Compact tag describing the type of a reflected field. This allows serializers to dispatch on the type of a field
+ * through a switch instead of comparing the stringified type name.
+ */
+enum class field_type : std::uint8_t
+{
+    unknown,
+    boolean,
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float32,
+    float64,
+    string,
+    std_string,
+    uuid,
+    blob
+};
+
+template <typename T>
+[[nodiscard]] consteval auto field_type_of() noexcept -> field_type
+{
+    using type = std::remove_cv_t<T>;
+
+    if constexpr (std::is_same_v<type, bool>)
+        return field_type::boolean;
+    else if constexpr (std::is_integral_v<type> && std::is_signed_v<type> && sizeof(type) == 1)
+        return field_type::int8;
+    else if constexpr (std::is_integral_v<type> && std::is_unsigned_v<type> && sizeof(type) == 1)
+        return field_type::uint8;
+    else if constexpr (std::is_integral_v<type> && std::is_signed_v<type> && sizeof(type) == 2)
+        return field_type::int16;
+    else if constexpr (std::is_integral_v<type> && std::is_unsigned_v<type> && sizeof(type) == 2)
+        return field_type::uint16;
+    else if constexpr (std::is_integral_v<type> && std::is_signed_v<type> && sizeof(type) == 4)
+        return field_type::int32;
+    else if constexpr (std::is_integral_v<type> && std::is_unsigned_v<type> && sizeof(type) == 4)
+        return field_type::uint32;
+    else if constexpr (std::is_integral_v<type> && std::is_signed_v<type> && sizeof(type) == 8)
+        return field_type::int64;
+    else if constexpr (std::is_integral_v<type> && std::is_unsigned_v<type> && sizeof(type) == 8)
+        return field_type::uint64;
+    else if constexpr (std::is_same_v<type, float>)
+        return field_type::float32;
+    else if constexpr (std::is_same_v<type, double>)
+        return field_type::float64;
+    else if constexpr (std::is_same_v<type, common::string>)
+        return field_type::string;
+    else if constexpr (std::is_same_v<type, std::string>)
+        return field_type::std_string;
+    else if constexpr (std::is_same_v<type, common::uuid>)
+        return field_type::uuid;
+    else if constexpr (std::is_same_v<type, std::vector<std::uint8_t>>)
+        return field_type::blob;
+    else
+        return field_type::unknown;
+}
+
+/*!
+ * Get the field type from the name of a type as it is written in the source, for example "int" or
+ * "aeon::common::string". This allows a field_info that was created by hand with only a type name to be dispatched on
+ * like one created through AEON_REFLECTION_FIELD. Returns field_type::unknown if the name is not recognized.
+ */
+[[nodiscard]] constexpr auto field_type_from_name(const common::string_view name) noexcept -> field_type
+{
+    if (name == "bool")
+        return field_type::boolean;
+    if (name == "std::int8_t" || name == "int8_t" || name == "signed char")
+        return field_type::int8;
+    if (name == "std::uint8_t" || name == "uint8_t" || name == "unsigned char")
+        return field_type::uint8;
+    if (name == "std::int16_t" || name == "int16_t" || name == "short")
+        return field_type::int16;
+    if (name == "std::uint16_t" || name == "uint16_t" || name == "unsigned short")
+        return field_type::uint16;
+    if (name == "std::int32_t" || name == "int32_t" || name == "int")
+        return field_type::int32;
+    if (name == "std::uint32_t" || name == "uint32_t" || name == "unsigned int" || name == "unsigned")
+        return field_type::uint32;
+    if (name == "std::int64_t" || name == "int64_t" || name == "long long")
+        return field_type::int64;
+    if (name == "std::uint64_t" || name == "uint64_t" || name == "unsigned long long")
+        return field_type::uint64;
+    if (name == "float")
+        return field_type::float32;
+    if (name == "double")
+        return field_type::float64;
+    if (name == "aeon::common::string" || name == "common::string")
+        return field_type::string;
+    if (name == "std::string")
+        return field_type::std_string;
+    if (name == "aeon::common::uuid" || name == "common::uuid")
+        return field_type::uuid;
+    if (name == "std::vector<std::uint8_t>")
+        return field_type::blob;
+
+    return field_type::unknown;
+}
+
+} // namespace aeon::reflection
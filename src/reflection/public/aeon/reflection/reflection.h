@@ -3,6 +3,7 @@
 #pragma once
 
 #include <aeon/reflection/reflection_info.h>
+#include <aeon/reflection/field_type.h>
 #include <aeon/reflection/reflection_object.h>
 #include <aeon/common/preprocessor.h>
 
@@ -35,6 +36,7 @@
 #define AEON_REFLECTION_FIELD(type, name)                                                                              \
                 {                                                                                                      \
                     (aeon_concatenate(u8, #name)), (aeon_concatenate(u8, #type)),                                      \
+                    aeon::reflection::field_type_of<type>(),                                                           \
                     reinterpret_cast<std::ptrdiff_t>(                                                                  \
                     &reinterpret_cast<std::uint8_t const &>((static_cast<reflection_class_type *>(nullptr)->name)))    \
                 },
@@ -43,6 +45,12 @@
             };                                                                                                         \
                                                                                                                        \
             return info;                                                                                               \
+        }                                                                                                              \
+                                                                                                                       \
+        [[nodiscard]] auto get_field_index() const -> const aeon::reflection::field_index * override                   \
+        {                                                                                                              \
+            static const aeon::reflection::field_index index{get_field_info()};                                        \
+            return &index;                                                                                             \
         }                                                                                                              \
     };                                                                                                                 \
                                                                                                                        \
@@ -4,6 +4,7 @@
 
 #include <aeon/reflection/exception.h>
 #include <aeon/reflection/field_info.h>
+#include <aeon/reflection/field_index.h>
 #include <aeon/reflection/reflection_object.h>
 #include <aeon/common/string_view.h>
 #include <vector>
@@ -28,20 +29,30 @@ public:
     template <typename U, reflection_object_implementation T>
     auto get_field(T &instance, const char *const name) const -> U *
     {
-        const auto &field_info = get_field_info();
-        for (const auto &field : field_info)
-        {
-            if (field.name() == name)
-                return reinterpret_cast<U *>(reinterpret_cast<std::uint8_t *>(&instance) + field.offset());
-        }
-
-        throw reflection_exception{};
+        const auto field = find_field(name);
+
+        if (!field)
+            throw reflection_exception{};
+
+        return reinterpret_cast<U *>(reinterpret_cast<std::uint8_t *>(&instance) + field->offset());
     }
 
     auto get_field_type(const char *const name) const -> common::string_view;
 
+    /*!
+     * Find a field by name through the name index of the class, or through a linear search if the class has no index.
+     * Returns nullptr if there is no such field.
+     */
+    [[nodiscard]] auto find_field(const common::string_view name) const -> const field_info *;
+
     [[nodiscard]] virtual auto create() const -> std::unique_ptr<reflection_object> = 0;
     [[nodiscard]] virtual auto get_field_info() const noexcept -> const std::vector<field_info> & = 0;
+
+    /*!
+     * The name index used by find_field. The AEON_REFLECTION_* macros build the index once per class, on first use.
+     * The default implementation returns nullptr, so that hand-written implementations don't need to provide one.
+     */
+    [[nodiscard]] virtual auto get_field_index() const -> const field_index *;
 };
 
 } // namespace aeon::reflection
@@ -0,0 +1,99 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/reflection/exception.h>
+#include <aeon/reflection/field_info.h>
+#include <aeon/reflection/field_type.h>
+#include <aeon/reflection/reflection_object.h>
+#include <type_traits>
+#include <cstdint>
+
+namespace aeon::reflection
+{
+
+/*!
+ * Call the given function with a std::type_identity of the C++ type that corresponds to the given field type.
+ *
+ * Throws reflection_exception if the field type is unknown.
+ */
+template <typename func_t>
+void visit_field_type(const field_type type, func_t &&func)
+{
+    switch (type)
+    {
+        case field_type::boolean:
+            func(std::type_identity<bool>{});
+            break;
+        case field_type::int8:
+            func(std::type_identity<std::int8_t>{});
+            break;
+        case field_type::uint8:
+            func(std::type_identity<std::uint8_t>{});
+            break;
+        case field_type::int16:
+            func(std::type_identity<std::int16_t>{});
+            break;
+        case field_type::uint16:
+            func(std::type_identity<std::uint16_t>{});
+            break;
+        case field_type::int32:
+            func(std::type_identity<std::int32_t>{});
+            break;
+        case field_type::uint32:
+            func(std::type_identity<std::uint32_t>{});
+            break;
+        case field_type::int64:
+            func(std::type_identity<std::int64_t>{});
+            break;
+        case field_type::uint64:
+            func(std::type_identity<std::uint64_t>{});
+            break;
+        case field_type::float32:
+            func(std::type_identity<float>{});
+            break;
+        case field_type::float64:
+            func(std::type_identity<double>{});
+            break;
+        case field_type::string:
+            func(std::type_identity<common::string>{});
+            break;
+        case field_type::std_string:
+            func(std::type_identity<std::string>{});
+            break;
+        case field_type::uuid:
+            func(std::type_identity<common::uuid>{});
+            break;
+        case field_type::blob:
+            func(std::type_identity<std::vector<std::uint8_t>>{});
+            break;
+        case field_type::unknown:
+        default:
+            throw reflection_exception{};
+    }
+}
+
+/*!
+ * Call the given function with a reference to the given field of an instance, typed according to the field's
+ * type_id(). If the instance is const, the function receives a const reference. This allows serializers to be written
+ * as a set of overloads per type instead of comparing type names at runtime.
+ *
+ * Throws reflection_exception if the field type is unknown.
+ */
+template <typename instance_t, typename func_t>
+    requires std::is_base_of_v<reflection_object, std::remove_const_t<instance_t>>
+void visit_field(const field_info &field, instance_t &instance, func_t &&func)
+{
+    using byte_type = std::conditional_t<std::is_const_v<instance_t>, const std::uint8_t, std::uint8_t>;
+
+    const auto address = reinterpret_cast<byte_type *>(&instance) + field.offset();
+
+    visit_field_type(field.type_id(),
+                     [address, &func]<typename T>(const std::type_identity<T>)
+                     {
+                         using value_type = std::conditional_t<std::is_const_v<instance_t>, const T, T>;
+                         func(*reinterpret_cast<value_type *>(address));
+                     });
+}
+
+} // namespace aeon::reflection
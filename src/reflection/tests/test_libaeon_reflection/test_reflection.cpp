@@ -1,6 +1,8 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/reflection/reflection.h>
+#include <aeon/reflection/visit_field.h>
+#include <aeon/reflection/field_columns.h>
 #include <aeon/common/memory.h>
 #include <gtest/gtest.h>
 
@@ -66,3 +68,119 @@ TEST(test_reflection, test_reflection_rt)
     *str = "Hello";
     EXPECT_EQ(test->get_string(), "Hello");
 }
+
+TEST(test_reflection, test_reflection_field_type_id)
+{
+    const auto &field_info = test_class::reflection_info().get_field_info();
+    ASSERT_EQ(3u, std::size(field_info));
+
+    EXPECT_EQ(reflection::field_type::int32, field_info[0].type_id());
+    EXPECT_EQ(reflection::field_type::float32, field_info[1].type_id());
+    EXPECT_EQ(reflection::field_type::std_string, field_info[2].type_id());
+}
+
+TEST(test_reflection, test_reflection_visit_field)
+{
+    test_class test;
+
+    for (const auto &field : test_class::reflection_info().get_field_info())
+    {
+        reflection::visit_field(field, test,
+                                [](auto &value)
+                                {
+                                    using value_type = std::decay_t<decltype(value)>;
+
+                                    if constexpr (std::is_same_v<value_type, int>)
+                                        value = 3;
+                                    else if constexpr (std::is_same_v<value_type, float>)
+                                        value = 4.0f;
+                                    else if constexpr (std::is_same_v<value_type, std::string>)
+                                        value = "visited";
+                                });
+    }
+
+    EXPECT_EQ(3, test.get_integer());
+    EXPECT_EQ(4.0f, test.get_float());
+    EXPECT_EQ("visited", test.get_string());
+}
+
+TEST(test_reflection, test_reflection_find_field)
+{
+    const auto &info = test_class::reflection_info();
+
+    const auto field = info.find_field("some_float");
+    ASSERT_NE(nullptr, field);
+    EXPECT_EQ("some_float", field->name());
+    EXPECT_EQ(reflection::field_type::float32, field->type_id());
+
+    EXPECT_EQ(nullptr, info.find_field("does_not_exist"));
+    EXPECT_EQ(nullptr, info.find_field(""));
+
+    test_class test;
+    EXPECT_THROW([[maybe_unused]] const auto result = info.get_field<int>(test, "does_not_exist"),
+                 reflection::reflection_exception);
+}
+
+TEST(test_reflection, test_reflection_field_columns)
+{
+    std::vector<test_class> instances(3);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        *test_class::reflection_info().get_field<int>(instances[i], "private_integer") = i;
+        *test_class::reflection_info().get_field<float>(instances[i], "some_float") = static_cast<float>(i) * 0.5f;
+        *test_class::reflection_info().get_field<std::string>(instances[i], "a_string") = std::to_string(i);
+    }
+
+    const std::span<const test_class> view{instances};
+    const auto columns = reflection::to_field_columns(test_class::reflection_info(), view);
+    ASSERT_EQ(3u, std::size(columns));
+
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), std::get<std::vector<std::int32_t>>(columns[0]));
+    EXPECT_EQ((std::vector<float>{0.0f, 0.5f, 1.0f}), std::get<std::vector<float>>(columns[1]));
+    EXPECT_EQ((std::vector<std::string>{"0", "1", "2"}), std::get<std::vector<std::string>>(columns[2]));
+
+    const auto field = test_class::reflection_info().find_field("private_integer");
+    ASSERT_NE(nullptr, field);
+    EXPECT_THROW([[maybe_unused]] const auto result =
+                     reflection::copy_field_column<float>(*field, view),
+                 reflection::reflection_exception);
+}
+
+namespace internal
+{
+
+/*!
+ * A reflection_info implemented by hand, without a field index.
+ */
+class handwritten_reflection_info final : public reflection::reflection_info
+{
+public:
+    [[nodiscard]] auto create() const -> std::unique_ptr<reflection::reflection_object> override
+    {
+        return nullptr;
+    }
+
+    [[nodiscard]] auto get_field_info() const noexcept -> const std::vector<reflection::field_info> & override
+    {
+        static const std::vector<reflection::field_info> info{{"first", "int", 0}, {"second", "float", 4}};
+        return info;
+    }
+};
+
+} // namespace internal
+
+TEST(test_reflection, test_reflection_find_field_without_index)
+{
+    const internal::handwritten_reflection_info info;
+    EXPECT_EQ(nullptr, info.get_field_index());
+
+    const auto field = info.find_field("second");
+    ASSERT_NE(nullptr, field);
+    EXPECT_EQ(4, field->offset());
+    EXPECT_EQ("float", info.get_field_type("second"));
+
+    EXPECT_EQ(nullptr, info.find_field("third"));
+    EXPECT_THROW([[maybe_unused]] const auto result = info.get_field_type("third"), reflection::reflection_exception);
+    EXPECT_NE(nullptr, test_class::reflection_info().get_field_index());
+}
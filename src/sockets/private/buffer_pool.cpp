@@ -0,0 +1,133 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/buffer_pool.h>
+#include <bit>
+
+namespace aeon::sockets
+{
+
+pooled_buffer::pooled_buffer() noexcept
+    : pool_{nullptr}
+    , data_{}
+    , size_{0}
+{
+}
+
+pooled_buffer::pooled_buffer(buffer_pool *pool, std::unique_ptr<std::byte[]> data, const std::size_t size) noexcept
+    : pool_{pool}
+    , data_{std::move(data)}
+    , size_{size}
+{
+}
+
+pooled_buffer::~pooled_buffer()
+{
+    reset();
+}
+
+pooled_buffer::pooled_buffer(pooled_buffer &&other) noexcept
+    : pool_{other.pool_}
+    , data_{std::move(other.data_)}
+    , size_{other.size_}
+{
+    other.pool_ = nullptr;
+    other.size_ = 0;
+}
+
+auto pooled_buffer::operator=(pooled_buffer &&other) noexcept -> pooled_buffer &
+{
+    if (this == &other) [[unlikely]]
+        return *this;
+
+    reset();
+
+    pool_ = other.pool_;
+    data_ = std::move(other.data_);
+    size_ = other.size_;
+
+    other.pool_ = nullptr;
+    other.size_ = 0;
+
+    return *this;
+}
+
+void pooled_buffer::reset() noexcept
+{
+    if (pool_ && data_)
+        pool_->release(std::move(data_), size_);
+
+    pool_ = nullptr;
+    data_.reset();
+    size_ = 0;
+}
+
+buffer_pool::buffer_pool(const std::size_t max_cached_buffers)
+    : max_cached_buffers_{max_cached_buffers}
+    , size_classes_{}
+{
+}
+
+auto buffer_pool::acquire(const std::size_t size) -> pooled_buffer
+{
+    if (size > max_size_class)
+        return pooled_buffer{nullptr, std::make_unique_for_overwrite<std::byte[]>(size), size};
+
+    const auto index = size_class_index(size);
+    const auto class_size = min_size_class << index;
+
+    {
+        auto &sc = size_classes_[index];
+        std::scoped_lock lock{sc.mutex};
+
+        if (!std::empty(sc.buffers))
+        {
+            auto data = std::move(sc.buffers.back());
+            sc.buffers.pop_back();
+            return pooled_buffer{this, std::move(data), class_size};
+        }
+    }
+
+    return pooled_buffer{this, std::make_unique_for_overwrite<std::byte[]>(class_size), class_size};
+}
+
+auto buffer_pool::get_default() -> buffer_pool &
+{
+    static buffer_pool pool;
+    return pool;
+}
+
+auto buffer_pool::round_to_size_class(const std::size_t size) noexcept -> std::size_t
+{
+    if (size > max_size_class)
+        return size;
+
+    return min_size_class << size_class_index(size);
+}
+
+auto buffer_pool::size_class_index(const std::size_t size) noexcept -> std::size_t
+{
+    if (size <= min_size_class)
+        return 0;
+
+    return static_cast<std::size_t>(std::bit_width(size - 1)) - std::bit_width(min_size_class - 1);
+}
+
+void buffer_pool::release(std::unique_ptr<std::byte[]> data, const std::size_t size) noexcept
+{
+    auto &sc = size_classes_[size_class_index(size)];
+    std::scoped_lock lock{sc.mutex};
+
+    // The buffer is freed when it goes out of scope instead.
+    if (std::size(sc.buffers) >= max_cached_buffers_)
+        return;
+
+    try
+    {
+        sc.buffers.emplace_back(std::move(data));
+    }
+    catch (...)
+    {
+    }
+}
+
+} // namespace aeon::sockets
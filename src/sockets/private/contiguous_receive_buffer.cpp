@@ -0,0 +1,99 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/contiguous_receive_buffer.h>
+#include <algorithm>
+#include <cstring>
+
+namespace aeon::sockets
+{
+
+contiguous_receive_buffer::contiguous_receive_buffer(const std::size_t max_size, buffer_pool &pool)
+    : pool_{&pool}
+    , max_size_{max_size}
+    , buffer_{}
+    , offset_{0}
+    , size_{0}
+{
+}
+
+auto contiguous_receive_buffer::write(const std::span<const std::byte> data) -> bool
+{
+    if (std::size(data) > max_size_ - size_)
+        return false;
+
+    if (std::empty(data))
+        return true;
+
+    const auto required_size = size_ + std::size(data);
+
+    if (offset_ + required_size > buffer_.size())
+    {
+        if (required_size <= buffer_.size())
+        {
+            // Move the data that is left to the front, to make room at the end.
+            std::memmove(buffer_.data(), buffer_.data() + offset_, size_);
+        }
+        else
+        {
+            auto buffer = pool_->acquire(std::max(required_size, buffer_.size() * 2));
+
+            if (size_ > 0)
+                std::memcpy(buffer.data(), buffer_.data() + offset_, size_);
+
+            buffer_ = std::move(buffer);
+        }
+
+        offset_ = 0;
+    }
+
+    std::memcpy(buffer_.data() + offset_ + size_, std::data(data), std::size(data));
+    size_ += std::size(data);
+    return true;
+}
+
+auto contiguous_receive_buffer::data() const noexcept -> std::span<const std::byte>
+{
+    if (size_ == 0)
+        return {};
+
+    return {buffer_.data() + offset_, size_};
+}
+
+void contiguous_receive_buffer::consume(const std::size_t size) noexcept
+{
+    const auto count = std::min(size, size_);
+    size_ -= count;
+
+    // Return the memory to the pool as soon as all data was processed, so that idle connections do not hold on to it.
+    if (size_ == 0)
+    {
+        clear();
+        return;
+    }
+
+    offset_ += count;
+}
+
+void contiguous_receive_buffer::clear() noexcept
+{
+    buffer_.reset();
+    offset_ = 0;
+    size_ = 0;
+}
+
+auto contiguous_receive_buffer::size() const noexcept -> std::size_t
+{
+    return size_;
+}
+
+auto contiguous_receive_buffer::empty() const noexcept -> bool
+{
+    return size_ == 0;
+}
+
+auto contiguous_receive_buffer::capacity() const noexcept -> std::size_t
+{
+    return buffer_.size();
+}
+
+} // namespace aeon::sockets
@@ -1,23 +1,19 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/sockets/line_protocol_socket.h>
-#include <aeon/streams/stream_reader.h>
-#include <aeon/sockets/config.h>
 
 namespace aeon::sockets
 {
 
 line_protocol_socket::line_protocol_socket(asio::io_context &service)
     : tcp_socket(service)
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<char>>{tcp_socket_circular_buffer_size}}
+    , receive_buffer_{}
 {
 }
 
 line_protocol_socket::line_protocol_socket(asio::ip::tcp::socket socket)
     : tcp_socket(std::move(socket))
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<char>>{tcp_socket_circular_buffer_size}}
+    , receive_buffer_{}
 {
 }
 
@@ -25,12 +21,18 @@ line_protocol_socket::~line_protocol_socket() = default;
 
 void line_protocol_socket::on_data(const std::span<const std::byte> &data)
 {
-    circular_buffer_.write(std::data(data), std::size(data));
-    streams::stream_reader reader(circular_buffer_);
+    if (!receive_buffer_.write(data))
+    {
+        on_error(std::make_error_code(std::errc::no_buffer_space));
+        disconnect();
+        return;
+    }
+
+    common::string line;
 
-    while (circular_buffer_.size() != 0)
+    while (receive_buffer_.read_line(line))
     {
-        on_line(reader.read_line());
+        on_line(line);
     }
 }
 
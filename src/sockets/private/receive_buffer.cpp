@@ -0,0 +1,162 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/receive_buffer.h>
+#include <algorithm>
+#include <cstring>
+
+namespace aeon::sockets
+{
+
+receive_buffer::receive_buffer(const std::size_t max_size, buffer_pool &pool, const std::size_t chunk_size)
+    : pool_{&pool}
+    , chunk_size_{buffer_pool::round_to_size_class(chunk_size)}
+    , max_size_{max_size}
+    , chunks_{}
+    , offset_{0}
+    , size_{0}
+{
+}
+
+auto receive_buffer::write(const std::span<const std::byte> data) -> bool
+{
+    if (std::size(data) > max_size_ - size_)
+        return false;
+
+    auto source = std::data(data);
+    auto remaining = std::size(data);
+
+    while (remaining > 0)
+    {
+        const auto end = offset_ + size_;
+        const auto chunk_index = end / chunk_size_;
+        const auto chunk_offset = end % chunk_size_;
+
+        if (chunk_index == std::size(chunks_))
+            chunks_.emplace_back(pool_->acquire(chunk_size_));
+
+        const auto count = std::min(remaining, chunk_size_ - chunk_offset);
+        std::memcpy(chunks_[chunk_index].data() + chunk_offset, source, count);
+
+        source += count;
+        remaining -= count;
+        size_ += count;
+    }
+
+    return true;
+}
+
+auto receive_buffer::peek(std::byte *data, const std::size_t size) const noexcept -> std::size_t
+{
+    const auto total = std::min(size, size_);
+    auto offset = offset_;
+    auto copied = std::size_t{0};
+
+    for (auto chunk = std::begin(chunks_); copied < total; ++chunk)
+    {
+        const auto count = std::min(total - copied, chunk_size_ - offset);
+        std::memcpy(data + copied, chunk->data() + offset, count);
+        copied += count;
+        offset = 0;
+    }
+
+    return total;
+}
+
+auto receive_buffer::read(std::byte *data, const std::size_t size) noexcept -> std::size_t
+{
+    const auto count = peek(data, size);
+    consume(count);
+    return count;
+}
+
+auto receive_buffer::read_line(common::string &line) -> bool
+{
+    const auto end = find(std::byte{'\n'});
+
+    if (end == npos)
+        return false;
+
+    line.resize(end);
+    [[maybe_unused]] const auto count = peek(reinterpret_cast<std::byte *>(std::data(line)), end);
+    consume(end + 1);
+
+    if (!std::empty(line) && line[std::size(line) - 1] == '\r')
+        line.resize(std::size(line) - 1);
+
+    return true;
+}
+
+void receive_buffer::consume(const std::size_t size) noexcept
+{
+    const auto count = std::min(size, size_);
+    size_ -= count;
+
+    // Return the memory to the pool as soon as all data was processed, so that idle connections do not hold on to it.
+    if (size_ == 0)
+    {
+        clear();
+        return;
+    }
+
+    offset_ += count;
+
+    const auto consumed_chunks = offset_ / chunk_size_;
+
+    if (consumed_chunks == 0)
+        return;
+
+    chunks_.erase(std::begin(chunks_), std::begin(chunks_) + static_cast<std::ptrdiff_t>(consumed_chunks));
+    offset_ %= chunk_size_;
+}
+
+auto receive_buffer::find(const std::byte value) const noexcept -> std::size_t
+{
+    auto offset = offset_;
+    auto position = std::size_t{0};
+
+    for (auto chunk = std::begin(chunks_); position < size_; ++chunk)
+    {
+        const auto count = std::min(size_ - position, chunk_size_ - offset);
+        const auto begin = chunk->data() + offset;
+
+        if (const auto result = std::memchr(begin, static_cast<int>(value), count); result)
+            return position + static_cast<std::size_t>(static_cast<const std::byte *>(result) - begin);
+
+        position += count;
+        offset = 0;
+    }
+
+    return npos;
+}
+
+auto receive_buffer::front() const noexcept -> std::span<const std::byte>
+{
+    if (size_ == 0)
+        return {};
+
+    return {chunks_.front().data() + offset_, std::min(size_, chunk_size_ - offset_)};
+}
+
+void receive_buffer::clear() noexcept
+{
+    chunks_.clear();
+    offset_ = 0;
+    size_ = 0;
+}
+
+auto receive_buffer::size() const noexcept -> std::size_t
+{
+    return size_;
+}
+
+auto receive_buffer::empty() const noexcept -> bool
+{
+    return size_ == 0;
+}
+
+auto receive_buffer::capacity() const noexcept -> std::size_t
+{
+    return std::size(chunks_) * chunk_size_;
+}
+
+} // namespace aeon::sockets
@@ -0,0 +1,129 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/sendable_file.h>
+#include <system_error>
+#include <limits>
+#include <algorithm>
+
+#if (defined(AEON_PLATFORM_OS_WINDOWS))
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace aeon::sockets
+{
+
+#if (defined(AEON_PLATFORM_OS_WINDOWS))
+
+sendable_file::sendable_file(const std::filesystem::path &path)
+    : handle_{CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr)}
+    , size_{0}
+{
+    if (handle_ == INVALID_HANDLE_VALUE)
+        throw std::system_error{static_cast<int>(GetLastError()), std::system_category()};
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(handle_, &size))
+    {
+        const auto error = GetLastError();
+        CloseHandle(handle_);
+        throw std::system_error{static_cast<int>(error), std::system_category()};
+    }
+
+    size_ = static_cast<std::uint64_t>(size.QuadPart);
+}
+
+sendable_file::~sendable_file()
+{
+    CloseHandle(handle_);
+}
+
+auto sendable_file::read(const std::uint64_t offset, const std::span<std::byte> data) const -> std::size_t
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    const auto size = static_cast<DWORD>(std::min<std::size_t>(std::size(data), std::numeric_limits<DWORD>::max()));
+    DWORD result = 0;
+
+    if (!ReadFile(handle_, std::data(data), size, &result, &overlapped))
+    {
+        const auto error = GetLastError();
+
+        if (error != ERROR_HANDLE_EOF)
+            throw std::system_error{static_cast<int>(error), std::system_category()};
+    }
+
+    return result;
+}
+
+#else
+
+sendable_file::sendable_file(const std::filesystem::path &path)
+    : handle_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)}
+    , size_{0}
+{
+    if (handle_ < 0)
+        throw std::system_error{errno, std::generic_category()};
+
+    struct stat status
+    {
+    };
+
+    if (::fstat(handle_, &status) != 0)
+    {
+        const auto error = errno;
+        ::close(handle_);
+        throw std::system_error{error, std::generic_category()};
+    }
+
+    size_ = static_cast<std::uint64_t>(status.st_size);
+}
+
+sendable_file::~sendable_file()
+{
+    ::close(handle_);
+}
+
+auto sendable_file::read(const std::uint64_t offset, const std::span<std::byte> data) const -> std::size_t
+{
+    std::size_t total = 0;
+
+    while (total < std::size(data))
+    {
+        const auto result = ::pread(handle_, std::data(data) + total, std::size(data) - total,
+                                    static_cast<off_t>(offset + total));
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw std::system_error{errno, std::generic_category()};
+        }
+
+        if (result == 0)
+            break;
+
+        total += static_cast<std::size_t>(result);
+    }
+
+    return total;
+}
+
+#endif
+
+auto sendable_file::size() const noexcept -> std::uint64_t
+{
+    return size_;
+}
+
+} // namespace aeon::sockets
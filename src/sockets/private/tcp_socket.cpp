@@ -1,10 +1,18 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/sockets/tcp_socket.h>
-#include <aeon/streams/stream_reader.h>
 #include <asio/write.hpp>
 #include <asio/connect.hpp>
 #include <asio/bind_executor.hpp>
+#include <asio/dispatch.hpp>
+#include <algorithm>
+#include <limits>
+#include <system_error>
+
+#if (defined(AEON_PLATFORM_OS_LINUX))
+#include <sys/sendfile.h>
+#include <cerrno>
+#endif
 
 namespace aeon::sockets
 {
@@ -12,16 +20,26 @@ namespace aeon::sockets
 tcp_socket::tcp_socket(asio::io_context &context)
     : context_{context}
     , socket_{context}
-    , data_{}
+    , receive_buffer_size_{tcp_socket_max_buff_len}
     , send_data_queue_{}
+    , send_in_progress_{0}
+    , write_buffers_{}
+#if (!defined(AEON_PLATFORM_OS_LINUX))
+    , file_buffer_{}
+#endif
 {
 }
 
 tcp_socket::tcp_socket(asio::ip::tcp::socket socket)
     : context_{static_cast<asio::io_context &>(socket.get_executor().context())}
     , socket_{std::move(socket)}
-    , data_{}
+    , receive_buffer_size_{tcp_socket_max_buff_len}
     , send_data_queue_{}
+    , send_in_progress_{0}
+    , write_buffers_{}
+#if (!defined(AEON_PLATFORM_OS_LINUX))
+    , file_buffer_{}
+#endif
 {
 }
 
@@ -39,6 +57,10 @@ void tcp_socket::on_error([[maybe_unused]] const std::error_code &ec)
 {
 }
 
+void tcp_socket::on_send_queue_empty()
+{
+}
+
 void tcp_socket::send(std::vector<std::byte> data)
 {
     if (std::empty(data))
@@ -46,15 +68,35 @@ void tcp_socket::send(std::vector<std::byte> data)
 
     auto self(shared_from_this());
 
-    asio::post(context_,
-               [self, data = std::move(data)]() mutable
-               {
-                   const auto write_in_progress = !std::empty(self->send_data_queue_);
+    // When called from the thread of the socket (for example from on_data), the data is queued right away.
+    asio::dispatch(context_, [self, data = std::move(data)]() mutable
+                   { self->internal_queue_send(send_buffer{.data = std::move(data)}); });
+}
 
-                   self->send_data_queue_.push(std::move(data));
-                   if (!write_in_progress)
-                       self->internal_handle_write();
-               });
+void tcp_socket::send(shared_buffer data)
+{
+    if (!data || std::empty(*data))
+        return;
+
+    auto self(shared_from_this());
+
+    asio::dispatch(context_, [self, data = std::move(data)]() mutable
+                   { self->internal_queue_send(send_buffer{.shared_data = std::move(data)}); });
+}
+
+void tcp_socket::send_file(std::shared_ptr<const sendable_file> file, const std::uint64_t offset,
+                           const std::uint64_t size)
+{
+    if (!file || size == 0)
+        return;
+
+    auto self(shared_from_this());
+
+    asio::dispatch(context_, [self, file = std::move(file), offset, size]() mutable
+                   {
+                       self->internal_queue_send(
+                           send_buffer{.file = std::move(file), .file_offset = offset, .file_size = size});
+                   });
 }
 
 void tcp_socket::disconnect()
@@ -81,8 +123,19 @@ void tcp_socket::internal_connect(const asio::ip::basic_resolver_results<asio::i
                         asio::bind_executor(context_,
                                             [self](const std::error_code ec, auto)
                                             {
-                                                if (ec && ec != asio::error::eof)
+                                                // A connection that could not be established is reported as an
+                                                // error, followed by a disconnect; never as connected.
+                                                if (ec)
+                                                {
                                                     self->on_error(ec);
+                                                    self->socket_.close();
+                                                    self->on_disconnected();
+                                                    return;
+                                                }
+
+                                                std::error_code option_ec;
+                                                self->socket_.non_blocking(true, option_ec);
+                                                self->socket_.set_option(asio::ip::tcp::no_delay{true}, option_ec);
 
                                                 self->internal_handle_read();
                                                 self->on_connected();
@@ -91,6 +144,11 @@ void tcp_socket::internal_connect(const asio::ip::basic_resolver_results<asio::i
 
 void tcp_socket::internal_socket_start()
 {
+    // Reads are done once the socket is readable; see internal_handle_read.
+    std::error_code ec;
+    socket_.non_blocking(true, ec);
+    socket_.set_option(asio::ip::tcp::no_delay{true}, ec);
+
     internal_handle_read();
     on_connected();
 }
@@ -99,50 +157,227 @@ void tcp_socket::internal_handle_read()
 {
     auto self(shared_from_this());
 
-    socket_.async_read_some(asio::buffer(data_, tcp_socket_max_buff_len),
-                            asio::bind_executor(context_,
-                                                [self](const std::error_code ec, const std::size_t length)
-                                                {
-                                                    if (ec && ec != asio::error::eof)
-                                                        self->on_error(ec);
+    // Wait until data can be read before a buffer is taken from the pool, instead of holding on to a buffer for as long
+    // as a read is pending. This keeps the memory use of idle connections to a minimum.
+    socket_.async_wait(asio::ip::tcp::socket::wait_read,
+                       asio::bind_executor(context_, [self](const std::error_code ec)
+                                           { self->internal_read_available(ec); }));
+}
+
+void tcp_socket::internal_read_available(const std::error_code &wait_ec)
+{
+    auto ec = wait_ec;
+    auto length = std::size_t{0};
+    pooled_buffer buffer;
+
+    if (!ec)
+    {
+        buffer = buffer_pool::get_default().acquire(receive_buffer_size_);
+        length = socket_.read_some(asio::buffer(buffer.data(), buffer.size()), ec);
+
+        // The socket was reported as readable, but there was nothing to read after all.
+        if (ec == asio::error::would_block || ec == asio::error::try_again)
+        {
+            internal_handle_read();
+            return;
+        }
+    }
+
+    if (ec && ec != asio::error::eof)
+        on_error(ec);
+
+    if (length > 0)
+    {
+        on_data({buffer.data(), length});
+        internal_update_receive_buffer_size(buffer.size(), length);
+
+        // The buffer goes back to the pool before waiting for more data.
+        buffer.reset();
+
+        if (!ec && socket_.is_open())
+            internal_handle_read();
+    }
+    else
+    {
+        socket_.close();
+        on_disconnected();
+    }
+}
 
-                                                    if (length > 0)
-                                                    {
-                                                        self->on_data({self->data_.data(), length});
+void tcp_socket::internal_update_receive_buffer_size(const std::size_t size, const std::size_t length) noexcept
+{
+    if (length == size && size < tcp_socket_max_receive_buffer_size)
+        receive_buffer_size_ = size * 2;
+    else if (length < size / 4 && size > tcp_socket_min_receive_buffer_size)
+        receive_buffer_size_ = size / 2;
+}
+
+void tcp_socket::internal_queue_send(send_buffer buffer)
+{
+    send_data_queue_.push_back(std::move(buffer));
 
-                                                        if (!ec && self->socket_.is_open())
-                                                            self->internal_handle_read();
-                                                    }
-                                                    else
-                                                    {
-                                                        self->socket_.close();
-                                                        self->on_disconnected();
-                                                    }
-                                                }));
+    if (send_in_progress_ == 0)
+        internal_handle_write();
 }
 
 void tcp_socket::internal_handle_write()
 {
+    // Files are written on their own.
+    if (send_data_queue_.front().file)
+    {
+        internal_write_file();
+        return;
+    }
+
     auto self(shared_from_this());
 
-    const auto &data = send_data_queue_.front();
+    // Everything that was queued so far, up to the next file, is written in one go.
+    write_buffers_.clear();
+
+    for (const auto &buffer : send_data_queue_)
+    {
+        if (buffer.file)
+            break;
+
+        const auto data = buffer.view();
+        write_buffers_.emplace_back(std::data(data), std::size(data));
+    }
+
+    send_in_progress_ = std::size(write_buffers_);
+
+    // A span is passed rather than the vector itself, so that asio does not copy it.
+    asio::async_write(socket_, std::span<const asio::const_buffer>{write_buffers_},
+                      asio::bind_executor(context_,
+                                          [self](const std::error_code ec, const std::size_t /*length*/)
+                                          {
+                                              if (ec && ec != asio::error::eof)
+                                              {
+                                                  self->internal_handle_write_error(ec);
+                                                  return;
+                                              }
+
+                                              const auto written = std::begin(self->send_data_queue_) +
+                                                                   static_cast<std::ptrdiff_t>(self->send_in_progress_);
+                                              self->send_data_queue_.erase(std::begin(self->send_data_queue_), written);
+                                              self->send_in_progress_ = 0;
+
+                                              if (!std::empty(self->send_data_queue_))
+                                                  self->internal_handle_write();
+                                              else
+                                                  self->on_send_queue_empty();
+                                          }));
+}
+
+void tcp_socket::internal_write_file()
+{
+    auto &buffer = send_data_queue_.front();
+    send_in_progress_ = 1;
+
+#if (defined(AEON_PLATFORM_OS_LINUX))
+    // Send as much as the socket accepts right away, and wait for it to become writable again when it is full.
+    while (buffer.file_size > 0)
+    {
+        auto offset = static_cast<off_t>(buffer.file_offset);
+        const auto size = static_cast<std::size_t>(
+            std::min<std::uint64_t>(buffer.file_size, std::numeric_limits<std::size_t>::max()));
+        const auto result = ::sendfile(socket_.native_handle(), buffer.file->handle_, &offset, size);
 
-    asio::async_write(self->socket_, asio::buffer(std::data(*data), std::size(*data)),
-                      [self](const std::error_code ec, const std::size_t /*length*/)
-                      {
-                          if (ec && ec != asio::error::eof)
-                          {
-                              self->on_error(ec);
-                              self->on_disconnected();
-                              self->socket_.close();
-                              return;
-                          }
+        if (result > 0)
+        {
+            buffer.file_offset += static_cast<std::uint64_t>(result);
+            buffer.file_size -= static_cast<std::uint64_t>(result);
+            continue;
+        }
 
-                          self->send_data_queue_.pop();
+        if (result < 0 && errno == EINTR)
+            continue;
 
-                          if (!std::empty(self->send_data_queue_))
-                              self->internal_handle_write();
-                      });
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            auto self(shared_from_this());
+            socket_.async_wait(asio::ip::tcp::socket::wait_write,
+                               asio::bind_executor(context_,
+                                                   [self](const std::error_code ec)
+                                                   {
+                                                       if (ec)
+                                                       {
+                                                           self->internal_handle_write_error(ec);
+                                                           return;
+                                                       }
+
+                                                       self->internal_write_file();
+                                                   }));
+            return;
+        }
+
+        // Nothing could be sent if the file was truncated after it was opened.
+        internal_handle_write_error((result < 0) ? std::error_code{errno, std::generic_category()}
+                                                 : std::make_error_code(std::errc::io_error));
+        return;
+    }
+#else
+    if (buffer.file_size > 0)
+    {
+        const auto size =
+            static_cast<std::size_t>(std::min<std::uint64_t>(buffer.file_size, buffer_pool::max_size_class));
+        file_buffer_ = buffer_pool::get_default().acquire(size);
+
+        std::size_t length = 0;
+
+        try
+        {
+            length = buffer.file->read(buffer.file_offset, file_buffer_.span().first(size));
+        }
+        catch (const std::system_error &e)
+        {
+            internal_handle_write_error(e.code());
+            return;
+        }
+
+        if (length == 0)
+        {
+            internal_handle_write_error(std::make_error_code(std::errc::io_error));
+            return;
+        }
+
+        buffer.file_offset += length;
+        buffer.file_size -= length;
+
+        auto self(shared_from_this());
+        asio::async_write(socket_, asio::buffer(file_buffer_.data(), length),
+                          asio::bind_executor(context_,
+                                              [self](const std::error_code ec, const std::size_t /*length*/)
+                                              {
+                                                  if (ec && ec != asio::error::eof)
+                                                  {
+                                                      self->internal_handle_write_error(ec);
+                                                      return;
+                                                  }
+
+                                                  self->internal_write_file();
+                                              }));
+        return;
+    }
+
+    file_buffer_.reset();
+#endif
+
+    send_data_queue_.pop_front();
+    send_in_progress_ = 0;
+
+    if (!std::empty(send_data_queue_))
+        internal_handle_write();
+    else
+        on_send_queue_empty();
+}
+
+void tcp_socket::internal_handle_write_error(const std::error_code &ec)
+{
+    send_data_queue_.clear();
+    send_in_progress_ = 0;
+    on_error(ec);
+    on_disconnected();
+    socket_.close();
 }
 
 } // namespace aeon::sockets
@@ -0,0 +1,128 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <span>
+#include <cstddef>
+
+namespace aeon::sockets
+{
+
+class buffer_pool;
+
+/*!
+ * A block of memory that is returned to the buffer_pool it came from when it is destroyed.
+ */
+class pooled_buffer final
+{
+    friend class buffer_pool;
+
+public:
+    pooled_buffer() noexcept;
+    ~pooled_buffer();
+
+    pooled_buffer(pooled_buffer &&other) noexcept;
+    auto operator=(pooled_buffer &&other) noexcept -> pooled_buffer &;
+
+    pooled_buffer(const pooled_buffer &) = delete;
+    auto operator=(const pooled_buffer &) -> pooled_buffer & = delete;
+
+    [[nodiscard]] auto data() const noexcept -> std::byte *
+    {
+        return data_.get();
+    }
+
+    /*!
+     * The size of the block. This is the requested size rounded up to the size class of the pool.
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return size_;
+    }
+
+    [[nodiscard]] auto span() const noexcept -> std::span<std::byte>
+    {
+        return {data_.get(), size_};
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+        return data_ != nullptr;
+    }
+
+    /*!
+     * Return the block to the pool.
+     */
+    void reset() noexcept;
+
+private:
+    pooled_buffer(buffer_pool *pool, std::unique_ptr<std::byte[]> data, const std::size_t size) noexcept;
+
+    buffer_pool *pool_;
+    std::unique_ptr<std::byte[]> data_;
+    std::size_t size_;
+};
+
+/*!
+ * Pool of memory blocks in power of two size classes, so that sockets do not have to allocate memory for every read.
+ * Blocks larger than the largest size class are allocated and freed directly. The pool is thread safe; every size
+ * class has a lock of its own.
+ */
+class buffer_pool final
+{
+    friend class pooled_buffer;
+
+public:
+    static constexpr std::size_t min_size_class = 512;
+    static constexpr std::size_t max_size_class = 64 * 1024;
+
+    // The amount of unused blocks that are kept per size class by default. Additional blocks are freed.
+    static constexpr std::size_t default_max_cached_buffers = 256;
+
+    explicit buffer_pool(const std::size_t max_cached_buffers = default_max_cached_buffers);
+    ~buffer_pool() = default;
+
+    buffer_pool(buffer_pool &&) = delete;
+    auto operator=(buffer_pool &&) -> buffer_pool & = delete;
+
+    buffer_pool(const buffer_pool &) = delete;
+    auto operator=(const buffer_pool &) -> buffer_pool & = delete;
+
+    /*!
+     * Get a block of at least the given size. The contents of the block are undefined.
+     */
+    [[nodiscard]] auto acquire(const std::size_t size) -> pooled_buffer;
+
+    /*!
+     * The pool that is shared by all sockets.
+     */
+    [[nodiscard]] static auto get_default() -> buffer_pool &;
+
+    /*!
+     * Round a size up to the size of the block that acquire() would return.
+     */
+    [[nodiscard]] static auto round_to_size_class(const std::size_t size) noexcept -> std::size_t;
+
+private:
+    struct size_class final
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<std::byte[]>> buffers;
+    };
+
+    static constexpr std::size_t size_class_count = 8;
+    static_assert((min_size_class << (size_class_count - 1)) == max_size_class);
+
+    [[nodiscard]] static auto size_class_index(const std::size_t size) noexcept -> std::size_t;
+
+    void release(std::unique_ptr<std::byte[]> data, const std::size_t size) noexcept;
+
+    std::size_t max_cached_buffers_;
+    std::array<size_class, size_class_count> size_classes_;
+};
+
+} // namespace aeon::sockets
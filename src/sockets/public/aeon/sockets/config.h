@@ -5,7 +5,15 @@
 namespace aeon::sockets
 {
 
+// The initial size of the receive buffer of a tcp_socket. It grows up to tcp_socket_max_receive_buffer_size while
+// reads keep filling it up, and shrinks again when they do not.
 static inline constexpr auto tcp_socket_max_buff_len = 2048;
-static inline constexpr auto tcp_socket_circular_buffer_size = 1024 * 1024;
+static inline constexpr auto tcp_socket_min_receive_buffer_size = 512;
+static inline constexpr auto tcp_socket_max_receive_buffer_size = 64 * 1024;
+
+// The size of the chunks a receive_buffer is made of, and the maximum amount of unprocessed data it can hold before
+// the connection is considered to be misbehaving.
+static inline constexpr auto receive_buffer_chunk_size = 4096;
+static inline constexpr auto receive_buffer_max_size = 1024 * 1024;
 
 } // namespace aeon::sockets
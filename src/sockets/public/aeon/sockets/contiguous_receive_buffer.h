@@ -0,0 +1,73 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/sockets/buffer_pool.h>
+#include <aeon/sockets/config.h>
+#include <span>
+#include <cstddef>
+
+namespace aeon::sockets
+{
+
+/*!
+ * Buffer for data that was received on a connection but was not processed yet, for parsers that need the data in a
+ * single piece of memory (for example to refer to it with string views).
+ *
+ * The memory is taken from a buffer_pool when data is written, grows when needed, and is returned to the pool as soon
+ * as all data has been consumed.
+ */
+class contiguous_receive_buffer final
+{
+public:
+    explicit contiguous_receive_buffer(const std::size_t max_size = receive_buffer_max_size,
+                                       buffer_pool &pool = buffer_pool::get_default());
+    ~contiguous_receive_buffer() = default;
+
+    contiguous_receive_buffer(contiguous_receive_buffer &&) noexcept = default;
+    auto operator=(contiguous_receive_buffer &&) noexcept -> contiguous_receive_buffer & = default;
+
+    contiguous_receive_buffer(const contiguous_receive_buffer &) = delete;
+    auto operator=(const contiguous_receive_buffer &) -> contiguous_receive_buffer & = delete;
+
+    /*!
+     * Append data to the end of the buffer. Returns false, without writing anything, if the buffer would hold more than
+     * max_size bytes. Any spans previously returned by data() are invalidated.
+     */
+    [[nodiscard]] auto write(const std::span<const std::byte> data) -> bool;
+
+    /*!
+     * All data in the buffer.
+     */
+    [[nodiscard]] auto data() const noexcept -> std::span<const std::byte>;
+
+    /*!
+     * Discard data from the start of the buffer.
+     */
+    void consume(const std::size_t size) noexcept;
+
+    /*!
+     * Discard all data and return the memory to the pool.
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    /*!
+     * The amount of memory that is currently held by the buffer.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+private:
+    buffer_pool *pool_;
+    std::size_t max_size_;
+    pooled_buffer buffer_;
+
+    // The start of the data that was not consumed yet.
+    std::size_t offset_;
+    std::size_t size_;
+};
+
+} // namespace aeon::sockets
@@ -3,16 +3,24 @@
 #pragma once
 
 #include <aeon/sockets/tcp_socket.h>
+#include <aeon/sockets/buffer_pool.h>
+#include <aeon/sockets/config.h>
 #include <aeon/streams/devices/memory_device.h>
-#include <aeon/streams/filters/circular_buffer_filter.h>
-#include <aeon/streams/stream.h>
-#include <aeon/streams/stream_reader.h>
 #include <aeon/streams/stream_writer.h>
 #include <concepts>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <system_error>
+#include <cstring>
 
 namespace aeon::sockets
 {
 
+/*!
+ * Builds a frame for a length_prefixed_binary_protocol_socket. Space for the length is reserved at the start of the
+ * frame when it is created, and the length is filled in by release(), so that the data never has to be moved.
+ */
 template <std::unsigned_integral length_t>
 class length_prefixed_binary_frame : public streams::stream_writer<streams::memory_device<std::vector<std::byte>>>
 {
@@ -23,7 +31,7 @@ public:
         if (reserve_size > 0)
             device_.reserve(reserve_size + sizeof(length_t));
 
-        // Write placeholder length at the start to avoid reallocation later
+        // Reserve space for the length at the start, so that it can be filled in without moving the data.
         *this << length_t();
     }
 
@@ -50,12 +58,23 @@ public:
     length_prefixed_binary_frame(const length_prefixed_binary_frame &) = delete;
     auto operator=(const length_prefixed_binary_frame &) -> length_prefixed_binary_frame & = delete;
 
-    [[nodiscard]] auto release() noexcept
+    /*!
+     * Append raw data to the frame.
+     */
+    void write(const std::span<const std::byte> data)
     {
-        device_.seekp(0, streams::seek_direction::begin);
-        *this << length_t(device_.size() - sizeof(length_t));
+        device_.write(std::data(data), static_cast<std::streamsize>(std::size(data)));
+    }
 
-        return std::move(device_.release());
+    /*!
+     * Get the data of the frame, including the length.
+     */
+    [[nodiscard]] auto release() noexcept -> std::vector<std::byte>
+    {
+        auto data = device_.release();
+        const auto length = static_cast<length_t>(std::size(data) - sizeof(length_t));
+        std::memcpy(std::data(data), &length, sizeof(length_t));
+        return data;
     }
 
 private:
@@ -65,6 +84,10 @@ private:
 /*!
  * Protocol implementation for a binary protocol that has its frames prefixed by a length
  * This is very common for binary protocol implementations over TCP
+ *
+ * Frames that were received completely in a single read are passed to on_frame straight from the receive buffer of the
+ * socket. Only frames that are split over multiple reads are copied, into a buffer from buffer_pool::get_default() that
+ * is returned once the frame was handled. The connection is closed if a frame is larger than receive_buffer_max_size.
  */
 template <std::unsigned_integral length_t>
 class length_prefixed_binary_protocol_socket : public tcp_socket
@@ -88,27 +111,40 @@ public:
     length_prefixed_binary_protocol_socket(const length_prefixed_binary_protocol_socket &) = delete;
     auto operator=(const length_prefixed_binary_protocol_socket &) -> length_prefixed_binary_protocol_socket & = delete;
 
-    virtual void on_frame(const streams::memory_view_device<std::vector<std::byte>> &frame) = 0;
+    /*!
+     * Called for every received frame, without the length. The data is only valid during the call.
+     */
+    virtual void on_frame(const std::span<const std::byte> &frame) = 0;
 
     void send_frame(length_prefixed_binary_frame<length_t> frame);
 
 private:
     void on_data(const std::span<const std::byte> &data) override;
 
-    streams::aggregate_device<streams::circular_buffer_filter, streams::memory_device<std::vector<std::byte>>>
-        circular_buffer_;
+    /*!
+     * Copy data into the frame that is split over multiple reads, and call on_frame once it is complete. Returns the
+     * data that is left after the frame.
+     */
+    auto internal_read_partial_frame(std::span<const std::byte> data) -> std::span<const std::byte>;
+
+    void internal_reset_partial_frame() noexcept;
 
-    length_t expected_length_;
-    std::vector<std::byte> frame_buffer_;
+    std::array<std::byte, sizeof(length_t)> partial_header_;
+    std::size_t partial_header_size_;
+    pooled_buffer partial_frame_;
+    length_t partial_frame_length_;
+    std::size_t partial_frame_size_;
 };
 
 template <std::unsigned_integral length_t>
 inline length_prefixed_binary_protocol_socket<length_t>::length_prefixed_binary_protocol_socket(
     asio::io_context &service)
     : tcp_socket(service)
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<std::byte>>{tcp_socket_circular_buffer_size}}
-    , expected_length_{0}
+    , partial_header_{}
+    , partial_header_size_{0}
+    , partial_frame_{}
+    , partial_frame_length_{0}
+    , partial_frame_size_{0}
 {
 }
 
@@ -116,9 +152,11 @@ template <std::unsigned_integral length_t>
 inline length_prefixed_binary_protocol_socket<length_t>::length_prefixed_binary_protocol_socket(
     asio::ip::tcp::socket socket)
     : tcp_socket(std::move(socket))
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<std::byte>>{tcp_socket_circular_buffer_size}}
-    , expected_length_{0}
+    , partial_header_{}
+    , partial_header_size_{0}
+    , partial_frame_{}
+    , partial_frame_length_{0}
+    , partial_frame_size_{0}
 {
 }
 
@@ -131,27 +169,80 @@ void length_prefixed_binary_protocol_socket<length_t>::send_frame(length_prefixe
 template <std::unsigned_integral length_t>
 inline void length_prefixed_binary_protocol_socket<length_t>::on_data(const std::span<const std::byte> &data)
 {
-    circular_buffer_.write(std::data(data), std::size(data));
-    streams::stream_reader reader{circular_buffer_};
+    auto remaining = data;
 
-    while (true)
+    if (partial_header_size_ > 0)
     {
-        if (expected_length_ == 0 && circular_buffer_.size() >= sizeof(length_t))
-            reader >> expected_length_;
+        remaining = internal_read_partial_frame(remaining);
 
-        if (expected_length_ == 0)
-            break;
+        if (partial_header_size_ > 0)
+            return;
+    }
+
+    while (std::size(remaining) >= sizeof(length_t))
+    {
+        length_t length;
+        std::memcpy(&length, std::data(remaining), sizeof(length_t));
 
-        if (circular_buffer_.size() < expected_length_)
+        if (std::size(remaining) - sizeof(length_t) < length)
             break;
 
-        reader.template read_to_vector<std::byte>(frame_buffer_, static_cast<std::streamoff>(expected_length_));
-        streams::memory_view_device device{frame_buffer_};
-        on_frame(device);
-        frame_buffer_.clear();
+        on_frame(remaining.subspan(sizeof(length_t), length));
+        remaining = remaining.subspan(sizeof(length_t) + length);
+    }
+
+    if (!std::empty(remaining))
+        internal_read_partial_frame(remaining);
+}
+
+template <std::unsigned_integral length_t>
+inline auto length_prefixed_binary_protocol_socket<length_t>::internal_read_partial_frame(
+    std::span<const std::byte> data) -> std::span<const std::byte>
+{
+    // The length itself may also be split over multiple reads.
+    if (partial_header_size_ < sizeof(length_t))
+    {
+        const auto count = std::min(sizeof(length_t) - partial_header_size_, std::size(data));
+        std::memcpy(std::data(partial_header_) + partial_header_size_, std::data(data), count);
+        partial_header_size_ += count;
+        data = data.subspan(count);
+
+        if (partial_header_size_ < sizeof(length_t))
+            return data;
+
+        std::memcpy(&partial_frame_length_, std::data(partial_header_), sizeof(length_t));
 
-        expected_length_ = 0;
+        if (partial_frame_length_ > static_cast<std::size_t>(receive_buffer_max_size))
+        {
+            internal_reset_partial_frame();
+            on_error(std::make_error_code(std::errc::no_buffer_space));
+            disconnect();
+            return {};
+        }
+
+        partial_frame_ = buffer_pool::get_default().acquire(partial_frame_length_);
     }
+
+    const auto count = std::min(partial_frame_length_ - partial_frame_size_, std::size(data));
+    std::memcpy(partial_frame_.data() + partial_frame_size_, std::data(data), count);
+    partial_frame_size_ += count;
+    data = data.subspan(count);
+
+    if (partial_frame_size_ < partial_frame_length_)
+        return data;
+
+    on_frame(std::span<const std::byte>{partial_frame_.data(), partial_frame_length_});
+    internal_reset_partial_frame();
+    return data;
+}
+
+template <std::unsigned_integral length_t>
+inline void length_prefixed_binary_protocol_socket<length_t>::internal_reset_partial_frame() noexcept
+{
+    partial_header_size_ = 0;
+    partial_frame_.reset();
+    partial_frame_length_ = 0;
+    partial_frame_size_ = 0;
 }
 
 } // namespace aeon::sockets
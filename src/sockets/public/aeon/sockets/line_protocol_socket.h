@@ -3,9 +3,8 @@
 #pragma once
 
 #include <aeon/sockets/tcp_socket.h>
-#include <aeon/streams/devices/memory_device.h>
-#include <aeon/streams/filters/circular_buffer_filter.h>
-#include <aeon/streams/stream.h>
+#include <aeon/sockets/receive_buffer.h>
+#include <aeon/common/string.h>
 
 namespace aeon::sockets
 {
@@ -16,6 +15,8 @@ namespace aeon::sockets
  * line endings to distinguish between different packets.
  *
  * Examples of line protocols are: Telnet, HTTP and IRC.
+ *
+ * The connection is closed if a line is longer than receive_buffer_max_size.
  */
 class line_protocol_socket : public tcp_socket
 {
@@ -44,8 +45,7 @@ protected:
 private:
     void on_data(const std::span<const std::byte> &data) override;
 
-    streams::aggregate_device<streams::circular_buffer_filter, streams::memory_device<std::vector<char>>>
-        circular_buffer_;
+    receive_buffer receive_buffer_;
 };
 
 } // namespace aeon::sockets
@@ -0,0 +1,101 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/sockets/buffer_pool.h>
+#include <aeon/sockets/config.h>
+#include <aeon/common/string.h>
+#include <vector>
+#include <span>
+#include <cstddef>
+
+namespace aeon::sockets
+{
+
+/*!
+ * Buffer for data that was received on a connection but was not processed yet, for example an incomplete line or
+ * frame.
+ *
+ * The data is stored in fixed size chunks from a buffer_pool. Chunks are only taken from the pool when data is
+ * written, and are returned as soon as all data in them has been consumed. A connection that has no unprocessed data
+ * therefore does not hold on to any memory.
+ */
+class receive_buffer final
+{
+public:
+    static constexpr auto npos = static_cast<std::size_t>(-1);
+
+    explicit receive_buffer(const std::size_t max_size = receive_buffer_max_size,
+                            buffer_pool &pool = buffer_pool::get_default(),
+                            const std::size_t chunk_size = receive_buffer_chunk_size);
+    ~receive_buffer() = default;
+
+    receive_buffer(receive_buffer &&) noexcept = default;
+    auto operator=(receive_buffer &&) noexcept -> receive_buffer & = default;
+
+    receive_buffer(const receive_buffer &) = delete;
+    auto operator=(const receive_buffer &) -> receive_buffer & = delete;
+
+    /*!
+     * Append data to the end of the buffer. Returns false, without writing anything, if the buffer would hold more than
+     * max_size bytes.
+     */
+    [[nodiscard]] auto write(const std::span<const std::byte> data) -> bool;
+
+    /*!
+     * Copy data from the start of the buffer without consuming it. Returns the amount of bytes that were copied.
+     */
+    [[nodiscard]] auto peek(std::byte *data, const std::size_t size) const noexcept -> std::size_t;
+
+    /*!
+     * Copy data from the start of the buffer and consume it. Returns the amount of bytes that were copied.
+     */
+    auto read(std::byte *data, const std::size_t size) noexcept -> std::size_t;
+
+    /*!
+     * Read and consume a line that ends with \n or \r\n. The line ending is not included. Returns false, leaving the
+     * buffer unchanged, if the buffer does not contain a complete line.
+     */
+    [[nodiscard]] auto read_line(common::string &line) -> bool;
+
+    /*!
+     * Discard data from the start of the buffer.
+     */
+    void consume(const std::size_t size) noexcept;
+
+    /*!
+     * The offset of the first occurrence of the given value, or npos if it is not in the buffer.
+     */
+    [[nodiscard]] auto find(const std::byte value) const noexcept -> std::size_t;
+
+    /*!
+     * The data at the start of the buffer that is stored contiguously. This may be less than size().
+     */
+    [[nodiscard]] auto front() const noexcept -> std::span<const std::byte>;
+
+    /*!
+     * Discard all data and return all chunks to the pool.
+     */
+    void clear() noexcept;
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    /*!
+     * The amount of memory that is currently held by the buffer.
+     */
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+private:
+    buffer_pool *pool_;
+    std::size_t chunk_size_;
+    std::size_t max_size_;
+    std::vector<pooled_buffer> chunks_;
+
+    // The read offset within the first chunk.
+    std::size_t offset_;
+    std::size_t size_;
+};
+
+} // namespace aeon::sockets
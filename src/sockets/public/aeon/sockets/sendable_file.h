@@ -0,0 +1,59 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/common/platform.h>
+#include <filesystem>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::sockets
+{
+
+/*!
+ * A file that is opened for reading, so that (parts of) it can be sent with tcp_socket::send_file. On Linux the file is
+ * sent with sendfile, so that its content is never copied into user space.
+ *
+ * The file can be sent to multiple sockets at the same time; it stays open for as long as it is referenced. Reads are
+ * done at an explicit offset, so they do not affect each other.
+ */
+class sendable_file final
+{
+    friend class tcp_socket;
+
+public:
+    /*!
+     * Open a file. Throws std::system_error if the file could not be opened.
+     */
+    explicit sendable_file(const std::filesystem::path &path);
+    ~sendable_file();
+
+    sendable_file(sendable_file &&) = delete;
+    auto operator=(sendable_file &&) -> sendable_file & = delete;
+
+    sendable_file(const sendable_file &) = delete;
+    auto operator=(const sendable_file &) -> sendable_file & = delete;
+
+    /*!
+     * The size of the file at the time it was opened.
+     */
+    [[nodiscard]] auto size() const noexcept -> std::uint64_t;
+
+    /*!
+     * Read data from the file at the given offset. Returns the amount of bytes that were read, which is only less than
+     * the size of the given data at the end of the file. Throws std::system_error if the read failed.
+     */
+    [[nodiscard]] auto read(const std::uint64_t offset, const std::span<std::byte> data) const -> std::size_t;
+
+private:
+#if (defined(AEON_PLATFORM_OS_WINDOWS))
+    void *handle_;
+#else
+    int handle_;
+#endif
+
+    std::uint64_t size_;
+};
+
+} // namespace aeon::sockets
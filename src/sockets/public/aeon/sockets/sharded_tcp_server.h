@@ -0,0 +1,298 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/sockets/tcp_server.h>
+#include <aeon/sockets/tcp_socket.h>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/executor_work_guard.hpp>
+#include <asio/post.hpp>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::sockets
+{
+
+namespace internal
+{
+
+#if (defined(SO_REUSEPORT))
+using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+static inline constexpr auto has_reuse_port = true;
+#else
+static inline constexpr auto has_reuse_port = false;
+#endif
+
+} // namespace internal
+
+/*!
+ * Determines how incoming connections are distributed over the threads of a sharded_tcp_server.
+ */
+enum class tcp_server_accept_mode
+{
+    // Every shard has an acceptor of its own, bound to the same port with SO_REUSEPORT, so that the kernel distributes
+    // the connections. Falls back to round_robin on platforms that do not support SO_REUSEPORT.
+    reuse_port,
+
+    // A single acceptor on the first shard hands the accepted connections to all shards in turn.
+    round_robin
+};
+
+struct sharded_tcp_server_settings final
+{
+    sharded_tcp_server_settings() = default;
+    ~sharded_tcp_server_settings() = default;
+
+    sharded_tcp_server_settings(sharded_tcp_server_settings &&) = default;
+    auto operator=(sharded_tcp_server_settings &&) -> sharded_tcp_server_settings & = default;
+
+    sharded_tcp_server_settings(const sharded_tcp_server_settings &) = default;
+    auto operator=(const sharded_tcp_server_settings &) -> sharded_tcp_server_settings & = default;
+
+    // The port to listen on. 0 lets the operating system pick a free port; see sharded_tcp_server::port().
+    std::uint16_t port = 0;
+
+    // The amount of threads (and io_contexts). 0 uses one thread per hardware thread.
+    std::size_t thread_count = 0;
+
+    tcp_server_accept_mode accept_mode = tcp_server_accept_mode::reuse_port;
+};
+
+/*!
+ * TCP Server that handles connections on multiple threads.
+ *
+ * Every thread runs an io_context of its own (a shard). A connection is assigned to a single shard when it is
+ * accepted, and all of its handlers (on_data, on_disconnected, etc.) run on that shard's thread. Sockets therefore
+ * never need any locking, while different connections are handled in parallel.
+ *
+ * socket_t and session_t are the same as for tcp_server. There is a single session_t for all shards, which must be
+ * safe to use from multiple threads once run() is called; typically it is only configured before that.
+ */
+template <typename socket_t, typename session_t = default_session>
+class sharded_tcp_server
+{
+public:
+    explicit sharded_tcp_server(sharded_tcp_server_settings settings);
+    explicit sharded_tcp_server(std::unique_ptr<session_t> session_handler, sharded_tcp_server_settings settings);
+    ~sharded_tcp_server() = default;
+
+    sharded_tcp_server(sharded_tcp_server &&) = delete;
+    auto operator=(sharded_tcp_server &&) -> sharded_tcp_server & = delete;
+
+    sharded_tcp_server(const sharded_tcp_server &) = delete;
+    auto operator=(const sharded_tcp_server &) -> sharded_tcp_server & = delete;
+
+    /*!
+     * Run all shards until stop() is called. One shard runs on the calling thread, the others on threads of their own.
+     */
+    void run();
+
+    /*!
+     * Stop all shards. May be called from any thread.
+     */
+    void stop();
+
+    [[nodiscard]] auto get_session() const -> session_t &;
+
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t;
+
+    /*!
+     * The port the server is listening on.
+     */
+    [[nodiscard]] auto port() const -> std::uint16_t;
+
+private:
+    struct shard final
+    {
+        shard()
+            // Tells asio that only a single thread runs the io_context, so that it can optimize for that.
+            : context{1}
+            , work{asio::make_work_guard(context)}
+            , acceptor{}
+        {
+        }
+
+        asio::io_context context;
+        asio::executor_work_guard<asio::io_context::executor_type> work;
+        std::unique_ptr<asio::ip::tcp::acceptor> acceptor;
+    };
+
+    [[nodiscard]] static auto create_acceptor(asio::io_context &context, const std::uint16_t port,
+                                              const bool reuse_port) -> std::unique_ptr<asio::ip::tcp::acceptor>;
+
+    void start_async_accept(shard &source);
+    void start_socket(asio::ip::tcp::socket socket);
+    [[nodiscard]] auto next_shard() noexcept -> shard &;
+
+    // Declared before the shards, so that it outlives the sockets that are destroyed along with them.
+    std::unique_ptr<session_t> session_handler_;
+    std::vector<std::unique_ptr<shard>> shards_;
+    bool round_robin_;
+
+    // Only used by the thread of the first shard.
+    std::size_t next_shard_;
+};
+
+template <typename socket_t, typename session_t>
+inline sharded_tcp_server<socket_t, session_t>::sharded_tcp_server(sharded_tcp_server_settings settings)
+    : sharded_tcp_server{std::make_unique<session_t>(), std::move(settings)}
+{
+}
+
+template <typename socket_t, typename session_t>
+inline sharded_tcp_server<socket_t, session_t>::sharded_tcp_server(std::unique_ptr<session_t> session_handler,
+                                                                   sharded_tcp_server_settings settings)
+    : session_handler_{std::move(session_handler)}
+    , shards_{}
+    , round_robin_{settings.accept_mode == tcp_server_accept_mode::round_robin || !internal::has_reuse_port}
+    , next_shard_{0}
+{
+    auto thread_count = settings.thread_count;
+
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    shards_.reserve(thread_count);
+
+    for (std::size_t i = 0; i < thread_count; ++i)
+        shards_.emplace_back(std::make_unique<shard>());
+
+    // The first acceptor is bound first, so that the others use the same port if the operating system picked one.
+    auto &first = *shards_.front();
+    first.acceptor = create_acceptor(first.context, settings.port, !round_robin_);
+
+    if (!round_robin_)
+    {
+        const auto port = first.acceptor->local_endpoint().port();
+
+        for (std::size_t i = 1; i < thread_count; ++i)
+            shards_[i]->acceptor = create_acceptor(shards_[i]->context, port, true);
+    }
+
+    for (const auto &s : shards_)
+    {
+        if (s->acceptor)
+            start_async_accept(*s);
+    }
+}
+
+template <typename socket_t, typename session_t>
+inline void sharded_tcp_server<socket_t, session_t>::run()
+{
+    std::vector<std::thread> threads;
+    threads.reserve(std::size(shards_) - 1);
+
+    for (std::size_t i = 1; i < std::size(shards_); ++i)
+        threads.emplace_back([&context = shards_[i]->context]() { context.run(); });
+
+    shards_.front()->context.run();
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+template <typename socket_t, typename session_t>
+inline void sharded_tcp_server<socket_t, session_t>::stop()
+{
+    for (const auto &s : shards_)
+        s->context.stop();
+}
+
+template <typename socket_t, typename session_t>
+inline auto sharded_tcp_server<socket_t, session_t>::get_session() const -> session_t &
+{
+    return *session_handler_;
+}
+
+template <typename socket_t, typename session_t>
+inline auto sharded_tcp_server<socket_t, session_t>::thread_count() const noexcept -> std::size_t
+{
+    return std::size(shards_);
+}
+
+template <typename socket_t, typename session_t>
+inline auto sharded_tcp_server<socket_t, session_t>::port() const -> std::uint16_t
+{
+    return shards_.front()->acceptor->local_endpoint().port();
+}
+
+template <typename socket_t, typename session_t>
+inline auto sharded_tcp_server<socket_t, session_t>::create_acceptor(asio::io_context &context,
+                                                                     const std::uint16_t port, const bool reuse_port)
+    -> std::unique_ptr<asio::ip::tcp::acceptor>
+{
+    const asio::ip::tcp::endpoint endpoint{asio::ip::tcp::v4(), port};
+
+    auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(context);
+    acceptor->open(endpoint.protocol());
+    acceptor->set_option(asio::ip::tcp::acceptor::reuse_address{true});
+
+#if (defined(SO_REUSEPORT))
+    if (reuse_port)
+        acceptor->set_option(internal::reuse_port{true});
+#else
+    (void)reuse_port;
+#endif
+
+    acceptor->bind(endpoint);
+    acceptor->listen();
+    return acceptor;
+}
+
+template <typename socket_t, typename session_t>
+inline void sharded_tcp_server<socket_t, session_t>::start_async_accept(shard &source)
+{
+    auto &target = round_robin_ ? next_shard() : source;
+
+    source.acceptor->async_accept(target.context,
+                                  [this, &source, &target](const std::error_code ec, asio::ip::tcp::socket socket)
+                                  {
+                                      if (ec == asio::error::operation_aborted)
+                                          return;
+
+                                      if (!ec)
+                                      {
+                                          if (&source == &target)
+                                          {
+                                              start_socket(std::move(socket));
+                                          }
+                                          else
+                                          {
+                                              // The socket must be created on the thread of the shard it belongs to.
+                                              asio::post(target.context, [this, socket = std::move(socket)]() mutable
+                                                         { start_socket(std::move(socket)); });
+                                          }
+                                      }
+
+                                      start_async_accept(source);
+                                  });
+}
+
+template <typename socket_t, typename session_t>
+inline void sharded_tcp_server<socket_t, session_t>::start_socket(asio::ip::tcp::socket socket)
+{
+    if constexpr (std::is_same<session_t, default_session>::value)
+    {
+        std::make_shared<socket_t>(std::move(socket))->internal_socket_start();
+    }
+    else
+    {
+        std::make_shared<socket_t>(std::move(socket), *session_handler_)->internal_socket_start();
+    }
+}
+
+template <typename socket_t, typename session_t>
+inline auto sharded_tcp_server<socket_t, session_t>::next_shard() noexcept -> shard &
+{
+    auto &s = *shards_[next_shard_];
+    next_shard_ = (next_shard_ + 1) % std::size(shards_);
+    return s;
+}
+
+} // namespace aeon::sockets
@@ -30,6 +30,12 @@ public:
     void connect(const common::string &host, const std::uint16_t port);
     void connect(const common::string &host, const common::string &service);
 
+    /*!
+     * Connect to endpoints that were already resolved; for example to open multiple connections to the same host
+     * without resolving it for each of them.
+     */
+    void connect(const asio::ip::basic_resolver_results<asio::ip::tcp> &endpoints);
+
     auto operator->() const -> socket_handler_t *;
 
 protected:
@@ -75,6 +81,12 @@ inline void tcp_client<socket_handler_t>::connect(const common::string &host, co
     socket_->internal_connect(result);
 }
 
+template <typename socket_handler_t>
+inline void tcp_client<socket_handler_t>::connect(const asio::ip::basic_resolver_results<asio::ip::tcp> &endpoints)
+{
+    socket_->internal_connect(endpoints);
+}
+
 template <typename socket_handler_t>
 inline auto tcp_client<socket_handler_t>::operator->() const -> socket_handler_t *
 {
@@ -44,6 +44,12 @@ public:
 
     auto get_session() const -> session_t &;
 
+    /*!
+     * The port the server is listening on. Useful when the server was created with port 0, which lets the operating
+     * system pick a free port.
+     */
+    [[nodiscard]] auto port() const -> std::uint16_t;
+
 protected:
     void start_async_accept();
 
@@ -99,4 +105,10 @@ inline auto tcp_server<socket_t, session_t>::get_session() const -> session_t &
     return *session_handler_;
 }
 
+template <typename socket_t, typename session_t>
+inline auto tcp_server<socket_t, session_t>::port() const -> std::uint16_t
+{
+    return acceptor_.local_endpoint().port();
+}
+
 } // namespace aeon::sockets
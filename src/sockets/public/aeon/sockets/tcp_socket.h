@@ -3,22 +3,50 @@
 #pragma once
 
 #include <aeon/sockets/config.h>
-#include <aeon/common/unique_obj.h>
+#include <aeon/sockets/buffer_pool.h>
+#include <aeon/sockets/sendable_file.h>
 #include <asio/io_context.hpp>
 #include <asio/ip/tcp.hpp>
-#include <queue>
-#include <array>
+#include <deque>
+#include <vector>
 #include <memory>
 #include <span>
+#include <cstdint>
+#include <cstddef>
 
 namespace aeon::sockets
 {
 
+/*!
+ * Immutable data that can be sent to multiple sockets without being copied for each of them.
+ */
+using shared_buffer = std::shared_ptr<const std::vector<std::byte>>;
+
+[[nodiscard]] inline auto make_shared_buffer(std::vector<std::byte> data) -> shared_buffer
+{
+    return std::make_shared<const std::vector<std::byte>>(std::move(data));
+}
+
+/*!
+ * Base class for a TCP connection.
+ *
+ * Incoming data is read into a buffer from buffer_pool::get_default() and passed to on_data by reference; the data is
+ * only valid during the call. The size of the buffer adapts to the amount of data that is received per read. The buffer
+ * is only taken from the pool once data is available, so that idle connections do not hold on to it.
+ *
+ * All data that is queued for sending while a write is in progress is written with a single gathered write once the
+ * previous write completes. Since sends are already gathered this way, Nagle's algorithm is disabled (TCP_NODELAY); it
+ * would only delay responses that are sent while the previous write is still unacknowledged. Files that are queued with
+ * send_file are written on their own, in order with the other data.
+ */
 class tcp_socket : public std::enable_shared_from_this<tcp_socket>
 {
     template <typename socket_handler_t, typename session_handler_t>
     friend class tcp_server;
 
+    template <typename socket_handler_t, typename session_handler_t>
+    friend class sharded_tcp_server;
+
     template <typename socket_handler_t>
     friend class tcp_client;
 
@@ -46,20 +74,75 @@ public:
     virtual void on_data(const std::span<const std::byte> &data) = 0;
     virtual void on_error(const std::error_code &ec);
 
+    /*!
+     * Called on the thread of the socket once all queued data was written. This can be used to produce more data only
+     * once the previous data was sent, so that large amounts of data are sent without queuing all of it in memory.
+     */
+    virtual void on_send_queue_empty();
+
+    /*!
+     * Queue data to be sent. May be called from any thread.
+     */
     void send(std::vector<std::byte> data);
 
+    /*!
+     * Queue shared data to be sent. The data is referenced until it is written, instead of being copied.
+     */
+    void send(shared_buffer data);
+
+    /*!
+     * Queue part of a file to be sent, in order with other sent data. On Linux the file is sent with sendfile; on other
+     * platforms it is read in blocks. The file is referenced until it is written.
+     */
+    void send_file(std::shared_ptr<const sendable_file> file, const std::uint64_t offset, const std::uint64_t size);
+
     void disconnect();
 
 private:
     void internal_connect(const asio::ip::basic_resolver_results<asio::ip::tcp> &endpoint);
     void internal_socket_start();
     void internal_handle_read();
+    void internal_read_available(const std::error_code &wait_ec);
     void internal_handle_write();
+    void internal_write_file();
+    void internal_handle_write_error(const std::error_code &ec);
+    void internal_update_receive_buffer_size(const std::size_t size, const std::size_t length) noexcept;
+
+    struct send_buffer final
+    {
+        std::vector<std::byte> data{};
+        shared_buffer shared_data{};
+
+        // Set for a part of a file; the offset and size are updated while it is being written.
+        std::shared_ptr<const sendable_file> file{};
+        std::uint64_t file_offset = 0;
+        std::uint64_t file_size = 0;
+
+        [[nodiscard]] auto view() const noexcept -> std::span<const std::byte>
+        {
+            return shared_data ? std::span{*shared_data} : std::span{data};
+        }
+    };
+
+    void internal_queue_send(send_buffer buffer);
 
     asio::io_context &context_;
     asio::ip::tcp::socket socket_;
-    std::array<std::byte, tcp_socket_max_buff_len> data_;
-    std::queue<common::unique_obj<std::vector<std::byte>>> send_data_queue_;
+
+    std::size_t receive_buffer_size_;
+
+    std::deque<send_buffer> send_data_queue_;
+
+    // The amount of buffers at the front of the send queue that are being written.
+    std::size_t send_in_progress_;
+
+    // Reused for every write, so that it only allocates when more buffers are queued than ever before.
+    std::vector<asio::const_buffer> write_buffers_;
+
+#if (!defined(AEON_PLATFORM_OS_LINUX))
+    // Holds the block of a file that is being written.
+    pooled_buffer file_buffer_;
+#endif
 };
 
 } // namespace aeon::sockets
@@ -3,9 +3,32 @@
 #include <aeon/sockets/length_prefixed_binary_protocol_socket.h>
 #include <aeon/sockets/tcp_client.h>
 #include <aeon/common/hexdump.h>
+#include <iostream>
+#include <iomanip>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
 
 using namespace aeon;
 
+/*
+ * Usage: aeon_sockets_length_prefixed_binary_protocol_client [benchmark [frame size] [frame count]]
+ *
+ * In benchmark mode, the server must be started in benchmark mode as well. The client keeps a number of frames in
+ * flight, which the server echoes back, and prints the throughput once all frames have been received.
+ */
+struct benchmark_settings final
+{
+    bool enabled = false;
+    std::size_t frame_size = 4096;
+    std::size_t frame_count = 100000;
+};
+
+static benchmark_settings benchmark;
+static constexpr std::size_t benchmark_frames_in_flight = 64;
+
 class binary_socket : public sockets::length_prefixed_binary_protocol_socket<std::uint32_t>
 {
 public:
@@ -14,6 +37,10 @@ public:
      */
     explicit binary_socket(asio::io_context &service)
         : length_prefixed_binary_protocol_socket<std::uint32_t>{service}
+        , payload_(benchmark.frame_size)
+        , frames_sent_{0}
+        , frames_received_{0}
+        , start_{}
     {
     }
 
@@ -22,12 +49,22 @@ public:
      */
     explicit binary_socket(asio::ip::tcp::socket socket)
         : length_prefixed_binary_protocol_socket<std::uint32_t>{std::move(socket)}
+        , payload_(benchmark.frame_size)
+        , frames_sent_{0}
+        , frames_received_{0}
+        , start_{}
     {
     }
 
-    void on_frame(const streams::memory_view_device<std::vector<std::byte>> &frame) final
+    void on_frame(const std::span<const std::byte> &frame) final
     {
-        common::hexdump::pretty_print(stdout, std::data(frame.data()), std::size(frame.data()));
+        if (benchmark.enabled)
+        {
+            on_benchmark_frame();
+            return;
+        }
+
+        common::hexdump::pretty_print(stdout, std::data(frame), std::size(frame));
 
         sockets::length_prefixed_binary_frame<std::uint32_t> reply;
         reply << static_cast<std::uint32_t>(2);
@@ -40,6 +77,16 @@ public:
     {
         std::cout << "Connected to server.\n";
 
+        if (benchmark.enabled)
+        {
+            start_ = std::chrono::steady_clock::now();
+
+            for (std::size_t i = 0; i < std::min(benchmark_frames_in_flight, benchmark.frame_count); ++i)
+                send_benchmark_frame();
+
+            return;
+        }
+
         sockets::length_prefixed_binary_frame<std::uint32_t> frame;
         frame << static_cast<std::uint32_t>(2);
         frame << static_cast<std::uint32_t>(0x12345678);
@@ -51,10 +98,53 @@ public:
     {
         std::cout << "On Disconnected.\n";
     }
+
+private:
+    void send_benchmark_frame()
+    {
+        sockets::length_prefixed_binary_frame<std::uint32_t> frame{std::size(payload_)};
+        frame.write(payload_);
+        send_frame(std::move(frame));
+        ++frames_sent_;
+    }
+
+    void on_benchmark_frame()
+    {
+        ++frames_received_;
+
+        if (frames_sent_ < benchmark.frame_count)
+            send_benchmark_frame();
+
+        if (frames_received_ < benchmark.frame_count)
+            return;
+
+        const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start_}.count();
+        const auto bytes = static_cast<double>(frames_received_ * std::size(payload_));
+
+        std::cout << std::fixed << std::setprecision(0) << frames_received_ << " frames of " << std::size(payload_)
+                  << " bytes in " << std::setprecision(3) << elapsed << "s: " << std::setprecision(0)
+                  << static_cast<double>(frames_received_) / elapsed << " frames/s, " << std::setprecision(1)
+                  << bytes / elapsed / (1024.0 * 1024.0) << " MB/s\n";
+
+        disconnect();
+    }
+
+    std::vector<std::byte> payload_;
+    std::size_t frames_sent_;
+    std::size_t frames_received_;
+    std::chrono::steady_clock::time_point start_;
 };
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
+int main(int argc, char *argv[])
 {
+    benchmark.enabled = (argc > 1) && (std::string_view{argv[1]} == "benchmark");
+
+    if (argc > 2)
+        benchmark.frame_size = static_cast<std::size_t>(std::atoi(argv[2]));
+
+    if (argc > 3)
+        benchmark.frame_count = static_cast<std::size_t>(std::atoi(argv[3]));
+
     asio::io_context service;
     sockets::tcp_client<binary_socket> client{service};
 
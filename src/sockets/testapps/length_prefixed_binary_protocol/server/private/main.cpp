@@ -3,9 +3,18 @@
 #include <aeon/sockets/length_prefixed_binary_protocol_socket.h>
 #include <aeon/sockets/tcp_server.h>
 #include <aeon/common/hexdump.h>
+#include <iostream>
+#include <string_view>
 
 using namespace aeon;
 
+/*
+ * Usage: aeon_sockets_length_prefixed_binary_protocol_server [benchmark]
+ *
+ * In benchmark mode all frames are echoed back to the client as they are, without being printed.
+ */
+static bool benchmark = false;
+
 class binary_socket : public sockets::length_prefixed_binary_protocol_socket<std::uint32_t>
 {
 public:
@@ -25,9 +34,17 @@ public:
     {
     }
 
-    void on_frame(const streams::memory_view_device<std::vector<std::byte>> &frame) final
+    void on_frame(const std::span<const std::byte> &frame) final
     {
-        common::hexdump::pretty_print(stdout, std::data(frame.data()), std::size(frame.data()));
+        if (benchmark)
+        {
+            sockets::length_prefixed_binary_frame<std::uint32_t> reply{std::size(frame)};
+            reply.write(frame);
+            send_frame(std::move(reply));
+            return;
+        }
+
+        common::hexdump::pretty_print(stdout, std::data(frame), std::size(frame));
 
         sockets::length_prefixed_binary_frame<std::uint32_t> reply;
         reply << static_cast<std::uint32_t>(2);
@@ -40,6 +57,9 @@ public:
     {
         std::cout << "On Connected.\n";
 
+        if (benchmark)
+            return;
+
         sockets::length_prefixed_binary_frame<std::uint32_t> frame;
         frame << static_cast<std::uint32_t>(1);
         frame << static_cast<std::uint32_t>(0x12345678);
@@ -53,8 +73,10 @@ public:
     }
 };
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
+int main(int argc, char *argv[])
 {
+    benchmark = (argc > 1) && (std::string_view{argv[1]} == "benchmark");
+
     asio::io_context service;
     sockets::tcp_server<binary_socket> handler{service, 7777};
 
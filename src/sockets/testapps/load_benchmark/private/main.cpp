@@ -0,0 +1,181 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/sharded_tcp_server.h>
+#include <aeon/sockets/tcp_socket.h>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+using namespace aeon;
+
+/*
+ * Load benchmark for sharded_tcp_server. A local echo server is started with 1 to 16 threads, after which client
+ * threads measure:
+ *  - connections/s: connect, send a request, wait for the reply and disconnect.
+ *  - requests/s: send requests over a connection that is kept open, one at a time.
+ *
+ * Usage: aeon_sockets_load_benchmark [duration in seconds per measurement] [client threads]
+ */
+
+static constexpr std::size_t request_size = 64;
+
+class echo_socket final : public sockets::tcp_socket
+{
+public:
+    explicit echo_socket(asio::ip::tcp::socket socket)
+        : tcp_socket{std::move(socket)}
+    {
+    }
+
+    void on_data(const std::span<const std::byte> &data) final
+    {
+        send(std::vector<std::byte>{std::begin(data), std::end(data)});
+    }
+};
+
+struct benchmark_result final
+{
+    double connections_per_second = 0.0;
+    double requests_per_second = 0.0;
+};
+
+static void send_request(asio::ip::tcp::socket &socket)
+{
+    std::array<std::byte, request_size> request{};
+    std::array<std::byte, request_size> reply{};
+
+    asio::write(socket, asio::buffer(request));
+    asio::read(socket, asio::buffer(reply));
+}
+
+/*!
+ * Run the given function on all client threads until the duration has passed, and return the amount of completed
+ * iterations per second.
+ */
+template <typename func_t>
+static auto measure(const std::size_t client_threads, const std::chrono::seconds duration, func_t &&func) -> double
+{
+    std::atomic<std::uint64_t> count{0};
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + duration;
+
+    std::vector<std::thread> threads;
+    threads.reserve(client_threads);
+
+    for (std::size_t i = 0; i < client_threads; ++i)
+    {
+        threads.emplace_back(
+            [&func, &count, end]()
+            {
+                try
+                {
+                    count.fetch_add(func(end), std::memory_order_relaxed);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Client error: " << e.what() << '\n';
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    return static_cast<double>(count.load()) / elapsed.count();
+}
+
+static auto run_benchmark(const std::size_t server_threads, const sockets::tcp_server_accept_mode accept_mode,
+                          const std::size_t client_threads, const std::chrono::seconds duration) -> benchmark_result
+{
+    sockets::sharded_tcp_server_settings settings;
+    settings.thread_count = server_threads;
+    settings.accept_mode = accept_mode;
+
+    sockets::sharded_tcp_server<echo_socket> server{settings};
+    const asio::ip::tcp::endpoint endpoint{asio::ip::address_v4::loopback(), server.port()};
+
+    std::thread server_thread{[&server]() { server.run(); }};
+
+    benchmark_result result;
+
+    result.connections_per_second = measure(client_threads, duration,
+                                            [&endpoint](const auto end)
+                                            {
+                                                asio::io_context context;
+                                                std::uint64_t count = 0;
+
+                                                while (std::chrono::steady_clock::now() < end)
+                                                {
+                                                    asio::ip::tcp::socket socket{context};
+                                                    socket.connect(endpoint);
+                                                    send_request(socket);
+                                                    ++count;
+                                                }
+
+                                                return count;
+                                            });
+
+    result.requests_per_second = measure(client_threads, duration,
+                                         [&endpoint](const auto end)
+                                         {
+                                             asio::io_context context;
+                                             asio::ip::tcp::socket socket{context};
+                                             socket.connect(endpoint);
+                                             socket.set_option(asio::ip::tcp::no_delay{true});
+
+                                             std::uint64_t count = 0;
+
+                                             while (std::chrono::steady_clock::now() < end)
+                                             {
+                                                 send_request(socket);
+                                                 ++count;
+                                             }
+
+                                             return count;
+                                         });
+
+    server.stop();
+    server_thread.join();
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    const auto duration = std::chrono::seconds{(argc > 1) ? std::atoi(argv[1]) : 2};
+    const auto client_threads =
+        (argc > 2) ? static_cast<std::size_t>(std::atoi(argv[2])) : std::size_t{std::thread::hardware_concurrency()};
+
+    std::cout << "Client threads: " << client_threads << ", " << duration.count() << "s per measurement.\n\n";
+    std::cout << std::left << std::setw(10) << "Threads" << std::setw(14) << "Accept mode" << std::right
+              << std::setw(16) << "Connections/s" << std::setw(16) << "Requests/s" << '\n';
+
+    for (const auto accept_mode :
+         {sockets::tcp_server_accept_mode::reuse_port, sockets::tcp_server_accept_mode::round_robin})
+    {
+        for (const auto threads : {1, 2, 4, 8, 16})
+        {
+            const auto result =
+                run_benchmark(static_cast<std::size_t>(threads), accept_mode, client_threads, duration);
+
+            std::cout << std::left << std::setw(10) << threads << std::setw(14)
+                      << ((accept_mode == sockets::tcp_server_accept_mode::reuse_port) ? "reuse_port" : "round_robin")
+                      << std::right << std::fixed << std::setprecision(0) << std::setw(16)
+                      << result.connections_per_second << std::setw(16) << result.requests_per_second << std::endl;
+        }
+    }
+
+    return 0;
+}
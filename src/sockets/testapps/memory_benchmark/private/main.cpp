@@ -0,0 +1,148 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/sharded_tcp_server.h>
+#include <aeon/sockets/line_protocol_socket.h>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/write.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__linux__))
+#include <unistd.h>
+#endif
+
+using namespace aeon;
+
+/*
+ * Memory benchmark for the receive buffers of the protocol sockets. A local line protocol server is started, after
+ * which a number of client connections are opened and the resident memory of the process is measured while all
+ * connections:
+ *  - are idle.
+ *  - have an incomplete line buffered on the server side.
+ *  - are idle again after the line was completed.
+ *
+ * The memory per connection includes both the client and the server side of every connection. Memory that is returned
+ * to the buffer_pool stays resident, since the pool keeps it for reuse.
+ *
+ * Usage: aeon_sockets_memory_benchmark [connections]
+ */
+
+static std::atomic<std::size_t> connected_count{0};
+static std::atomic<std::size_t> line_count{0};
+
+class counting_socket final : public sockets::line_protocol_socket
+{
+public:
+    explicit counting_socket(asio::ip::tcp::socket socket)
+        : line_protocol_socket{std::move(socket)}
+    {
+    }
+
+    void on_connected() final
+    {
+        connected_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void on_line([[maybe_unused]] const common::string &line) final
+    {
+        line_count.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/*!
+ * The resident memory of the process in bytes, or 0 if this is not supported on this platform.
+ */
+[[nodiscard]] static auto resident_memory() -> std::size_t
+{
+#if (defined(__linux__))
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t total_pages = 0;
+    std::size_t resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+    return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+static void wait_for(const std::atomic<std::size_t> &counter, const std::size_t value)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+    while (counter.load(std::memory_order_relaxed) < value && std::chrono::steady_clock::now() < timeout)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+}
+
+static void send_to_all(std::vector<asio::ip::tcp::socket> &sockets, const std::string_view data)
+{
+    for (auto &socket : sockets)
+        asio::write(socket, asio::buffer(std::data(data), std::size(data)));
+}
+
+static void print_result(const char *state, const std::size_t baseline, const std::size_t connections)
+{
+    const auto memory = resident_memory();
+    const auto per_connection = (memory > baseline) ? (memory - baseline) / connections : 0;
+
+    std::cout << std::left << std::setw(24) << state << std::right << std::setw(16) << memory / 1024 << std::setw(20)
+              << per_connection << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const auto connections = (argc > 1) ? static_cast<std::size_t>(std::atoi(argv[1])) : std::size_t{400};
+
+    if (resident_memory() == 0)
+    {
+        std::cerr << "Measuring resident memory is not supported on this platform.\n";
+        return 1;
+    }
+
+    sockets::sharded_tcp_server_settings settings;
+    settings.thread_count = 1;
+
+    sockets::sharded_tcp_server<counting_socket> server{settings};
+    const asio::ip::tcp::endpoint endpoint{asio::ip::address_v4::loopback(), server.port()};
+
+    std::thread server_thread{[&server]() { server.run(); }};
+
+    asio::io_context context;
+    std::vector<asio::ip::tcp::socket> sockets;
+    sockets.reserve(connections);
+
+    const auto baseline = resident_memory();
+
+    for (std::size_t i = 0; i < connections; ++i)
+        sockets.emplace_back(context).connect(endpoint);
+
+    wait_for(connected_count, connections);
+
+    std::cout << "Connections: " << connections << "\n\n";
+    std::cout << std::left << std::setw(24) << "State" << std::right << std::setw(16) << "Resident (KB)"
+              << std::setw(20) << "Bytes/connection" << '\n';
+
+    print_result("idle", baseline, connections);
+
+    send_to_all(sockets, "complete line\nincomplete line");
+    wait_for(line_count, connections);
+    print_result("incomplete line", baseline, connections);
+
+    send_to_all(sockets, "\n");
+    wait_for(line_count, connections * 2);
+    print_result("idle after line", baseline, connections);
+
+    server.stop();
+    server_thread.join();
+
+    return 0;
+}
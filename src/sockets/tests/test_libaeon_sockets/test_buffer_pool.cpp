@@ -0,0 +1,67 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/buffer_pool.h>
+#include <gtest/gtest.h>
+
+using namespace aeon;
+
+TEST(test_buffer_pool, rounds_up_to_size_class)
+{
+    EXPECT_EQ(sockets::buffer_pool::min_size_class, sockets::buffer_pool::round_to_size_class(1));
+    EXPECT_EQ(512u, sockets::buffer_pool::round_to_size_class(512));
+    EXPECT_EQ(1024u, sockets::buffer_pool::round_to_size_class(513));
+    EXPECT_EQ(2048u, sockets::buffer_pool::round_to_size_class(2048));
+    EXPECT_EQ(65536u, sockets::buffer_pool::round_to_size_class(40000));
+    EXPECT_EQ(100000u, sockets::buffer_pool::round_to_size_class(100000));
+}
+
+TEST(test_buffer_pool, released_buffers_are_reused)
+{
+    sockets::buffer_pool pool;
+
+    auto buffer = pool.acquire(1000);
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(1024u, buffer.size());
+
+    const auto data = buffer.data();
+    buffer.reset();
+    EXPECT_FALSE(buffer);
+
+    const auto reused = pool.acquire(600);
+    EXPECT_EQ(data, reused.data());
+
+    const auto other_class = pool.acquire(4096);
+    EXPECT_NE(data, other_class.data());
+}
+
+TEST(test_buffer_pool, max_cached_buffers)
+{
+    sockets::buffer_pool pool{1};
+
+    auto buffer1 = pool.acquire(512);
+    auto buffer2 = pool.acquire(512);
+    const auto data1 = buffer1.data();
+
+    buffer1.reset();
+    buffer2.reset();
+
+    // Only the first buffer is kept.
+    EXPECT_EQ(data1, pool.acquire(512).data());
+}
+
+TEST(test_buffer_pool, move_transfers_ownership)
+{
+    sockets::buffer_pool pool;
+
+    auto buffer = pool.acquire(512);
+    const auto data = buffer.data();
+
+    sockets::pooled_buffer moved{std::move(buffer)};
+    EXPECT_FALSE(buffer);
+    EXPECT_EQ(data, moved.data());
+
+    sockets::pooled_buffer assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(data, assigned.data());
+    EXPECT_EQ(512u, assigned.size());
+}
@@ -0,0 +1,70 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/contiguous_receive_buffer.h>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+using namespace aeon;
+
+static auto as_bytes(const std::string_view str) -> std::span<const std::byte>
+{
+    return std::as_bytes(std::span{str});
+}
+
+static auto as_string(const std::span<const std::byte> data) -> std::string_view
+{
+    return {reinterpret_cast<const char *>(std::data(data)), std::size(data)};
+}
+
+TEST(test_contiguous_receive_buffer, starts_empty)
+{
+    const sockets::contiguous_receive_buffer buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.capacity());
+    EXPECT_TRUE(std::empty(buffer.data()));
+}
+
+TEST(test_contiguous_receive_buffer, grows_and_stays_contiguous)
+{
+    sockets::buffer_pool pool;
+    sockets::contiguous_receive_buffer buffer{4096, pool};
+
+    ASSERT_TRUE(buffer.write(as_bytes("Hello ")));
+    EXPECT_EQ(512u, buffer.capacity());
+
+    const std::vector<std::byte> large(1000, std::byte{'x'});
+    ASSERT_TRUE(buffer.write(large));
+    EXPECT_EQ(1006u, buffer.size());
+    EXPECT_EQ(1024u, buffer.capacity());
+
+    EXPECT_EQ("Hello x", as_string(buffer.data().first(7)));
+    EXPECT_EQ('x', static_cast<char>(buffer.data()[1005]));
+}
+
+TEST(test_contiguous_receive_buffer, consume)
+{
+    sockets::buffer_pool pool;
+    sockets::contiguous_receive_buffer buffer{4096, pool};
+
+    ASSERT_TRUE(buffer.write(as_bytes("first second")));
+    buffer.consume(6);
+    EXPECT_EQ("second", as_string(buffer.data()));
+
+    ASSERT_TRUE(buffer.write(as_bytes(" third")));
+    EXPECT_EQ("second third", as_string(buffer.data()));
+
+    buffer.consume(12);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.capacity());
+}
+
+TEST(test_contiguous_receive_buffer, max_size)
+{
+    sockets::buffer_pool pool;
+    sockets::contiguous_receive_buffer buffer{8, pool};
+
+    EXPECT_TRUE(buffer.write(as_bytes("12345")));
+    EXPECT_FALSE(buffer.write(as_bytes("6789")));
+    EXPECT_EQ("12345", as_string(buffer.data()));
+}
@@ -0,0 +1,178 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/length_prefixed_binary_protocol_socket.h>
+#include <aeon/sockets/config.h>
+#include <asio/io_context.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace aeon;
+
+namespace internal
+{
+
+/*!
+ * Records the received frames. Data is fed to on_data directly, without a connection.
+ */
+class frame_socket final : public sockets::length_prefixed_binary_protocol_socket<std::uint32_t>
+{
+public:
+    explicit frame_socket(asio::io_context &context)
+        : length_prefixed_binary_protocol_socket{context}
+        , frames{}
+        , errors{}
+    {
+    }
+
+    void on_frame(const std::span<const std::byte> &frame) final
+    {
+        frames.emplace_back(reinterpret_cast<const char *>(std::data(frame)), std::size(frame));
+    }
+
+    void on_error(const std::error_code &ec) final
+    {
+        errors.emplace_back(ec);
+    }
+
+    void receive(const std::span<const std::byte> data)
+    {
+        static_cast<tcp_socket &>(*this).on_data(data);
+    }
+
+    std::vector<std::string> frames;
+    std::vector<std::error_code> errors;
+};
+
+[[nodiscard]] static auto make_frame(const std::string &content) -> std::vector<std::byte>
+{
+    sockets::length_prefixed_binary_frame<std::uint32_t> frame;
+    frame.write(std::as_bytes(std::span{std::data(content), std::size(content)}));
+    return frame.release();
+}
+
+[[nodiscard]] static auto make_frames(const std::vector<std::string> &contents) -> std::vector<std::byte>
+{
+    std::vector<std::byte> data;
+
+    for (const auto &content : contents)
+    {
+        const auto frame = make_frame(content);
+        data.insert(std::end(data), std::begin(frame), std::end(frame));
+    }
+
+    return data;
+}
+
+} // namespace internal
+
+TEST(test_length_prefixed_binary_protocol_socket, single_frame)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+
+    socket->receive(internal::make_frame("Hello"));
+
+    ASSERT_EQ(1u, std::size(socket->frames));
+    EXPECT_EQ("Hello", socket->frames[0]);
+    EXPECT_TRUE(std::empty(socket->errors));
+}
+
+TEST(test_length_prefixed_binary_protocol_socket, header_split_over_reads)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+    const auto data = internal::make_frames({"Hello", "World"});
+    const std::span<const std::byte> view{data};
+
+    // Split within the length of the first frame.
+    socket->receive(view.first(2));
+    EXPECT_TRUE(std::empty(socket->frames));
+
+    socket->receive(view.subspan(2, 1));
+    EXPECT_TRUE(std::empty(socket->frames));
+
+    // The rest of the first frame, and the first byte of the length of the second.
+    socket->receive(view.subspan(3, 7));
+    ASSERT_EQ(1u, std::size(socket->frames));
+    EXPECT_EQ("Hello", socket->frames[0]);
+
+    socket->receive(view.subspan(10));
+    ASSERT_EQ(2u, std::size(socket->frames));
+    EXPECT_EQ("World", socket->frames[1]);
+}
+
+TEST(test_length_prefixed_binary_protocol_socket, frame_split_over_reads)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+    const std::string content(1000, 'x');
+    const auto data = internal::make_frame(content);
+    const std::span<const std::byte> view{data};
+
+    for (std::size_t offset = 0; offset < std::size(data); offset += 100)
+    {
+        EXPECT_TRUE(std::empty(socket->frames));
+        socket->receive(view.subspan(offset, std::min<std::size_t>(100, std::size(data) - offset)));
+    }
+
+    ASSERT_EQ(1u, std::size(socket->frames));
+    EXPECT_EQ(content, socket->frames[0]);
+
+    // The partial frame buffer is reset, so the next frame can be received normally.
+    socket->receive(internal::make_frame("next"));
+    ASSERT_EQ(2u, std::size(socket->frames));
+    EXPECT_EQ("next", socket->frames[1]);
+}
+
+TEST(test_length_prefixed_binary_protocol_socket, byte_by_byte)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+    const auto data = internal::make_frames({"a", "", "bcd"});
+
+    for (const auto byte : data)
+        socket->receive(std::span{&byte, 1});
+
+    EXPECT_EQ((std::vector<std::string>{"a", "", "bcd"}), socket->frames);
+}
+
+TEST(test_length_prefixed_binary_protocol_socket, multiple_frames_in_one_read)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+    auto data = internal::make_frames({"one", "two", "", "three"});
+
+    // A fourth frame that is only partially received.
+    const auto last = internal::make_frame("four");
+    data.insert(std::end(data), std::begin(last), std::end(last) - 2);
+
+    socket->receive(data);
+    EXPECT_EQ((std::vector<std::string>{"one", "two", "", "three"}), socket->frames);
+
+    socket->receive(std::span{last}.last(2));
+    EXPECT_EQ((std::vector<std::string>{"one", "two", "", "three", "four"}), socket->frames);
+}
+
+TEST(test_length_prefixed_binary_protocol_socket, oversized_frame_disconnects)
+{
+    asio::io_context context;
+    const auto socket = std::make_shared<internal::frame_socket>(context);
+
+    const auto length = static_cast<std::uint32_t>(sockets::receive_buffer_max_size + 1);
+    std::vector<std::byte> data(sizeof(length) + 16);
+    std::memcpy(std::data(data), &length, sizeof(length));
+
+    socket->receive(data);
+
+    EXPECT_TRUE(std::empty(socket->frames));
+    ASSERT_EQ(1u, std::size(socket->errors));
+    EXPECT_EQ(std::make_error_code(std::errc::no_buffer_space), socket->errors[0]);
+
+    // The disconnect is posted to the context of the socket.
+    EXPECT_EQ(1u, context.poll());
+}
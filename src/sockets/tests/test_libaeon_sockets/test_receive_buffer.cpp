@@ -0,0 +1,108 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/receive_buffer.h>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+using namespace aeon;
+
+static auto as_bytes(const std::string_view str) -> std::span<const std::byte>
+{
+    return std::as_bytes(std::span{str});
+}
+
+TEST(test_receive_buffer, starts_empty)
+{
+    const sockets::receive_buffer buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.size());
+    EXPECT_EQ(0u, buffer.capacity());
+    EXPECT_TRUE(std::empty(buffer.front()));
+}
+
+TEST(test_receive_buffer, write_and_read_across_chunks)
+{
+    sockets::buffer_pool pool;
+    sockets::receive_buffer buffer{4096, pool, 512};
+
+    std::vector<std::byte> data(1500);
+    for (std::size_t i = 0; i < std::size(data); ++i)
+        data[i] = static_cast<std::byte>(i);
+
+    ASSERT_TRUE(buffer.write(data));
+    EXPECT_EQ(1500u, buffer.size());
+    EXPECT_EQ(1536u, buffer.capacity());
+    EXPECT_EQ(512u, std::size(buffer.front()));
+
+    std::vector<std::byte> result(1500);
+    EXPECT_EQ(1000u, buffer.read(std::data(result), 1000));
+    EXPECT_EQ(500u, buffer.size());
+    EXPECT_EQ(1024u, buffer.capacity());
+
+    EXPECT_EQ(500u, buffer.read(std::data(result) + 1000, 1000));
+    EXPECT_EQ(data, result);
+}
+
+TEST(test_receive_buffer, memory_is_released_when_empty)
+{
+    sockets::buffer_pool pool;
+    sockets::receive_buffer buffer{4096, pool, 512};
+
+    ASSERT_TRUE(buffer.write(as_bytes("Hello")));
+    EXPECT_EQ(512u, buffer.capacity());
+
+    buffer.consume(5);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.capacity());
+}
+
+TEST(test_receive_buffer, max_size)
+{
+    sockets::buffer_pool pool;
+    sockets::receive_buffer buffer{8, pool, 512};
+
+    EXPECT_TRUE(buffer.write(as_bytes("12345")));
+    EXPECT_FALSE(buffer.write(as_bytes("6789")));
+    EXPECT_EQ(5u, buffer.size());
+    EXPECT_TRUE(buffer.write(as_bytes("678")));
+    EXPECT_EQ(8u, buffer.size());
+}
+
+TEST(test_receive_buffer, read_line)
+{
+    sockets::buffer_pool pool;
+    sockets::receive_buffer buffer{4096, pool, 512};
+    common::string line;
+
+    ASSERT_TRUE(buffer.write(as_bytes("first line\r\nsecond")));
+    ASSERT_TRUE(buffer.read_line(line));
+    EXPECT_EQ("first line", line);
+
+    EXPECT_FALSE(buffer.read_line(line));
+    EXPECT_EQ(6u, buffer.size());
+
+    ASSERT_TRUE(buffer.write(as_bytes(" line\n\n")));
+    ASSERT_TRUE(buffer.read_line(line));
+    EXPECT_EQ("second line", line);
+
+    ASSERT_TRUE(buffer.read_line(line));
+    EXPECT_TRUE(std::empty(line));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(test_receive_buffer, read_line_across_chunks)
+{
+    sockets::buffer_pool pool;
+    sockets::receive_buffer buffer{4096, pool, 512};
+
+    const std::string expected(1000, 'a');
+    ASSERT_TRUE(buffer.write(as_bytes(expected)));
+    ASSERT_TRUE(buffer.write(as_bytes("\n")));
+    EXPECT_EQ(1000u, buffer.find(std::byte{'\n'}));
+
+    common::string line;
+    ASSERT_TRUE(buffer.read_line(line));
+    EXPECT_EQ(expected, std::string_view(std::data(line), std::size(line)));
+    EXPECT_EQ(0u, buffer.capacity());
+}
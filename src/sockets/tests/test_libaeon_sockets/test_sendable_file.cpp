@@ -0,0 +1,45 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/sendable_file.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <array>
+
+using namespace aeon;
+
+TEST(test_sendable_file, read_at_offset)
+{
+    const auto path = std::filesystem::temp_directory_path() / "aeon_test_sendable_file.txt";
+
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "0123456789";
+    }
+
+    {
+        const sockets::sendable_file file{path};
+        EXPECT_EQ(10u, file.size());
+
+        std::array<std::byte, 4> data{};
+        ASSERT_EQ(4u, file.read(3, data));
+        EXPECT_EQ(std::byte{'3'}, data[0]);
+        EXPECT_EQ(std::byte{'6'}, data[3]);
+
+        // Only the remainder of the file is read at the end.
+        ASSERT_EQ(2u, file.read(8, data));
+        EXPECT_EQ(std::byte{'8'}, data[0]);
+        EXPECT_EQ(std::byte{'9'}, data[1]);
+
+        EXPECT_EQ(0u, file.read(10, data));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_sendable_file, open_missing_file_throws)
+{
+    EXPECT_THROW(sockets::sendable_file{std::filesystem::temp_directory_path() / "aeon_test_sendable_file_missing"},
+                 std::system_error);
+}
@@ -0,0 +1,140 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/sockets/sharded_tcp_server.h>
+#include <aeon/sockets/tcp_socket.h>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+using namespace aeon;
+
+namespace internal
+{
+
+/*!
+ * Records the remote port of every accepted connection, and the thread it was accepted on.
+ */
+class accept_session final
+{
+public:
+    void accepted(const std::uint16_t remote_port)
+    {
+        std::scoped_lock lock{mutex_};
+        ++connections_[remote_port];
+        threads_.insert(std::this_thread::get_id());
+    }
+
+    [[nodiscard]] auto connections() const -> std::map<std::uint16_t, int>
+    {
+        std::scoped_lock lock{mutex_};
+        return connections_;
+    }
+
+    [[nodiscard]] auto thread_count() const -> std::size_t
+    {
+        std::scoped_lock lock{mutex_};
+        return std::size(threads_);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::uint16_t, int> connections_;
+    std::set<std::thread::id> threads_;
+};
+
+class accept_socket final : public sockets::tcp_socket
+{
+public:
+    explicit accept_socket(asio::ip::tcp::socket socket, accept_session &session)
+        : tcp_socket{record(std::move(socket), session)}
+    {
+    }
+
+    void on_data([[maybe_unused]] const std::span<const std::byte> &data) final
+    {
+    }
+
+private:
+    [[nodiscard]] static auto record(asio::ip::tcp::socket socket, accept_session &session) -> asio::ip::tcp::socket
+    {
+        session.accepted(socket.remote_endpoint().port());
+        return socket;
+    }
+};
+
+struct accept_result final
+{
+    std::map<std::uint16_t, int> connections;
+    std::size_t thread_count = 0;
+};
+
+/*!
+ * Connect the given amount of clients to a sharded server on a port picked by the operating system. Every client
+ * must have been accepted exactly once.
+ */
+[[nodiscard]] static auto connect_clients(const sockets::tcp_server_accept_mode accept_mode,
+                                          const std::size_t thread_count, const std::size_t client_count)
+    -> accept_result
+{
+    sockets::sharded_tcp_server_settings settings;
+    settings.thread_count = thread_count;
+    settings.accept_mode = accept_mode;
+
+    sockets::sharded_tcp_server<accept_socket, accept_session> server{settings};
+    EXPECT_EQ(thread_count, server.thread_count());
+    EXPECT_NE(0, server.port());
+
+    std::thread server_thread{[&server]() { server.run(); }};
+
+    asio::io_context context;
+    std::vector<asio::ip::tcp::socket> clients;
+
+    for (std::size_t i = 0; i < client_count; ++i)
+    {
+        auto &client = clients.emplace_back(context);
+        client.connect(asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), server.port()});
+    }
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+    while (std::size(server.get_session().connections()) < client_count && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+    server.stop();
+    server_thread.join();
+
+    accept_result result{server.get_session().connections(), server.get_session().thread_count()};
+    EXPECT_EQ(client_count, std::size(result.connections));
+
+    for (const auto &client : clients)
+    {
+        const auto connection = result.connections.find(client.local_endpoint().port());
+        const auto accepted = (connection != std::end(result.connections)) ? connection->second : 0;
+        EXPECT_EQ(1, accepted);
+    }
+
+    return result;
+}
+
+} // namespace internal
+
+TEST(test_sharded_tcp_server, reuse_port_accepts_every_connection_once)
+{
+    [[maybe_unused]] const auto result =
+        internal::connect_clients(sockets::tcp_server_accept_mode::reuse_port, 4, 32);
+}
+
+TEST(test_sharded_tcp_server, round_robin_accepts_every_connection_once)
+{
+    const auto result = internal::connect_clients(sockets::tcp_server_accept_mode::round_robin, 4, 32);
+
+    // Connections are handed to all shards in turn, so every shard has accepted some of them.
+    EXPECT_EQ(4u, result.thread_count);
+}
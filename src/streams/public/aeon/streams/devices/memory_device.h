@@ -90,10 +90,11 @@ inline memory_device<T>::memory_device(memory_device &&other) noexcept
     : memory_view_device<T>{}
     , buffer_{std::move(other.buffer_)}
 {
+    // Keep the read and write positions; the span is pointed at the new buffer.
+    memory_view_device<T>::span_device_ = other.span_device_;
     memory_view_device<T>::buffer_view_ = &buffer_;
-
-    if (!std::empty(buffer_))
-        memory_view_device<T>::update_span();
+    memory_view_device<T>::update_span();
+    other.update_span();
 }
 
 template <memory_viewable T>
@@ -103,10 +104,10 @@ inline auto memory_device<T>::operator=(memory_device &&other) noexcept -> memor
     {
         buffer_ = std::move(other.buffer_);
 
+        memory_view_device<T>::span_device_ = other.span_device_;
         memory_view_device<T>::buffer_view_ = &buffer_;
-
-        if (!std::empty(buffer_))
-            memory_view_device<T>::update_span();
+        memory_view_device<T>::update_span();
+        other.update_span();
     }
 
     return *this;
@@ -117,10 +118,9 @@ inline memory_device<T>::memory_device(const memory_device &other)
     : memory_view_device<T>{}
     , buffer_{other.buffer_}
 {
+    memory_view_device<T>::span_device_ = other.span_device_;
     memory_view_device<T>::buffer_view_ = &buffer_;
-
-    if (!std::empty(buffer_))
-        memory_view_device<T>::update_span();
+    memory_view_device<T>::update_span();
 }
 
 template <memory_viewable T>
@@ -130,10 +130,9 @@ inline auto memory_device<T>::operator=(const memory_device &other) -> memory_de
     {
         buffer_ = other.buffer_;
 
+        memory_view_device<T>::span_device_ = other.span_device_;
         memory_view_device<T>::buffer_view_ = &buffer_;
-
-        if (!std::empty(buffer_))
-            memory_view_device<T>::update_span();
+        memory_view_device<T>::update_span();
     }
 
     return *this;
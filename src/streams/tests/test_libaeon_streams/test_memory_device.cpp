@@ -54,3 +54,26 @@ TEST_F(test_fixture_memory_device_default_data, test_memory_device_write_read)
 
     ASSERT_THAT(fixture_data, ::testing::ElementsAreArray(readbackdata));
 }
+
+TEST_F(test_fixture_memory_device_default_data, test_memory_device_move_assign)
+{
+    std::vector<std::byte> readbackdata;
+    readbackdata.resize(fixture_data_written);
+    ASSERT_EQ(fixture_data_written, device.read(std::data(readbackdata), std::size(readbackdata)));
+
+    // The positions of the assigned device must be used, not those of the device that is assigned to.
+    device = streams::memory_device<std::vector<std::byte>>{};
+    ASSERT_EQ(0, device.size());
+    ASSERT_EQ(0, device.tellg());
+    ASSERT_EQ(0, device.tellp());
+
+    const char data[] = {'F', 'G'};
+    ASSERT_EQ(aeon_signed_sizeof(data), device.write(reinterpret_cast<const std::byte *>(data), sizeof(data)));
+
+    streams::memory_device<std::vector<std::byte>> moved{std::move(device)};
+    ASSERT_EQ(aeon_signed_sizeof(data), moved.tellp());
+
+    std::array<std::byte, 2> moved_data{};
+    ASSERT_EQ(aeon_signed_sizeof(data), moved.read(std::data(moved_data), std::size(moved_data)));
+    ASSERT_EQ(static_cast<std::byte>('G'), moved_data[1]);
+}
@@ -0,0 +1,107 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/tracelog/tracelog.h>
+#include <benchmark/benchmark.h>
+
+using namespace aeon;
+
+namespace internal
+{
+
+static constexpr tracelog::category benchmark_category = 1 << 1;
+
+static void setup_ring_buffer()
+{
+    // A small ring keeps the memory usage bounded regardless of the amount of iterations.
+    tracelog::settings settings;
+    settings.mode = tracelog::buffer_mode::ring;
+    settings.ring_chunk_count = 4;
+    tracelog::configure(settings);
+    tracelog::initialize();
+}
+
+} // namespace internal
+
+// The cost of the loop itself, to compare the disabled benchmarks against.
+static void BM_tracelog_baseline(benchmark::State &state)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_tracelog_baseline);
+
+static void BM_tracelog_scope_disabled(benchmark::State &state)
+{
+    tracelog::disable();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        aeon_tracelog_scoped();
+        benchmark::ClobberMemory();
+    }
+
+    tracelog::enable();
+}
+
+BENCHMARK(BM_tracelog_scope_disabled);
+
+static void BM_tracelog_scope_category_disabled(benchmark::State &state)
+{
+    tracelog::disable(internal::benchmark_category);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        aeon_tracelog_scoped_category(internal::benchmark_category);
+        benchmark::ClobberMemory();
+    }
+
+    tracelog::enable(internal::benchmark_category);
+}
+
+BENCHMARK(BM_tracelog_scope_category_disabled);
+
+static void BM_tracelog_counter_disabled(benchmark::State &state)
+{
+    tracelog::disable();
+
+    std::int64_t value = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        tracelog::counter("counter", ++value);
+        benchmark::ClobberMemory();
+    }
+
+    tracelog::enable();
+}
+
+BENCHMARK(BM_tracelog_counter_disabled);
+
+static void BM_tracelog_scope_enabled(benchmark::State &state)
+{
+    internal::setup_ring_buffer();
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        aeon_tracelog_scoped();
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_tracelog_scope_enabled);
+
+static void BM_tracelog_counter_enabled(benchmark::State &state)
+{
+    internal::setup_ring_buffer();
+
+    std::int64_t value = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        tracelog::counter("counter", ++value);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_tracelog_counter_enabled);
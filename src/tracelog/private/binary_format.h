@@ -0,0 +1,106 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::tracelog::detail
+{
+
+/*
+ * The binary trace format consists of a header, followed by records. Every record starts with a type byte and
+ * the size of its payload as a 32-bit little endian integer.
+ *
+ * A name record assigns an id to a function name: varint id, followed by the name (the rest of the payload).
+ * Names are always written before the first event that uses them.
+ *
+ * An events record contains events of a single thread: varint thread id, followed by the events until the end
+ * of the payload. Every event consists of:
+ * - The event type byte. The highest bit is set if the event has an argument.
+ * - The end timestamp in nanoseconds, as zigzag varint delta to the end of the previous event in the record. Events
+ *   are recorded when they end, so the deltas are normally small and positive.
+ * - For scopes: the duration in nanoseconds as varint.
+ * - The id of the name as varint.
+ * - For counters, async and flow events: the value or id as zigzag varint.
+ * - For events with an argument: the id of the argument name as varint, and the value as zigzag varint.
+ */
+
+static constexpr std::array<std::byte, 4> binary_trace_magic{std::byte{'A'}, std::byte{'T'}, std::byte{'R'},
+                                                             std::byte{'C'}};
+static constexpr std::uint32_t binary_trace_version = 2;
+static constexpr std::size_t binary_trace_header_size = std::size(binary_trace_magic) + sizeof(std::uint32_t);
+static constexpr std::size_t binary_trace_record_header_size = 1 + sizeof(std::uint32_t);
+
+static constexpr std::uint8_t binary_trace_argument_flag = 0x80;
+
+enum class binary_trace_record : std::uint8_t
+{
+    name = 1,
+    events = 2
+};
+
+[[nodiscard]] inline auto zigzag_encode(const std::int64_t value) noexcept -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+[[nodiscard]] inline auto zigzag_decode(const std::uint64_t value) noexcept -> std::int64_t
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline void append_varint(std::vector<std::byte> &buffer, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    buffer.push_back(static_cast<std::byte>(value));
+}
+
+inline void append_uint32(std::vector<std::byte> &buffer, const std::uint32_t value)
+{
+    for (auto i = 0; i < 4; ++i)
+        buffer.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xff));
+}
+
+[[nodiscard]] inline auto read_uint32(const std::byte *data) noexcept -> std::uint32_t
+{
+    std::uint32_t value = 0;
+
+    for (auto i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(data[i]) << (i * 8);
+
+    return value;
+}
+
+/*!
+ * Read a varint at the given offset and advance the offset. Returns false if the data ends before the varint does.
+ */
+[[nodiscard]] inline auto read_varint(const std::span<const std::byte> data, std::size_t &offset,
+                                      std::uint64_t &value) noexcept -> bool
+{
+    value = 0;
+
+    for (auto shift = 0; shift < 64; shift += 7)
+    {
+        if (offset >= std::size(data))
+            return false;
+
+        const auto byte = static_cast<std::uint64_t>(data[offset++]);
+        value |= (byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace aeon::tracelog::detail
@@ -0,0 +1,116 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "binary_writer.h"
+#include <cstring>
+
+namespace aeon::tracelog::detail
+{
+
+namespace internal
+{
+
+static constexpr std::size_t binary_buffer_size = 1024 * 1024;
+
+} // namespace internal
+
+trace_binary_writer::trace_binary_writer(const std::filesystem::path &path)
+    : file_{path, streams::file_mode::binary, streams::file_flag::truncate}
+    , buffer_{}
+    , payload_{}
+    , name_payload_{}
+    , names_{}
+{
+    buffer_.reserve(internal::binary_buffer_size + 1024);
+    buffer_.insert(std::end(buffer_), std::begin(binary_trace_magic), std::end(binary_trace_magic));
+    append_uint32(buffer_, binary_trace_version);
+}
+
+void trace_binary_writer::write(const trace_log_chunk &chunk, const std::size_t begin, const std::size_t end,
+                                const std::int64_t min_time, const trace_clock_conversion &conversion)
+{
+    payload_.clear();
+    append_varint(payload_, static_cast<std::uint64_t>(chunk.thread_id));
+
+    const auto header_size = std::size(payload_);
+    std::int64_t previous_end = 0;
+
+    for (auto i = begin; i < end; ++i)
+    {
+        const auto &entry = chunk.entries[i];
+
+        if (entry.end < min_time)
+            continue;
+
+        const auto event = to_event(chunk, entry, conversion);
+
+        // May append name records to the buffer, which are then written before this events record.
+        const auto name_id = intern(entry.name);
+        const auto argument_name_id = entry.argument_name ? intern(entry.argument_name) : 0;
+
+        auto type = static_cast<std::uint8_t>(event.type);
+        if (entry.argument_name)
+            type |= binary_trace_argument_flag;
+
+        payload_.push_back(static_cast<std::byte>(type));
+        append_varint(payload_, zigzag_encode(event.end - previous_end));
+        previous_end = event.end;
+
+        if (event.type == trace_log_entry_type::scope)
+            append_varint(payload_, static_cast<std::uint64_t>(event.end - event.begin));
+
+        append_varint(payload_, name_id);
+
+        if (event.type != trace_log_entry_type::scope && event.type != trace_log_entry_type::instant)
+            append_varint(payload_, zigzag_encode(event.value));
+
+        if (entry.argument_name)
+        {
+            append_varint(payload_, argument_name_id);
+            append_varint(payload_, zigzag_encode(event.value));
+        }
+    }
+
+    if (std::size(payload_) > header_size)
+        append_record(binary_trace_record::events, payload_);
+
+    if (std::size(buffer_) >= internal::binary_buffer_size)
+        flush_buffer();
+}
+
+void trace_binary_writer::finish()
+{
+    flush_buffer();
+    file_.flush();
+}
+
+auto trace_binary_writer::intern(const char *name) -> std::uint64_t
+{
+    const auto [itr, inserted] = names_.try_emplace(name, std::size(names_));
+
+    if (inserted)
+    {
+        name_payload_.clear();
+        append_varint(name_payload_, itr->second);
+
+        const auto bytes = reinterpret_cast<const std::byte *>(name);
+        name_payload_.insert(std::end(name_payload_), bytes, bytes + std::strlen(name));
+        append_record(binary_trace_record::name, name_payload_);
+    }
+
+    return itr->second;
+}
+
+void trace_binary_writer::append_record(const binary_trace_record type, const std::vector<std::byte> &payload)
+{
+    buffer_.push_back(static_cast<std::byte>(type));
+    append_uint32(buffer_, static_cast<std::uint32_t>(std::size(payload)));
+    buffer_.insert(std::end(buffer_), std::begin(payload), std::end(payload));
+}
+
+void trace_binary_writer::flush_buffer()
+{
+    file_.write(std::data(buffer_), static_cast<std::streamsize>(std::size(buffer_)));
+    buffer_.clear();
+}
+
+} // namespace aeon::tracelog::detail
@@ -0,0 +1,51 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include "trace_writer.h"
+#include "binary_format.h"
+#include <aeon/streams/devices/file_device.h>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::tracelog::detail
+{
+
+/*!
+ * Writes trace events in the compact binary trace format (see binary_format.h).
+ */
+class trace_binary_writer final : public trace_writer
+{
+public:
+    explicit trace_binary_writer(const std::filesystem::path &path);
+    ~trace_binary_writer() final = default;
+
+    trace_binary_writer(trace_binary_writer &&) = delete;
+    auto operator=(trace_binary_writer &&) -> trace_binary_writer & = delete;
+
+    trace_binary_writer(const trace_binary_writer &) = delete;
+    auto operator=(const trace_binary_writer &) -> trace_binary_writer & = delete;
+
+    void write(const trace_log_chunk &chunk, const std::size_t begin, const std::size_t end,
+               const std::int64_t min_time, const trace_clock_conversion &conversion) final;
+
+    void finish() final;
+
+private:
+    [[nodiscard]] auto intern(const char *name) -> std::uint64_t;
+    void append_record(const binary_trace_record type, const std::vector<std::byte> &payload);
+    void flush_buffer();
+
+    streams::file_sink_device file_;
+    std::vector<std::byte> buffer_;
+    std::vector<std::byte> payload_;
+    std::vector<std::byte> name_payload_;
+
+    // Names are interned by their address, since they are string literals.
+    std::unordered_map<const char *, std::uint64_t> names_;
+};
+
+} // namespace aeon::tracelog::detail
@@ -0,0 +1,85 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "clock.h"
+#include <thread>
+
+#if (AEON_TRACELOG_TSC_SUPPORTED && !defined(_MSC_VER))
+#include <cpuid.h>
+#endif
+
+namespace aeon::tracelog::detail
+{
+
+namespace internal
+{
+
+// The minimum time to calibrate the time stamp counter over.
+static constexpr std::int64_t minimum_calibration_time = 1'000'000;
+
+[[nodiscard]] static auto has_invariant_tsc() noexcept -> bool
+{
+#if (AEON_TRACELOG_TSC_SUPPORTED)
+    // CPUID leaf 0x80000007, EDX bit 8: the time stamp counter runs at a constant rate in all power states.
+    constexpr unsigned int leaf = 0x80000007;
+    constexpr unsigned int invariant_tsc_bit = 1u << 8;
+
+#if (defined(_MSC_VER))
+    int registers[4]{};
+    __cpuid(registers, static_cast<int>(0x80000000));
+
+    if (static_cast<unsigned int>(registers[0]) < leaf)
+        return false;
+
+    __cpuid(registers, static_cast<int>(leaf));
+    return (static_cast<unsigned int>(registers[3]) & invariant_tsc_bit) != 0;
+#else
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    if (__get_cpuid_max(0x80000000, nullptr) < leaf)
+        return false;
+
+    __get_cpuid(leaf, &eax, &ebx, &ecx, &edx);
+    return (edx & invariant_tsc_bit) != 0;
+#endif
+#else
+    return false;
+#endif
+}
+
+} // namespace internal
+
+trace_clock::trace_clock() noexcept
+    : use_tsc_{internal::has_invariant_tsc()}
+    , epoch_ticks_{0}
+    , epoch_nanoseconds_{steady_now()}
+{
+    epoch_ticks_ = now();
+}
+
+auto trace_clock::is_tsc() const noexcept -> bool
+{
+    return use_tsc_;
+}
+
+auto trace_clock::calibrate() const noexcept -> trace_clock_conversion
+{
+    if (!use_tsc_)
+        return {epoch_ticks_, 1.0};
+
+    auto elapsed_nanoseconds = steady_now() - epoch_nanoseconds_;
+
+    // Right after the start of the trace, the measurement would be too imprecise.
+    while (elapsed_nanoseconds < internal::minimum_calibration_time)
+    {
+        std::this_thread::yield();
+        elapsed_nanoseconds = steady_now() - epoch_nanoseconds_;
+    }
+
+    const auto elapsed_ticks = now() - epoch_ticks_;
+    return {epoch_ticks_, static_cast<double>(elapsed_nanoseconds) / static_cast<double>(elapsed_ticks)};
+}
+
+} // namespace aeon::tracelog::detail
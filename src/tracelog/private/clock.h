@@ -0,0 +1,91 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(_M_X64))
+#define AEON_TRACELOG_TSC_SUPPORTED 1
+#if (defined(_MSC_VER))
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace aeon::tracelog::detail
+{
+
+/*!
+ * Converts clock ticks into nanoseconds since the start of the trace. This is a copy of the calibration of a clock at
+ * a certain moment, so that it can be used without synchronizing with the clock.
+ */
+struct trace_clock_conversion
+{
+    std::int64_t epoch = 0;
+    double nanoseconds_per_tick = 1.0;
+
+    [[nodiscard]] auto to_nanoseconds(const std::int64_t ticks) const noexcept -> std::int64_t
+    {
+        return std::llround(static_cast<double>(ticks - epoch) * nanoseconds_per_tick);
+    }
+
+    [[nodiscard]] auto to_ticks(const std::int64_t nanoseconds) const noexcept -> std::int64_t
+    {
+        return epoch + std::llround(static_cast<double>(nanoseconds) / nanoseconds_per_tick);
+    }
+};
+
+/*!
+ * The clock used for trace timestamps. Uses the time stamp counter of the CPU if it runs at a constant rate
+ * (invariant TSC), which is much cheaper to read than steady_clock. Otherwise steady_clock is used, with nanosecond
+ * ticks.
+ *
+ * The rate of the time stamp counter is calibrated against steady_clock over the time since the clock was created.
+ * The longer the trace runs, the more precise the calibration.
+ */
+class trace_clock final
+{
+public:
+    trace_clock() noexcept;
+    ~trace_clock() = default;
+
+    trace_clock(trace_clock &&) = delete;
+    auto operator=(trace_clock &&) -> trace_clock & = delete;
+
+    trace_clock(const trace_clock &) = delete;
+    auto operator=(const trace_clock &) -> trace_clock & = delete;
+
+    [[nodiscard]] auto now() const noexcept -> std::int64_t
+    {
+#if (AEON_TRACELOG_TSC_SUPPORTED)
+        if (use_tsc_)
+            return static_cast<std::int64_t>(__rdtsc());
+#endif
+
+        return steady_now();
+    }
+
+    [[nodiscard]] auto is_tsc() const noexcept -> bool;
+
+    /*!
+     * Measure the rate of the clock against steady_clock, and return the resulting conversion.
+     */
+    [[nodiscard]] auto calibrate() const noexcept -> trace_clock_conversion;
+
+private:
+    [[nodiscard]] static auto steady_now() noexcept -> std::int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    bool use_tsc_;
+    std::int64_t epoch_ticks_;
+    std::int64_t epoch_nanoseconds_;
+};
+
+} // namespace aeon::tracelog::detail
@@ -1,6 +0,0 @@
-// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
-
-#pragma once
-
-// Around 300mb per list.
-#define log_entry_count 10000000ull
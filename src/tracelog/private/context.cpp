@@ -1,127 +1,303 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include "context.h"
+#include "json_writer.h"
+#include "binary_writer.h"
 #include <aeon/common/assert.h>
-#include <aeon/streams/stream_writer.h>
+#include <algorithm>
+#include <limits>
 
 namespace aeon::tracelog::detail
 {
 
 thread_local trace_log_thread_context trace_log_context::context_;
 
+trace_log_thread_context::~trace_log_thread_context()
+{
+    if (state)
+        trace_log_context::get_singleton().release_thread(state);
+}
+
+trace_log_context::trace_log_context()
+    : clock_{}
+    , thread_index_{0}
+    , record_events_{true}
+    , collect_statistics_{false}
+    , mutex_{}
+    , settings_{}
+    , threads_{}
+    , completed_chunks_{}
+    , free_chunks_{}
+    , retired_statistics_{}
+    , stream_writer_{}
+    , flusher_signal_{}
+    , streaming_{false}
+    , flusher_{}
+{
+}
+
+trace_log_context::~trace_log_context()
+{
+    if (flusher_.joinable())
+        end_streaming();
+}
+
+void trace_log_context::configure(const settings &s)
+{
+    aeon_assert(s.chunk_size > 0, "Chunk size must be larger than 0.");
+    aeon_assert(s.mode != buffer_mode::ring || s.ring_chunk_count > 0, "Ring chunk count must be larger than 0.");
+
+    std::scoped_lock lock{mutex_};
+    settings_ = s;
+    record_events_.store(s.record_events, std::memory_order_relaxed);
+    collect_statistics_.store(s.collect_statistics, std::memory_order_relaxed);
+}
+
 void trace_log_context::initialize()
 {
-    aeon_assert(!context_.head && !context_.tail, "tracelog::initialize() already called on this thread.");
+    if (context_.state)
+        return;
+
+    std::scoped_lock lock{mutex_};
+    auto state = std::make_unique<trace_log_thread_state>();
+    state->thread_id = std::atomic_fetch_add(&thread_index_, 1);
 
-    context_.tail = std::make_unique<detail::trace_log_list>();
-    context_.head = context_.tail.get();
-    context_.index = 0;
-    context_.thread_id = generate_unique_thread_id();
+    if (settings_.record_events)
+        state->chunk = acquire_chunk(state->thread_id);
 
-    register_threadlocal_context(&context_);
+    context_.state = state.get();
+    threads_.emplace_back(std::move(state));
 }
 
-[[nodiscard]] auto trace_log_context::add_scoped_log_entry(const char *func) const -> trace_log_entry *
+void trace_log_context::write(const std::filesystem::path &path, const output_format format)
 {
-    aeon_assert(context_.head && context_.tail, "tracelog::initialize() must be called before using the trace logger.");
+    std::scoped_lock lock{mutex_};
+    aeon_assert(!streaming_, "tracelog::write() can not be used while streaming.");
 
-    const auto entry_ptr = &context_.head->entries[context_.index];
-    *entry_ptr = {context_.timer.get_time_difference(), 0.0, func, context_.thread_id, trace_log_entry_type::scope};
+    const auto conversion = clock_.calibrate();
+    auto min_time = std::numeric_limits<std::int64_t>::min();
 
-    if (++context_.index >= log_entry_count)
-        allocate_new_list();
+    if (settings_.mode == buffer_mode::ring && settings_.ring_duration.count() > 0)
+    {
+        const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(settings_.ring_duration).count();
+        min_time = conversion.to_ticks(conversion.to_nanoseconds(timestamp()) - duration);
+    }
 
-    return entry_ptr;
+    const auto writer = create_writer(path, format);
+    write_pending(*writer, min_time, conversion);
+    writer->finish();
 }
 
-void trace_log_context::add_scoped_log_exit(trace_log_entry *entry) const
+void trace_log_context::begin_streaming(const std::filesystem::path &path, const output_format format)
 {
-    entry->end = context_.timer.get_time_difference();
+    std::scoped_lock lock{mutex_};
+    aeon_assert(!streaming_ && !flusher_.joinable(), "tracelog::begin_streaming() already called.");
+
+    stream_writer_ = create_writer(path, format);
+    streaming_ = true;
+    flusher_ = std::thread{[this]() { flusher_main(); }};
 }
 
-void trace_log_context::add_event(const char *func) const
+void trace_log_context::end_streaming()
 {
-    aeon_assert(context_.head && context_.tail, "tracelog::initialize() must be called before using the trace logger.");
+    {
+        std::scoped_lock lock{mutex_};
+        aeon_assert(streaming_, "tracelog::begin_streaming() must be called before end_streaming().");
+        streaming_ = false;
+    }
 
-    context_.head->entries[context_.index] = {context_.timer.get_time_difference(), 0.0f, func, context_.thread_id,
-                                              trace_log_entry_type::event};
+    flusher_signal_.notify_one();
+    flusher_.join();
 
-    if (++context_.index >= log_entry_count)
-        allocate_new_list();
+    std::scoped_lock lock{mutex_};
+    write_pending(*stream_writer_, std::numeric_limits<std::int64_t>::min(), clock_.calibrate());
+    stream_writer_->finish();
+    stream_writer_.reset();
 }
 
-void trace_log_context::write(const std::filesystem::path &path)
+void trace_log_context::release_thread(trace_log_thread_state *state)
 {
-    aeon_assert(context_.head && context_.tail, "tracelog::initialize() must be called before using the trace logger.");
+    std::scoped_lock lock{mutex_};
 
-    streams::file_sink_device file(path, streams::file_mode::text);
-    streams::stream_writer writer{file};
+    if (state->chunk)
+    {
+        if (state->chunk->size.load(std::memory_order_relaxed) > state->chunk->flushed)
+            push_completed_chunk(std::move(state->chunk));
+        else
+            release_chunk(std::move(state->chunk));
+    }
 
-    writer << "{\"traceEvents\": [";
+    state->statistics.merge_into(retired_statistics_);
+
+    std::erase_if(threads_, [state](const auto &s) { return s.get() == state; });
+}
 
-    std::scoped_lock<std::mutex> lock(thread_container_lock_);
-    for (auto context : contexts_)
+void trace_log_context::add_entry(const trace_log_entry &entry)
+{
+    if (!record_events_.load(std::memory_order_relaxed))
+        return;
+
+    auto &state = thread_state();
+
+    // Events may have been enabled after the thread was registered.
+    if (!state.chunk) [[unlikely]]
     {
-        append_write(file, context);
+        std::scoped_lock lock{mutex_};
+        state.chunk = acquire_chunk(state.thread_id);
     }
 
-    writer << "]}";
+    auto &chunk = *state.chunk;
+
+    const auto size = chunk.size.load(std::memory_order_relaxed);
+    chunk.entries[size] = entry;
+    chunk.size.store(size + 1, std::memory_order_release);
+
+    if (size + 1 >= chunk.capacity)
+        complete_chunk(state);
+}
+
+void trace_log_context::add_scope(const trace_log_entry &entry)
+{
+    if (collect_statistics_.load(std::memory_order_relaxed))
+        thread_state().statistics.record(entry.name, static_cast<std::uint64_t>(entry.end - entry.begin));
+
+    add_entry(entry);
+}
+
+auto trace_log_context::merge_statistics() -> scope_statistics_map
+{
+    std::scoped_lock lock{mutex_};
+    auto statistics = retired_statistics_;
+
+    for (const auto &state : threads_)
+        state->statistics.merge_into(statistics);
 
-    file.flush();
+    return statistics;
 }
 
-void trace_log_context::allocate_new_list() const
+void trace_log_context::reset_statistics()
 {
-    context_.head->next = std::make_unique<detail::trace_log_list>();
-    context_.head = context_.head->next.get();
-    context_.index = 0;
+    std::scoped_lock lock{mutex_};
+    retired_statistics_.clear();
+
+    for (const auto &state : threads_)
+        state->statistics.request_reset();
+}
+
+void trace_log_context::complete_chunk(trace_log_thread_state &state)
+{
+    std::scoped_lock lock{mutex_};
+    push_completed_chunk(std::move(state.chunk));
+    state.chunk = acquire_chunk(state.thread_id);
+}
+
+void trace_log_context::push_completed_chunk(std::unique_ptr<trace_log_chunk> chunk)
+{
+    completed_chunks_.emplace_back(std::move(chunk));
+
+    if (streaming_)
+    {
+        flusher_signal_.notify_one();
+    }
+    else if (settings_.mode == buffer_mode::ring && std::size(completed_chunks_) > settings_.ring_chunk_count)
+    {
+        // Discard the oldest events by reusing their chunk.
+        release_chunk(std::move(completed_chunks_.front()));
+        completed_chunks_.pop_front();
+    }
 }
 
-auto trace_log_context::generate_unique_thread_id() noexcept -> int
+auto trace_log_context::acquire_chunk(const int thread_id) -> std::unique_ptr<trace_log_chunk>
 {
-    return std::atomic_fetch_add(&thread_index_, 1);
+    while (!std::empty(free_chunks_))
+    {
+        auto chunk = std::move(free_chunks_.back());
+        free_chunks_.pop_back();
+
+        // The chunk size may have been changed since this chunk was allocated.
+        if (chunk->capacity == settings_.chunk_size)
+        {
+            chunk->reset(thread_id);
+            return chunk;
+        }
+    }
+
+    return std::make_unique<trace_log_chunk>(settings_.chunk_size, thread_id);
 }
 
-void trace_log_context::register_threadlocal_context(trace_log_thread_context *context)
+void trace_log_context::release_chunk(std::unique_ptr<trace_log_chunk> chunk)
 {
-    std::scoped_lock<std::mutex> lock(thread_container_lock_);
-    contexts_.emplace_back(context);
+    free_chunks_.emplace_back(std::move(chunk));
 }
 
-void trace_log_context::append_write(streams::file_sink_device &stream, trace_log_thread_context *context) const
+void trace_log_context::write_pending(trace_writer &writer, const std::int64_t min_time,
+                                      const trace_clock_conversion &conversion)
 {
-    // Move the lists out 1 by 1 while parsing so that they'll get deleted non-recursively.
-    // Without this, there is a chance of a stack overflow.
-    auto current_list = std::move(context->tail);
-    auto current_list_size = log_entry_count;
+    for (auto &chunk : completed_chunks_)
+    {
+        writer.write(*chunk, chunk->flushed, chunk->size.load(std::memory_order_acquire), min_time, conversion);
+        release_chunk(std::move(chunk));
+    }
 
-    if (current_list.get() == context->head)
-        current_list_size = context->index;
+    completed_chunks_.clear();
 
-    streams::stream_writer writer{stream};
+    // Chunks that are still being filled by their thread. Only the entries that are complete are written; the rest
+    // will be written the next time.
+    for (const auto &state : threads_)
+    {
+        if (!state->chunk)
+            continue;
+
+        auto &chunk = *state->chunk;
+        const auto size = chunk.size.load(std::memory_order_acquire);
+        writer.write(chunk, chunk.flushed, size, min_time, conversion);
+        chunk.flushed = size;
+    }
+}
+
+void trace_log_context::flusher_main()
+{
+    std::unique_lock lock{mutex_};
+    std::vector<std::unique_ptr<trace_log_chunk>> chunks;
 
     while (true)
     {
-        for (std::uint64_t i = 0; i < current_list_size; ++i)
-        {
-            const auto entry = current_list->entries[i];
-            auto str = R"({ "pid":1, "tid":)" + std::to_string(entry.thread_id) + R"(, "ts":)" +
-                       std::to_string(entry.begin) + R"(, "dur":)" + std::to_string(entry.end - entry.begin) +
-                       R"(, "ph":"X", "name":")" + entry.function + R"(" })";
+        flusher_signal_.wait(lock, [this]() { return !std::empty(completed_chunks_) || !streaming_; });
 
-            writer << str;
+        std::ranges::move(completed_chunks_, std::back_inserter(chunks));
+        completed_chunks_.clear();
 
-            if (i + 1 < current_list_size)
-                writer << ',';
+        const auto stop = !streaming_;
 
-            writer << '\n';
-        }
+        // The completed chunks are no longer modified, so they can be written without holding the lock. This way
+        // traced threads are never blocked by the file I/O.
+        lock.unlock();
+
+        const auto conversion = clock_.calibrate();
+
+        for (const auto &chunk : chunks)
+            stream_writer_->write(*chunk, chunk->flushed, chunk->size.load(std::memory_order_acquire),
+                                  std::numeric_limits<std::int64_t>::min(), conversion);
+
+        lock.lock();
+
+        for (auto &chunk : chunks)
+            release_chunk(std::move(chunk));
 
-        if (current_list.get() == context->head)
-            break;
+        chunks.clear();
 
-        current_list = std::move(current_list->next);
+        if (stop)
+            return;
     }
 }
 
+auto trace_log_context::create_writer(const std::filesystem::path &path, const output_format format)
+    -> std::unique_ptr<trace_writer>
+{
+    if (format == output_format::binary)
+        return std::make_unique<trace_binary_writer>(path);
+
+    return std::make_unique<trace_json_writer>(path);
+}
+
 } // namespace aeon::tracelog::detail
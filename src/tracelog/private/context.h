@@ -3,39 +3,143 @@
 #pragma once
 
 #include "data.h"
-#include <aeon/streams/devices/file_device.h>
+#include "trace_writer.h"
+#include "clock.h"
+#include "statistics.h"
+#include <aeon/tracelog/tracelog.h>
 #include <aeon/common/singleton.h>
 #include <filesystem>
+#include <chrono>
 #include <atomic>
 #include <vector>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 
 namespace aeon::tracelog::detail
 {
 
+/*!
+ * Thread local handle to the state of a traced thread. When the thread exits, its remaining events are handed over
+ * to the trace log context, so that they are still written.
+ */
+struct trace_log_thread_context
+{
+    trace_log_thread_context() = default;
+    ~trace_log_thread_context();
+
+    trace_log_thread_context(trace_log_thread_context &&) = delete;
+    auto operator=(trace_log_thread_context &&) -> trace_log_thread_context & = delete;
+
+    trace_log_thread_context(const trace_log_thread_context &) = delete;
+    auto operator=(const trace_log_thread_context &) -> trace_log_thread_context & = delete;
+
+    trace_log_thread_state *state = nullptr;
+};
+
 class trace_log_context : public common::singleton<trace_log_context>
 {
 public:
+    trace_log_context();
+    ~trace_log_context();
+
+    trace_log_context(trace_log_context &&) = delete;
+    auto operator=(trace_log_context &&) -> trace_log_context & = delete;
+
+    trace_log_context(const trace_log_context &) = delete;
+    auto operator=(const trace_log_context &) -> trace_log_context & = delete;
+
+    void configure(const settings &s);
     void initialize();
-    [[nodiscard]] auto add_scoped_log_entry(const char *func) const -> trace_log_entry *;
-    void add_scoped_log_exit(trace_log_entry *entry) const;
 
-    void add_event(const char *func) const;
+    [[nodiscard]] auto timestamp() const noexcept -> std::int64_t
+    {
+        return clock_.now();
+    }
+
+    /*!
+     * Record an event, if events are recorded.
+     */
+    void add_entry(const trace_log_entry &entry);
+
+    /*!
+     * Record a scope that has ended, as an event and/or in the statistics of the calling thread.
+     */
+    void add_scope(const trace_log_entry &entry);
+
+    void write(const std::filesystem::path &path, const output_format format);
+
+    void begin_streaming(const std::filesystem::path &path, const output_format format);
+    void end_streaming();
 
-    void write(const std::filesystem::path &path);
+    void release_thread(trace_log_thread_state *state);
+
+    [[nodiscard]] auto merge_statistics() -> scope_statistics_map;
+    void reset_statistics();
+
+    [[nodiscard]] auto calibrate() const noexcept -> trace_clock_conversion
+    {
+        return clock_.calibrate();
+    }
 
 private:
-    void allocate_new_list() const;
-    auto generate_unique_thread_id() noexcept -> int;
-    void register_threadlocal_context(trace_log_thread_context *context);
+    [[nodiscard]] auto thread_state() -> trace_log_thread_state &
+    {
+        // Threads are registered on their first event, so that tracing can be enabled at any time without every
+        // thread having to call initialize() up front.
+        if (!context_.state) [[unlikely]]
+            initialize();
+
+        return *context_.state;
+    }
+
+    void complete_chunk(trace_log_thread_state &state);
+
+    /*!
+     * Hand a chunk over to be written. In ring mode (when not streaming) the oldest chunk is discarded once more than
+     * ring_chunk_count chunks are pending. The mutex must be held.
+     */
+    void push_completed_chunk(std::unique_ptr<trace_log_chunk> chunk);
+
+    [[nodiscard]] auto acquire_chunk(const int thread_id) -> std::unique_ptr<trace_log_chunk>;
+    void release_chunk(std::unique_ptr<trace_log_chunk> chunk);
 
-    void append_write(streams::file_sink_device &stream, trace_log_thread_context *context) const;
+    /*!
+     * Write all events that were not written yet, including those in chunks that are still being filled. The mutex
+     * must be held.
+     */
+    void write_pending(trace_writer &writer, const std::int64_t min_time, const trace_clock_conversion &conversion);
+
+    void flusher_main();
+
+    [[nodiscard]] static auto create_writer(const std::filesystem::path &path, const output_format format)
+        -> std::unique_ptr<trace_writer>;
 
     static thread_local trace_log_thread_context context_;
-    std::atomic<int> thread_index_ = 0;
 
-    std::vector<trace_log_thread_context *> contexts_;
-    std::mutex thread_container_lock_;
+    trace_clock clock_;
+    std::atomic<int> thread_index_;
+
+    // Copies of the settings, which are read without taking the mutex.
+    std::atomic<bool> record_events_;
+    std::atomic<bool> collect_statistics_;
+
+    // Guards all members below. Traced threads only take it when a chunk is full.
+    std::mutex mutex_;
+    settings settings_;
+    std::vector<std::unique_ptr<trace_log_thread_state>> threads_;
+    std::deque<std::unique_ptr<trace_log_chunk>> completed_chunks_;
+    std::vector<std::unique_ptr<trace_log_chunk>> free_chunks_;
+
+    // Statistics of threads that have exited.
+    scope_statistics_map retired_statistics_;
+
+    std::unique_ptr<trace_writer> stream_writer_;
+    std::condition_variable flusher_signal_;
+    bool streaming_;
+    std::thread flusher_;
 };
 
 } // namespace aeon::tracelog::detail
@@ -0,0 +1,188 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/tracelog/converter.h>
+#include <aeon/tracelog/exception.h>
+#include "binary_format.h"
+#include "json_writer.h"
+#include <aeon/streams/devices/file_device.h>
+#include <filesystem>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace aeon::tracelog
+{
+
+namespace internal
+{
+
+class binary_trace_converter final
+{
+public:
+    explicit binary_trace_converter(const std::filesystem::path &binary_file, const std::filesystem::path &json_file)
+        : source_{binary_file}
+        , file_size_{std::filesystem::file_size(binary_file)}
+        , writer_{json_file}
+        , payload_{}
+        , names_{}
+    {
+    }
+
+    ~binary_trace_converter() = default;
+
+    binary_trace_converter(binary_trace_converter &&) = delete;
+    auto operator=(binary_trace_converter &&) -> binary_trace_converter & = delete;
+
+    binary_trace_converter(const binary_trace_converter &) = delete;
+    auto operator=(const binary_trace_converter &) -> binary_trace_converter & = delete;
+
+    void convert()
+    {
+        read_header();
+
+        std::array<std::byte, detail::binary_trace_record_header_size> record_header{};
+
+        while (true)
+        {
+            const auto size = source_.read(std::data(record_header), std::ssize(record_header));
+
+            if (size == 0)
+                break;
+
+            if (size != std::ssize(record_header))
+                throw tracelog_exception{};
+
+            // Check the size before allocating, so that a corrupt size can not cause a huge allocation.
+            const auto payload_size = detail::read_uint32(std::data(record_header) + 1);
+
+            if (payload_size > file_size_ - static_cast<std::uintmax_t>(source_.tellg()))
+                throw tracelog_exception{};
+
+            payload_.resize(payload_size);
+
+            if (source_.read(std::data(payload_), std::ssize(payload_)) != std::ssize(payload_))
+                throw tracelog_exception{};
+
+            switch (static_cast<detail::binary_trace_record>(record_header[0]))
+            {
+                case detail::binary_trace_record::name:
+                    read_name_record();
+                    break;
+                case detail::binary_trace_record::events:
+                    read_events();
+                    break;
+                default:
+                    throw tracelog_exception{};
+            }
+        }
+
+        writer_.finish();
+    }
+
+private:
+    void read_header()
+    {
+        std::array<std::byte, detail::binary_trace_header_size> header{};
+
+        if (source_.read(std::data(header), std::ssize(header)) != std::ssize(header))
+            throw tracelog_exception{};
+
+        if (!std::equal(std::begin(detail::binary_trace_magic), std::end(detail::binary_trace_magic),
+                        std::begin(header)))
+            throw tracelog_exception{};
+
+        if (detail::read_uint32(std::data(header) + std::size(detail::binary_trace_magic)) !=
+            detail::binary_trace_version)
+            throw tracelog_exception{};
+    }
+
+    void read_name_record()
+    {
+        std::size_t offset = 0;
+        const auto id = read_varint(offset);
+
+        if (id != std::size(names_))
+            throw tracelog_exception{};
+
+        names_.emplace_back(reinterpret_cast<const char *>(std::data(payload_)) + offset, std::size(payload_) - offset);
+    }
+
+    void read_events()
+    {
+        std::size_t offset = 0;
+
+        detail::trace_event event;
+        event.thread_id = static_cast<int>(read_varint(offset));
+
+        std::int64_t end = 0;
+
+        while (offset < std::size(payload_))
+        {
+            const auto type = static_cast<std::uint8_t>(payload_[offset++]);
+            const auto has_argument = (type & detail::binary_trace_argument_flag) != 0;
+            event.type = static_cast<detail::trace_log_entry_type>(type & ~detail::binary_trace_argument_flag);
+
+            if (event.type > detail::trace_log_entry_type::flow_end)
+                throw tracelog_exception{};
+
+            end += detail::zigzag_decode(read_varint(offset));
+            event.end = end;
+            event.begin = end;
+
+            if (event.type == detail::trace_log_entry_type::scope)
+                event.begin -= static_cast<std::int64_t>(read_varint(offset));
+
+            event.name = read_name(offset);
+            event.argument_name = {};
+            event.value = 0;
+
+            if (event.type != detail::trace_log_entry_type::scope &&
+                event.type != detail::trace_log_entry_type::instant)
+                event.value = detail::zigzag_decode(read_varint(offset));
+
+            if (has_argument)
+            {
+                event.argument_name = read_name(offset);
+                event.value = detail::zigzag_decode(read_varint(offset));
+            }
+
+            writer_.write_event(event);
+        }
+    }
+
+    [[nodiscard]] auto read_name(std::size_t &offset) const -> std::string_view
+    {
+        const auto id = read_varint(offset);
+
+        if (id >= std::size(names_))
+            throw tracelog_exception{};
+
+        return names_[id];
+    }
+
+    [[nodiscard]] auto read_varint(std::size_t &offset) const -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+
+        if (!detail::read_varint(payload_, offset, value))
+            throw tracelog_exception{};
+
+        return value;
+    }
+
+    streams::file_source_device source_;
+    std::uintmax_t file_size_;
+    detail::trace_json_writer writer_;
+    std::vector<std::byte> payload_;
+    std::vector<std::string> names_;
+};
+
+} // namespace internal
+
+void convert_to_json(const std::filesystem::path &binary_file, const std::filesystem::path &json_file)
+{
+    internal::binary_trace_converter converter{binary_file, json_file};
+    converter.convert();
+}
+
+} // namespace aeon::tracelog
@@ -2,41 +2,90 @@
 
 #pragma once
 
-#include <aeon/common/timer.h>
-#include "config.h"
+#include "statistics.h"
+#include <aeon/tracelog/tracelog.h>
 #include <memory>
+#include <atomic>
+#include <string_view>
 #include <cstdint>
+#include <cstddef>
 
 namespace aeon::tracelog::detail
 {
 
-enum class trace_log_entry_type
+/*!
+ * A single traced event. Timestamps are in ticks of the trace clock. An entry is written once, and never modified
+ * afterwards; scopes are recorded when they end. All other types of events have the same begin and end.
+ *
+ * The value is the value of a counter, the id of an async or flow event, or the value of the argument of a scope or
+ * instant event. Names must be string literals (or otherwise outlive the trace log).
+ */
+struct [[nodiscard]] trace_log_entry
 {
-    scope,
-    event
+    std::int64_t begin;
+    std::int64_t end;
+    const char *name;
+    const char *argument_name; // nullptr if the event has no argument.
+    std::int64_t value;
+    trace_log_entry_type type;
 };
 
-struct [[nodiscard]] trace_log_entry
+/*!
+ * An event as it is written to a file, with timestamps converted to nanoseconds since the start of the trace.
+ */
+struct trace_event
 {
-    double begin;
-    double end;
-    const char *function;
-    int thread_id;
-    trace_log_entry_type type;
+    int thread_id = 0;
+    trace_log_entry_type type = trace_log_entry_type::instant;
+    std::int64_t begin = 0;
+    std::int64_t end = 0;
+    std::string_view name;
+    std::string_view argument_name; // Empty if the event has no argument.
+    std::int64_t value = 0;
 };
 
-struct trace_log_list
+/*!
+ * A fixed size block of entries, written by a single thread.
+ */
+struct trace_log_chunk
 {
-    trace_log_entry entries[log_entry_count]; // Uninitialized on purpose.
-    std::unique_ptr<trace_log_list> next;
+    explicit trace_log_chunk(const std::size_t chunk_capacity, const int owner_thread_id)
+        : entries{std::make_unique_for_overwrite<trace_log_entry[]>(chunk_capacity)}
+        , capacity{chunk_capacity}
+        , size{0}
+        , flushed{0}
+        , thread_id{owner_thread_id}
+    {
+    }
+
+    void reset(const int new_thread_id) noexcept
+    {
+        size.store(0, std::memory_order_relaxed);
+        flushed = 0;
+        thread_id = new_thread_id;
+    }
+
+    std::unique_ptr<trace_log_entry[]> entries; // Uninitialized on purpose.
+    std::size_t capacity;
+
+    // Only modified by the owning thread. Entries below this size are complete.
+    std::atomic<std::size_t> size;
+
+    // The amount of entries that were already written to a file. Guarded by the trace log context mutex.
+    std::size_t flushed;
+
+    int thread_id;
 };
 
-struct trace_log_thread_context
+/*!
+ * The state of a traced thread. Owned by the trace log context, so that the events of a thread that has exited can
+ * still be written.
+ */
+struct trace_log_thread_state
 {
-    trace_log_list *head = nullptr;
-    std::unique_ptr<trace_log_list> tail;
-    std::uint64_t index = 0;
-    common::timer timer;
+    // Only allocated when events are recorded.
+    std::unique_ptr<trace_log_chunk> chunk;
+    thread_statistics statistics;
     int thread_id = 0;
 };
 
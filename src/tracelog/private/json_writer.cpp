@@ -0,0 +1,169 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "json_writer.h"
+#include <charconv>
+#include <array>
+
+namespace aeon::tracelog::detail
+{
+
+namespace internal
+{
+
+static constexpr std::size_t json_buffer_size = 1024 * 1024;
+
+} // namespace internal
+
+trace_json_writer::trace_json_writer(const std::filesystem::path &path)
+    : file_{path, streams::file_mode::binary, streams::file_flag::truncate}
+    , buffer_{}
+    , first_{true}
+{
+    buffer_.reserve(internal::json_buffer_size + 1024);
+    buffer_ += "{\"traceEvents\": [";
+}
+
+void trace_json_writer::write(const trace_log_chunk &chunk, const std::size_t begin, const std::size_t end,
+                              const std::int64_t min_time, const trace_clock_conversion &conversion)
+{
+    for (auto i = begin; i < end; ++i)
+    {
+        const auto &entry = chunk.entries[i];
+
+        if (entry.end < min_time)
+            continue;
+
+        write_event(to_event(chunk, entry, conversion));
+    }
+}
+
+void trace_json_writer::write_event(const trace_event &event)
+{
+    if (!first_)
+        buffer_ += ",\n";
+
+    first_ = false;
+
+    buffer_ += R"({"pid":1,"tid":)";
+    append_integer(event.thread_id);
+    buffer_ += R"(,"ts":)";
+    append_microseconds(event.begin);
+
+    switch (event.type)
+    {
+        case trace_log_entry_type::scope:
+            buffer_ += R"(,"dur":)";
+            append_microseconds(event.end - event.begin);
+            buffer_ += R"(,"ph":"X")";
+            break;
+        case trace_log_entry_type::instant:
+            buffer_ += R"(,"ph":"i","s":"t")";
+            break;
+        case trace_log_entry_type::counter:
+            buffer_ += R"(,"ph":"C")";
+            break;
+        case trace_log_entry_type::async_begin:
+            buffer_ += R"(,"ph":"b")";
+            append_id("async", event.value);
+            break;
+        case trace_log_entry_type::async_end:
+            buffer_ += R"(,"ph":"e")";
+            append_id("async", event.value);
+            break;
+        case trace_log_entry_type::flow_begin:
+            buffer_ += R"(,"ph":"s")";
+            append_id("flow", event.value);
+            break;
+        case trace_log_entry_type::flow_end:
+            // Bind to the enclosing scope, instead of the next scope that begins.
+            buffer_ += R"(,"ph":"f","bp":"e")";
+            append_id("flow", event.value);
+            break;
+    }
+
+    buffer_ += R"(,"name":")";
+    append_escaped(event.name);
+    buffer_ += '"';
+
+    if (event.type == trace_log_entry_type::counter)
+    {
+        buffer_ += R"(,"args":{"value":)";
+        append_integer(event.value);
+        buffer_ += '}';
+    }
+    else if (!std::empty(event.argument_name))
+    {
+        buffer_ += R"(,"args":{")";
+        append_escaped(event.argument_name);
+        buffer_ += R"(":)";
+        append_integer(event.value);
+        buffer_ += '}';
+    }
+
+    buffer_ += '}';
+
+    if (std::size(buffer_) >= internal::json_buffer_size)
+        flush_buffer();
+}
+
+void trace_json_writer::finish()
+{
+    buffer_ += "\n]}";
+    flush_buffer();
+    file_.flush();
+}
+
+void trace_json_writer::append_integer(const std::int64_t value)
+{
+    std::array<char, 24> buffer{};
+    const auto [end, ec] = std::to_chars(std::data(buffer), std::data(buffer) + std::size(buffer), value);
+    buffer_.append(std::data(buffer), end);
+}
+
+void trace_json_writer::append_microseconds(const std::int64_t nanoseconds)
+{
+    // Written as an exact decimal with 3 digits, instead of going through a double.
+    auto value = nanoseconds;
+
+    if (value < 0)
+    {
+        buffer_ += '-';
+        value = -value;
+    }
+
+    append_integer(value / 1000);
+
+    const auto fraction = static_cast<int>(value % 1000);
+    const std::array<char, 4> digits{'.', static_cast<char>('0' + fraction / 100),
+                                     static_cast<char>('0' + (fraction / 10) % 10),
+                                     static_cast<char>('0' + fraction % 10)};
+    buffer_.append(std::data(digits), std::size(digits));
+}
+
+void trace_json_writer::append_escaped(const std::string_view str)
+{
+    for (const auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            buffer_ += '\\';
+
+        buffer_ += c;
+    }
+}
+
+void trace_json_writer::append_id(const char *category, const std::int64_t id)
+{
+    buffer_ += R"(,"cat":")";
+    buffer_ += category;
+    buffer_ += R"(","id":)";
+    append_integer(id);
+}
+
+void trace_json_writer::flush_buffer()
+{
+    file_.write(reinterpret_cast<const std::byte *>(std::data(buffer_)),
+                static_cast<std::streamsize>(std::size(buffer_)));
+    buffer_.clear();
+}
+
+} // namespace aeon::tracelog::detail
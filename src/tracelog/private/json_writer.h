@@ -0,0 +1,51 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include "trace_writer.h"
+#include <aeon/streams/devices/file_device.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::tracelog::detail
+{
+
+/*!
+ * Writes trace events in the Chrome trace event JSON format. The text is formatted into a large buffer which is
+ * written to the file in one go when it is full.
+ */
+class trace_json_writer final : public trace_writer
+{
+public:
+    explicit trace_json_writer(const std::filesystem::path &path);
+    ~trace_json_writer() final = default;
+
+    trace_json_writer(trace_json_writer &&) = delete;
+    auto operator=(trace_json_writer &&) -> trace_json_writer & = delete;
+
+    trace_json_writer(const trace_json_writer &) = delete;
+    auto operator=(const trace_json_writer &) -> trace_json_writer & = delete;
+
+    void write(const trace_log_chunk &chunk, const std::size_t begin, const std::size_t end,
+               const std::int64_t min_time, const trace_clock_conversion &conversion) final;
+
+    void write_event(const trace_event &event);
+
+    void finish() final;
+
+private:
+    void append_integer(const std::int64_t value);
+    void append_microseconds(const std::int64_t nanoseconds);
+    void append_escaped(const std::string_view str);
+    void append_id(const char *category, const std::int64_t id);
+    void flush_buffer();
+
+    streams::file_sink_device file_;
+    std::string buffer_;
+    bool first_;
+};
+
+} // namespace aeon::tracelog::detail
@@ -0,0 +1,172 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "statistics.h"
+#include "context.h"
+#include <cmath>
+
+namespace aeon::tracelog
+{
+
+namespace detail
+{
+
+thread_scope_statistics::thread_scope_statistics() noexcept
+    : count{0}
+    , total{0}
+    , min{std::numeric_limits<std::uint64_t>::max()}
+    , max{0}
+    , buckets{}
+{
+}
+
+void thread_scope_statistics::record(const std::uint64_t duration) noexcept
+{
+    // Only the owning thread writes, so a load followed by a store can not lose updates.
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+
+    if (duration < min.load(std::memory_order_relaxed))
+        min.store(duration, std::memory_order_relaxed);
+
+    if (duration > max.load(std::memory_order_relaxed))
+        max.store(duration, std::memory_order_relaxed);
+
+    auto &bucket = buckets[histogram_bucket_index(duration)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+scope_statistics_accumulator::scope_statistics_accumulator()
+    : count{0}
+    , total{0}
+    , min{std::numeric_limits<std::uint64_t>::max()}
+    , max{0}
+    , buckets(histogram_bucket_count)
+{
+}
+
+void scope_statistics_accumulator::merge(const thread_scope_statistics &statistics) noexcept
+{
+    count += statistics.count.load(std::memory_order_relaxed);
+    total += statistics.total.load(std::memory_order_relaxed);
+    min = std::min(min, statistics.min.load(std::memory_order_relaxed));
+    max = std::max(max, statistics.max.load(std::memory_order_relaxed));
+
+    for (std::size_t i = 0; i < histogram_bucket_count; ++i)
+        buckets[i] += statistics.buckets[i].load(std::memory_order_relaxed);
+}
+
+void scope_statistics_accumulator::merge(const scope_statistics_accumulator &statistics) noexcept
+{
+    count += statistics.count;
+    total += statistics.total;
+    min = std::min(min, statistics.min);
+    max = std::max(max, statistics.max);
+
+    for (std::size_t i = 0; i < histogram_bucket_count; ++i)
+        buckets[i] += statistics.buckets[i];
+}
+
+auto scope_statistics_accumulator::value_at_percentile(const double percentile) const noexcept -> std::uint64_t
+{
+    const auto target =
+        std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count))));
+
+    std::uint64_t counted = 0;
+    for (std::size_t i = 0; i < histogram_bucket_count; ++i)
+    {
+        counted += buckets[i];
+
+        if (counted >= target)
+            return std::clamp(histogram_bucket_upper_bound(i), min, max);
+    }
+
+    // The histogram is read while it may be modified, so its sum may be slightly behind the count.
+    return max;
+}
+
+thread_statistics::thread_statistics()
+    : mutex_{}
+    , scopes_{}
+    , reset_requested_{false}
+{
+}
+
+void thread_statistics::record(const char *name, const std::uint64_t duration)
+{
+    if (reset_requested_.load(std::memory_order_relaxed)) [[unlikely]]
+    {
+        std::scoped_lock lock{mutex_};
+        scopes_.clear();
+        reset_requested_.store(false, std::memory_order_relaxed);
+    }
+
+    auto result = scopes_.find(name);
+
+    if (result == std::end(scopes_)) [[unlikely]]
+    {
+        std::scoped_lock lock{mutex_};
+        result = scopes_.emplace(name, std::make_unique<thread_scope_statistics>()).first;
+    }
+
+    result->second->record(duration);
+}
+
+void thread_statistics::request_reset() noexcept
+{
+    std::scoped_lock lock{mutex_};
+    reset_requested_.store(true, std::memory_order_relaxed);
+}
+
+void thread_statistics::merge_into(scope_statistics_map &statistics)
+{
+    std::scoped_lock lock{mutex_};
+
+    // These statistics are about to be cleared.
+    if (reset_requested_.load(std::memory_order_relaxed))
+        return;
+
+    for (const auto &[name, scope] : scopes_)
+        statistics[name].merge(*scope);
+}
+
+} // namespace detail
+
+auto statistics_snapshot() -> std::vector<scope_statistics>
+{
+    auto &context = detail::trace_log_context::get_singleton();
+    const auto merged = context.merge_statistics();
+    const auto nanoseconds_per_tick = context.calibrate().nanoseconds_per_tick;
+
+    const auto to_duration = [nanoseconds_per_tick](const std::uint64_t ticks)
+    { return std::chrono::nanoseconds{std::llround(static_cast<double>(ticks) * nanoseconds_per_tick)}; };
+
+    std::vector<scope_statistics> result;
+    result.reserve(std::size(merged));
+
+    for (const auto &[name, statistics] : merged)
+    {
+        if (statistics.count == 0)
+            continue;
+
+        auto &s = result.emplace_back();
+        s.name = name;
+        s.count = statistics.count;
+        s.total = to_duration(statistics.total);
+        s.min = to_duration(statistics.min);
+        s.max = to_duration(statistics.max);
+        s.p50 = to_duration(statistics.value_at_percentile(50.0));
+        s.p90 = to_duration(statistics.value_at_percentile(90.0));
+        s.p99 = to_duration(statistics.value_at_percentile(99.0));
+        s.p999 = to_duration(statistics.value_at_percentile(99.9));
+    }
+
+    std::ranges::sort(result, [](const auto &lhs, const auto &rhs) { return lhs.total > rhs.total; });
+    return result;
+}
+
+void reset_statistics()
+{
+    detail::trace_log_context::get_singleton().reset_statistics();
+}
+
+} // namespace aeon::tracelog
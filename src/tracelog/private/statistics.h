@@ -0,0 +1,143 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/tracelog/statistics.h>
+#include <unordered_map>
+#include <map>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <string_view>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::tracelog::detail
+{
+
+/*
+ * Layout of the latency histogram. Durations (in clock ticks) below 2 * histogram_sub_bucket_count have a bucket of
+ * their own. Above that, every power of two is split into histogram_sub_bucket_count buckets of equal width, so that
+ * the width of a bucket is never more than 1 / histogram_sub_bucket_count of its value. Longer durations than
+ * histogram_max_value are counted in the last bucket.
+ */
+inline constexpr int histogram_sub_bucket_bits = 5;
+inline constexpr std::uint64_t histogram_sub_bucket_count = 1ull << histogram_sub_bucket_bits;
+inline constexpr int histogram_max_value_bits = 44;
+inline constexpr std::uint64_t histogram_max_value = (1ull << histogram_max_value_bits) - 1;
+inline constexpr std::size_t histogram_bucket_count =
+    2 * histogram_sub_bucket_count + (histogram_max_value_bits - histogram_sub_bucket_bits - 1) * histogram_sub_bucket_count;
+
+[[nodiscard]] constexpr auto histogram_bucket_index(const std::uint64_t value) noexcept -> std::size_t
+{
+    const auto v = std::min(value, histogram_max_value);
+
+    if (v < 2 * histogram_sub_bucket_count)
+        return static_cast<std::size_t>(v);
+
+    const auto shift = static_cast<std::uint64_t>(std::bit_width(v)) - (histogram_sub_bucket_bits + 1);
+    return static_cast<std::size_t>(2 * histogram_sub_bucket_count + (shift - 1) * histogram_sub_bucket_count +
+                                    (v >> shift) - histogram_sub_bucket_count);
+}
+
+/*!
+ * The highest value that is counted in the bucket with the given index.
+ */
+[[nodiscard]] constexpr auto histogram_bucket_upper_bound(const std::size_t index) noexcept -> std::uint64_t
+{
+    if (index < 2 * histogram_sub_bucket_count)
+        return index;
+
+    const auto offset = index - 2 * histogram_sub_bucket_count;
+    const auto shift = offset / histogram_sub_bucket_count + 1;
+    const auto sub_bucket = offset % histogram_sub_bucket_count + histogram_sub_bucket_count;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+/*!
+ * The timings of a single scope on a single thread. Only the owning thread modifies it, but other threads may read it
+ * at the same time when taking a snapshot; that is why all fields are atomic. Relaxed loads and stores are as cheap as
+ * regular memory accesses, so recording does not need any read-modify-write operations.
+ */
+struct thread_scope_statistics
+{
+    thread_scope_statistics() noexcept;
+
+    void record(const std::uint64_t duration) noexcept;
+
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> min;
+    std::atomic<std::uint64_t> max;
+    std::array<std::atomic<std::uint64_t>, histogram_bucket_count> buckets;
+};
+
+/*!
+ * Statistics of a scope merged from multiple threads. Durations are in clock ticks.
+ */
+struct scope_statistics_accumulator
+{
+    scope_statistics_accumulator();
+
+    void merge(const thread_scope_statistics &statistics) noexcept;
+    void merge(const scope_statistics_accumulator &statistics) noexcept;
+
+    /*!
+     * The value below which the given percentage (0-100) of the recorded durations fall.
+     */
+    [[nodiscard]] auto value_at_percentile(const double percentile) const noexcept -> std::uint64_t;
+
+    std::uint64_t count;
+    std::uint64_t total;
+    std::uint64_t min;
+    std::uint64_t max;
+    std::vector<std::uint64_t> buckets;
+};
+
+// Keyed by name rather than by pointer, since the same name may be given by different string literals.
+using scope_statistics_map = std::map<std::string_view, scope_statistics_accumulator>;
+
+/*!
+ * The statistics of all scopes recorded by a single thread.
+ */
+class thread_statistics final
+{
+public:
+    thread_statistics();
+    ~thread_statistics() = default;
+
+    thread_statistics(thread_statistics &&) = delete;
+    auto operator=(thread_statistics &&) -> thread_statistics & = delete;
+
+    thread_statistics(const thread_statistics &) = delete;
+    auto operator=(const thread_statistics &) -> thread_statistics & = delete;
+
+    /*!
+     * Must only be called by the owning thread.
+     */
+    void record(const char *name, const std::uint64_t duration);
+
+    /*!
+     * Ask the owning thread to clear its statistics the next time it records a scope.
+     */
+    void request_reset() noexcept;
+
+    /*!
+     * Add the statistics of this thread to the given map. May be called from any thread.
+     */
+    void merge_into(scope_statistics_map &statistics);
+
+private:
+    // Only the owning thread modifies the table. It takes the mutex when doing so, so that other threads can safely
+    // read the table while holding it.
+    std::mutex mutex_;
+    std::unordered_map<const char *, std::unique_ptr<thread_scope_statistics>> scopes_;
+    std::atomic<bool> reset_requested_;
+};
+
+} // namespace aeon::tracelog::detail
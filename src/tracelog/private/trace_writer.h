@@ -0,0 +1,59 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include "data.h"
+#include "clock.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::tracelog::detail
+{
+
+/*!
+ * Base class for the output formats of the trace log.
+ */
+class trace_writer
+{
+public:
+    trace_writer() = default;
+    virtual ~trace_writer() = default;
+
+    trace_writer(trace_writer &&) = delete;
+    auto operator=(trace_writer &&) -> trace_writer & = delete;
+
+    trace_writer(const trace_writer &) = delete;
+    auto operator=(const trace_writer &) -> trace_writer & = delete;
+
+    /*!
+     * Write the entries [begin, end) of the given chunk. Entries that ended before min_time (in clock ticks) are
+     * skipped.
+     */
+    virtual void write(const trace_log_chunk &chunk, const std::size_t begin, const std::size_t end,
+                       const std::int64_t min_time, const trace_clock_conversion &conversion) = 0;
+
+    /*!
+     * Write any buffered data and terminate the file. Nothing may be written after this.
+     */
+    virtual void finish() = 0;
+
+protected:
+    [[nodiscard]] static auto to_event(const trace_log_chunk &chunk, const trace_log_entry &entry,
+                                       const trace_clock_conversion &conversion) noexcept -> trace_event
+    {
+        trace_event event;
+        event.thread_id = chunk.thread_id;
+        event.type = entry.type;
+        event.begin = conversion.to_nanoseconds(entry.begin);
+        event.end = (entry.begin == entry.end) ? event.begin : conversion.to_nanoseconds(entry.end);
+        event.name = entry.name;
+        event.value = entry.value;
+
+        if (entry.argument_name)
+            event.argument_name = entry.argument_name;
+
+        return event;
+    }
+};
+
+} // namespace aeon::tracelog::detail
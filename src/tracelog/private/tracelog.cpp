@@ -9,31 +9,70 @@ namespace aeon::tracelog
 namespace detail
 {
 
-[[nodiscard]] auto add_entry(const char *func) -> trace_log_entry *
+[[nodiscard]] auto timestamp() noexcept -> std::int64_t
 {
-    return detail::trace_log_context::get_singleton().add_scoped_log_entry(func);
+    return detail::trace_log_context::get_singleton().timestamp();
 }
 
-void add_exit(trace_log_entry *entry)
+void add_scope(const char *name, const std::int64_t begin)
 {
-    detail::trace_log_context::get_singleton().add_scoped_log_exit(entry);
+    auto &context = detail::trace_log_context::get_singleton();
+    context.add_scope({begin, context.timestamp(), name, nullptr, 0, trace_log_entry_type::scope});
 }
 
-void add_event(const char *func)
+void add_scope(const char *name, const std::int64_t begin, const char *argument_name, const std::int64_t value)
 {
-    detail::trace_log_context::get_singleton().add_event(func);
+    auto &context = detail::trace_log_context::get_singleton();
+    context.add_scope({begin, context.timestamp(), name, argument_name, value, trace_log_entry_type::scope});
+}
+
+void add_event(const trace_log_entry_type type, const char *name, const char *argument_name, const std::int64_t value)
+{
+    auto &context = detail::trace_log_context::get_singleton();
+    const auto now = context.timestamp();
+    context.add_entry({now, now, name, argument_name, value, type});
 }
 
 } // namespace detail
 
+void enable(const category categories) noexcept
+{
+    detail::enabled_category_mask.fetch_or(categories, std::memory_order_relaxed);
+}
+
+void disable(const category categories) noexcept
+{
+    detail::enabled_category_mask.fetch_and(~categories, std::memory_order_relaxed);
+}
+
+[[nodiscard]] auto enabled_categories() noexcept -> category
+{
+    return detail::enabled_category_mask.load(std::memory_order_relaxed);
+}
+
+void configure(const settings &s)
+{
+    detail::trace_log_context::get_singleton().configure(s);
+}
+
 void initialize()
 {
     detail::trace_log_context::get_singleton().initialize();
 }
 
-void write(const std::filesystem::path &file)
+void write(const std::filesystem::path &file, const output_format format)
+{
+    detail::trace_log_context::get_singleton().write(file, format);
+}
+
+void begin_streaming(const std::filesystem::path &file, const output_format format)
+{
+    detail::trace_log_context::get_singleton().begin_streaming(file, format);
+}
+
+void end_streaming()
 {
-    detail::trace_log_context::get_singleton().write(file);
+    detail::trace_log_context::get_singleton().end_streaming();
 }
 
 } // namespace aeon::tracelog
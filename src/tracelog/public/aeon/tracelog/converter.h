@@ -0,0 +1,16 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <filesystem>
+
+namespace aeon::tracelog
+{
+
+/*!
+ * Convert a trace written in the binary format to the Chrome trace event JSON format, which can be loaded in
+ * chrome://tracing or Perfetto. Throws tracelog_exception if the source file is not a valid binary trace.
+ */
+void convert_to_json(const std::filesystem::path &binary_file, const std::filesystem::path &json_file);
+
+} // namespace aeon::tracelog
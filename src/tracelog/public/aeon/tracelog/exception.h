@@ -0,0 +1,14 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <stdexcept>
+
+namespace aeon::tracelog
+{
+
+class tracelog_exception : public std::exception
+{
+};
+
+} // namespace aeon::tracelog
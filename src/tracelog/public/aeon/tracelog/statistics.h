@@ -0,0 +1,55 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace aeon::tracelog
+{
+
+/*!
+ * Aggregated timings of all recorded instances of a traced scope, over all threads.
+ *
+ * Percentiles are taken from a histogram with logarithmic buckets, in the style of an HDR histogram. They are accurate
+ * to within about 3% of the actual value.
+ */
+struct scope_statistics final
+{
+    std::string name;
+    std::uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p90{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds p999{0};
+
+    [[nodiscard]] auto mean() const noexcept -> std::chrono::nanoseconds
+    {
+        if (count == 0)
+            return std::chrono::nanoseconds{0};
+
+        return total / static_cast<std::int64_t>(count);
+    }
+};
+
+/*!
+ * Statistics are collected when settings::collect_statistics is enabled. Every thread aggregates the timings of its
+ * scopes in a table of its own, so that recording a scope never waits for other threads. The tables are merged when
+ * a snapshot is taken. Statistics of threads that have exited are kept.
+ *
+ * Returns the statistics of all scopes, sorted by total time (highest first).
+ */
+[[nodiscard]] auto statistics_snapshot() -> std::vector<scope_statistics>;
+
+/*!
+ * Clear all collected statistics. Threads clear their table the next time they record a scope; until then their
+ * statistics are no longer included in snapshots.
+ */
+void reset_statistics();
+
+} // namespace aeon::tracelog
@@ -4,30 +4,155 @@
 
 #include <aeon/common/preprocessor.h>
 #include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
 
 namespace aeon::tracelog
 {
 
+enum class buffer_mode
+{
+    // Keep all events until they are written. Memory usage grows with the amount of events.
+    unbounded,
+
+    // Keep a fixed amount of chunks. When all chunks are full, the oldest chunk is reused, so that only the most
+    // recent events are kept.
+    ring
+};
+
+enum class output_format
+{
+    // The Chrome trace event JSON format, which can be loaded in chrome://tracing or Perfetto.
+    json,
+
+    // A compact binary format, which is much smaller and faster to write. Use convert_to_json (converter.h) to
+    // convert it to JSON for viewing.
+    binary
+};
+
+struct settings final
+{
+    settings() = default;
+    ~settings() = default;
+
+    settings(settings &&) = default;
+    auto operator=(settings &&) -> settings & = default;
+
+    settings(const settings &) = default;
+    auto operator=(const settings &) -> settings & = default;
+
+    // The amount of events per chunk. Every thread that is traced has one chunk that it is writing to.
+    std::size_t chunk_size = 64 * 1024;
+
+    buffer_mode mode = buffer_mode::unbounded;
+
+    // The amount of full chunks (shared by all threads) to keep in ring mode.
+    std::size_t ring_chunk_count = 64;
+
+    // In ring mode, only write events that ended within this duration before the write. 0 writes all kept events.
+    std::chrono::milliseconds ring_duration{0};
+
+    // Record every event, so that they can be written to a file.
+    bool record_events = true;
+
+    // Aggregate the timings of every traced scope; see statistics.h. This can be used without recording events, which
+    // keeps the memory usage small regardless of how long tracing runs.
+    bool collect_statistics = false;
+};
+
+/*!
+ * A set of trace categories as a bit mask. Applications define their own categories as single bits, for example:
+ * constexpr aeon::tracelog::category rendering = 1 << 1; and give them to the macros and event functions below.
+ * Events that are not given a category belong to default_category.
+ */
+using category = std::uint64_t;
+
+inline constexpr category default_category = 1;
+inline constexpr category all_categories = ~category{0};
+
 namespace detail
 {
 
-struct trace_log_entry;
+// The categories that are currently enabled. This is checked inline by every traced event, so that a disabled event
+// costs no more than a load and a branch.
+inline std::atomic<category> enabled_category_mask{all_categories};
 
-auto add_entry(const char *func) -> trace_log_entry *;
-void add_exit(trace_log_entry *entry);
-void add_event(const char *func);
+enum class trace_log_entry_type : std::uint8_t
+{
+    scope,
+    instant,
+    counter,
+    async_begin,
+    async_end,
+    flow_begin,
+    flow_end
+};
+
+/*!
+ * The current time in ticks of the trace clock.
+ */
+[[nodiscard]] auto timestamp() noexcept -> std::int64_t;
+void add_scope(const char *name, const std::int64_t begin);
+void add_scope(const char *name, const std::int64_t begin, const char *argument_name, const std::int64_t value);
+void add_event(const trace_log_entry_type type, const char *name, const char *argument_name, const std::int64_t value);
+
+} // namespace detail
+
+/*!
+ * Returns true if any of the given categories is enabled.
+ */
+[[nodiscard]] inline auto is_enabled(const category categories) noexcept -> bool
+{
+    return (detail::enabled_category_mask.load(std::memory_order_relaxed) & categories) != 0;
+}
+
+namespace detail
+{
 
 class [[nodiscard]] scoped_trace_log
 {
 public:
-    scoped_trace_log(const char *func)
+    explicit scoped_trace_log(const char *name, const category categories = default_category)
+        : name_{nullptr}
+        , argument_name_{nullptr}
+        , value_{0}
+        , begin_{0}
+    {
+        if (is_enabled(categories))
+        {
+            name_ = name;
+            begin_ = timestamp();
+        }
+    }
+
+    explicit scoped_trace_log(const char *name, const char *argument_name, const std::int64_t value,
+                              const category categories = default_category)
+        : name_{nullptr}
+        , argument_name_{argument_name}
+        , value_{value}
+        , begin_{0}
     {
-        entry_ = detail::add_entry(func);
+        if (is_enabled(categories))
+        {
+            name_ = name;
+            begin_ = timestamp();
+        }
     }
 
+    /*!
+     * A scope that was enabled when it started is always recorded, even if its category was disabled in the meantime.
+     */
     ~scoped_trace_log()
     {
-        detail::add_exit(entry_);
+        if (!name_)
+            return;
+
+        if (argument_name_)
+            detail::add_scope(name_, begin_, argument_name_, value_);
+        else
+            detail::add_scope(name_, begin_);
     }
 
     scoped_trace_log(scoped_trace_log &&) = delete;
@@ -37,24 +162,144 @@ public:
     auto operator=(const scoped_trace_log &) -> scoped_trace_log & = delete;
 
 private:
-    trace_log_entry *entry_;
+    const char *name_;
+    const char *argument_name_;
+    std::int64_t value_;
+    std::int64_t begin_;
 };
 
 } // namespace detail
 
 /*!
- * Must be called at the start of each thread before using aeon_scoped_tracelog.
+ * Enable the given categories, in addition to the categories that are already enabled. All categories are enabled by
+ * default. This can be called at any time from any thread; events that are in progress are not affected.
+ */
+void enable(const category categories = all_categories) noexcept;
+
+/*!
+ * Disable the given categories. Events of a disabled category are not recorded, which only costs a single check.
+ * This can be called at any time from any thread.
+ */
+void disable(const category categories = all_categories) noexcept;
+
+/*!
+ * Returns the mask of the categories that are currently enabled.
+ */
+[[nodiscard]] auto enabled_categories() noexcept -> category;
+
+/*
+ * All names given to the functions below must be string literals, or otherwise outlive the trace log, since only the
+ * pointer is stored. Events are only recorded if (one of) their categories is enabled.
+ */
+
+/*!
+ * Record an instant event.
+ */
+inline void instant(const char *name, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::instant, name, nullptr, 0);
+}
+
+/*!
+ * Record an instant event with an integer argument.
+ */
+inline void instant(const char *name, const char *argument_name, const std::int64_t value,
+                    const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::instant, name, argument_name, value);
+}
+
+/*!
+ * Record the value of a counter, for example the depth of a queue. Shown as a graph over time.
+ */
+inline void counter(const char *name, const std::int64_t value, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::counter, name, nullptr, value);
+}
+
+/*!
+ * Mark the beginning of an asynchronous operation that may end on another thread. The id must be unique among the
+ * operations with the same name that are in progress.
+ */
+inline void async_begin(const char *name, const std::uint64_t id, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::async_begin, name, nullptr, static_cast<std::int64_t>(id));
+}
+
+/*!
+ * Mark the end of an asynchronous operation started with async_begin.
+ */
+inline void async_end(const char *name, const std::uint64_t id, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::async_end, name, nullptr, static_cast<std::int64_t>(id));
+}
+
+/*!
+ * Start a flow (an arrow between events, for example from where work is queued to where it is processed). Should be
+ * called within a traced scope, to which the start of the arrow is attached.
+ */
+inline void flow_begin(const char *name, const std::uint64_t id, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::flow_begin, name, nullptr, static_cast<std::int64_t>(id));
+}
+
+/*!
+ * End a flow started with flow_begin. Should be called within a traced scope, to which the arrow points.
+ */
+inline void flow_end(const char *name, const std::uint64_t id, const category categories = default_category)
+{
+    if (is_enabled(categories))
+        detail::add_event(detail::trace_log_entry_type::flow_end, name, nullptr, static_cast<std::int64_t>(id));
+}
+
+/*!
+ * Change the settings of the trace logger. Changes to the chunk size only apply to chunks that are allocated after
+ * this call, so this should be called before initialize().
+ */
+void configure(const settings &s);
+
+/*!
+ * Register the calling thread with the trace logger. Threads are registered automatically when they record their
+ * first event, so calling this is optional; it can be used to avoid the allocation on the first event of a thread.
  */
 void initialize();
 
 /*!
  * Should be called at the end of tracing. This will clear all current tracing buffers.
- * The file may not already exist.
+ * If the file already exists, it is truncated.
+ */
+void write(const std::filesystem::path &file, const output_format format = output_format::json);
+
+/*!
+ * Start writing events to the given file in the background while tracing continues. Whenever a chunk of events is
+ * full, it is written to the file and the chunk is reused, which keeps memory usage bounded regardless of the buffer
+ * mode.
  */
-void write(const std::filesystem::path &file);
+void begin_streaming(const std::filesystem::path &file, const output_format format = output_format::json);
+
+/*!
+ * Write all remaining events to the file given to begin_streaming, and close it.
+ */
+void end_streaming();
 
 #define aeon_tracelog_scoped() aeon::tracelog::detail::scoped_trace_log aeon_anonymous_variable(trace)(__FUNCTION__)
 
-#define aeon_event() aeon::tracelog::detail::add_trace_log_event(__FUNCTION__)
+#define aeon_tracelog_scoped_category(category)                                                                       \
+    aeon::tracelog::detail::scoped_trace_log aeon_anonymous_variable(trace)(__FUNCTION__, category)
+
+#define aeon_tracelog_scoped_value(argument_name, value)                                                              \
+    aeon::tracelog::detail::scoped_trace_log aeon_anonymous_variable(trace)(__FUNCTION__, argument_name, value)
+
+#define aeon_tracelog_scoped_category_value(category, argument_name, value)                                           \
+    aeon::tracelog::detail::scoped_trace_log aeon_anonymous_variable(trace)(__FUNCTION__, argument_name, value,       \
+                                                                            category)
+
+#define aeon_event() aeon::tracelog::instant(__FUNCTION__)
 
 } // namespace aeon::tracelog
@@ -1,9 +1,16 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/tracelog/tracelog.h>
+#include <aeon/tracelog/converter.h>
+#include <aeon/tracelog/exception.h>
+#include <aeon/tracelog/statistics.h>
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
 
 static void test_func3([[maybe_unused]] float a, [[maybe_unused]] const char *str)
 {
@@ -32,6 +39,30 @@ static void test_func1(int arg1, [[maybe_unused]] float arg2)
     }
 }
 
+static void test_event_func()
+{
+    aeon_event();
+}
+
+static void test_scope_func()
+{
+    aeon_tracelog_scoped();
+}
+
+[[nodiscard]] static auto count_occurrences(const std::filesystem::path &path, const std::string &str)
+{
+    std::ifstream file{path};
+    std::stringstream stream;
+    stream << file.rdbuf();
+    const auto content = stream.str();
+
+    auto count = 0u;
+    for (auto pos = content.find(str); pos != std::string::npos; pos = content.find(str, pos + 1))
+        ++count;
+
+    return count;
+}
+
 TEST(test_tracelog, test_tracelog_basic_stack)
 {
     aeon::tracelog::initialize();
@@ -43,3 +74,293 @@ TEST(test_tracelog, test_tracelog_basic_stack)
 
     aeon::tracelog::write("test.trace");
 }
+
+TEST(test_tracelog, test_tracelog_ring_mode_keeps_latest_events)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 16;
+    settings.mode = aeon::tracelog::buffer_mode::ring;
+    settings.ring_chunk_count = 2;
+    aeon::tracelog::configure(settings);
+
+    std::thread thread{[]()
+                       {
+                           aeon::tracelog::initialize();
+
+                           for (int i = 0; i < 1000; ++i)
+                               test_event_func();
+                       }};
+    thread.join();
+
+    aeon::tracelog::write("test_ring.trace");
+
+    // Two chunks are kept: the last full chunk, and the partially filled chunk of the thread.
+    EXPECT_EQ(16u + 1000u % 16u, count_occurrences("test_ring.trace", "test_event_func"));
+}
+
+TEST(test_tracelog, test_tracelog_ring_mode_bounds_chunks_of_exited_threads)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 16;
+    settings.mode = aeon::tracelog::buffer_mode::ring;
+    settings.ring_chunk_count = 2;
+    aeon::tracelog::configure(settings);
+
+    // Every thread leaves a partially filled chunk behind when it exits.
+    for (int i = 0; i < 10; ++i)
+    {
+        std::thread thread{[]()
+                           {
+                               for (int j = 0; j < 5; ++j)
+                                   test_event_func();
+                           }};
+        thread.join();
+    }
+
+    aeon::tracelog::write("test_ring_threads.trace");
+
+    EXPECT_EQ(2u * 5u, count_occurrences("test_ring_threads.trace", "test_event_func"));
+}
+
+TEST(test_tracelog, test_tracelog_streaming)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 16;
+    aeon::tracelog::configure(settings);
+
+    aeon::tracelog::begin_streaming("test_stream.trace");
+
+    std::thread thread{[]()
+                       {
+                           aeon::tracelog::initialize();
+
+                           for (int i = 0; i < 1000; ++i)
+                               test_scope_func();
+                       }};
+    thread.join();
+
+    aeon::tracelog::end_streaming();
+
+    EXPECT_EQ(1000u, count_occurrences("test_stream.trace", "test_scope_func"));
+}
+
+TEST(test_tracelog, test_tracelog_binary_format_converts_to_json)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 64;
+    aeon::tracelog::configure(settings);
+
+    std::thread thread{[]()
+                       {
+                           aeon::tracelog::initialize();
+
+                           for (int i = 0; i < 1000; ++i)
+                           {
+                               test_scope_func();
+                               test_event_func();
+                           }
+                       }};
+    thread.join();
+
+    aeon::tracelog::write("test_binary.trace", aeon::tracelog::output_format::binary);
+    aeon::tracelog::convert_to_json("test_binary.trace", "test_binary.json");
+
+    EXPECT_EQ(1000u, count_occurrences("test_binary.json", R"("ph":"X","name":"test_scope_func"})"));
+    EXPECT_EQ(1000u, count_occurrences("test_binary.json", R"("ph":"i","s":"t","name":"test_event_func"})"));
+
+    // The binary format is much more compact than the JSON format.
+    EXPECT_LT(std::filesystem::file_size("test_binary.trace") * 10, std::filesystem::file_size("test_binary.json"));
+}
+
+TEST(test_tracelog, test_tracelog_convert_invalid_file_throws)
+{
+    {
+        std::ofstream file{"test_invalid.trace"};
+        file << "This is not a trace.";
+    }
+
+    EXPECT_THROW(aeon::tracelog::convert_to_json("test_invalid.trace", "test_invalid.json"),
+                 aeon::tracelog::tracelog_exception);
+}
+
+TEST(test_tracelog, test_tracelog_convert_invalid_record_size_throws)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 64;
+    aeon::tracelog::configure(settings);
+
+    std::thread thread{[]()
+                       {
+                           for (int i = 0; i < 10; ++i)
+                               test_event_func();
+                       }};
+    thread.join();
+
+    aeon::tracelog::write("test_record_size.trace", aeon::tracelog::output_format::binary);
+
+    // Change the payload size of the first record (after the 8 byte header and the record type) to 4GB.
+    {
+        std::fstream file{"test_record_size.trace", std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(9);
+        file.write("\xff\xff\xff\xff", 4);
+    }
+
+    EXPECT_THROW(aeon::tracelog::convert_to_json("test_record_size.trace", "test_record_size.json"),
+                 aeon::tracelog::tracelog_exception);
+
+    // A size that is only slightly too large.
+    {
+        std::fstream file{"test_record_size.trace", std::ios::in | std::ios::out | std::ios::binary};
+        const auto size = static_cast<std::uint32_t>(std::filesystem::file_size("test_record_size.trace"));
+        const char bytes[] = {static_cast<char>(size & 0xff), static_cast<char>((size >> 8) & 0xff),
+                              static_cast<char>((size >> 16) & 0xff), static_cast<char>((size >> 24) & 0xff)};
+        file.seekp(9);
+        file.write(bytes, 4);
+    }
+
+    EXPECT_THROW(aeon::tracelog::convert_to_json("test_record_size.trace", "test_record_size.json"),
+                 aeon::tracelog::tracelog_exception);
+}
+
+static void test_value_scope_func(const std::int64_t value)
+{
+    aeon_tracelog_scoped_value("items", value);
+}
+
+TEST(test_tracelog, test_tracelog_event_types)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 4;
+    aeon::tracelog::configure(settings);
+
+    std::thread thread{[]()
+                       {
+                           aeon::tracelog::initialize();
+
+                           test_value_scope_func(42);
+                           aeon::tracelog::instant("marker", "frame", -3);
+                           aeon::tracelog::counter("queue_depth", 17);
+                           aeon::tracelog::async_begin("request", 1000);
+                           aeon::tracelog::flow_begin("job", 7);
+                           aeon::tracelog::flow_end("job", 7);
+                           aeon::tracelog::async_end("request", 1000);
+                       }};
+    thread.join();
+
+    aeon::tracelog::write("test_event_types.trace", aeon::tracelog::output_format::binary);
+    aeon::tracelog::convert_to_json("test_event_types.trace", "test_event_types.json");
+
+    const auto file = "test_event_types.json";
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"X","name":"test_value_scope_func","args":{"items":42}})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"i","s":"t","name":"marker","args":{"frame":-3}})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"C","name":"queue_depth","args":{"value":17}})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"b","cat":"async","id":1000,"name":"request"})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"e","cat":"async","id":1000,"name":"request"})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"s","cat":"flow","id":7,"name":"job"})"));
+    EXPECT_EQ(1u, count_occurrences(file, R"("ph":"f","bp":"e","cat":"flow","id":7,"name":"job"})"));
+}
+
+static constexpr aeon::tracelog::category test_category_network = 1 << 1;
+static constexpr aeon::tracelog::category test_category_rendering = 1 << 2;
+
+static void test_network_func()
+{
+    aeon_tracelog_scoped_category(test_category_network);
+}
+
+static void test_rendering_func()
+{
+    aeon_tracelog_scoped_category(test_category_rendering);
+    aeon::tracelog::counter("triangles", 3, test_category_rendering);
+}
+
+TEST(test_tracelog, test_tracelog_categories)
+{
+    aeon::tracelog::settings settings;
+    settings.chunk_size = 64;
+    aeon::tracelog::configure(settings);
+
+    aeon::tracelog::disable(test_category_rendering);
+    EXPECT_FALSE(aeon::tracelog::is_enabled(test_category_rendering));
+    EXPECT_TRUE(aeon::tracelog::is_enabled(test_category_network | test_category_rendering));
+
+    // The thread does not call initialize(); it is registered on its first event.
+    std::thread thread{[]()
+                       {
+                           for (int i = 0; i < 100; ++i)
+                           {
+                               test_network_func();
+                               test_rendering_func();
+                           }
+
+                           aeon::tracelog::disable();
+
+                           for (int i = 0; i < 100; ++i)
+                               test_network_func();
+
+                           aeon::tracelog::enable(test_category_rendering);
+                           test_rendering_func();
+                       }};
+    thread.join();
+
+    EXPECT_EQ(test_category_rendering, aeon::tracelog::enabled_categories());
+    aeon::tracelog::enable();
+
+    aeon::tracelog::write("test_categories.trace");
+
+    EXPECT_EQ(100u, count_occurrences("test_categories.trace", "test_network_func"));
+    EXPECT_EQ(1u, count_occurrences("test_categories.trace", "test_rendering_func"));
+    EXPECT_EQ(1u, count_occurrences("test_categories.trace", "triangles"));
+}
+
+static void test_statistics_func()
+{
+    aeon_tracelog_scoped();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+TEST(test_tracelog, test_tracelog_statistics)
+{
+    aeon::tracelog::settings settings;
+    settings.record_events = false;
+    settings.collect_statistics = true;
+    aeon::tracelog::configure(settings);
+
+    const auto run = []()
+    {
+        for (int i = 0; i < 50; ++i)
+            test_statistics_func();
+    };
+
+    std::thread thread1{run};
+    std::thread thread2{run};
+    thread1.join();
+    thread2.join();
+
+    // Statistics of a thread that is still running are included as well.
+    run();
+
+    const auto statistics = aeon::tracelog::statistics_snapshot();
+    const auto result = std::ranges::find(statistics, "test_statistics_func", &aeon::tracelog::scope_statistics::name);
+    ASSERT_NE(result, std::end(statistics));
+
+    EXPECT_EQ(150u, result->count);
+    EXPECT_GE(result->min, std::chrono::microseconds(100));
+    EXPECT_LE(result->min, result->p50);
+    EXPECT_LE(result->p50, result->p90);
+    EXPECT_LE(result->p90, result->p99);
+    EXPECT_LE(result->p99, result->p999);
+    EXPECT_LE(result->p999, result->max);
+    EXPECT_GE(result->total, result->min * 150);
+    EXPECT_EQ(result->total / 150, result->mean());
+
+    aeon::tracelog::reset_statistics();
+    EXPECT_TRUE(std::empty(aeon::tracelog::statistics_snapshot()));
+
+    test_statistics_func();
+    const auto after_reset = aeon::tracelog::statistics_snapshot();
+    ASSERT_EQ(1u, std::size(after_reset));
+    EXPECT_EQ(1u, after_reset.front().count);
+
+    aeon::tracelog::configure({});
+}
@@ -0,0 +1,165 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/route_tree.h>
+#include <aeon/web/http/route.h>
+#include <aeon/common/string.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <memory>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class null_route final : public web::http::route
+{
+public:
+    explicit null_route(common::string mount_point)
+        : route{std::move(mount_point)}
+    {
+    }
+
+    void on_http_request([[maybe_unused]] web::http::http_server_socket &source,
+                         [[maybe_unused]] web::http::routable_http_server_session &session,
+                         [[maybe_unused]] const web::http::request &request) final
+    {
+    }
+};
+
+[[nodiscard]] static auto make_mount_point(const std::int64_t index) -> common::string
+{
+    return common::string{"/api/v1/resource" + std::to_string(index)};
+}
+
+[[nodiscard]] static auto make_routes(const std::int64_t count) -> std::vector<std::unique_ptr<null_route>>
+{
+    std::vector<std::unique_ptr<null_route>> routes;
+
+    for (std::int64_t i = 0; i < count; ++i)
+        routes.push_back(std::make_unique<null_route>(make_mount_point(i)));
+
+    return routes;
+}
+
+[[nodiscard]] static auto make_paths(const std::int64_t count) -> std::vector<common::string>
+{
+    std::vector<common::string> paths;
+
+    for (std::int64_t i = 0; i < count; i += std::max<std::int64_t>(count / 16, 1))
+        paths.push_back(make_mount_point(i) + "/1234/items?page=2");
+
+    return paths;
+}
+
+/*!
+ * The lookup that routable_http_server_session used before route_tree: a scan over all mount points.
+ */
+[[nodiscard]] static auto find_best_match_route(const std::map<common::string, web::http::route *> &routes,
+                                                const common::string &path, common::string &route_path)
+    -> web::http::route *
+{
+    auto actual_path = path;
+
+    if (path[0] != '/')
+        actual_path = "/" + path;
+
+    std::size_t best_match_length = 0;
+    web::http::route *best_match_route = nullptr;
+
+    for (const auto &[mount_point, route] : routes)
+    {
+        const auto length = mount_point.size();
+
+        if (length > best_match_length && actual_path.compare(0, length, mount_point) == 0)
+        {
+            best_match_length = length;
+            best_match_route = route;
+        }
+    }
+
+    if (!best_match_route)
+        return nullptr;
+
+    route_path = actual_path.substr(best_match_length);
+    return best_match_route;
+}
+
+} // namespace internal
+
+static void BM_route_tree_match_mount(benchmark::State &state)
+{
+    const auto routes = internal::make_routes(state.range(0));
+    const auto paths = internal::make_paths(state.range(0));
+
+    web::http::route_tree tree;
+
+    for (const auto &route : routes)
+        tree.add(route->mount_point() + "*", *route);
+
+    std::size_t index = 0;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        web::http::route_match match;
+        const auto result = tree.match(paths[index++ % std::size(paths)], web::http::http_method::get, match);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(match.remainder);
+    }
+}
+
+BENCHMARK(BM_route_tree_match_mount)->Arg(10)->Arg(100)->Arg(500);
+
+static void BM_linear_scan_match_mount(benchmark::State &state)
+{
+    const auto routes = internal::make_routes(state.range(0));
+    const auto paths = internal::make_paths(state.range(0));
+
+    std::map<common::string, web::http::route *> mounts;
+
+    for (const auto &route : routes)
+        mounts.emplace(route->mount_point(), route.get());
+
+    std::size_t index = 0;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        common::string route_path;
+        const auto result = internal::find_best_match_route(mounts, paths[index++ % std::size(paths)], route_path);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(route_path);
+    }
+}
+
+BENCHMARK(BM_linear_scan_match_mount)->Arg(10)->Arg(100)->Arg(500);
+
+static void BM_route_tree_match_parameters(benchmark::State &state)
+{
+    const auto routes = internal::make_routes(state.range(0));
+    const auto paths = internal::make_paths(state.range(0));
+
+    web::http::route_tree tree;
+
+    for (const auto &route : routes)
+    {
+        tree.add(route->mount_point() + "/:id", *route, web::http::http_method::get);
+        tree.add(route->mount_point() + "/:id/items", *route, web::http::http_method::get);
+        tree.add(route->mount_point() + "/:id/items", *route, web::http::http_method::post);
+    }
+
+    std::size_t index = 0;
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        web::http::route_match match;
+        const auto result = tree.match(paths[index++ % std::size(paths)], web::http::http_method::post, match);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(match.parameters[0].value);
+    }
+}
+
+BENCHMARK(BM_route_tree_match_parameters)->Arg(10)->Arg(100)->Arg(500);
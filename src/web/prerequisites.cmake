@@ -4,3 +4,5 @@ depend_on(common)
 depend_on(ptree)
 depend_on(streams)
 depend_on(sockets)
+depend_on(compression)
+depend_on(tracelog)
@@ -0,0 +1,245 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/chunked_encoding.h>
+#include <aeon/web/http/constants.h>
+#include <algorithm>
+#include <charconv>
+#include <array>
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+// More digits could overflow the chunk size.
+static constexpr std::size_t max_chunk_size_digits = 15;
+
+[[nodiscard]] static auto hex_digit_value(const char c) noexcept -> int
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+
+    return -1;
+}
+
+static void append(std::vector<std::byte> &buffer, const char *str, const std::size_t size)
+{
+    const auto data = reinterpret_cast<const std::byte *>(str);
+    buffer.insert(std::end(buffer), data, data + size);
+}
+
+} // namespace internal
+
+chunked_decoder::chunked_decoder() noexcept
+    : state_{decoder_state::size}
+    , chunk_size_{0}
+    , size_digits_{0}
+    , line_length_{0}
+{
+}
+
+auto chunked_decoder::decode(const std::span<const std::byte> data, std::span<const std::byte> &content) noexcept
+    -> std::size_t
+{
+    content = {};
+
+    std::size_t offset = 0;
+
+    while (offset < std::size(data))
+    {
+        const auto c = static_cast<char>(data[offset]);
+
+        switch (state_)
+        {
+            case decoder_state::size:
+            {
+                if (const auto value = internal::hex_digit_value(c); value >= 0)
+                {
+                    if (++size_digits_ > internal::max_chunk_size_digits)
+                    {
+                        state_ = decoder_state::invalid;
+                        return offset;
+                    }
+
+                    chunk_size_ = chunk_size_ * 16 + static_cast<std::uint64_t>(value);
+                }
+                else if (size_digits_ > 0 && c == '\r')
+                {
+                    state_ = decoder_state::size_lf;
+                }
+                else if (size_digits_ > 0 && (c == ';' || c == ' ' || c == '\t'))
+                {
+                    line_length_ = size_digits_;
+                    state_ = decoder_state::extension;
+                }
+                else
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+            }
+            break;
+            case decoder_state::extension:
+            {
+                if (c == '\r')
+                {
+                    state_ = decoder_state::size_lf;
+                }
+                else if (++line_length_ > detail::max_chunk_line_size)
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+            }
+            break;
+            case decoder_state::size_lf:
+            {
+                if (c != '\n')
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+
+                size_digits_ = 0;
+                line_length_ = 0;
+                state_ = (chunk_size_ == 0) ? decoder_state::trailer_start : decoder_state::data;
+            }
+            break;
+            case decoder_state::data:
+            {
+                const auto size =
+                    static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size_, std::size(data) - offset));
+                content = data.subspan(offset, size);
+                chunk_size_ -= size;
+
+                if (chunk_size_ == 0)
+                    state_ = decoder_state::data_cr;
+
+                return offset + size;
+            }
+            case decoder_state::data_cr:
+            {
+                if (c != '\r')
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+
+                state_ = decoder_state::data_lf;
+            }
+            break;
+            case decoder_state::data_lf:
+            {
+                if (c != '\n')
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+
+                state_ = decoder_state::size;
+            }
+            break;
+            case decoder_state::trailer_start:
+            {
+                state_ = (c == '\r') ? decoder_state::last_lf : decoder_state::trailer;
+            }
+            break;
+            case decoder_state::trailer:
+            {
+                // All trailers together are limited like the headers of a request.
+                if (c == '\r')
+                {
+                    state_ = decoder_state::trailer_lf;
+                }
+                else if (++line_length_ > detail::max_request_head_size)
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+            }
+            break;
+            case decoder_state::trailer_lf:
+            {
+                if (c != '\n')
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+
+                state_ = decoder_state::trailer_start;
+            }
+            break;
+            case decoder_state::last_lf:
+            {
+                if (c != '\n')
+                {
+                    state_ = decoder_state::invalid;
+                    return offset;
+                }
+
+                state_ = decoder_state::complete;
+                return offset + 1;
+            }
+            case decoder_state::complete:
+            case decoder_state::invalid:
+                return offset;
+        }
+
+        ++offset;
+    }
+
+    return offset;
+}
+
+auto chunked_decoder::complete() const noexcept -> bool
+{
+    return state_ == decoder_state::complete;
+}
+
+auto chunked_decoder::failed() const noexcept -> bool
+{
+    return state_ == decoder_state::invalid;
+}
+
+void chunked_decoder::reset() noexcept
+{
+    state_ = decoder_state::size;
+    chunk_size_ = 0;
+    size_digits_ = 0;
+    line_length_ = 0;
+}
+
+auto encode_chunk(const std::span<const std::byte> data) -> std::vector<std::byte>
+{
+    if (std::empty(data))
+        return {};
+
+    std::array<char, 16> size_str;
+    const auto result =
+        std::to_chars(std::data(size_str), std::data(size_str) + std::size(size_str), std::size(data), 16);
+    const auto size_length = static_cast<std::size_t>(result.ptr - std::data(size_str));
+
+    std::vector<std::byte> chunk;
+    chunk.reserve(size_length + std::size(data) + 4);
+    internal::append(chunk, std::data(size_str), size_length);
+    internal::append(chunk, "\r\n", 2);
+    chunk.insert(std::end(chunk), std::begin(data), std::end(data));
+    internal::append(chunk, "\r\n", 2);
+    return chunk;
+}
+
+auto encode_last_chunk() -> std::vector<std::byte>
+{
+    std::vector<std::byte> chunk;
+    internal::append(chunk, "0\r\n\r\n", 5);
+    return chunk;
+}
+
+} // namespace aeon::web::http
@@ -0,0 +1,77 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/client_request.h>
+#include <aeon/web/http/url_encoding.h>
+#include <aeon/web/http/constants.h>
+#include <charconv>
+#include <array>
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+static void append(std::vector<std::byte> &buffer, const common::string_view &str)
+{
+    const auto data = reinterpret_cast<const std::byte *>(std::data(str));
+    buffer.insert(std::end(buffer), data, data + std::size(str));
+}
+
+static void append_header(std::vector<std::byte> &buffer, const common::string_view &name,
+                          const common::string_view &value)
+{
+    append(buffer, name);
+    append(buffer, ": ");
+    append(buffer, value);
+    append(buffer, "\r\n");
+}
+
+[[nodiscard]] static auto has_content(const client_request &request) noexcept -> bool
+{
+    // Servers require a length for these methods, even without content.
+    return !std::empty(request.content) || request.method == http_method::post ||
+           request.method == http_method::put || request.method == http_method::patch;
+}
+
+} // namespace internal
+
+auto serialize_request(const common::string_view &host, const client_request &request) -> std::vector<std::byte>
+{
+    const auto method = common::string_view{method_to_string(request.method)};
+    const auto uri = url_encode(request.uri);
+
+    std::vector<std::byte> buffer;
+    buffer.reserve(std::size(method) + std::size(uri) + std::size(host) + 128 + std::size(request.content));
+
+    internal::append(buffer, method);
+    internal::append(buffer, " ");
+    internal::append(buffer, uri);
+    internal::append(buffer, " ");
+    internal::append(buffer, detail::http_version_string);
+    internal::append(buffer, "\r\n");
+
+    internal::append_header(buffer, "Host", host);
+
+    for (const auto &[name, value] : request.headers)
+        internal::append_header(buffer, name, value);
+
+    if (internal::has_content(request))
+    {
+        if (!std::empty(request.content_type))
+            internal::append_header(buffer, "Content-Type", request.content_type);
+
+        std::array<char, 20> length;
+        const auto result =
+            std::to_chars(std::data(length), std::data(length) + std::size(length), std::size(request.content));
+        internal::append_header(buffer, "Content-Length",
+                                common::string_view{std::data(length),
+                                                    static_cast<std::size_t>(result.ptr - std::data(length))});
+    }
+
+    internal::append(buffer, "\r\n");
+    buffer.insert(std::end(buffer), std::begin(request.content), std::end(request.content));
+    return buffer;
+}
+
+} // namespace aeon::web::http
@@ -0,0 +1,185 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/content_encoding.h>
+#include <aeon/common/string_utils.h>
+#include <algorithm>
+#include <array>
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+static constexpr int max_quality = 1000;
+
+/*!
+ * Parse a quality value ("0", "0.5", "1.000" etc.) into thousandths. Invalid values are treated as 0.
+ */
+[[nodiscard]] static auto parse_quality(const common::string_view &value) noexcept -> int
+{
+    if (std::empty(value) || (value[0] != '0' && value[0] != '1'))
+        return 0;
+
+    auto quality = (value[0] == '1') ? max_quality : 0;
+
+    if (std::size(value) == 1)
+        return quality;
+
+    if (value[1] != '.' || std::size(value) > 5)
+        return 0;
+
+    auto scale = 100;
+
+    for (std::size_t i = 2; i < std::size(value); ++i, scale /= 10)
+    {
+        if (value[i] < '0' || value[i] > '9')
+            return 0;
+
+        quality += (value[i] - '0') * scale;
+    }
+
+    return std::min(quality, max_quality);
+}
+
+/*!
+ * Returns true if the name of a coding in an Accept-Encoding header refers to the given coding.
+ */
+[[nodiscard]] static auto is_coding(const common::string_view &name, const content_coding coding) noexcept -> bool
+{
+    if (common::string_utils::iequals(name, content_coding_name(coding)))
+        return true;
+
+    // Sent by some older clients.
+    return coding == content_coding::gzip && common::string_utils::iequals(name, "x-gzip");
+}
+
+} // namespace internal
+
+auto content_coding_name(const content_coding coding) noexcept -> const char *
+{
+    switch (coding)
+    {
+        case content_coding::gzip:
+            return "gzip";
+        case content_coding::deflate:
+            return "deflate";
+        case content_coding::identity:
+        default:
+            return "identity";
+    }
+}
+
+auto content_coding_quality(const common::string_view &accept_encoding, const content_coding coding) noexcept -> int
+{
+    auto quality = -1;
+    auto wildcard_quality = -1;
+    std::size_t offset = 0;
+
+    while (offset <= std::size(accept_encoding))
+    {
+        auto end = accept_encoding.find(',', offset);
+
+        if (end == common::string_view::npos)
+            end = std::size(accept_encoding);
+
+        const auto element = accept_encoding.substr(offset, end - offset);
+        offset = end + 1;
+
+        const auto parameters = element.find(';');
+        const auto name = common::string_utils::trimmedsv(element.substr(0, parameters));
+
+        if (std::empty(name))
+            continue;
+
+        auto element_quality = internal::max_quality;
+
+        if (parameters != common::string_view::npos)
+        {
+            const auto parameter = common::string_utils::trimmedsv(element.substr(parameters + 1));
+
+            if (std::size(parameter) > 2 && (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '=')
+                element_quality = internal::parse_quality(parameter.substr(2));
+        }
+
+        if (internal::is_coding(name, coding))
+            quality = std::max(quality, element_quality);
+        else if (name == "*")
+            wildcard_quality = element_quality;
+    }
+
+    if (quality >= 0)
+        return quality;
+
+    if (wildcard_quality >= 0)
+        return wildcard_quality;
+
+    return (coding == content_coding::identity) ? internal::max_quality : 0;
+}
+
+auto negotiate_content_coding(const common::string_view &accept_encoding) noexcept -> content_coding
+{
+    const auto gzip_quality = content_coding_quality(accept_encoding, content_coding::gzip);
+    const auto deflate_quality = content_coding_quality(accept_encoding, content_coding::deflate);
+
+    if (gzip_quality == 0 && deflate_quality == 0)
+        return content_coding::identity;
+
+    return (gzip_quality >= deflate_quality) ? content_coding::gzip : content_coding::deflate;
+}
+
+auto is_compressible_content_type(const common::string_view &content_type) noexcept -> bool
+{
+    const auto type = common::string_utils::trimmedsv(content_type.substr(0, content_type.find(';')));
+
+    if (std::size(type) > 5 && common::string_utils::iequals(type.substr(0, 5), "text/"))
+        return true;
+
+    // Structured syntax suffixes, like application/ld+json and image/svg+xml.
+    for (const common::string_view suffix : {"+json", "+xml"})
+    {
+        if (std::size(type) > std::size(suffix) &&
+            common::string_utils::iequals(type.substr(std::size(type) - std::size(suffix)), suffix))
+            return true;
+    }
+
+    static constexpr std::array compressible_types{"application/json",       "application/javascript",
+                                                   "application/x-javascript", "application/ecmascript",
+                                                   "application/xml",        "application/wasm",
+                                                   "font/ttf",               "font/otf",
+                                                   "image/bmp",              "image/x-icon"};
+
+    for (const common::string_view compressible_type : compressible_types)
+    {
+        if (common::string_utils::iequals(type, compressible_type))
+            return true;
+    }
+
+    return false;
+}
+
+auto compress_content(const std::span<const std::byte> content, const content_coding coding,
+                      const compression::zlib_compression_mode mode) -> std::vector<std::byte>
+{
+    if (coding == content_coding::identity)
+        return {std::begin(content), std::end(content)};
+
+    const auto format =
+        (coding == content_coding::gzip) ? compression::zlib_format::gzip : compression::zlib_format::zlib;
+
+    std::vector<std::byte> compressed;
+    compressed.reserve(std::size(content) / 2);
+
+    const auto write = [&compressed](const std::byte *data, const std::streamsize size)
+    {
+        compressed.insert(std::end(compressed), data, data + size);
+        return size;
+    };
+
+    compression::zlib_compress compress{mode, 16 * 1024, format};
+    compress.write(std::data(content), static_cast<std::streamsize>(std::size(content)), write);
+    compress.finish(write);
+    return compressed;
+}
+
+} // namespace aeon::web::http
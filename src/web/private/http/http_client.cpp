@@ -0,0 +1,570 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/http_client.h>
+#include <aeon/web/http/http_client_socket.h>
+#include <aeon/sockets/tcp_client.h>
+#include <asio/steady_timer.hpp>
+#include <asio/dispatch.hpp>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <string>
+
+namespace aeon::web::http
+{
+
+struct http_client::pending_request final
+{
+    // The serialized request, so that it can be sent again without serializing it again when it is retried.
+    sockets::shared_buffer data{};
+    http_method method = http_method::invalid;
+    reply_handler handler{};
+    std::chrono::steady_clock::time_point deadline{};
+    bool retried = false;
+};
+
+class http_client::connection final : public http_client_socket
+{
+public:
+    explicit connection(asio::io_context &context)
+        : http_client_socket{context}
+        , client_{nullptr}
+        , pool_{nullptr}
+        , timer_{context}
+        , connect_deadline_{}
+        , in_flight_{}
+        , error_{}
+        , request_count_{0}
+        , connected_{false}
+        , disconnected_{false}
+        , timed_out_{false}
+    {
+    }
+
+    ~connection() final = default;
+
+    connection(connection &&) = delete;
+    auto operator=(connection &&) -> connection & = delete;
+
+    connection(const connection &) = delete;
+    auto operator=(const connection &) -> connection & = delete;
+
+    void attach(http_client &client, host_pool &pool)
+    {
+        client_ = &client;
+        pool_ = &pool;
+        connect_deadline_ = std::chrono::steady_clock::now() + client.settings_.connect_timeout;
+        arm_timer();
+    }
+
+    /*!
+     * Stop reporting to the client; for example because it is being destroyed.
+     */
+    void detach() noexcept
+    {
+        client_ = nullptr;
+        pool_ = nullptr;
+        timer_.cancel();
+    }
+
+    [[nodiscard]] auto connected() const noexcept -> bool
+    {
+        return connected_;
+    }
+
+    [[nodiscard]] auto connecting() const noexcept -> bool
+    {
+        return !connected_ && !disconnected_;
+    }
+
+    [[nodiscard]] auto timed_out() const noexcept -> bool
+    {
+        return timed_out_;
+    }
+
+    [[nodiscard]] auto in_flight_count() const noexcept -> std::size_t
+    {
+        return std::size(in_flight_);
+    }
+
+    /*!
+     * Returns true if a request can be sent on this connection.
+     */
+    [[nodiscard]] auto usable() const noexcept -> bool
+    {
+        if (!connected_ || disconnected_ || closed() || !client_)
+            return false;
+
+        return client_->settings_.keep_alive || request_count_ == 0;
+    }
+
+    /*!
+     * Returns true if another request can be sent before the replies to the requests in flight were received. This is
+     * only done when all of them are idempotent, since they may have to be retried.
+     */
+    [[nodiscard]] auto pipelinable() const noexcept -> bool
+    {
+        return usable() && std::size(in_flight_) < client_->settings_.max_pipeline_depth &&
+               std::all_of(std::begin(in_flight_), std::end(in_flight_),
+                           [](const auto &request) { return is_idempotent_method(request.method); });
+    }
+
+    void send(pending_request request)
+    {
+        const auto was_idle = std::empty(in_flight_);
+
+        send_request(request.data, request.method);
+        in_flight_.push_back(std::move(request));
+        ++request_count_;
+
+        if (was_idle)
+            arm_timer();
+    }
+
+    [[nodiscard]] auto take_in_flight() noexcept -> std::deque<pending_request>
+    {
+        return std::exchange(in_flight_, {});
+    }
+
+private:
+    void on_connected() final
+    {
+        connected_ = true;
+        arm_timer();
+
+        if (client_)
+            client_->dispatch_requests(*pool_);
+    }
+
+    void on_error(const std::error_code &ec) final
+    {
+        if (!error_)
+            error_ = ec;
+    }
+
+    void on_disconnected() final
+    {
+        // This may still pass a reply to on_http_reply.
+        http_client_socket::on_disconnected();
+
+        if (disconnected_)
+            return;
+
+        disconnected_ = true;
+        timer_.cancel();
+
+        if (client_)
+            client_->on_connection_closed(*pool_, *this, error_);
+    }
+
+    void on_http_reply(reply &reply) final
+    {
+        if (std::empty(in_flight_))
+            return;
+
+        auto request = std::move(in_flight_.front());
+        in_flight_.pop_front();
+
+        if (client_ && !client_->settings_.keep_alive)
+            disconnect();
+
+        arm_timer();
+        request.handler({}, reply);
+
+        // The handler may have closed the client.
+        if (client_)
+            client_->dispatch_requests(*pool_);
+    }
+
+    /*!
+     * Wait for the deadline that currently applies: the connect timeout, the timeout of the oldest request in flight or
+     * the idle timeout.
+     */
+    void arm_timer()
+    {
+        if (disconnected_ || !client_)
+            return;
+
+        if (!connected_)
+            timer_.expires_at(connect_deadline_);
+        else if (!std::empty(in_flight_))
+            timer_.expires_at(in_flight_.front().deadline);
+        else
+            timer_.expires_after(client_->settings_.idle_timeout);
+
+        auto self = std::static_pointer_cast<connection>(shared_from_this());
+        timer_.async_wait([self](const std::error_code &ec) { self->on_timer(ec); });
+    }
+
+    void on_timer(const std::error_code &ec)
+    {
+        // The timer may have been set to a later deadline after this wait completed.
+        if (ec == asio::error::operation_aborted || disconnected_ || !client_ ||
+            timer_.expiry() > std::chrono::steady_clock::now())
+            return;
+
+        if (!connected_)
+            error_ = std::make_error_code(std::errc::timed_out);
+        else if (!std::empty(in_flight_))
+            timed_out_ = true;
+
+        disconnect();
+    }
+
+    http_client *client_;
+    host_pool *pool_;
+
+    asio::steady_timer timer_;
+    std::chrono::steady_clock::time_point connect_deadline_;
+
+    // The requests that were sent on this connection, of which the reply was not received yet.
+    std::deque<pending_request> in_flight_;
+
+    std::error_code error_;
+    std::size_t request_count_;
+    bool connected_;
+    bool disconnected_;
+    bool timed_out_;
+};
+
+struct http_client::host_pool final
+{
+    // The value of the Host header.
+    common::string host;
+
+    // Set while the host is being resolved; requests are queued until it is done.
+    std::shared_ptr<host_resolver> resolver;
+    asio::ip::tcp::resolver::results_type endpoints;
+
+    std::vector<std::unique_ptr<sockets::tcp_client<connection>>> connections;
+
+    // Requests that wait for a connection.
+    std::deque<pending_request> queue;
+};
+
+/*!
+ * Resolves the name of a host without blocking the io_context. Fails with std::errc::timed_out if it takes longer than
+ * the connect timeout.
+ */
+class http_client::host_resolver final : public std::enable_shared_from_this<host_resolver>
+{
+public:
+    explicit host_resolver(asio::io_context &context)
+        : resolver_{context}
+        , timer_{context}
+        , client_{nullptr}
+        , pool_{nullptr}
+    {
+    }
+
+    ~host_resolver() = default;
+
+    host_resolver(host_resolver &&) = delete;
+    auto operator=(host_resolver &&) -> host_resolver & = delete;
+
+    host_resolver(const host_resolver &) = delete;
+    auto operator=(const host_resolver &) -> host_resolver & = delete;
+
+    void resolve(http_client &client, host_pool &pool, const common::string &host, const std::string &port)
+    {
+        client_ = &client;
+        pool_ = &pool;
+
+        auto self = shared_from_this();
+
+        timer_.expires_after(client.settings_.connect_timeout);
+        timer_.async_wait([self](const std::error_code &ec) { self->on_timer(ec); });
+
+        resolver_.async_resolve(host.as_std_string_view(), port,
+                                [self](const std::error_code &ec, asio::ip::tcp::resolver::results_type results)
+                                { self->on_resolved(ec, std::move(results)); });
+    }
+
+    /*!
+     * Stop reporting to the client; for example because it is being destroyed.
+     */
+    void detach() noexcept
+    {
+        client_ = nullptr;
+        pool_ = nullptr;
+        timer_.cancel();
+        resolver_.cancel();
+    }
+
+private:
+    void on_resolved(const std::error_code &ec, asio::ip::tcp::resolver::results_type results)
+    {
+        timer_.cancel();
+
+        if (!client_)
+            return;
+
+        if (!ec)
+            pool_->endpoints = std::move(results);
+
+        complete(ec);
+    }
+
+    void on_timer(const std::error_code &ec)
+    {
+        if (ec == asio::error::operation_aborted || !client_)
+            return;
+
+        resolver_.cancel();
+        complete(std::make_error_code(std::errc::timed_out));
+    }
+
+    void complete(const std::error_code &ec)
+    {
+        // Only the first of the resolve and the timeout is reported.
+        auto *client = std::exchange(client_, nullptr);
+        auto *pool = std::exchange(pool_, nullptr);
+        client->on_host_resolved(*pool, ec);
+    }
+
+    asio::ip::tcp::resolver resolver_;
+    asio::steady_timer timer_;
+    http_client *client_;
+    host_pool *pool_;
+};
+
+namespace internal
+{
+
+static void fail_requests(std::vector<http_client::pending_request> &requests, const std::error_code &ec)
+{
+    for (auto &request : requests)
+    {
+        reply empty_reply;
+        request.handler(ec, empty_reply);
+    }
+}
+
+} // namespace internal
+
+http_client::http_client(asio::io_context &context, http_client_settings settings)
+    : context_{context}
+    , settings_{settings}
+    , pools_{}
+{
+}
+
+http_client::~http_client()
+{
+    close();
+}
+
+void http_client::request_async(const common::string &host, const std::uint16_t port, client_request request,
+                                reply_handler handler)
+{
+    asio::dispatch(context_,
+                   [this, host, port, request = std::move(request), handler = std::move(handler)]() mutable
+                   { queue_request(host, port, std::move(request), std::move(handler)); });
+}
+
+void http_client::close()
+{
+    auto pools = std::exchange(pools_, {});
+    std::vector<pending_request> canceled;
+
+    for (auto &[key, pool] : pools)
+    {
+        if (pool->resolver)
+            pool->resolver->detach();
+
+        std::move(std::begin(pool->queue), std::end(pool->queue), std::back_inserter(canceled));
+
+        for (auto &client : pool->connections)
+        {
+            auto &socket = *(*client).operator->();
+            auto in_flight = socket.take_in_flight();
+            std::move(std::begin(in_flight), std::end(in_flight), std::back_inserter(canceled));
+
+            socket.detach();
+            socket.disconnect();
+        }
+    }
+
+    internal::fail_requests(canceled, std::make_error_code(std::errc::operation_canceled));
+}
+
+auto http_client::connection_count() const noexcept -> std::size_t
+{
+    std::size_t count = 0;
+
+    for (const auto &[key, pool] : pools_)
+        count += std::size(pool->connections);
+
+    return count;
+}
+
+void http_client::queue_request(const common::string &host, const std::uint16_t port, client_request request,
+                                reply_handler handler)
+{
+    const auto port_string = std::to_string(port);
+    const common::string key{host.str() + ":" + port_string};
+
+    auto &pool = pools_[key];
+
+    if (!pool)
+    {
+        pool = std::make_unique<host_pool>();
+        pool->host = (port == 80) ? host : key;
+
+        // Resolved once, for all connections to the host.
+        pool->resolver = std::make_shared<host_resolver>(context_);
+        pool->resolver->resolve(*this, *pool, host, port_string);
+    }
+
+    if (!settings_.keep_alive)
+        request.headers.emplace_back("Connection", "close");
+
+    pool->queue.push_back(pending_request{.data = sockets::make_shared_buffer(serialize_request(pool->host, request)),
+                                          .method = request.method,
+                                          .handler = std::move(handler),
+                                          .deadline = std::chrono::steady_clock::now() + settings_.request_timeout});
+
+    dispatch_requests(*pool);
+}
+
+void http_client::dispatch_requests(host_pool &pool)
+{
+    if (pool.resolver)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<pending_request> expired;
+
+    while (!std::empty(pool.queue))
+    {
+        auto &request = pool.queue.front();
+
+        if (request.deadline <= now)
+        {
+            expired.push_back(std::move(request));
+            pool.queue.pop_front();
+            continue;
+        }
+
+        connection *target = nullptr;
+        std::size_t connecting = 0;
+
+        for (const auto &client : pool.connections)
+        {
+            const auto candidate = (*client).operator->();
+
+            if (!target && candidate->usable() && candidate->in_flight_count() == 0)
+                target = candidate;
+
+            if (candidate->connecting())
+                ++connecting;
+        }
+
+        if (!target && std::size(pool.connections) < settings_.max_connections_per_host)
+        {
+            // Open a connection for every request that waits for one; they are sent once the connections are open.
+            if (connecting < std::size(pool.queue))
+            {
+                open_connection(pool);
+                continue;
+            }
+
+            break;
+        }
+
+        if (!target && settings_.max_pipeline_depth > 1 && is_idempotent_method(request.method))
+        {
+            for (const auto &client : pool.connections)
+            {
+                const auto candidate = (*client).operator->();
+
+                if (candidate->pipelinable() &&
+                    (!target || candidate->in_flight_count() < target->in_flight_count()))
+                    target = candidate;
+            }
+        }
+
+        if (!target)
+            break;
+
+        target->send(std::move(request));
+        pool.queue.pop_front();
+    }
+
+    internal::fail_requests(expired, std::make_error_code(std::errc::timed_out));
+}
+
+void http_client::on_host_resolved(host_pool &pool, const std::error_code &ec)
+{
+    pool.resolver.reset();
+
+    if (!ec)
+    {
+        dispatch_requests(pool);
+        return;
+    }
+
+    // The requests that waited for the host fail; the next request tries to resolve it again.
+    std::vector<pending_request> failed;
+    std::move(std::begin(pool.queue), std::end(pool.queue), std::back_inserter(failed));
+    std::erase_if(pools_, [&pool](const auto &entry) { return entry.second.get() == &pool; });
+
+    internal::fail_requests(failed, ec);
+}
+
+void http_client::open_connection(host_pool &pool)
+{
+    auto client = std::make_unique<sockets::tcp_client<connection>>(context_);
+    (*client)->attach(*this, pool);
+    client->connect(pool.endpoints);
+    pool.connections.push_back(std::move(client));
+}
+
+void http_client::on_connection_closed(host_pool &pool, connection &closed_connection, const std::error_code &ec)
+{
+    const auto was_connected = closed_connection.connected();
+    const auto timed_out = closed_connection.timed_out();
+    auto in_flight = closed_connection.take_in_flight();
+
+    closed_connection.detach();
+
+    // The socket is kept alive by the handler that is calling this, until it returns.
+    std::erase_if(pool.connections,
+                  [&closed_connection](const auto &client) { return (*client).operator->() == &closed_connection; });
+
+    std::vector<pending_request> failed;
+    std::vector<pending_request> expired;
+
+    // Requests that were sent but not replied to are retried once if that is safe; in their original order, before
+    // any requests that were not sent yet.
+    for (auto i = std::size(in_flight); i-- > 0;)
+    {
+        auto &request = in_flight[i];
+
+        if (i == 0 && timed_out)
+            expired.push_back(std::move(request));
+        else if (is_idempotent_method(request.method) && !request.retried)
+        {
+            request.retried = true;
+            pool.queue.push_front(std::move(request));
+        }
+        else
+            failed.push_back(std::move(request));
+    }
+
+    // If a connection could not be opened while no other connection is open, the host can not be reached; in that case
+    // the waiting requests fail, instead of trying to connect again and again.
+    if (!was_connected && std::none_of(std::begin(pool.connections), std::end(pool.connections),
+                                       [](const auto &client) { return (*client)->connected(); }))
+    {
+        std::move(std::begin(pool.queue), std::end(pool.queue), std::back_inserter(failed));
+        pool.queue.clear();
+    }
+
+    dispatch_requests(pool);
+
+    internal::fail_requests(expired, std::make_error_code(std::errc::timed_out));
+    internal::fail_requests(failed, ec ? ec : std::make_error_code(std::errc::connection_reset));
+}
+
+} // namespace aeon::web::http
@@ -1,168 +1,274 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/web/http/http_client_socket.h>
-#include <aeon/web/http/url_encoding.h>
 #include <aeon/web/http/constants.h>
-#include <aeon/sockets/config.h>
-#include <aeon/streams/stream_reader.h>
-#include <aeon/streams/string_stream.h>
 #include <aeon/common/string_utils.h>
-#include <aeon/common/u8_stream.h>
-#include <aeon/common/assert.h>
+#include <algorithm>
 
 namespace aeon::web::http
 {
 
+namespace internal
+{
+
+[[nodiscard]] static auto reply_has_content(const http_method method, const int code) noexcept -> bool
+{
+    return method != http_method::head && code != static_cast<int>(status_code::no_content) &&
+           code != static_cast<int>(status_code::not_modified);
+}
+
+[[nodiscard]] static auto closes_connection(const response_head &head) noexcept -> bool
+{
+    const auto connection = head.find_header("connection");
+
+    // HTTP/1.0 servers close the connection unless they explicitly keep it open.
+    if (head.version != detail::http_version_string)
+        return !connection || !common::string_utils::iequals(connection->value, "keep-alive");
+
+    return connection && common::string_utils::iequals(connection->value, "close");
+}
+
+} // namespace internal
+
 http_client_socket::http_client_socket(asio::io_context &context)
     : tcp_socket{context}
-    , state_{http_state::client_read_status}
+    , state_{http_state::client_read_head}
     , reply_{}
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<char>>{sockets::tcp_socket_circular_buffer_size}}
+    , receive_buffer_{}
+    , head_scanned_size_{0}
     , expected_content_length_{0}
+    , received_content_length_{0}
+    , chunked_decoder_{}
+    , close_after_reply_{false}
+    , pending_requests_{}
 {
 }
 
 http_client_socket::~http_client_socket() = default;
 
 void http_client_socket::request_async(const common::string &host, const common::string &uri,
-                                       [[maybe_unused]] const http_method method)
-{
-    // TODO: Use the given method for the request, instead of just GET
-    streams::string_stream<std::vector<std::byte>> request{64};
-    request << "GET ";
-    request << url_encode(uri);
-    request << ' ';
-    request << detail::http_version_string;
-    request << "\r\n";
-    request << "Host: ";
-    request << host;
-    request << "\r\n\r\n";
-
-    send(request.release());
+                                       const http_method method)
+{
+    request_async(host, client_request{.method = method, .uri = uri});
 }
 
-void http_client_socket::on_data(const std::span<const std::byte> &data)
+void http_client_socket::request_async(const common::string &host, const client_request &request)
 {
-    circular_buffer_.write(std::data(data), std::size(data));
-    streams::stream_reader reader(circular_buffer_);
+    pending_requests_.push_back(request.method);
+    send(serialize_request(host, request));
+}
+
+auto http_client_socket::pending_request_count() const noexcept -> std::size_t
+{
+    return std::size(pending_requests_);
+}
+
+auto http_client_socket::closed() const noexcept -> bool
+{
+    return state_ == http_state::client_closed || close_after_reply_;
+}
+
+void http_client_socket::send_request(sockets::shared_buffer request, const http_method method)
+{
+    pending_requests_.push_back(method);
+    send(std::move(request));
+}
 
-    while (circular_buffer_.size() != 0)
+void http_client_socket::on_disconnected()
+{
+    // A reply without a length ends when the connection is closed.
+    if (state_ == http_state::client_read_until_close)
     {
-        if (state_ == http_state::client_read_body)
-        {
-            std::vector<std::byte> vec;
-            reader.read_to_vector(vec);
-            reply_.append_raw_content_data(vec);
-
-            if (reply_.get_content_length() >= expected_content_length_)
-            {
-                disconnect();
-                on_http_reply(reply_);
-            }
-        }
-        else
-        {
-            const auto result = __on_line(reader.read_line());
-            if (!result)
-            {
-                // TODO: Better error code here.
-                on_error(std::error_code{});
-                disconnect();
-                return;
-            }
-        }
+        close_after_reply_ = true;
+        __finish_reply();
     }
+
+    state_ = http_state::client_closed;
+    receive_buffer_.clear();
 }
 
-auto http_client_socket::__on_line(const common::string &line) -> bool
+void http_client_socket::on_data(const std::span<const std::byte> &data)
 {
-    /*
-    HTTP/1.1 200 Ok
-    Connection: close
-    Content-type: text/plain
-    Content-Length: 6
+    if (state_ == http_state::client_closed)
+        return;
 
-    Hello!
-    */
-
-    switch (state_)
+    // Replies are parsed straight from the data that was read; it is only copied if a reply is incomplete.
+    if (receive_buffer_.empty())
     {
-        case http_state::client_read_status:
-            return __handle_read_status_state(line);
-        case http_state::client_read_headers:
-            return __handle_read_headers_state(line);
-
-        // Unexpected read body state. Body must be read binary.
-        // If this happens, there is a bug.
-        case http_state::client_read_body:
-            aeon_assert_fail("Unexpected read body state.");
-            return false;
+        const auto remaining = data.subspan(__parse(data));
 
-        default:
-            return false;
+        if (state_ != http_state::client_closed && !receive_buffer_.write(remaining))
+            __fail(std::make_error_code(std::errc::no_buffer_space));
+
+        return;
+    }
+
+    if (!receive_buffer_.write(data))
+    {
+        __fail(std::make_error_code(std::errc::no_buffer_space));
+        return;
     }
+
+    const auto size = __parse(receive_buffer_.data());
+
+    if (state_ != http_state::client_closed)
+        receive_buffer_.consume(size);
 }
 
-auto http_client_socket::__parse_expected_content_length() -> bool
+auto http_client_socket::__parse(const std::span<const std::byte> data) -> std::size_t
 {
-    const auto http_headers = parse_raw_http_headers(reply_.get_raw_headers());
+    response_head head;
+    std::size_t offset = 0;
 
-    const auto result = http_headers.find(detail::content_length_key);
+    while (offset < std::size(data) && state_ != http_state::client_closed)
+    {
+        const auto remaining = data.subspan(offset);
 
-    if (result == http_headers.end())
-        return false;
+        if (state_ != http_state::client_read_head)
+        {
+            offset += __read_body(remaining);
+            continue;
+        }
 
-    expected_content_length_ = std::stoll(result->second.str());
-    return true;
+        const auto result = parse_response_head(remaining, head, head_scanned_size_);
+
+        if (result == request_parse_result::incomplete)
+        {
+            head_scanned_size_ = std::size(remaining);
+
+            if (head_scanned_size_ > detail::max_request_head_size)
+                __fail(std::make_error_code(std::errc::message_size));
+
+            break;
+        }
+
+        head_scanned_size_ = 0;
+
+        if (result != request_parse_result::complete || !__handle_reply_head(head))
+        {
+            __fail(std::make_error_code(std::errc::bad_message));
+            break;
+        }
+
+        offset += head.size;
+    }
+
+    return offset;
 }
 
-auto http_client_socket::__handle_read_status_state(const common::string &line) -> bool
+auto http_client_socket::__handle_reply_head(const response_head &head) -> bool
 {
-    const auto status_line_split = common::string_utils::split(line, ' ');
-
-    // The line looks like this: "HTTP/1.1 200 Ok"
-    // We only need to parse the version string and the status code.
-    // We don't really care about the status text.
-    if (status_line_split.size() < 2)
+    if (std::empty(pending_requests_) || head.status_code > 599)
         return false;
 
-    const auto version_string = status_line_split[0];
-    const auto status_code_string = status_line_split[1];
+    // Interim replies (like 100 Continue) are followed by the actual reply. Switching protocols is not supported.
+    if (head.status_code < 200)
+        return head.status_code != static_cast<int>(status_code::switching_protocols);
 
-    auto status_code_int = 0;
+    reply_ = reply{static_cast<status_code>(head.status_code)};
 
-    try
+    for (std::size_t i = 0; i < head.header_count; ++i)
+        reply_.append_http_header(head.headers[i].name, head.headers[i].value);
+
+    close_after_reply_ = internal::closes_connection(head);
+
+    if (!internal::reply_has_content(pending_requests_.front(), head.status_code))
     {
-        status_code_int = std::stoi(status_code_string.str());
+        __finish_reply();
+        return true;
     }
-    catch (const std::invalid_argument &)
+
+    if (const auto transfer_encoding = head.find_header(detail::transfer_encoding_key); transfer_encoding)
     {
-        return false;
+        if (!common::string_utils::iequals(transfer_encoding->value, detail::chunked_transfer_coding))
+            return false;
+
+        state_ = http_state::client_read_chunked_body;
+        return true;
     }
 
-    if (!verify_status_code(status_code_int))
-        return false;
+    if (const auto content_length = head.find_header(detail::content_length_key); content_length)
+    {
+        if (!parse_content_length(content_length->value, expected_content_length_))
+            return false;
+
+        if (expected_content_length_ == 0)
+            __finish_reply();
+        else
+            state_ = http_state::client_read_body;
 
-    reply_ = reply(static_cast<status_code>(status_code_int));
-    state_ = http_state::client_read_headers;
+        return true;
+    }
 
+    state_ = http_state::client_read_until_close;
     return true;
 }
 
-auto http_client_socket::__handle_read_headers_state(const common::string &line) -> bool
+auto http_client_socket::__read_body(const std::span<const std::byte> data) -> std::size_t
 {
-    if (line.empty())
+    if (state_ == http_state::client_read_until_close)
     {
-        if (!__parse_expected_content_length())
-            return false;
+        reply_.append_raw_content_data(data);
+        return std::size(data);
+    }
 
-        state_ = http_state::client_read_body;
-        return true;
+    if (state_ == http_state::client_read_chunked_body)
+    {
+        std::span<const std::byte> content;
+        const auto size = chunked_decoder_.decode(data, content);
+
+        if (chunked_decoder_.failed())
+        {
+            __fail(std::make_error_code(std::errc::bad_message));
+            return size;
+        }
+
+        reply_.append_raw_content_data(content);
+
+        if (chunked_decoder_.complete())
+            __finish_reply();
+
+        return size;
     }
 
-    reply_.append_raw_http_header_line(line);
-    return true;
+    // Only the content of this reply is read; anything after it belongs to the next reply.
+    const auto remaining = expected_content_length_ - received_content_length_;
+    const auto size = std::min(std::size(data), remaining);
+    reply_.append_raw_content_data(data.first(size));
+    received_content_length_ += size;
+
+    if (size == remaining)
+        __finish_reply();
+
+    return size;
+}
+
+void http_client_socket::__finish_reply()
+{
+    pending_requests_.pop_front();
+
+    state_ = http_state::client_read_head;
+    expected_content_length_ = 0;
+    received_content_length_ = 0;
+    chunked_decoder_.reset();
+
+    const auto close = close_after_reply_;
+
+    if (close)
+        state_ = http_state::client_closed;
+
+    on_http_reply(reply_);
+
+    if (close)
+        disconnect();
+}
+
+void http_client_socket::__fail(const std::error_code &ec)
+{
+    state_ = http_state::client_closed;
+    receive_buffer_.clear();
+    on_error(ec);
+    disconnect();
 }
 
 } // namespace aeon::web::http
@@ -22,6 +22,7 @@ http_jsonrpc_route::http_jsonrpc_route(const common::string &mount_point,
     : route{mount_point}
     , rpc_server_{std::move(json_rpc_server)}
     , rpc_server_ref_{*rpc_server_}
+    , compression_settings_{}
 {
 }
 
@@ -29,6 +30,7 @@ http_jsonrpc_route::http_jsonrpc_route(const common::string &mount_point, jsonrp
     : route{mount_point}
     , rpc_server_{}
     , rpc_server_ref_{json_rpc_server}
+    , compression_settings_{}
 {
 }
 
@@ -39,6 +41,11 @@ void http_jsonrpc_route::register_method(const jsonrpc::method &method) const
     rpc_server_ref_.register_method(method);
 }
 
+void http_jsonrpc_route::set_compression_settings(const compression_settings &settings)
+{
+    compression_settings_ = settings;
+}
+
 void http_jsonrpc_route::on_http_request(http_server_socket &source,
                                          [[maybe_unused]] routable_http_server_session &session, const request &request)
 {
@@ -46,7 +53,8 @@ void http_jsonrpc_route::on_http_request(http_server_socket &source,
         return;
 
     const auto result = rpc_server_ref_.request(request.get_content_string());
-    source.respond(json_rpc_content_type, result);
+    source.respond(json_rpc_content_type, std::as_bytes(std::span{std::data(result), std::size(result)}),
+                   compression_settings_);
 }
 
 auto http_jsonrpc_route::validate_request(http_server_socket &source, const request &request) const -> bool
@@ -3,22 +3,43 @@
 #include <aeon/web/http/http_server_socket.h>
 #include <aeon/web/http/constants.h>
 #include <aeon/web/http/url_encoding.h>
-#include <aeon/sockets/config.h>
-#include <aeon/streams/stream_reader.h>
-#include <aeon/streams/string_stream.h>
-#include <aeon/streams/dynamic_stream.h>
+#include <aeon/web/http/validators.h>
+#include <aeon/web/http/response_head_writer.h>
 #include <aeon/common/string_utils.h>
+#include <algorithm>
 
 namespace aeon::web::http
 {
 
+namespace internal
+{
+
+[[nodiscard]] static auto write_response_head(const common::string_view &content_type, const std::size_t content_length,
+                                              const status_code code) -> std::vector<std::byte>
+{
+    response_head_writer writer{code};
+    writer.add_header("Connection", "keep-alive");
+    writer.add_header("Content-Type", content_type);
+    writer.add_header("Content-Length", content_length);
+    return writer.release(content_length);
+}
+
+} // namespace internal
+
 http_server_socket::http_server_socket(asio::ip::tcp::socket socket)
     : tcp_socket{std::move(socket)}
-    , state_{http_state::server_read_method}
+    , state_{http_state::server_read_head}
     , request_{http_method::invalid}
-    , circular_buffer_{streams::circular_buffer_filter{},
-                       streams::memory_device<std::vector<char>>{sockets::tcp_socket_circular_buffer_size}}
+    , receive_buffer_{}
+    , head_scanned_size_{0}
     , expected_content_length_{0}
+    , received_content_length_{0}
+    , chunked_content_{false}
+    , chunked_decoder_{}
+    , stream_content_{false}
+    , parsing_{false}
+    , streaming_response_{false}
+    , content_sent_handler_{}
 {
 }
 
@@ -26,182 +47,381 @@ http_server_socket::~http_server_socket() = default;
 
 void http_server_socket::respond(const common::string &content_type, const common::string &data, const status_code code)
 {
-    streams::string_stream<std::vector<std::byte>> sstream{std::size(data)};
-    sstream << data;
-    respond(content_type, sstream.release(), code);
+    const auto content = std::as_bytes(std::span{std::data(data), std::size(data)});
+    auto response = internal::write_response_head(content_type, std::size(content), code);
+    response.insert(std::end(response), std::begin(content), std::end(content));
+    send(std::move(response));
+    __finish_response();
 }
 
 void http_server_socket::respond(const common::string &content_type, std::vector<std::byte> data,
                                  const status_code code)
 {
-    streams::string_stream<std::vector<std::byte>> sstream{64};
-    sstream << detail::http_version_string;
-    sstream << ' ';
-    sstream << std::to_string(static_cast<int>(code));
-    sstream << ' ';
-    sstream << status_code_to_string(code);
-    sstream << "\r\n";
-    sstream << "Connection: keep-alive\r\n";
-    sstream << "Content-type: ";
-    sstream << content_type;
-    sstream << "\r\n";
-    sstream << "Content-Length: ";
-    sstream << std::to_string(std::size(data));
-    sstream << "\r\n\r\n";
-
-    send(sstream.release());
-    send(std::move(data));
-    __reset_state();
+    // The head and content are sent as one buffer, so that they are written with a single call.
+    auto response = internal::write_response_head(content_type, std::size(data), code);
+    response.insert(std::end(response), std::begin(data), std::end(data));
+    send(std::move(response));
+    __finish_response();
 }
 
-void http_server_socket::on_data(const std::span<const std::byte> &data)
+void http_server_socket::respond(const common::string_view &content_type, const std::span<const std::byte> content,
+                                 const compression_settings &settings, const status_code code)
 {
-    circular_buffer_.write(std::data(data), std::size(data));
-    streams::stream_reader reader(circular_buffer_);
+    const auto compressible = settings.enabled && std::size(content) >= settings.min_size &&
+                              is_compressible_content_type(content_type);
 
-    while (circular_buffer_.size() != 0)
+    auto coding = content_coding::identity;
+
+    if (compressible)
     {
-        if (state_ == http_state::server_read_body)
-        {
-            std::vector<std::byte> vec;
-            reader.read_to_vector(vec);
-            request_.append_raw_content_data(vec);
+        if (const auto accept_encoding = request_.find_header(detail::accept_encoding_key); accept_encoding)
+            coding = negotiate_content_coding(*accept_encoding);
+    }
 
-            if (request_.get_content_length() >= expected_content_length_)
-                __enter_reply_state();
-        }
-        else
-        {
-            const auto result = __on_line(reader.read_line());
-            if (result != status_code::ok)
-            {
-                respond_default(result);
-                disconnect();
-                return;
-            }
-        }
+    std::vector<std::byte> compressed;
+
+    if (coding != content_coding::identity)
+    {
+        compressed = compress_content(content, coding, settings.mode);
+
+        if (std::size(compressed) >= std::size(content))
+            coding = content_coding::identity;
     }
+
+    const auto body = (coding == content_coding::identity) ? content : std::span<const std::byte>{compressed};
+
+    response_head_writer writer{code};
+    writer.add_header("Connection", "keep-alive");
+    writer.add_header("Content-Type", content_type);
+
+    if (coding != content_coding::identity)
+        writer.add_header("Content-Encoding", content_coding_name(coding));
+
+    // Caches must not give a compressed response to a client that does not accept it, or the other way around.
+    if (compressible)
+        writer.add_header("Vary", "Accept-Encoding");
+
+    writer.add_header("Content-Length", std::size(body));
+
+    auto response = writer.release(std::size(body));
+    response.insert(std::end(response), std::begin(body), std::end(body));
+    send(std::move(response));
+    __finish_response();
 }
 
-auto http_server_socket::__on_line(const common::string &line) -> status_code
+void http_server_socket::respond(std::vector<std::byte> response)
 {
-    switch (state_)
-    {
-        case http_state::server_read_method:
-            return __handle_read_method_state(line);
-        case http_state::server_read_headers:
-            return __handle_read_headers_state(line);
-
-        // Unexpected read body state. Body must be read binary.
-        // If this happens, there is a bug.
-        case http_state::server_read_body:
-            return status_code::internal_server_error;
-
-        // Did not expect to receive more data in reply state.
-        case http_state::server_reply:
-            return status_code::bad_request;
-        // If default happens, there is a bug.
-        default:
-            return status_code::internal_server_error;
-    }
+    send(std::move(response));
+    __finish_response();
 }
 
-void http_server_socket::respond_default(const status_code code)
+void http_server_socket::respond(sockets::shared_buffer response)
 {
-    respond(detail::default_response_content_type, status_code_to_string(code), code);
+    send(std::move(response));
+    __finish_response();
 }
 
-auto http_server_socket::__parse_expected_content_length_and_type() -> status_code
+void http_server_socket::respond(std::vector<std::byte> head, std::shared_ptr<const sockets::sendable_file> file,
+                                 const std::uint64_t offset, const std::uint64_t size)
 {
-    const auto http_headers = parse_raw_http_headers(request_.get_raw_headers());
+    send(std::move(head));
+    send_file(std::move(file), offset, size);
+    __finish_response();
+}
 
-    const auto content_length_result = http_headers.find(detail::content_length_key);
+void http_server_socket::begin_response(const common::string_view &content_type, const status_code code,
+                                        std::function<void()> content_sent_handler)
+{
+    response_head_writer writer{code};
+    writer.add_header("Connection", "keep-alive");
+    writer.add_header("Content-Type", content_type);
+    writer.add_header("Transfer-Encoding", detail::chunked_transfer_coding);
+
+    streaming_response_ = true;
+    content_sent_handler_ = std::move(content_sent_handler);
+    send(writer.release());
+}
 
-    if (content_length_result == http_headers.end())
-        return status_code::length_required;
+void http_server_socket::write_response_content(const std::span<const std::byte> data)
+{
+    send(encode_chunk(data));
+}
+
+void http_server_socket::end_response()
+{
+    streaming_response_ = false;
+    send(encode_last_chunk());
+    __finish_response();
+}
 
-    const auto content_type_result = http_headers.find(detail::content_type_key);
+auto http_server_socket::on_http_request_head([[maybe_unused]] const request &request) -> bool
+{
+    return false;
+}
 
-    if (content_type_result == http_headers.end())
-        return status_code::bad_request;
+void http_server_socket::on_http_request_content([[maybe_unused]] const request &request,
+                                                 [[maybe_unused]] const std::span<const std::byte> data)
+{
+}
 
-    expected_content_length_ = std::stoll(content_length_result->second.str());
-    request_.set_content_type(content_type_result->second);
-    return status_code::ok;
+void http_server_socket::on_send_queue_empty()
+{
+    if (!streaming_response_ || !content_sent_handler_)
+        return;
+
+    // The handler is moved out while it is called, since it may end the response (and with that, replace itself).
+    auto handler = std::move(content_sent_handler_);
+    content_sent_handler_ = nullptr;
+    handler();
+
+    if (streaming_response_ && !content_sent_handler_)
+        content_sent_handler_ = std::move(handler);
 }
 
-auto http_server_socket::__enter_parse_body_state() -> status_code
+void http_server_socket::on_data(const std::span<const std::byte> &data)
 {
-    const auto result = __parse_expected_content_length_and_type();
+    if (state_ == http_state::server_closed)
+        return;
+
+    // Requests are parsed straight from the data that was read. It is only copied if a request is incomplete, or if
+    // pipelined requests have to wait for a response to the current request.
+    if (receive_buffer_.empty())
+    {
+        const auto remaining = data.subspan(__parse(data));
 
-    // If there was a parse error for the content length
-    if (result != status_code::ok)
-        return result;
+        if (state_ != http_state::server_closed && !receive_buffer_.write(remaining))
+            __fail(status_code::payload_too_large);
+
+        return;
+    }
 
-    // If content length is simply 0.
-    if (expected_content_length_ == 0)
+    if (!receive_buffer_.write(data))
     {
-        __enter_reply_state();
-        return status_code::ok;
+        __fail(status_code::payload_too_large);
+        return;
     }
 
-    state_ = http_state::server_read_body;
-    return status_code::ok;
+    __parse_buffered();
 }
 
-void http_server_socket::__enter_reply_state()
+auto http_server_socket::__parse(const std::span<const std::byte> data) -> std::size_t
 {
-    state_ = http_state::server_reply;
-    on_http_request(request_);
+    parsing_ = true;
+
+    request_head head;
+    std::size_t offset = 0;
+
+    while (offset < std::size(data))
+    {
+        const auto remaining = data.subspan(offset);
+
+        if (state_ == http_state::server_read_body)
+        {
+            offset += __read_body(remaining);
+            continue;
+        }
+
+        // Wait for a response to the current request before handling the next one.
+        if (state_ != http_state::server_read_head)
+            break;
+
+        const auto result = parse_request_head(remaining, head, head_scanned_size_);
+
+        if (result == request_parse_result::incomplete)
+        {
+            head_scanned_size_ = std::size(remaining);
+
+            if (head_scanned_size_ > detail::max_request_head_size)
+                __fail(status_code::request_header_fields_too_large);
+
+            break;
+        }
+
+        head_scanned_size_ = 0;
+
+        if (result != request_parse_result::complete)
+        {
+            __fail((result == request_parse_result::too_many_headers) ? status_code::request_header_fields_too_large
+                                                                       : status_code::bad_request);
+            break;
+        }
+
+        offset += head.size;
+
+        if (const auto status = __handle_request_head(head); status != status_code::ok)
+        {
+            __fail(status);
+            break;
+        }
+    }
+
+    parsing_ = false;
+    return offset;
 }
 
-auto http_server_socket::__handle_read_method_state(const common::string &line) -> status_code
+void http_server_socket::__parse_buffered()
 {
-    auto method_line_split = common::string_utils::split(line, ' ');
+    if (receive_buffer_.empty())
+        return;
 
-    if (method_line_split.size() != 3)
-        return status_code::bad_request;
+    const auto size = __parse(receive_buffer_.data());
 
-    const auto method = method_line_split[0];
-    const auto request_uri = method_line_split[1];
-    const auto version_string = method_line_split[2];
+    if (state_ == http_state::server_closed)
+        return;
 
-    if (!detail::validate_http_version_string(common::string{version_string.as_std_u8string_view()}))
+    receive_buffer_.consume(size);
+}
+
+auto http_server_socket::__handle_request_head(const request_head &head) -> status_code
+{
+    if (!detail::validate_http_version_string(head.version))
         return status_code::http_version_not_supported;
 
-    if (!detail::validate_uri(common::string{request_uri.as_std_u8string_view()}))
+    if (!detail::validate_uri(head.uri))
         return status_code::bad_request;
 
-    const request request(method, url_decode(request_uri));
+    const auto method = string_to_method(head.method);
 
-    if (request.get_method() == http_method::invalid)
+    if (method == http_method::invalid)
         return status_code::method_not_allowed;
 
-    request_ = request;
-    state_ = http_state::server_read_headers;
+    request_ = request{method};
+    request_.set_uri(url_decode(common::string{head.uri}));
 
-    return status_code::ok;
-}
+    for (std::size_t i = 0; i < head.header_count; ++i)
+        request_.append_http_header(head.headers[i].name, head.headers[i].value);
 
-auto http_server_socket::__handle_read_headers_state(const common::string &line) -> status_code
-{
-    if (line.empty())
+    // The end of the content must be known, so that the start of the next request can be found.
+    const auto transfer_encoding = head.find_header(detail::transfer_encoding_key);
+    const auto content_length = head.find_header(detail::content_length_key);
+
+    if (transfer_encoding)
     {
-        if (request_.get_method() == http_method::post)
-            return __enter_parse_body_state();
+        if (!common::string_utils::iequals(transfer_encoding->value, detail::chunked_transfer_coding))
+            return status_code::not_implemented;
+
+        // A request with both could be used to smuggle a request past a proxy that uses the other (RFC 7230, 3.3.3).
+        if (content_length)
+            return status_code::bad_request;
 
+        chunked_content_ = true;
+    }
+    else if (content_length)
+    {
+        if (!parse_content_length(content_length->value, expected_content_length_))
+            return status_code::bad_request;
+    }
+    else if (method == http_method::post)
+    {
+        return status_code::length_required;
+    }
+
+    if (transfer_encoding || content_length)
+    {
+        if (const auto content_type = head.find_header(detail::content_type_key); content_type)
+            request_.set_content_type(common::string{content_type->value});
+        else if (method == http_method::post)
+            return status_code::bad_request;
+    }
+
+    stream_content_ = on_http_request_head(request_);
+
+    if (!chunked_content_ && expected_content_length_ == 0)
+    {
         __enter_reply_state();
         return status_code::ok;
     }
 
-    request_.append_raw_http_header_line(line);
+    state_ = http_state::server_read_body;
     return status_code::ok;
 }
 
+auto http_server_socket::__read_body(const std::span<const std::byte> data) -> std::size_t
+{
+    // Only the content of this request is read; anything after it belongs to the next request.
+    if (chunked_content_)
+    {
+        std::span<const std::byte> content;
+        const auto size = chunked_decoder_.decode(data, content);
+
+        if (chunked_decoder_.failed())
+        {
+            __fail(status_code::bad_request);
+            return size;
+        }
+
+        if (!std::empty(content))
+            __handle_content(content);
+
+        if (chunked_decoder_.complete())
+            __enter_reply_state();
+
+        return size;
+    }
+
+    const auto remaining = expected_content_length_ - received_content_length_;
+    const auto size = std::min(std::size(data), remaining);
+    __handle_content(data.first(size));
+
+    if (size == remaining)
+        __enter_reply_state();
+
+    return size;
+}
+
+void http_server_socket::__handle_content(const std::span<const std::byte> data)
+{
+    received_content_length_ += std::size(data);
+
+    if (stream_content_)
+        on_http_request_content(request_, data);
+    else
+        request_.append_raw_content_data(data);
+}
+
+void http_server_socket::respond_default(const status_code code)
+{
+    respond(detail::default_response_content_type, status_code_to_string(code), code);
+}
+
+void http_server_socket::__enter_reply_state()
+{
+    state_ = http_state::server_reply;
+    on_http_request(request_);
+}
+
+void http_server_socket::__fail(const status_code code)
+{
+    state_ = http_state::server_closed;
+    receive_buffer_.clear();
+    respond_default(code);
+    disconnect();
+}
+
+void http_server_socket::__finish_response()
+{
+    if (state_ == http_state::server_closed)
+        return;
+
+    __reset_state();
+
+    // Continue with the requests that were pipelined behind this one, unless this response was given from within
+    // on_http_request; in that case __parse continues by itself.
+    if (!parsing_)
+        __parse_buffered();
+}
+
 void http_server_socket::__reset_state()
 {
-    state_ = http_state::server_read_method;
+    state_ = http_state::server_read_head;
     request_ = request{http_method::invalid};
     expected_content_length_ = 0;
+    received_content_length_ = 0;
+    chunked_content_ = false;
+    chunked_decoder_.reset();
+    stream_content_ = false;
+    streaming_response_ = false;
+    content_sent_handler_ = nullptr;
 }
+
 } // namespace aeon::web::http
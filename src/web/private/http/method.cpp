@@ -31,4 +31,20 @@ auto string_to_method(const common::string_view &str) noexcept -> http_method
     return http_method::invalid;
 }
 
+auto method_to_string(const http_method method) noexcept -> const char *
+{
+    for (const auto &method_string : method_string_lookup)
+    {
+        if (method_string.method == method)
+            return method_string.str.c_str();
+    }
+
+    return "";
+}
+
+auto is_idempotent_method(const http_method method) noexcept -> bool
+{
+    return method != http_method::invalid && method != http_method::post && method != http_method::patch;
+}
+
 } // namespace aeon::web::http
@@ -1,8 +1,8 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/web/http/reply.h>
-#include <aeon/streams/stream_writer.h>
 #include <aeon/streams/stream_reader.h>
+#include <aeon/common/string_utils.h>
 
 namespace aeon::web::http
 {
@@ -32,15 +32,35 @@ auto reply::get_raw_headers() const -> const std::vector<common::string> &
     return raw_headers_;
 }
 
-void reply::append_raw_http_header_line(const common::string &header_line)
+auto reply::find_header(const common::string_view &name) const -> std::optional<common::string_view>
 {
-    raw_headers_.push_back(header_line);
+    for (const auto &header_line : raw_headers_)
+    {
+        const common::string_view line{header_line};
+        const auto header_name_end = line.find(':');
+
+        if (header_name_end == common::string_view::npos ||
+            !common::string_utils::iequals(line.substr(0, header_name_end), name))
+            continue;
+
+        return common::string_utils::trimmedsv(line.substr(header_name_end + 1));
+    }
+
+    return std::nullopt;
+}
+
+void reply::append_http_header(const common::string_view &name, const common::string_view &value)
+{
+    auto &header_line = raw_headers_.emplace_back();
+    header_line.reserve(std::size(name) + 2 + std::size(value));
+    header_line.append(name);
+    header_line.append(": ");
+    header_line.append(value);
 }
 
-void reply::append_raw_content_data(const std::vector<std::byte> &data)
+void reply::append_raw_content_data(const std::span<const std::byte> data)
 {
-    streams::stream_writer writer{content_};
-    writer.vector_write(data);
+    content_.write(std::data(data), std::size(data));
 }
 
 } // namespace aeon::web::http
@@ -12,6 +12,7 @@ request::request(const http_method method)
     , uri_{}
     , raw_headers_{}
     , content_type_{}
+    , path_parameters_{}
     , content_{}
 {
 }
@@ -21,6 +22,7 @@ request::request(const common::string &method, common::string uri)
     , uri_{std::move(uri)}
     , raw_headers_{}
     , content_type_{}
+    , path_parameters_{}
     , content_{}
 {
 }
@@ -50,12 +52,49 @@ auto request::get_raw_headers() const -> const std::vector<common::string> &
     return raw_headers_;
 }
 
+auto request::find_header(const common::string_view &name) const -> std::optional<common::string_view>
+{
+    for (const auto &header_line : raw_headers_)
+    {
+        const common::string_view line{header_line};
+        const auto header_name_end = line.find(':');
+
+        if (header_name_end == common::string_view::npos ||
+            !common::string_utils::iequals(line.substr(0, header_name_end), name))
+            continue;
+
+        return common::string_utils::trimmedsv(line.substr(header_name_end + 1));
+    }
+
+    return std::nullopt;
+}
+
+auto request::find_path_parameter(const common::string_view &name) const -> std::optional<common::string_view>
+{
+    for (const auto &[parameter_name, value] : path_parameters_)
+    {
+        if (parameter_name == name)
+            return value;
+    }
+
+    return std::nullopt;
+}
+
 void request::append_raw_http_header_line(const common::string &header_line)
 {
     raw_headers_.push_back(header_line);
 }
 
-void request::append_raw_content_data(const std::vector<std::byte> &data) const
+void request::append_http_header(const common::string_view &name, const common::string_view &value)
+{
+    auto &header_line = raw_headers_.emplace_back();
+    header_line.reserve(std::size(name) + 2 + std::size(value));
+    header_line.append(name);
+    header_line.append(": ");
+    header_line.append(value);
+}
+
+void request::append_raw_content_data(const std::span<const std::byte> data) const
 {
     content_.write(std::data(data), std::size(data));
 }
@@ -65,6 +104,11 @@ void request::set_content_type(const common::string &content_type)
     content_type_ = content_type;
 }
 
+void request::add_path_parameter(const common::string_view &name, const common::string_view &value)
+{
+    path_parameters_.emplace_back(common::string{name}, common::string{value});
+}
+
 auto parse_raw_http_headers(const std::vector<common::string> &raw_headers) -> std::map<common::string, common::string>
 {
     std::map<common::string, common::string> headers;
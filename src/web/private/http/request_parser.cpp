@@ -0,0 +1,344 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/request_parser.h>
+#include <aeon/common/string_utils.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <bit>
+
+#if (!defined(AEON_DISABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)))
+#define AEON_WEB_HTTP_PARSER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+static constexpr auto del_char = static_cast<unsigned char>(0x7f);
+
+/*!
+ * Find the first character that is at most max_delimiter (typically a space or a control character) or DEL. With SSE2,
+ * 16 characters are checked at a time.
+ */
+[[nodiscard]] static auto find_delimiter(const char *begin, const char *end, const char max_delimiter) noexcept
+    -> const char *
+{
+#if (defined(AEON_WEB_HTTP_PARSER_SSE2))
+    const auto delimiter = _mm_set1_epi8(max_delimiter);
+    const auto del = _mm_set1_epi8(static_cast<char>(del_char));
+
+    while (end - begin >= 16)
+    {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+
+        // There is no unsigned compare in SSE2; a character is at most the delimiter if the minimum of both is itself.
+        const auto at_most_delimiter = _mm_cmpeq_epi8(_mm_min_epu8(chars, delimiter), chars);
+        const auto is_del = _mm_cmpeq_epi8(chars, del);
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(at_most_delimiter, is_del)));
+
+        if (mask != 0)
+            return begin + std::countr_zero(mask);
+
+        begin += 16;
+    }
+#endif
+
+    for (; begin != end; ++begin)
+    {
+        const auto c = static_cast<unsigned char>(*begin);
+
+        if (c <= static_cast<unsigned char>(max_delimiter) || c == del_char)
+            return begin;
+    }
+
+    return end;
+}
+
+/*!
+ * Find the end of the head (the empty line after the headers), starting at the given position. Returns nullptr if the
+ * head is not complete.
+ */
+[[nodiscard]] static auto find_head_end(const char *begin, const char *end) noexcept -> const char *
+{
+    while (begin != end)
+    {
+        const auto line_end = static_cast<const char *>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+
+        if (!line_end)
+            return nullptr;
+
+        const auto remaining = end - line_end;
+
+        if (remaining >= 2 && line_end[1] == '\n')
+            return line_end + 2;
+
+        if (remaining >= 3 && line_end[1] == '\r' && line_end[2] == '\n')
+            return line_end + 3;
+
+        begin = line_end + 1;
+    }
+
+    return nullptr;
+}
+
+/*!
+ * Parse a line ending (\r\n or \n). Returns nullptr if there is none.
+ */
+[[nodiscard]] static auto parse_line_end(const char *begin, const char *end) noexcept -> const char *
+{
+    if (begin != end && *begin == '\r')
+        ++begin;
+
+    if (begin == end || *begin != '\n')
+        return nullptr;
+
+    return begin + 1;
+}
+
+[[nodiscard]] static auto is_token_char(const char c) noexcept -> bool
+{
+    const auto uc = static_cast<unsigned char>(c);
+    return uc > ' ' && uc < del_char && c != ':' && c != '"' && c != '(' && c != ')' && c != ',' && c != '/' &&
+           c != ';' && c != '<' && c != '=' && c != '>' && c != '?' && c != '@' && c != '[' && c != '\\' && c != ']' &&
+           c != '{' && c != '}';
+}
+
+[[nodiscard]] static auto is_whitespace(const char c) noexcept -> bool
+{
+    return c == ' ' || c == '\t';
+}
+
+/*!
+ * Parse "name: value\r\n". Returns nullptr if the header is invalid.
+ */
+[[nodiscard]] static auto parse_header(const char *begin, const char *end, header_view &header) noexcept -> const char *
+{
+    auto name_end = begin;
+
+    while (name_end != end && is_token_char(*name_end))
+        ++name_end;
+
+    if (name_end == begin || name_end == end || *name_end != ':')
+        return nullptr;
+
+    auto value_begin = name_end + 1;
+
+    while (value_begin != end && is_whitespace(*value_begin))
+        ++value_begin;
+
+    // Tabs are allowed in the value; any other control character ends it.
+    auto value_end = find_delimiter(value_begin, end, '\x1f');
+
+    while (value_end != end && *value_end == '\t')
+        value_end = find_delimiter(value_end + 1, end, '\x1f');
+
+    const auto next = parse_line_end(value_end, end);
+
+    if (!next)
+        return nullptr;
+
+    while (value_end != value_begin && is_whitespace(*(value_end - 1)))
+        --value_end;
+
+    header.name = common::string_view{begin, static_cast<std::size_t>(name_end - begin)};
+    header.value = common::string_view{value_begin, static_cast<std::size_t>(value_end - value_begin)};
+    return next;
+}
+
+/*!
+ * Parse a token that ends with a single space (the method and the uri). Returns nullptr if the token is invalid.
+ */
+[[nodiscard]] static auto parse_request_line_token(const char *begin, const char *end,
+                                                   common::string_view &token) noexcept -> const char *
+{
+    const auto token_end = find_delimiter(begin, end, ' ');
+
+    if (token_end == begin || token_end == end || *token_end != ' ')
+        return nullptr;
+
+    token = common::string_view{begin, static_cast<std::size_t>(token_end - begin)};
+    return token_end + 1;
+}
+
+/*!
+ * Find the end of the head like find_head_end, but only search the data that was not searched before; except for the
+ * last 3 characters of it, since the end of the head may have been split. Empty lines before the first line are skipped
+ * and returned through begin.
+ */
+[[nodiscard]] static auto find_new_head_end(const char *data_begin, const char *end, const std::size_t previous_size,
+                                            const char *&begin) noexcept -> const char *
+{
+    begin = data_begin;
+
+    // Skip empty lines before the first line. Some clients send one after the body of a request.
+    while (begin != end && (*begin == '\r' || *begin == '\n'))
+        ++begin;
+
+    const auto search_offset = std::max(begin - data_begin, static_cast<std::ptrdiff_t>(previous_size) - 3);
+    return find_head_end(data_begin + std::min(search_offset, end - data_begin), end);
+}
+
+/*!
+ * Parse the headers after the first line, up to and including the empty line that ends them.
+ */
+[[nodiscard]] static auto parse_headers(const char *current, const char *head_end, header_view *headers,
+                                        const std::size_t max_headers, std::size_t &header_count,
+                                        const char *&next) noexcept -> request_parse_result
+{
+    header_count = 0;
+
+    while (true)
+    {
+        if (const auto line_end = parse_line_end(current, head_end); line_end)
+        {
+            next = line_end;
+            return request_parse_result::complete;
+        }
+
+        if (header_count == max_headers)
+            return request_parse_result::too_many_headers;
+
+        current = parse_header(current, head_end, headers[header_count]);
+
+        if (!current)
+            return request_parse_result::invalid;
+
+        ++header_count;
+    }
+}
+
+[[nodiscard]] static auto find_header(const header_view *headers, const std::size_t header_count,
+                                      const common::string_view &name) noexcept -> const header_view *
+{
+    for (std::size_t i = 0; i < header_count; ++i)
+    {
+        if (common::string_utils::iequals(headers[i].name, name))
+            return &headers[i];
+    }
+
+    return nullptr;
+}
+
+} // namespace internal
+
+auto request_head::find_header(const common::string_view &name) const noexcept -> const header_view *
+{
+    return internal::find_header(std::data(headers), header_count, name);
+}
+
+auto response_head::find_header(const common::string_view &name) const noexcept -> const header_view *
+{
+    return internal::find_header(std::data(headers), header_count, name);
+}
+
+auto parse_request_head(const std::span<const std::byte> data, request_head &head,
+                        const std::size_t previous_size) noexcept -> request_parse_result
+{
+    const auto data_begin = reinterpret_cast<const char *>(std::data(data));
+    const auto end = data_begin + std::size(data);
+
+    const char *begin = nullptr;
+    const auto head_end = internal::find_new_head_end(data_begin, end, previous_size, begin);
+
+    if (!head_end)
+        return request_parse_result::incomplete;
+
+    auto current = internal::parse_request_line_token(begin, head_end, head.method);
+
+    if (!current)
+        return request_parse_result::invalid;
+
+    current = internal::parse_request_line_token(current, head_end, head.uri);
+
+    if (!current)
+        return request_parse_result::invalid;
+
+    const auto version_end = internal::find_delimiter(current, head_end, ' ');
+
+    if (version_end == current)
+        return request_parse_result::invalid;
+
+    head.version = common::string_view{current, static_cast<std::size_t>(version_end - current)};
+    current = internal::parse_line_end(version_end, head_end);
+
+    if (!current)
+        return request_parse_result::invalid;
+
+    const auto result = internal::parse_headers(current, head_end, std::data(head.headers), request_head::max_headers,
+                                                head.header_count, current);
+
+    if (result != request_parse_result::complete)
+        return result;
+
+    head.size = static_cast<std::size_t>(current - data_begin);
+    return request_parse_result::complete;
+}
+
+auto parse_response_head(const std::span<const std::byte> data, response_head &head,
+                         const std::size_t previous_size) noexcept -> request_parse_result
+{
+    const auto data_begin = reinterpret_cast<const char *>(std::data(data));
+    const auto end = data_begin + std::size(data);
+
+    const char *begin = nullptr;
+    const auto head_end = internal::find_new_head_end(data_begin, end, previous_size, begin);
+
+    if (!head_end)
+        return request_parse_result::incomplete;
+
+    // The status line looks like "HTTP/1.1 200 OK"; the reason phrase may be empty and may contain spaces.
+    auto current = internal::parse_request_line_token(begin, head_end, head.version);
+
+    if (!current || head_end - current < 3)
+        return request_parse_result::invalid;
+
+    const auto [status_end, ec] = std::from_chars(current, current + 3, head.status_code);
+
+    if (ec != std::errc{} || status_end != current + 3 || head.status_code < 100)
+        return request_parse_result::invalid;
+
+    current = status_end;
+
+    if (*current == ' ')
+        ++current;
+    else if (*current != '\r' && *current != '\n')
+        return request_parse_result::invalid;
+
+    auto reason_end = internal::find_delimiter(current, head_end, '\x1f');
+
+    while (reason_end != head_end && *reason_end == '\t')
+        reason_end = internal::find_delimiter(reason_end + 1, head_end, '\x1f');
+
+    head.reason = common::string_view{current, static_cast<std::size_t>(reason_end - current)};
+    current = internal::parse_line_end(reason_end, head_end);
+
+    if (!current)
+        return request_parse_result::invalid;
+
+    const auto result = internal::parse_headers(current, head_end, std::data(head.headers), response_head::max_headers,
+                                                head.header_count, current);
+
+    if (result != request_parse_result::complete)
+        return result;
+
+    head.size = static_cast<std::size_t>(current - data_begin);
+    return request_parse_result::complete;
+}
+
+auto parse_content_length(const common::string_view &value, std::size_t &length) noexcept -> bool
+{
+    const auto begin = std::data(value);
+    const auto end = begin + std::size(value);
+
+    if (begin == end)
+        return false;
+
+    const auto [ptr, ec] = std::from_chars(begin, end, length);
+    return ec == std::errc{} && ptr == end;
+}
+
+} // namespace aeon::web::http
@@ -0,0 +1,60 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/response_head_writer.h>
+#include <aeon/web/http/constants.h>
+#include <charconv>
+#include <array>
+
+namespace aeon::web::http
+{
+
+response_head_writer::response_head_writer(const status_code code, const std::size_t reserve)
+    : buffer_{}
+{
+    buffer_.reserve(reserve);
+
+    append(detail::http_version_string);
+    append(" ");
+    append(static_cast<std::uint64_t>(code));
+    append(" ");
+    append(status_code_to_string(code));
+    append("\r\n");
+}
+
+void response_head_writer::add_header(const common::string_view &name, const common::string_view &value)
+{
+    append(name);
+    append(": ");
+    append(value);
+    append("\r\n");
+}
+
+void response_head_writer::add_header(const common::string_view &name, const std::uint64_t value)
+{
+    append(name);
+    append(": ");
+    append(value);
+    append("\r\n");
+}
+
+auto response_head_writer::release(const std::size_t content_size) -> std::vector<std::byte>
+{
+    append("\r\n");
+    buffer_.reserve(std::size(buffer_) + content_size);
+    return std::move(buffer_);
+}
+
+void response_head_writer::append(const common::string_view &str)
+{
+    const auto data = reinterpret_cast<const std::byte *>(std::data(str));
+    buffer_.insert(std::end(buffer_), data, data + std::size(str));
+}
+
+void response_head_writer::append(const std::uint64_t value)
+{
+    std::array<char, 20> str;
+    const auto result = std::to_chars(std::data(str), std::data(str) + std::size(str), value);
+    append(common::string_view{std::data(str), static_cast<std::size_t>(result.ptr - std::data(str))});
+}
+
+} // namespace aeon::web::http
@@ -1,7 +1,6 @@
 // Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
 
 #include <aeon/web/http/routable_http_server_session.h>
-#include <aeon/common/literals.h>
 
 namespace aeon::web::http
 {
@@ -9,6 +8,7 @@ namespace aeon::web::http
 routable_http_server_session::routable_http_server_session()
     : http_server_session{}
     , routes_{}
+    , route_tree_{}
 {
 }
 
@@ -16,48 +16,44 @@ routable_http_server_session::~routable_http_server_session() = default;
 
 void routable_http_server_session::add_route(std::unique_ptr<route> route)
 {
-    const auto mountpoint = route->mount_point();
-    routes_.insert({mountpoint, std::move(route)});
+    auto pattern = route->mount_point();
+
+    if (std::empty(pattern) || pattern.back() != '*')
+        pattern += '*';
+
+    add_route(std::move(pattern), http_method::invalid, std::move(route));
 }
 
-void routable_http_server_session::remove_route(const common::string &mountpoint)
+void routable_http_server_session::add_route(const http_method method, std::unique_ptr<route> route)
 {
-    routes_.erase(mountpoint);
+    auto pattern = route->mount_point();
+    add_route(std::move(pattern), method, std::move(route));
 }
 
-auto routable_http_server_session::find_best_match_route(const common::string &path, common::string &route_path) const
-    -> route *
+void routable_http_server_session::remove_route(const common::string &mountpoint)
 {
-    auto actual_path = path;
-
-    if (path[0] != '/')
-        actual_path = "/" + path;
-
-    auto best_match_length = 0_size_t;
-    route *best_match_route = nullptr;
-
-    for (auto &[route, route_ptr] : routes_)
-    {
-        const auto route_path_length = route.size();
-
-        // Due to possible mountpoints being inside other mountpoints, the best match provider is the one that
-        // has the most in common with the path
-        if (route_path_length > best_match_length)
-        {
-            if (actual_path.compare(0, route_path_length, route) == 0)
-            {
-                best_match_length = route_path_length;
-                best_match_route = route_ptr.get();
-            }
-        }
-    }
-
-    if (!best_match_route)
-        return nullptr;
+    std::erase_if(routes_,
+                  [this, &mountpoint](const route_entry &entry)
+                  {
+                      if (entry.handler->mount_point() != mountpoint)
+                          return false;
+
+                      route_tree_.remove(entry.pattern, entry.method);
+                      return true;
+                  });
+}
 
-    route_path = actual_path.substr(best_match_length);
+auto routable_http_server_session::match_route(const common::string_view &path, const http_method method,
+                                               route_match &match) const noexcept -> bool
+{
+    return route_tree_.match(path, method, match);
+}
 
-    return best_match_route;
+void routable_http_server_session::add_route(common::string pattern, const http_method method,
+                                             std::unique_ptr<route> route)
+{
+    route_tree_.add(pattern, *route, method);
+    routes_.push_back({std::move(pattern), method, std::move(route)});
 }
 
 } // namespace aeon::web::http
@@ -2,6 +2,7 @@
 
 #include <aeon/web/http/routable_http_server_socket.h>
 #include <aeon/web/http/routable_http_server_session.h>
+#include <utility>
 
 namespace aeon::web::http
 {
@@ -10,28 +11,66 @@ routable_http_server_socket::routable_http_server_socket(asio::ip::tcp::socket s
                                                          routable_http_server_session &session)
     : http_server_socket{std::move(socket)}
     , session_{session}
+    , matched_route_{nullptr}
+    , routed_request_{http_method::invalid}
+    , route_streams_content_{false}
 {
 }
 
 routable_http_server_socket::~routable_http_server_socket() = default;
 
-void routable_http_server_socket::on_http_request(const request &request)
+auto routable_http_server_socket::on_http_request_head(const request &request) -> bool
 {
-    common::string route_path;
-    const auto route = session_.find_best_match_route(request.get_uri(), route_path);
+    route_match match;
 
-    if (!route)
+    if (!session_.match_route(request.get_uri(), request.get_method(), match))
     {
-        respond_default(status_code::not_found);
-        return;
+        matched_route_ = nullptr;
+        route_streams_content_ = false;
+
+        // The content of a request that is not going to be handled is ignored rather than collected.
+        return true;
     }
 
-    // Change the request so actually use the new route_path. This way, a route doesn't need to know
+    // Change the request so actually use the remainder of the path. This way, a route doesn't need to know
     // what the full path is it's mounted on.
-    auto new_request = request;
-    new_request.set_uri(route_path);
+    matched_route_ = match.matched_route;
+    routed_request_ = request;
+    routed_request_.set_uri(common::string{match.remainder});
+
+    for (std::size_t i = 0; i < match.parameter_count; ++i)
+        routed_request_.add_path_parameter(match.parameters[i].name, match.parameters[i].value);
+
+    route_streams_content_ = matched_route_->on_http_request_head(*this, session_, routed_request_);
+
+    // The content is always received here, so that it can be collected in the routed request directly.
+    return true;
+}
+
+void routable_http_server_socket::on_http_request_content([[maybe_unused]] const request &request,
+                                                          const std::span<const std::byte> data)
+{
+    if (!matched_route_)
+        return;
+
+    if (route_streams_content_)
+        matched_route_->on_http_request_content(*this, session_, routed_request_, data);
+    else
+        routed_request_.append_raw_content_data(data);
+}
+
+void routable_http_server_socket::on_http_request([[maybe_unused]] const request &request)
+{
+    if (!matched_route_)
+    {
+        respond_default(status_code::not_found);
+        return;
+    }
 
-    route->on_http_request(*this, session_, new_request);
+    // The route may respond right away, after which the next request replaces the members.
+    const auto route = std::exchange(matched_route_, nullptr);
+    const auto routed_request = std::move(routed_request_);
+    route->on_http_request(*this, session_, routed_request);
 }
 
 } // namespace aeon::web::http
@@ -0,0 +1,274 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/route_tree.h>
+#include <aeon/common/string.h>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+static constexpr auto method_count = static_cast<std::size_t>(http_method::patch) + 1;
+
+// Routes per method. The route at the index of http_method::invalid is used for all methods.
+using method_routes = std::array<route *, method_count>;
+
+[[nodiscard]] static auto find_route(const method_routes &routes, const http_method method) noexcept -> route *
+{
+    if (const auto route = routes[static_cast<std::size_t>(method)]; route)
+        return route;
+
+    return routes[static_cast<std::size_t>(http_method::invalid)];
+}
+
+[[nodiscard]] static auto is_parameter_name_char(const char c) noexcept -> bool
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+[[nodiscard]] static auto starts_with(const common::string_view &str, const common::string &prefix) noexcept -> bool
+{
+    return std::size(str) >= std::size(prefix) && std::memcmp(std::data(str), std::data(prefix), std::size(prefix)) == 0;
+}
+
+} // namespace internal
+
+struct route_tree::node final
+{
+    // The static text that is matched by this node. Empty for the root and for parameter nodes. The first characters of
+    // the prefixes of the children of a node are unique.
+    common::string prefix;
+    std::vector<std::unique_ptr<node>> children;
+
+    // The child that matches a parameter, and the name of that parameter.
+    std::unique_ptr<node> parameter_child;
+    common::string parameter_name;
+
+    // The routes for paths that end at this node, and for paths that continue with a wildcard at this node.
+    internal::method_routes routes{};
+    internal::method_routes wildcard_routes{};
+};
+
+namespace internal
+{
+
+/*!
+ * Split a node, so that it only matches the first length characters of its prefix, with the rest moved to a child.
+ */
+static void split_node(std::unique_ptr<route_tree::node> &child, const std::size_t length)
+{
+    auto parent = std::make_unique<route_tree::node>();
+    parent->prefix = child->prefix.substr(0, length);
+    child->prefix = child->prefix.substr(length);
+    parent->children.push_back(std::move(child));
+    child = std::move(parent);
+}
+
+/*!
+ * Find the routes for a pattern, relative to the given node. If insert is true, any missing nodes are added; otherwise
+ * nullptr is returned if the pattern was never added. Throws route_pattern_exception if the pattern is invalid.
+ */
+[[nodiscard]] static auto find_routes(route_tree::node &node, const common::string_view pattern,
+                                      std::size_t parameter_count, const bool insert) -> method_routes *
+{
+    if (std::empty(pattern))
+        return &node.routes;
+
+    if (pattern[0] == '*')
+    {
+        if (std::size(pattern) != 1)
+            throw route_pattern_exception{};
+
+        return &node.wildcard_routes;
+    }
+
+    if (pattern[0] == ':')
+    {
+        auto name_end = std::size_t{1};
+
+        while (name_end < std::size(pattern) && is_parameter_name_char(pattern[name_end]))
+            ++name_end;
+
+        const auto name = pattern.substr(1, name_end - 1);
+
+        if (std::empty(name) || ++parameter_count > route_match::max_parameters)
+            throw route_pattern_exception{};
+
+        if (name_end < std::size(pattern) && pattern[name_end] != '/' && pattern[name_end] != '*')
+            throw route_pattern_exception{};
+
+        if (!node.parameter_child)
+        {
+            if (!insert)
+                return nullptr;
+
+            node.parameter_child = std::make_unique<route_tree::node>();
+            node.parameter_name = common::string{name};
+        }
+        else if (node.parameter_name != name)
+        {
+            throw route_pattern_exception{};
+        }
+
+        return find_routes(*node.parameter_child, pattern.substr(name_end), parameter_count, insert);
+    }
+
+    // Static text, up to the next parameter or wildcard. A parameter must be a complete path segment.
+    const auto text = pattern.substr(0, std::min(pattern.find(':'), pattern.find('*')));
+
+    if (std::size(text) < std::size(pattern) && pattern[std::size(text)] == ':' && text.back() != '/')
+        throw route_pattern_exception{};
+
+    for (auto &child : node.children)
+    {
+        if (child->prefix.front() != text.front())
+            continue;
+
+        const auto length = std::min(std::size(text), std::size(child->prefix));
+        const auto mismatch = std::mismatch(std::begin(text), std::begin(text) + length, std::begin(child->prefix));
+        const auto common_length = static_cast<std::size_t>(mismatch.first - std::begin(text));
+
+        if (common_length < std::size(child->prefix))
+        {
+            if (!insert)
+                return nullptr;
+
+            split_node(child, common_length);
+        }
+
+        return find_routes(*child, pattern.substr(common_length), parameter_count, insert);
+    }
+
+    if (!insert)
+        return nullptr;
+
+    auto &child = node.children.emplace_back(std::make_unique<route_tree::node>());
+    child->prefix = common::string{text};
+    return find_routes(*child, pattern.substr(std::size(text)), parameter_count, insert);
+}
+
+/*!
+ * Match the remainder of a path (without the query) against a node and its children. The end of the complete path
+ * (including the query) is passed, so that the remainder can be returned.
+ */
+[[nodiscard]] static auto match_node(const route_tree::node &node, const common::string_view path, const char *end,
+                                     const http_method method, route_match &match) noexcept -> bool
+{
+    if (std::empty(path))
+    {
+        if (const auto route = find_route(node.routes, method); route)
+        {
+            match.matched_route = route;
+            match.remainder = common::string_view{std::data(path), static_cast<std::size_t>(end - std::data(path))};
+            return true;
+        }
+    }
+    else
+    {
+        for (const auto &child : node.children)
+        {
+            if (child->prefix.front() != path.front())
+                continue;
+
+            if (starts_with(path, child->prefix) &&
+                match_node(*child, path.substr(std::size(child->prefix)), end, method, match))
+                return true;
+
+            break;
+        }
+
+        // A parameter matches a complete, non-empty segment.
+        if (node.parameter_child && path.front() != '/')
+        {
+            const auto value_end = std::min(path.find('/'), std::size(path));
+            match.parameters[match.parameter_count++] = route_parameter{node.parameter_name, path.substr(0, value_end)};
+
+            if (match_node(*node.parameter_child, path.substr(value_end), end, method, match))
+                return true;
+
+            --match.parameter_count;
+        }
+    }
+
+    if (const auto route = find_route(node.wildcard_routes, method); route)
+    {
+        match.matched_route = route;
+        match.remainder = common::string_view{std::data(path), static_cast<std::size_t>(end - std::data(path))};
+        return true;
+    }
+
+    return false;
+}
+
+[[nodiscard]] static auto strip_leading_slash(const common::string_view &path) noexcept -> common::string_view
+{
+    if (!std::empty(path) && path.front() == '/')
+        return path.substr(1);
+
+    return path;
+}
+
+} // namespace internal
+
+auto route_match::find_parameter(const common::string_view &name) const noexcept -> const route_parameter *
+{
+    for (std::size_t i = 0; i < parameter_count; ++i)
+    {
+        if (parameters[i].name == name)
+            return &parameters[i];
+    }
+
+    return nullptr;
+}
+
+route_tree::route_tree()
+    : root_{std::make_unique<node>()}
+{
+}
+
+route_tree::~route_tree() = default;
+
+route_tree::route_tree(route_tree &&) noexcept = default;
+
+auto route_tree::operator=(route_tree &&) noexcept -> route_tree & = default;
+
+void route_tree::add(const common::string_view &pattern, route &route, const http_method method)
+{
+    auto &routes = *internal::find_routes(*root_, internal::strip_leading_slash(pattern), 0, true);
+    auto &method_route = routes[static_cast<std::size_t>(method)];
+
+    if (method_route)
+        throw route_pattern_exception{};
+
+    method_route = &route;
+}
+
+auto route_tree::remove(const common::string_view &pattern, const http_method method) -> bool
+{
+    // Nodes are not removed or merged again; they are only used when routes are added for them again.
+    const auto routes = internal::find_routes(*root_, internal::strip_leading_slash(pattern), 0, false);
+
+    if (!routes || !(*routes)[static_cast<std::size_t>(method)])
+        return false;
+
+    (*routes)[static_cast<std::size_t>(method)] = nullptr;
+    return true;
+}
+
+auto route_tree::match(const common::string_view &path, const http_method method, route_match &match) const noexcept
+    -> bool
+{
+    match.matched_route = nullptr;
+    match.parameter_count = 0;
+    match.remainder = common::string_view{};
+
+    const auto end = std::data(path) + std::size(path);
+    const auto path_without_query = path.substr(0, std::min(path.find('?'), std::size(path)));
+    return internal::match_node(*root_, internal::strip_leading_slash(path_without_query), end, method, match);
+}
+
+} // namespace aeon::web::http
@@ -0,0 +1,338 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/static_file_cache.h>
+#include <aeon/common/string_utils.h>
+#include <system_error>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <array>
+
+namespace aeon::web::http
+{
+
+namespace internal
+{
+
+static constexpr std::array<const char *, 7> weekday_names{"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static constexpr std::array<const char *, 12> month_names{"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+/*!
+ * Parse a number that makes up the complete given string.
+ */
+[[nodiscard]] static auto parse_number(const common::string_view &str, std::uint64_t &value) noexcept -> bool
+{
+    const auto begin = std::data(str);
+    const auto end = begin + std::size(str);
+
+    if (begin == end)
+        return false;
+
+    const auto [ptr, ec] = std::from_chars(begin, end, value);
+    return ec == std::errc{} && ptr == end;
+}
+
+static void append_hex(common::string &str, const std::uint64_t value)
+{
+    std::array<char, 16> buffer;
+    const auto result = std::to_chars(std::data(buffer), std::data(buffer) + std::size(buffer), value, 16);
+    str.append(common::string_view{std::data(buffer), static_cast<std::size_t>(result.ptr - std::data(buffer))});
+}
+
+/*!
+ * A strong entity tag based on the modification time and size of a file. Every content coding of the file gets its own
+ * entity tag, since they are different representations.
+ */
+[[nodiscard]] static auto make_etag(const std::filesystem::file_time_type last_write_time, const std::uint64_t size,
+                                    const content_coding coding = content_coding::identity) -> common::string
+{
+    common::string etag = "\"";
+    append_hex(etag, static_cast<std::uint64_t>(last_write_time.time_since_epoch().count()));
+    etag += '-';
+    append_hex(etag, size);
+
+    if (coding != content_coding::identity)
+    {
+        etag += '-';
+        etag += content_coding_name(coding);
+    }
+
+    etag += '"';
+    return etag;
+}
+
+} // namespace internal
+
+auto detail::format_http_date(const std::filesystem::file_time_type time) -> common::string
+{
+    const auto system_time =
+        std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::file_clock::to_sys(time));
+    const auto days = std::chrono::floor<std::chrono::days>(system_time);
+    const std::chrono::year_month_day date{days};
+    const std::chrono::weekday weekday{days};
+    const std::chrono::hh_mm_ss time_of_day{system_time - days};
+
+    std::array<char, 32> buffer;
+    const auto length =
+        std::snprintf(std::data(buffer), std::size(buffer), "%s, %02u %s %04d %02d:%02d:%02d GMT",
+                      internal::weekday_names[weekday.c_encoding()], static_cast<unsigned int>(date.day()),
+                      internal::month_names[static_cast<unsigned int>(date.month()) - 1], static_cast<int>(date.year()),
+                      static_cast<int>(time_of_day.hours().count()), static_cast<int>(time_of_day.minutes().count()),
+                      static_cast<int>(time_of_day.seconds().count()));
+
+    return common::string{common::string_view{std::data(buffer), static_cast<std::size_t>(length)}};
+}
+
+auto detail::etag_matches(const common::string_view &if_none_match, const common::string_view &etag) -> bool
+{
+    for (const auto &tag : common::string_utils::splitsv(if_none_match, ','))
+    {
+        auto value = common::string_utils::trimmedsv(tag);
+
+        if (value == "*")
+            return true;
+
+        // The weak comparison function is used (RFC 7232), so weak tags match as well.
+        if (common::string_utils::begins_with(value, "W/"))
+            value = value.substr(2);
+
+        if (value == etag)
+            return true;
+    }
+
+    return false;
+}
+
+auto detail::parse_byte_range(const common::string_view &value, const std::uint64_t size, byte_range &range)
+    -> byte_range_result
+{
+    static constexpr common::string_view unit = "bytes=";
+
+    if (std::size(value) < std::size(unit) || !common::string_utils::iequals(value.substr(0, std::size(unit)), unit))
+        return byte_range_result::ignored;
+
+    const auto spec = common::string_utils::trimmedsv(value.substr(std::size(unit)));
+
+    if (spec.find(',') != common::string_view::npos)
+        return byte_range_result::ignored;
+
+    const auto separator = spec.find('-');
+
+    if (separator == common::string_view::npos)
+        return byte_range_result::ignored;
+
+    const auto first_str = spec.substr(0, separator);
+    const auto last_str = spec.substr(separator + 1);
+
+    // A suffix range: the last n bytes.
+    if (std::empty(first_str))
+    {
+        std::uint64_t suffix_length = 0;
+
+        if (!internal::parse_number(last_str, suffix_length))
+            return byte_range_result::ignored;
+
+        if (suffix_length == 0 || size == 0)
+            return byte_range_result::unsatisfiable;
+
+        range.length = std::min(suffix_length, size);
+        range.offset = size - range.length;
+        return byte_range_result::satisfiable;
+    }
+
+    std::uint64_t first = 0;
+
+    if (!internal::parse_number(first_str, first))
+        return byte_range_result::ignored;
+
+    auto last = size - 1;
+
+    if (!std::empty(last_str))
+    {
+        if (!internal::parse_number(last_str, last) || last < first)
+            return byte_range_result::ignored;
+    }
+
+    if (first >= size)
+        return byte_range_result::unsatisfiable;
+
+    range.offset = first;
+    range.length = std::min(last, size - 1) - first + 1;
+    return byte_range_result::satisfiable;
+}
+
+auto static_file::write_head(const status_code code, const content_coding coding) const -> response_head_writer
+{
+    const auto gzip = coding == content_coding::gzip;
+
+    response_head_writer writer{code};
+    writer.add_header("Connection", "keep-alive");
+    writer.add_header("Content-Type", content_type);
+
+    if (gzip)
+        writer.add_header("Content-Encoding", content_coding_name(coding));
+
+    // Caches must not give the compressed variant to a client that does not accept it, or the other way around.
+    if (gzip || gzip_response)
+        writer.add_header("Vary", "Accept-Encoding");
+
+    writer.add_header("Accept-Ranges", "bytes");
+    writer.add_header("ETag", gzip ? gzip_etag : etag);
+    writer.add_header("Last-Modified", last_modified);
+    return writer;
+}
+
+auto static_file::content() const noexcept -> std::span<const std::byte>
+{
+    if (!response)
+        return {};
+
+    return std::span{*response}.subspan(head_size);
+}
+
+auto static_file::gzip_content() const noexcept -> std::span<const std::byte>
+{
+    if (!gzip_response)
+        return {};
+
+    return std::span{*gzip_response}.subspan(gzip_head_size);
+}
+
+auto static_file::cached_size() const noexcept -> std::size_t
+{
+    return std::size(content()) + std::size(gzip_content());
+}
+
+static_file_cache::static_file_cache(const std::uint64_t max_file_size, const std::size_t max_size,
+                                     const compression_settings &compression)
+    : max_file_size_{max_file_size}
+    , max_size_{max_size}
+    , compression_{compression}
+    , mutex_{}
+    , files_{}
+    , size_{0}
+{
+}
+
+auto static_file_cache::get(const std::filesystem::path &path, const common::string &content_type)
+    -> std::shared_ptr<const static_file>
+{
+    const auto last_write_time = std::filesystem::last_write_time(path);
+
+    {
+        std::scoped_lock lock{mutex_};
+
+        if (const auto result = files_.find(path.native()); result != std::end(files_))
+        {
+            const auto &file = result->second;
+
+            if (file->last_write_time == last_write_time && file->content_type == content_type)
+                return file;
+        }
+    }
+
+    // The file is loaded without holding the lock, so that other files can still be served in the meantime.
+    auto file = load(path, content_type, last_write_time);
+    const auto file_size = file->cached_size();
+
+    std::scoped_lock lock{mutex_};
+
+    if (const auto result = files_.find(path.native()); result != std::end(files_))
+    {
+        size_ -= result->second->cached_size();
+        files_.erase(result);
+    }
+
+    if (file_size <= max_size_)
+    {
+        evict(file_size);
+        files_.emplace(path.native(), file);
+        size_ += file_size;
+    }
+
+    return file;
+}
+
+void static_file_cache::clear()
+{
+    std::scoped_lock lock{mutex_};
+    files_.clear();
+    size_ = 0;
+}
+
+auto static_file_cache::size() const -> std::size_t
+{
+    std::scoped_lock lock{mutex_};
+    return size_;
+}
+
+auto static_file_cache::load(const std::filesystem::path &path, const common::string &content_type,
+                             const std::filesystem::file_time_type last_write_time) const
+    -> std::shared_ptr<const static_file>
+{
+    auto opened_file = std::make_shared<const sockets::sendable_file>(path);
+
+    auto file = std::make_shared<static_file>();
+    file->last_write_time = last_write_time;
+    file->size = opened_file->size();
+    file->content_type = content_type;
+    file->etag = internal::make_etag(last_write_time, file->size);
+    file->last_modified = detail::format_http_date(last_write_time);
+
+    if (file->size > max_file_size_)
+    {
+        auto writer = file->write_head(status_code::ok);
+        writer.add_header("Content-Length", file->size);
+        file->head = writer.release();
+        file->file = std::move(opened_file);
+        return file;
+    }
+
+    std::vector<std::byte> content(static_cast<std::size_t>(file->size));
+
+    if (opened_file->read(0, content) != std::size(content))
+        throw std::system_error{std::make_error_code(std::errc::io_error)};
+
+    // The compressed variant is made first, since the heads of both variants depend on whether there is one.
+    if (compression_.enabled && std::size(content) >= compression_.min_size &&
+        is_compressible_content_type(content_type))
+    {
+        if (const auto compressed = compress_content(content, content_coding::gzip, compression_.mode);
+            std::size(compressed) < std::size(content))
+        {
+            file->gzip_etag = internal::make_etag(last_write_time, file->size, content_coding::gzip);
+
+            auto writer = file->write_head(status_code::ok, content_coding::gzip);
+            writer.add_header("Content-Length", std::size(compressed));
+
+            auto gzip_response = writer.release(std::size(compressed));
+            file->gzip_head_size = std::size(gzip_response);
+            gzip_response.insert(std::end(gzip_response), std::begin(compressed), std::end(compressed));
+            file->gzip_response = sockets::make_shared_buffer(std::move(gzip_response));
+        }
+    }
+
+    auto writer = file->write_head(status_code::ok);
+    writer.add_header("Content-Length", file->size);
+
+    auto response = writer.release(std::size(content));
+    file->head_size = std::size(response);
+    response.insert(std::end(response), std::begin(content), std::end(content));
+
+    file->response = sockets::make_shared_buffer(std::move(response));
+    return file;
+}
+
+void static_file_cache::evict(const std::size_t required_size)
+{
+    while (!std::empty(files_) && (size_ + required_size > max_size_ || std::size(files_) >= max_files))
+    {
+        const auto file = std::begin(files_);
+        size_ -= file->second->cached_size();
+        files_.erase(file);
+    }
+}
+
+} // namespace aeon::web::http
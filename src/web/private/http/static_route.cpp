@@ -6,15 +6,78 @@
 #include <aeon/web/http/url_encoding.h>
 #include <aeon/web/http/request.h>
 #include <aeon/web/http/constants.h>
-#include <aeon/streams/devices/file_device.h>
-#include <aeon/streams/dynamic_stream.h>
-#include <aeon/streams/stream_reader.h>
 #include <aeon/common/string_utils.h>
+#include <system_error>
 #include <cassert>
 
 namespace aeon::web::http
 {
 
+namespace internal
+{
+
+[[nodiscard]] static auto is_not_modified(const request &request, const static_file &file, const content_coding coding)
+    -> bool
+{
+    if (const auto if_none_match = request.find_header("if-none-match"); if_none_match)
+        return detail::etag_matches(*if_none_match, (coding == content_coding::gzip) ? file.gzip_etag : file.etag);
+
+    if (const auto if_modified_since = request.find_header("if-modified-since"); if_modified_since)
+        return *if_modified_since == file.last_modified;
+
+    return false;
+}
+
+/*!
+ * Find the range of the file that was requested. Returns ignored if the complete file should be sent.
+ */
+[[nodiscard]] static auto find_byte_range(const request &request, const static_file &file, detail::byte_range &range)
+    -> detail::byte_range_result
+{
+    const auto range_header = request.find_header("range");
+
+    if (!range_header)
+        return detail::byte_range_result::ignored;
+
+    // With If-Range, the range only applies if the file was not modified since the client received part of it.
+    if (const auto if_range = request.find_header("if-range");
+        if_range && *if_range != file.etag && *if_range != file.last_modified)
+        return detail::byte_range_result::ignored;
+
+    return detail::parse_byte_range(*range_header, file.size, range);
+}
+
+/*!
+ * Choose the variant of the file to send: gzip if there is one and the client accepts it, unless a range was requested
+ * (ranges are only served from the uncompressed file).
+ */
+[[nodiscard]] static auto select_content_coding(const request &request, const static_file &file) -> content_coding
+{
+    if (!file.gzip_response || request.find_header("range"))
+        return content_coding::identity;
+
+    const auto accept_encoding = request.find_header(detail::accept_encoding_key);
+
+    if (!accept_encoding || content_coding_quality(*accept_encoding, content_coding::gzip) == 0)
+        return content_coding::identity;
+
+    return content_coding::gzip;
+}
+
+[[nodiscard]] static auto write_content_range(const detail::byte_range &range, const std::uint64_t size)
+    -> common::string
+{
+    common::string content_range = "bytes ";
+    content_range += std::to_string(range.offset);
+    content_range += '-';
+    content_range += std::to_string(range.offset + range.length - 1);
+    content_range += '/';
+    content_range += std::to_string(size);
+    return content_range;
+}
+
+} // namespace internal
+
 auto detail::to_url_path(const common::string &path) -> common::string
 {
     return common::string{common::string_utils::replace_copy(path, "\\", "/").as_std_u8string_view()};
@@ -37,6 +100,8 @@ static_route::static_route(common::string mount_point, const std::filesystem::pa
     : route{std::move(mount_point)}
     , base_path_{std::filesystem::canonical(base_path)}
     , settings_{std::move(settings)}
+    , file_cache_{std::make_unique<static_file_cache>(settings_.max_cached_file_size, settings_.max_file_cache_size,
+                                                      settings_.compression)}
 {
     assert(std::filesystem::is_directory(base_path));
 }
@@ -71,7 +136,7 @@ void static_route::on_http_request(http_server_socket &source, routable_http_ser
 
     if (std::filesystem::is_regular_file(full_path))
     {
-        reply_file(source, session, full_path);
+        reply_file(source, session, request, full_path);
     }
     else
     {
@@ -107,18 +172,107 @@ auto static_route::get_path_for_default_files(const std::filesystem::path &path)
 }
 
 void static_route::reply_file(http_server_socket &source, routable_http_server_session &session,
-                              const std::filesystem::path &file) const
+                              const request &request, const std::filesystem::path &path) const
 {
-    auto extension = file.extension().u8string();
+    auto extension = path.extension().u8string();
 
     if (extension.empty())
-        extension = file.stem().u8string();
+        extension = path.stem().u8string();
 
     const auto mime_type = session.find_mime_type_by_extension(extension);
 
-    auto file_stream = streams::make_dynamic_stream(streams::file_source_device{file});
-    const streams::stream_reader reader{file_stream};
-    source.respond(mime_type, reader.read_to_vector<std::byte>());
+    std::shared_ptr<const static_file> file;
+
+    try
+    {
+        file = file_cache_->get(path, mime_type);
+    }
+    catch (const std::system_error &)
+    {
+        source.respond_default(status_code::not_found);
+        return;
+    }
+
+    const auto coding = internal::select_content_coding(request, *file);
+
+    if (internal::is_not_modified(request, *file, coding))
+    {
+        source.respond(file->write_head(status_code::not_modified, coding).release());
+        return;
+    }
+
+    const auto head_only = request.get_method() == http_method::head;
+
+    detail::byte_range range;
+    const auto range_result = internal::find_byte_range(request, *file, range);
+
+    if (range_result == detail::byte_range_result::unsatisfiable)
+    {
+        auto writer = file->write_head(status_code::range_not_satisfiable);
+        writer.add_header("Content-Range", "bytes */" + std::to_string(file->size));
+        writer.add_header("Content-Length", std::uint64_t{0});
+        source.respond(writer.release());
+        return;
+    }
+
+    if (range_result == detail::byte_range_result::satisfiable)
+    {
+        auto writer = file->write_head(status_code::partial_content);
+        writer.add_header("Content-Range", internal::write_content_range(range, file->size));
+        writer.add_header("Content-Length", range.length);
+
+        if (head_only)
+        {
+            source.respond(writer.release());
+        }
+        else if (file->response)
+        {
+            const auto content = file->content().subspan(static_cast<std::size_t>(range.offset),
+                                                         static_cast<std::size_t>(range.length));
+            auto response = writer.release(std::size(content));
+            response.insert(std::end(response), std::begin(content), std::end(content));
+            source.respond(std::move(response));
+        }
+        else
+        {
+            source.respond(writer.release(), file->file, range.offset, range.length);
+        }
+
+        return;
+    }
+
+    if (coding == content_coding::gzip)
+    {
+        if (head_only)
+        {
+            const auto head = std::span{*file->gzip_response}.first(file->gzip_head_size);
+            source.respond(std::vector<std::byte>{std::begin(head), std::end(head)});
+        }
+        else
+        {
+            source.respond(file->gzip_response);
+        }
+    }
+    else if (head_only)
+    {
+        if (file->response)
+        {
+            const auto head = std::span{*file->response}.first(file->head_size);
+            source.respond(std::vector<std::byte>{std::begin(head), std::end(head)});
+        }
+        else
+        {
+            source.respond(file->head);
+        }
+    }
+    else if (file->response)
+    {
+        source.respond(file->response);
+    }
+    else
+    {
+        source.respond(file->head, file->file, 0, file->size);
+    }
 }
 
 void static_route::reply_folder(http_server_socket &source, [[maybe_unused]] routable_http_server_session &session,
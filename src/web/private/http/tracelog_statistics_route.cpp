@@ -0,0 +1,49 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/tracelog_statistics_route.h>
+#include <aeon/web/http/http_server_socket.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+
+namespace aeon::web::http
+{
+
+static const auto statistics_content_type = "application/json";
+
+tracelog_statistics_route::tracelog_statistics_route(const common::string &mount_point)
+    : route{mount_point}
+{
+}
+
+tracelog_statistics_route::~tracelog_statistics_route() = default;
+
+auto tracelog_statistics_route::to_ptree(const std::vector<tracelog::scope_statistics> &statistics)
+    -> ptree::property_tree
+{
+    ptree::array scopes;
+    scopes.reserve(std::size(statistics));
+
+    for (const auto &s : statistics)
+    {
+        scopes.emplace_back(ptree::object{{"name", common::string{s.name}},
+                                          {"count", static_cast<std::int64_t>(s.count)},
+                                          {"total", s.total.count()},
+                                          {"mean", s.mean().count()},
+                                          {"min", s.min.count()},
+                                          {"max", s.max.count()},
+                                          {"p50", s.p50.count()},
+                                          {"p90", s.p90.count()},
+                                          {"p99", s.p99.count()},
+                                          {"p999", s.p999.count()}});
+    }
+
+    return ptree::object{{"scopes", std::move(scopes)}};
+}
+
+void tracelog_statistics_route::on_http_request(http_server_socket &source,
+                                                [[maybe_unused]] routable_http_server_session &session,
+                                                [[maybe_unused]] const request &request)
+{
+    source.respond(statistics_content_type, ptree::serialization::to_json(to_ptree(tracelog::statistics_snapshot())));
+}
+
+} // namespace aeon::web::http
@@ -7,12 +7,12 @@
 namespace aeon::web::http::detail
 {
 
-auto validate_http_version_string(const common::string &version_string) noexcept -> bool
+auto validate_http_version_string(const common::string_view &version_string) noexcept -> bool
 {
     return version_string == http_version_string;
 }
 
-auto validate_uri(const common::string &uri) noexcept -> bool
+auto validate_uri(const common::string_view &uri) noexcept -> bool
 {
     for (const auto c : uri)
     {
@@ -139,7 +139,7 @@ auto server::handle_single_rpc_request(const ptree::property_tree &request) cons
     if (jsonrpc_value.string_value() != json_rpc_version_string)
         return result{json_rpc_error::invalid_request, "Invalid rpc version. Required: '2.0'.", id};
 
-    if (request.contains("method"))
+    if (!request.contains("method"))
         return result{json_rpc_error::invalid_request, "Missing 'method' field.", id};
 
     auto method_value = request.at("method");
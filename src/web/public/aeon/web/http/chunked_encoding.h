@@ -0,0 +1,87 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+/*!
+ * Incremental decoder for content with chunked transfer encoding (RFC 7230, section 4.1). The content is decoded in
+ * place: decode returns views into the data that was passed to it, so nothing is buffered or copied. Chunk extensions
+ * and trailers are skipped.
+ */
+class chunked_decoder final
+{
+    enum class decoder_state
+    {
+        size,
+        extension,
+        size_lf,
+        data,
+        data_cr,
+        data_lf,
+        trailer_start,
+        trailer,
+        trailer_lf,
+        last_lf,
+        complete,
+        invalid
+    };
+
+public:
+    chunked_decoder() noexcept;
+    ~chunked_decoder() = default;
+
+    chunked_decoder(chunked_decoder &&) noexcept = default;
+    auto operator=(chunked_decoder &&) noexcept -> chunked_decoder & = default;
+
+    chunked_decoder(const chunked_decoder &) noexcept = default;
+    auto operator=(const chunked_decoder &) noexcept -> chunked_decoder & = default;
+
+    /*!
+     * Decode data, up to the end of the data, the end of the content or the end of a piece of content; whichever comes
+     * first. Returns the amount of bytes that were used. The decoded content (if any) is returned through content; it
+     * refers to the given data.
+     *
+     * Call repeatedly with the remaining data until all data is used, or until the decoder is complete or has failed.
+     * Any data after the end of the content is not used.
+     */
+    [[nodiscard]] auto decode(const std::span<const std::byte> data, std::span<const std::byte> &content) noexcept
+        -> std::size_t;
+
+    /*!
+     * Returns true once the last chunk and the trailers were decoded.
+     */
+    [[nodiscard]] auto complete() const noexcept -> bool;
+
+    /*!
+     * Returns true if the data was not validly chunked. The decoder can not be used anymore until it is reset.
+     */
+    [[nodiscard]] auto failed() const noexcept -> bool;
+
+    void reset() noexcept;
+
+private:
+    decoder_state state_;
+    std::uint64_t chunk_size_;
+    std::size_t size_digits_;
+    std::size_t line_length_;
+};
+
+/*!
+ * Encode a piece of content as a single chunk, including the chunk size line and the line ending after the data.
+ * Empty data can not be encoded as a chunk, since an empty chunk ends the content; an empty buffer is returned instead.
+ */
+[[nodiscard]] auto encode_chunk(const std::span<const std::byte> data) -> std::vector<std::byte>;
+
+/*!
+ * The last chunk, which ends content with chunked transfer encoding, without trailers.
+ */
+[[nodiscard]] auto encode_last_chunk() -> std::vector<std::byte>;
+
+} // namespace aeon::web::http
@@ -0,0 +1,39 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/method.h>
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+/*!
+ * A request that is sent by http_client_socket or http_client.
+ */
+struct client_request final
+{
+    http_method method = http_method::get;
+
+    // The path and query of the request. It is url encoded when the request is sent.
+    common::string uri = "/";
+
+    // Additional headers. Host and Content-Length are added when the request is serialized.
+    std::vector<std::pair<common::string, common::string>> headers{};
+
+    common::string content_type{};
+    std::vector<std::byte> content{};
+};
+
+/*!
+ * Serialize a request (the request line, headers and content) into a single buffer, so that it can be sent with one
+ * write.
+ */
+[[nodiscard]] auto serialize_request(const common::string_view &host, const client_request &request)
+    -> std::vector<std::byte>;
+
+} // namespace aeon::web::http
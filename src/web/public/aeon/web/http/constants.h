@@ -4,21 +4,40 @@
 
 #include <aeon/common/string.h>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 namespace aeon::web::http::detail
 {
 
 static const auto content_length_key = "content-length";
 static const auto content_type_key = "content-type";
+static const auto transfer_encoding_key = "transfer-encoding";
+static const auto accept_encoding_key = "accept-encoding";
+
+// Requests with a larger request line and headers are rejected.
+static constexpr std::size_t max_request_head_size = 64 * 1024;
+
+// Chunk size lines (including chunk extensions) of chunked content that are longer are rejected.
+static constexpr std::size_t max_chunk_line_size = 4 * 1024;
+
+static const auto chunked_transfer_coding = "chunked";
 
 static const auto default_response_content_type = "text/plain";
 
+// Responses with smaller content are not compressed by default.
+static constexpr std::size_t default_min_compressed_size = 1024;
+
 static const auto http_version_string = common::string{"HTTP/1.1"};
 
 static const auto default_file_mime_type = common::string{"application/octet-stream"};
 
 static const auto default_files = std::vector<common::string>{"index.html", "index.htm"};
 
+static constexpr std::uint64_t default_max_cached_file_size = 64 * 1024;
+
+static constexpr std::size_t default_max_file_cache_size = 16 * 1024 * 1024;
+
 static const auto hidden_files = std::vector<common::string>{".ds_store", "thumbs.db"};
 
 } // namespace aeon::web::http::detail
@@ -0,0 +1,66 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/constants.h>
+#include <aeon/compression/zlib.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <span>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+enum class content_coding
+{
+    identity,
+    gzip,
+    deflate
+};
+
+/*!
+ * When responses are compressed; see negotiate_content_coding.
+ */
+struct compression_settings final
+{
+    bool enabled = true;
+
+    // Smaller content is not compressed, since the savings would not outweigh the overhead.
+    std::size_t min_size = detail::default_min_compressed_size;
+
+    compression::zlib_compression_mode mode = compression::zlib_compression_mode::balanced;
+};
+
+/*!
+ * The name of a content coding, as used in the Content-Encoding header.
+ */
+[[nodiscard]] auto content_coding_name(const content_coding coding) noexcept -> const char *;
+
+/*!
+ * The quality value (0 to 1000) that the value of an Accept-Encoding header (RFC 7231, section 5.3.4) gives to a
+ * content coding; 0 means it is not acceptable. "*" applies to all codings that are not listed. Identity is acceptable
+ * unless it is explicitly excluded.
+ */
+[[nodiscard]] auto content_coding_quality(const common::string_view &accept_encoding,
+                                          const content_coding coding) noexcept -> int;
+
+/*!
+ * Choose the content coding of a response from the value of an Accept-Encoding header: gzip or deflate, whichever has
+ * the higher quality value (gzip if they are equal), or identity if neither is acceptable.
+ */
+[[nodiscard]] auto negotiate_content_coding(const common::string_view &accept_encoding) noexcept -> content_coding;
+
+/*!
+ * Returns true for content types that are worth compressing: text, and text based formats like JSON, JavaScript, XML
+ * and SVG. Parameters (like the charset) are ignored.
+ */
+[[nodiscard]] auto is_compressible_content_type(const common::string_view &content_type) noexcept -> bool;
+
+/*!
+ * Compress content with gzip or deflate. Identity returns a copy of the content.
+ */
+[[nodiscard]] auto compress_content(const std::span<const std::byte> content, const content_coding coding,
+                                    const compression::zlib_compression_mode mode) -> std::vector<std::byte>;
+
+} // namespace aeon::web::http
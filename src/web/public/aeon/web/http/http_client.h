@@ -0,0 +1,107 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/client_request.h>
+#include <aeon/web/http/reply.h>
+#include <aeon/common/string.h>
+#include <asio/io_context.hpp>
+#include <map>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <system_error>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+struct http_client_settings final
+{
+    // The maximum amount of connections that are opened to a single host.
+    std::size_t max_connections_per_host = 8;
+
+    // The maximum amount of requests that are sent on a connection before the reply to the first of them was received.
+    // Only idempotent requests are pipelined. 1 disables pipelining.
+    std::size_t max_pipeline_depth = 8;
+
+    // Connections are kept open to be used for more requests. If disabled, every request is sent on a new connection.
+    bool keep_alive = true;
+
+    std::chrono::milliseconds connect_timeout{10000};
+
+    // The time in which the complete reply to a request must be received, starting when the request is made.
+    std::chrono::milliseconds request_timeout{30000};
+
+    // Connections that were not used for this long are closed.
+    std::chrono::milliseconds idle_timeout{60000};
+};
+
+/*!
+ * Called with the reply to a request, or with an error code (and an empty reply) if the request failed. Requests that
+ * time out fail with std::errc::timed_out.
+ */
+using reply_handler = std::function<void(const std::error_code &ec, reply &reply)>;
+
+/*!
+ * HTTP client that keeps a pool of connections for every host (see http_client_settings).
+ *
+ * A request is sent on an idle connection if there is one. Otherwise a new connection is opened, as long as there are
+ * less than max_connections_per_host; and after that, idempotent requests are pipelined on the connection with the
+ * least requests in flight. Any remaining requests wait for a connection to become available.
+ *
+ * An idempotent request that was sent on a connection that is closed before the reply was received is retried once on
+ * another connection; this typically happens when a server closes an idle connection just as a request is sent on it.
+ *
+ * The name of a host is resolved asynchronously when the first request to it is made; requests to the host wait until
+ * it is resolved. Resolving fails with std::errc::timed_out if it takes longer than the connect timeout.
+ *
+ * The io_context must be run by a single thread; replies are passed to the handlers on that thread. request_async may
+ * be called from any thread, but the client must be destroyed on the thread of the io_context, or after it stopped.
+ */
+class http_client final
+{
+public:
+    explicit http_client(asio::io_context &context, http_client_settings settings = {});
+    ~http_client();
+
+    http_client(http_client &&) = delete;
+    auto operator=(http_client &&) -> http_client & = delete;
+
+    http_client(const http_client &) = delete;
+    auto operator=(const http_client &) -> http_client & = delete;
+
+    void request_async(const common::string &host, const std::uint16_t port, client_request request,
+                       reply_handler handler);
+
+    /*!
+     * Close all connections. Requests that were not replied to yet fail with std::errc::operation_canceled.
+     */
+    void close();
+
+    /*!
+     * The amount of connections that are open or being opened, to all hosts.
+     */
+    [[nodiscard]] auto connection_count() const noexcept -> std::size_t;
+
+    // The connections and queued requests for a single host; only defined in the implementation.
+    class connection;
+    class host_resolver;
+    struct pending_request;
+    struct host_pool;
+
+private:
+    void queue_request(const common::string &host, const std::uint16_t port, client_request request,
+                       reply_handler handler);
+    void dispatch_requests(host_pool &pool);
+    void on_host_resolved(host_pool &pool, const std::error_code &ec);
+    void open_connection(host_pool &pool);
+    void on_connection_closed(host_pool &pool, connection &connection, const std::error_code &ec);
+
+    asio::io_context &context_;
+    http_client_settings settings_;
+    std::map<common::string, std::unique_ptr<host_pool>> pools_;
+};
+
+} // namespace aeon::web::http
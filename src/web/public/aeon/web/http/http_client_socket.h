@@ -3,25 +3,41 @@
 #pragma once
 
 #include <aeon/web/http/request.h>
+#include <aeon/web/http/client_request.h>
+#include <aeon/web/http/request_parser.h>
+#include <aeon/web/http/chunked_encoding.h>
 #include <aeon/web/http/status_code.h>
 #include <aeon/web/http/reply.h>
 #include <aeon/sockets/tcp_socket.h>
-#include <aeon/streams/devices/memory_device.h>
-#include <aeon/streams/filters/circular_buffer_filter.h>
-#include <aeon/streams/stream.h>
+#include <aeon/sockets/contiguous_receive_buffer.h>
 #include <aeon/common/string.h>
 #include <asio.hpp>
+#include <deque>
 
 namespace aeon::web::http
 {
 
+/*!
+ * HTTP/1.1 client connection.
+ *
+ * The connection is kept open after a reply, so that it can be used for more requests. Requests can be sent before the
+ * replies to the previous ones were received (pipelining); the replies are passed to on_http_reply in the order of the
+ * requests. Replies are parsed with parse_response_head, and their content may be sized by Content-Length, chunked, or
+ * end when the server closes the connection. Requests must be sent from the thread of the socket (for example from
+ * on_connected or on_http_reply).
+ *
+ * Subclasses that override on_disconnected must call http_client_socket::on_disconnected, since a reply without a
+ * length ends when the connection is closed.
+ */
 class http_client_socket : public sockets::tcp_socket
 {
     enum class http_state
     {
-        client_read_status,
-        client_read_headers,
-        client_read_body
+        client_read_head,
+        client_read_body,
+        client_read_chunked_body,
+        client_read_until_close,
+        client_closed
     };
 
 public:
@@ -38,23 +54,59 @@ public:
     void request_async(const common::string &host, const common::string &uri,
                        const http_method method = http_method::get);
 
+    void request_async(const common::string &host, const client_request &request);
+
+    /*!
+     * The amount of requests that were sent, of which the reply was not completely received yet.
+     */
+    [[nodiscard]] auto pending_request_count() const noexcept -> std::size_t;
+
+    /*!
+     * Returns true once the connection was closed, or will be closed after the reply that is being received; no more
+     * requests should be sent then.
+     */
+    [[nodiscard]] auto closed() const noexcept -> bool;
+
     virtual void on_http_reply(reply &reply) = 0;
 
+    void on_disconnected() override;
+
+protected:
+    /*!
+     * Send a request that was already serialized (see serialize_request); for example to send the same request again
+     * on another connection without serializing it again.
+     */
+    void send_request(sockets::shared_buffer request, const http_method method);
+
 private:
     void on_data(const std::span<const std::byte> &data) override;
 
-    [[nodiscard]] auto __on_line(const common::string &line) -> bool;
+    /*!
+     * Handle as many replies from the given data as possible. Returns the amount of bytes that were used.
+     */
+    auto __parse(const std::span<const std::byte> data) -> std::size_t;
 
-    [[nodiscard]] auto __parse_expected_content_length() -> bool;
+    [[nodiscard]] auto __handle_reply_head(const response_head &head) -> bool;
+    auto __read_body(const std::span<const std::byte> data) -> std::size_t;
 
-    [[nodiscard]] auto __handle_read_status_state(const common::string &line) -> bool;
-    [[nodiscard]] auto __handle_read_headers_state(const common::string &line) -> bool;
+    void __finish_reply();
+    void __fail(const std::error_code &ec);
 
     http_state state_;
     reply reply_;
-    streams::aggregate_device<streams::circular_buffer_filter, streams::memory_device<std::vector<char>>>
-        circular_buffer_;
-    std::streamoff expected_content_length_;
+    sockets::contiguous_receive_buffer receive_buffer_;
+
+    // The amount of data that was searched for the end of an incomplete reply head.
+    std::size_t head_scanned_size_;
+    std::size_t expected_content_length_;
+    std::size_t received_content_length_;
+    chunked_decoder chunked_decoder_;
+
+    // Set if the server closes the connection after the current reply.
+    bool close_after_reply_;
+
+    // The methods of the requests that were not replied to yet. The reply to a HEAD request has no content.
+    std::deque<http_method> pending_requests_;
 };
 
 } // namespace aeon::web::http
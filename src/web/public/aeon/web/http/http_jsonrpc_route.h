@@ -4,6 +4,7 @@
 
 #include <aeon/web/jsonrpc/server.h>
 #include <aeon/web/http/route.h>
+#include <aeon/web/http/content_encoding.h>
 #include <aeon/common/string.h>
 #include <memory>
 
@@ -28,6 +29,12 @@ public:
 
     void register_method(const jsonrpc::method &method) const;
 
+    /*!
+     * Set when results are compressed. By default results of at least compression_settings::min_size are compressed
+     * for clients that accept it.
+     */
+    void set_compression_settings(const compression_settings &settings);
+
 private:
     void on_http_request(http_server_socket &source, routable_http_server_session &session,
                          const request &request) override;
@@ -36,6 +43,7 @@ private:
 
     std::unique_ptr<jsonrpc::server> rpc_server_;
     jsonrpc::server &rpc_server_ref_;
+    compression_settings compression_settings_;
 };
 
 } // namespace aeon::web::http
@@ -3,33 +3,42 @@
 #pragma once
 
 #include <aeon/web/http/request.h>
+#include <aeon/web/http/request_parser.h>
+#include <aeon/web/http/chunked_encoding.h>
+#include <aeon/web/http/content_encoding.h>
 #include <aeon/web/http/status_code.h>
 #include <aeon/sockets/tcp_socket.h>
-#include <aeon/streams/devices/memory_device.h>
-#include <aeon/streams/filters/circular_buffer_filter.h>
-#include <aeon/streams/stream.h>
+#include <aeon/sockets/contiguous_receive_buffer.h>
 #include <aeon/common/string.h>
 #include <asio.hpp>
+#include <functional>
 
 namespace aeon::web::http
 {
 
-namespace detail
-{
-auto validate_http_version_string(const common::string &version_string) -> bool;
-auto validate_uri(const common::string &uri) -> bool;
-} // namespace detail
-
 class http_server_session;
 
+/*!
+ * HTTP/1.1 server connection.
+ *
+ * Requests are parsed with parse_request_head, straight from the data that was read from the socket; data is only
+ * buffered when a request is split over multiple reads. Pipelined requests are handled one at a time: the next request
+ * is only passed to on_http_request once a response to the previous one was given through respond(), which must be
+ * called from the thread of the socket.
+ *
+ * Request content is either sized by Content-Length or sent with chunked transfer encoding. By default the content is
+ * collected in the request; by returning true from on_http_request_head it is passed to on_http_request_content as it
+ * arrives instead, so that large uploads do not have to be held in memory. Responses of which the size is not known up
+ * front can be sent in parts with chunked transfer encoding; see begin_response.
+ */
 class http_server_socket : public sockets::tcp_socket
 {
     enum class http_state
     {
-        server_read_method,
-        server_read_headers,
+        server_read_head,
         server_read_body,
-        server_reply
+        server_reply,
+        server_closed
     };
 
 public:
@@ -51,30 +60,110 @@ public:
     void respond(const common::string &content_type, std::vector<std::byte> data,
                  const status_code code = status_code::ok);
 
+    /*!
+     * Respond with content that is compressed with gzip or deflate if the request accepts it (see
+     * negotiate_content_coding), and if it is worth compressing according to the given settings: its type must be
+     * compressible (see is_compressible_content_type) and its size at least the minimum. Content that does not get
+     * smaller is sent uncompressed.
+     */
+    void respond(const common::string_view &content_type, const std::span<const std::byte> content,
+                 const compression_settings &settings, const status_code code = status_code::ok);
+
+    /*!
+     * Respond with a complete, serialized response (head and content; see response_head_writer).
+     */
+    void respond(std::vector<std::byte> response);
+
+    /*!
+     * Respond with a complete, serialized response that is only referenced, so that it can be shared between
+     * connections; for example when it is cached.
+     */
+    void respond(sockets::shared_buffer response);
+
+    /*!
+     * Respond with a serialized head, followed by part of a file that is sent without reading it into memory first
+     * (see tcp_socket::send_file). The head must declare the size of the content.
+     */
+    void respond(std::vector<std::byte> head, std::shared_ptr<const sockets::sendable_file> file,
+                 const std::uint64_t offset, const std::uint64_t size);
+
     void respond_default(const status_code code);
 
+    /*!
+     * Start a response with chunked transfer encoding. The content is sent with write_response_content, in as many parts
+     * as needed, and the response must be finished with end_response.
+     *
+     * The given handler (if any) is called every time all content that was written so far was sent. Writing the next
+     * part from this handler, rather than all content at once, means that only one part is held in memory at a time.
+     */
+    void begin_response(const common::string_view &content_type, const status_code code = status_code::ok,
+                        std::function<void()> content_sent_handler = {});
+
+    /*!
+     * Send a part of the content of a response that was started with begin_response. Empty data is ignored.
+     */
+    void write_response_content(const std::span<const std::byte> data);
+
+    /*!
+     * Finish a response that was started with begin_response.
+     */
+    void end_response();
+
+    /*!
+     * Called once the head of a request was received, before its content. Return true to receive the content through
+     * on_http_request_content, instead of having it collected in the request. on_http_request is called once all
+     * content was received either way. A response may only be given from on_http_request.
+     */
+    virtual auto on_http_request_head(const request &request) -> bool;
+
+    /*!
+     * Called with each part of the content of a request, if on_http_request_head returned true. The data is only valid
+     * during the call.
+     */
+    virtual void on_http_request_content(const request &request, const std::span<const std::byte> data);
+
     virtual void on_http_request(const request &request) = 0;
 
 private:
     void on_data(const std::span<const std::byte> &data) override;
+    void on_send_queue_empty() override;
 
-    auto __on_line(const common::string &line) -> status_code;
+    /*!
+     * Handle as many requests from the given data as possible. Returns the amount of bytes that were used.
+     */
+    auto __parse(const std::span<const std::byte> data) -> std::size_t;
+    void __parse_buffered();
 
-    auto __parse_expected_content_length_and_type() -> status_code;
+    auto __handle_request_head(const request_head &head) -> status_code;
+    auto __read_body(const std::span<const std::byte> data) -> std::size_t;
+    void __handle_content(const std::span<const std::byte> data);
 
-    auto __enter_parse_body_state() -> status_code;
     void __enter_reply_state();
-
-    auto __handle_read_method_state(const common::string &line) -> status_code;
-    auto __handle_read_headers_state(const common::string &line) -> status_code;
-
+    void __finish_response();
+    void __fail(const status_code code);
     void __reset_state();
 
     http_state state_;
     request request_;
-    streams::aggregate_device<streams::circular_buffer_filter, streams::memory_device<std::vector<char>>>
-        circular_buffer_;
-    std::streamoff expected_content_length_;
+    sockets::contiguous_receive_buffer receive_buffer_;
+
+    // The amount of data that was searched for the end of an incomplete request head.
+    std::size_t head_scanned_size_;
+    std::size_t expected_content_length_;
+    std::size_t received_content_length_;
+
+    // Set if the content of the current request has chunked transfer encoding.
+    bool chunked_content_;
+    chunked_decoder chunked_decoder_;
+
+    // Set if the content of the current request is passed to on_http_request_content.
+    bool stream_content_;
+
+    bool parsing_;
+
+    // Set between begin_response and end_response.
+    bool streaming_response_;
+    std::function<void()> content_sent_handler_;
 };
 
 } // namespace aeon::web::http
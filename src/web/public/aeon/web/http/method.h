@@ -21,4 +21,16 @@ enum class http_method
 
 [[nodiscard]] auto string_to_method(const common::string_view &str) noexcept -> http_method;
 
+/*!
+ * The name of a method as it is used in a request line ("GET", "POST", ...). Returns an empty string for
+ * http_method::invalid.
+ */
+[[nodiscard]] auto method_to_string(const http_method method) noexcept -> const char *;
+
+/*!
+ * Returns true if a request with this method can be repeated without changing its effect (RFC 7231, 4.2.2). Such
+ * requests can safely be retried, and pipelined.
+ */
+[[nodiscard]] auto is_idempotent_method(const http_method method) noexcept -> bool;
+
 } // namespace aeon::web::http
@@ -5,7 +5,10 @@
 #include <aeon/web/http/status_code.h>
 #include <aeon/streams/devices/memory_device.h>
 #include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
 #include <vector>
+#include <optional>
+#include <span>
 
 namespace aeon::web::http
 {
@@ -32,9 +35,14 @@ public:
 
     [[nodiscard]] auto get_raw_headers() const -> const std::vector<common::string> &;
 
+    /*!
+     * Find the value of a header by name (case insensitive).
+     */
+    [[nodiscard]] auto find_header(const common::string_view &name) const -> std::optional<common::string_view>;
+
 private:
-    void append_raw_http_header_line(const common::string &header_line);
-    void append_raw_content_data(const std::vector<std::byte> &data);
+    void append_http_header(const common::string_view &name, const common::string_view &value);
+    void append_raw_content_data(const std::span<const std::byte> data);
 
     status_code status_;
     std::vector<common::string> raw_headers_;
@@ -5,8 +5,12 @@
 #include <aeon/web/http/method.h>
 #include <aeon/streams/devices/memory_device.h>
 #include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
 #include <vector>
 #include <map>
+#include <optional>
+#include <utility>
+#include <span>
 
 namespace aeon::web::http
 {
@@ -14,6 +18,7 @@ namespace aeon::web::http
 class request
 {
     friend class http_server_socket;
+    friend class routable_http_server_socket;
 
 public:
     explicit request(const http_method method);
@@ -24,7 +29,7 @@ public:
         return method_;
     }
 
-    auto get_uri() const
+    auto get_uri() const noexcept -> const common::string &
     {
         return uri_;
     }
@@ -52,16 +57,30 @@ public:
 
     auto get_raw_headers() const -> const std::vector<common::string> &;
 
+    /*!
+     * Find the value of a header by name (case insensitive).
+     */
+    [[nodiscard]] auto find_header(const common::string_view &name) const -> std::optional<common::string_view>;
+
+    /*!
+     * Find the value of a parameter in the path of the route that handles this request (see route_tree).
+     */
+    [[nodiscard]] auto find_path_parameter(const common::string_view &name) const
+        -> std::optional<common::string_view>;
+
 private:
     void append_raw_http_header_line(const common::string &header_line);
-    void append_raw_content_data(const std::vector<std::byte> &data) const;
+    void append_http_header(const common::string_view &name, const common::string_view &value);
+    void append_raw_content_data(const std::span<const std::byte> data) const;
     void set_content_type(const common::string &content_type);
+    void add_path_parameter(const common::string_view &name, const common::string_view &value);
 
     http_method method_;
     common::string uri_;
     std::vector<common::string> raw_headers_;
 
     common::string content_type_;
+    std::vector<std::pair<common::string, common::string>> path_parameters_;
     mutable streams::memory_device<std::vector<char>> content_;
 };
 
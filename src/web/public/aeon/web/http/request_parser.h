@@ -0,0 +1,101 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/common/string_view.h>
+#include <array>
+#include <span>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+/*!
+ * A header of a request_head.
+ */
+struct header_view final
+{
+    common::string_view name;
+    common::string_view value;
+};
+
+/*!
+ * The request line and headers of an HTTP/1.x request, as parsed by parse_request_head. All views refer to the data
+ * that was parsed; they are only valid for as long as that data is.
+ */
+struct request_head final
+{
+    static constexpr std::size_t max_headers = 64;
+
+    common::string_view method;
+    common::string_view uri;
+    common::string_view version;
+
+    std::array<header_view, max_headers> headers;
+    std::size_t header_count = 0;
+
+    // The size of the request line and headers, including the empty line that ends them.
+    std::size_t size = 0;
+
+    /*!
+     * Find a header by name (case insensitive). Returns nullptr if the request does not have the header.
+     */
+    [[nodiscard]] auto find_header(const common::string_view &name) const noexcept -> const header_view *;
+};
+
+/*!
+ * The status line and headers of an HTTP/1.x response, as parsed by parse_response_head. All views refer to the data
+ * that was parsed; they are only valid for as long as that data is.
+ */
+struct response_head final
+{
+    static constexpr std::size_t max_headers = request_head::max_headers;
+
+    common::string_view version;
+    int status_code = 0;
+    common::string_view reason;
+
+    std::array<header_view, max_headers> headers;
+    std::size_t header_count = 0;
+
+    // The size of the status line and headers, including the empty line that ends them.
+    std::size_t size = 0;
+
+    /*!
+     * Find a header by name (case insensitive). Returns nullptr if the response does not have the header.
+     */
+    [[nodiscard]] auto find_header(const common::string_view &name) const noexcept -> const header_view *;
+};
+
+enum class request_parse_result
+{
+    complete,
+    incomplete,
+    invalid,
+    too_many_headers
+};
+
+/*!
+ * Parse the request line and headers at the start of the given data, without allocating or copying anything.
+ *
+ * If the data does not contain the complete head yet, incomplete is returned and the call can be repeated once more
+ * data was received. Pass the size of the data that was found incomplete as previous_size, so that only the new data
+ * has to be searched for the end of the head.
+ *
+ * Empty lines before the request line are skipped, as recommended by RFC 7230.
+ */
+[[nodiscard]] auto parse_request_head(const std::span<const std::byte> data, request_head &head,
+                                      const std::size_t previous_size = 0) noexcept -> request_parse_result;
+
+/*!
+ * Parse the status line and headers at the start of the given data, like parse_request_head does for requests.
+ */
+[[nodiscard]] auto parse_response_head(const std::span<const std::byte> data, response_head &head,
+                                       const std::size_t previous_size = 0) noexcept -> request_parse_result;
+
+/*!
+ * Parse the value of a Content-Length header. Returns false if the value is not a valid length.
+ */
+[[nodiscard]] auto parse_content_length(const common::string_view &value, std::size_t &length) noexcept -> bool;
+
+} // namespace aeon::web::http
@@ -0,0 +1,46 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/status_code.h>
+#include <aeon/common/string_view.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+/*!
+ * Serializes the status line and headers of a response straight into a byte buffer. The content can be appended to the
+ * released buffer, so that a response is sent as a single piece of memory.
+ */
+class response_head_writer final
+{
+public:
+    explicit response_head_writer(const status_code code, const std::size_t reserve = 256);
+    ~response_head_writer() = default;
+
+    response_head_writer(response_head_writer &&) noexcept = default;
+    auto operator=(response_head_writer &&) noexcept -> response_head_writer & = default;
+
+    response_head_writer(const response_head_writer &) = delete;
+    auto operator=(const response_head_writer &) -> response_head_writer & = delete;
+
+    void add_header(const common::string_view &name, const common::string_view &value);
+    void add_header(const common::string_view &name, const std::uint64_t value);
+
+    /*!
+     * Finish the head (add the empty line that ends it) and return it. Additional capacity can be reserved for the
+     * content, so that it can be appended without reallocating.
+     */
+    [[nodiscard]] auto release(const std::size_t content_size = 0) -> std::vector<std::byte>;
+
+private:
+    void append(const common::string_view &str);
+    void append(const std::uint64_t value);
+
+    std::vector<std::byte> buffer_;
+};
+
+} // namespace aeon::web::http
@@ -4,13 +4,18 @@
 
 #include <aeon/web/http/http_server_socket.h>
 #include <aeon/web/http/route.h>
+#include <aeon/web/http/route_tree.h>
 #include <aeon/web/http/http_server_session.h>
 #include <aeon/common/string.h>
 #include <memory>
+#include <vector>
 
 namespace aeon::web::http
 {
 
+/*!
+ * Session that dispatches requests to routes, which are looked up in a route_tree.
+ */
 class routable_http_server_session final : public http_server_session
 {
 public:
@@ -23,13 +28,41 @@ public:
     routable_http_server_session(const routable_http_server_session &) = delete;
     auto operator=(const routable_http_server_session &) -> routable_http_server_session & = delete;
 
+    /*!
+     * Add a route that handles all requests for its mount point and everything below it, for all methods. Mount points
+     * may contain parameters (see route_tree).
+     */
     void add_route(std::unique_ptr<route> route);
+
+    /*!
+     * Add a route that only handles requests with the given method that match its mount point exactly. The mount point
+     * is a route_tree pattern; it can end with a wildcard to also match everything below it.
+     */
+    void add_route(const http_method method, std::unique_ptr<route> route);
+
+    /*!
+     * Remove all routes with the given mount point.
+     */
     void remove_route(const common::string &mountpoint);
 
-    auto find_best_match_route(const common::string &path, common::string &route_path) const -> route *;
+    /*!
+     * Find the route for a request. Returns false if there is none.
+     */
+    [[nodiscard]] auto match_route(const common::string_view &path, const http_method method, route_match &match) const
+        noexcept -> bool;
 
 private:
-    std::map<common::string, std::unique_ptr<route>> routes_;
+    struct route_entry final
+    {
+        common::string pattern;
+        http_method method = http_method::invalid;
+        std::unique_ptr<route> handler;
+    };
+
+    void add_route(common::string pattern, const http_method method, std::unique_ptr<route> route);
+
+    std::vector<route_entry> routes_;
+    route_tree route_tree_;
 };
 
 } // namespace aeon::web::http
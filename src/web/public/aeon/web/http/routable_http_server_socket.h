@@ -27,9 +27,16 @@ public:
     auto operator=(const routable_http_server_socket &) -> routable_http_server_socket & = delete;
 
 private:
+    auto on_http_request_head(const request &request) -> bool override;
+    void on_http_request_content(const request &request, const std::span<const std::byte> data) override;
     void on_http_request(const request &request) override;
 
     routable_http_server_session &session_;
+
+    // The route that handles the current request (if any), and the request as it is passed to that route.
+    route *matched_route_;
+    request routed_request_;
+    bool route_streams_content_;
 };
 
 } // namespace aeon::web::http
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <aeon/common/string.h>
+#include <span>
+#include <cstddef>
 
 namespace aeon::web::http
 {
@@ -23,6 +25,17 @@ public:
     route(const route &) = delete;
     auto operator=(const route &) -> route & = delete;
 
+    /*!
+     * Called once the head of a request was received, before its content. Return true to receive the content through
+     * on_http_request_content as it arrives, instead of having it collected in the request that is passed to
+     * on_http_request. See http_server_socket::on_http_request_head.
+     */
+    virtual auto on_http_request_head(http_server_socket &source, routable_http_server_session &session,
+                                      const request &request) -> bool;
+
+    virtual void on_http_request_content(http_server_socket &source, routable_http_server_session &session,
+                                         const request &request, const std::span<const std::byte> data);
+
     virtual void on_http_request(http_server_socket &source, routable_http_server_session &session,
                                  const request &request) = 0;
 
@@ -37,6 +50,20 @@ inline route::route(common::string mount_point)
 {
 }
 
+inline auto route::on_http_request_head([[maybe_unused]] http_server_socket &source,
+                                        [[maybe_unused]] routable_http_server_session &session,
+                                        [[maybe_unused]] const request &request) -> bool
+{
+    return false;
+}
+
+inline void route::on_http_request_content([[maybe_unused]] http_server_socket &source,
+                                           [[maybe_unused]] routable_http_server_session &session,
+                                           [[maybe_unused]] const request &request,
+                                           [[maybe_unused]] const std::span<const std::byte> data)
+{
+}
+
 inline auto route::mount_point() const noexcept -> const common::string &
 {
     return mount_point_;
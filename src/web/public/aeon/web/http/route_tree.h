@@ -0,0 +1,104 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/method.h>
+#include <aeon/common/string_view.h>
+#include <stdexcept>
+#include <memory>
+#include <array>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+class route;
+
+class route_pattern_exception final : public std::exception
+{
+};
+
+/*!
+ * A path parameter of a route_match. The views refer to the pattern and the matched path.
+ */
+struct route_parameter final
+{
+    common::string_view name;
+    common::string_view value;
+};
+
+/*!
+ * The result of route_tree::match.
+ */
+struct route_match final
+{
+    static constexpr std::size_t max_parameters = 8;
+
+    route *matched_route = nullptr;
+
+    std::array<route_parameter, max_parameters> parameters{};
+    std::size_t parameter_count = 0;
+
+    // The part of the path after the part that was matched; what was matched by a wildcard, followed by the query.
+    common::string_view remainder;
+
+    /*!
+     * Find a path parameter by name. Returns nullptr if the route does not have the parameter.
+     */
+    [[nodiscard]] auto find_parameter(const common::string_view &name) const noexcept -> const route_parameter *;
+};
+
+/*!
+ * Compressed radix tree (a trie in which chains of nodes with a single child are merged) that maps path patterns to
+ * routes. Matching a path does not allocate; parameters and the remainder of the path are returned as views.
+ *
+ * Patterns always start with a '/' (one is added if it is missing) and may contain:
+ * - ":name": a parameter, which matches a single non-empty path segment (up to the next '/').
+ * - "*" at the end: a wildcard, which matches the rest of the path, including nothing. "/files*" matches "/files",
+ *   "/files/a/b" and "/filesystem".
+ *
+ * When multiple patterns match a path, static text takes precedence over parameters, and parameters take precedence
+ * over wildcards; so the most specific route is found. The query part of a path is not matched; it is part of the
+ * remainder.
+ *
+ * A route can be added for a specific method, or for all methods (http_method::invalid). A route that was added for a
+ * specific method takes precedence.
+ */
+class route_tree final
+{
+public:
+    route_tree();
+    ~route_tree();
+
+    route_tree(route_tree &&) noexcept;
+    auto operator=(route_tree &&) noexcept -> route_tree &;
+
+    route_tree(const route_tree &) = delete;
+    auto operator=(const route_tree &) -> route_tree & = delete;
+
+    /*!
+     * Add a route. Throws route_pattern_exception if the pattern is invalid, has too many parameters, uses a different
+     * name for a parameter than a pattern that was added before, or if a route was already added for the same pattern
+     * and method.
+     */
+    void add(const common::string_view &pattern, route &route, const http_method method = http_method::invalid);
+
+    /*!
+     * Remove the route that was added for the given pattern and method. Returns false if there was none.
+     */
+    auto remove(const common::string_view &pattern, const http_method method = http_method::invalid) -> bool;
+
+    /*!
+     * Find the route for a path. Returns false if no route matches.
+     */
+    [[nodiscard]] auto match(const common::string_view &path, const http_method method, route_match &match) const
+        noexcept -> bool;
+
+    // A node of the tree; only defined in the implementation.
+    struct node;
+
+private:
+    std::unique_ptr<node> root_;
+};
+
+} // namespace aeon::web::http
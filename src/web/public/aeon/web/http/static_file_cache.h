@@ -0,0 +1,164 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/response_head_writer.h>
+#include <aeon/web/http/content_encoding.h>
+#include <aeon/web/http/status_code.h>
+#include <aeon/sockets/tcp_socket.h>
+#include <aeon/sockets/sendable_file.h>
+#include <aeon/common/string.h>
+#include <aeon/common/string_view.h>
+#include <filesystem>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeon::web::http
+{
+
+namespace detail
+{
+
+/*!
+ * Format a time as an HTTP date (RFC 7231), for example "Sun, 06 Nov 1994 08:49:37 GMT".
+ */
+[[nodiscard]] auto format_http_date(const std::filesystem::file_time_type time) -> common::string;
+
+/*!
+ * Check if the value of an If-None-Match header matches the given entity tag.
+ */
+[[nodiscard]] auto etag_matches(const common::string_view &if_none_match, const common::string_view &etag) -> bool;
+
+struct byte_range final
+{
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+};
+
+enum class byte_range_result
+{
+    // The header is not supported or invalid; the complete content should be sent.
+    ignored,
+    satisfiable,
+    unsatisfiable
+};
+
+/*!
+ * Parse the value of a Range header for content of the given size. Only a single range of bytes is supported; a
+ * request for multiple ranges is ignored, as permitted by RFC 7233.
+ */
+[[nodiscard]] auto parse_byte_range(const common::string_view &value, const std::uint64_t size, byte_range &range)
+    -> byte_range_result;
+
+} // namespace detail
+
+/*!
+ * A file that is served by a static_route, together with everything of its response that does not depend on the
+ * request.
+ */
+struct static_file final
+{
+    std::filesystem::file_time_type last_write_time;
+    std::uint64_t size = 0;
+    common::string content_type;
+    common::string etag;
+    common::string last_modified;
+
+    // The complete response (head and content) to a plain GET request, for files that are kept in memory.
+    sockets::shared_buffer response;
+    std::size_t head_size = 0;
+
+    // The head of the response to a plain GET request and the opened file, for files that are sent from disk.
+    std::vector<std::byte> head;
+    std::shared_ptr<const sockets::sendable_file> file;
+
+    // The complete response to a plain GET request with gzip compressed content, for files that are kept in memory and
+    // are compressible; compressed once when the file is loaded. Not set if compressing does not make the file smaller.
+    sockets::shared_buffer gzip_response;
+    std::size_t gzip_head_size = 0;
+    common::string gzip_etag;
+
+    /*!
+     * Start the head of a response for this file, with the headers that describe the file in the given coding (which
+     * must be identity or gzip). The Content-Length header is not added.
+     */
+    [[nodiscard]] auto write_head(const status_code code, const content_coding coding = content_coding::identity) const
+        -> response_head_writer;
+
+    /*!
+     * The content of the file, if it is kept in memory.
+     */
+    [[nodiscard]] auto content() const noexcept -> std::span<const std::byte>;
+
+    /*!
+     * The gzip compressed content of the file, if there is any.
+     */
+    [[nodiscard]] auto gzip_content() const noexcept -> std::span<const std::byte>;
+
+    /*!
+     * The amount of memory that is used by the content of the file and its compressed variant.
+     */
+    [[nodiscard]] auto cached_size() const noexcept -> std::size_t;
+};
+
+/*!
+ * Cache of files that are served by a static_route, keyed by path and modification time.
+ *
+ * Files up to max_file_size are kept in memory together with their pre-serialized response, so that serving them again
+ * only requires a single write. Compressible files (see is_compressible_content_type) of at least the minimum size of
+ * the compression settings also get a pre-serialized gzip compressed response, so that they are compressed once rather
+ * than for every request. Larger files are kept open, and are sent from disk with sendable_file. When the cache is
+ * full, arbitrary entries are evicted. The cache is thread safe.
+ */
+class static_file_cache final
+{
+public:
+    // The maximum amount of files that are kept in the cache, which also limits the amount of open files.
+    static constexpr std::size_t max_files = 1024;
+
+    explicit static_file_cache(const std::uint64_t max_file_size, const std::size_t max_size,
+                               const compression_settings &compression = {});
+    ~static_file_cache() = default;
+
+    static_file_cache(static_file_cache &&) = delete;
+    auto operator=(static_file_cache &&) -> static_file_cache & = delete;
+
+    static_file_cache(const static_file_cache &) = delete;
+    auto operator=(const static_file_cache &) -> static_file_cache & = delete;
+
+    /*!
+     * Get a file. It is loaded when it is not in the cache yet, or when it was modified since it was loaded. Throws
+     * std::system_error if the file could not be opened or read.
+     */
+    [[nodiscard]] auto get(const std::filesystem::path &path, const common::string &content_type)
+        -> std::shared_ptr<const static_file>;
+
+    void clear();
+
+    /*!
+     * The total size of the files that are kept in memory, including their compressed variants.
+     */
+    [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+    [[nodiscard]] auto load(const std::filesystem::path &path, const common::string &content_type,
+                            const std::filesystem::file_time_type last_write_time) const
+        -> std::shared_ptr<const static_file>;
+
+    void evict(const std::size_t required_size);
+
+    std::uint64_t max_file_size_;
+    std::size_t max_size_;
+    compression_settings compression_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::filesystem::path::string_type, std::shared_ptr<const static_file>> files_;
+    std::size_t size_;
+};
+
+} // namespace aeon::web::http
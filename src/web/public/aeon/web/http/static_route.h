@@ -3,10 +3,15 @@
 #pragma once
 
 #include <aeon/web/http/route.h>
+#include <aeon/web/http/static_file_cache.h>
+#include <aeon/web/http/content_encoding.h>
 #include <aeon/web/http/constants.h>
 #include <aeon/common/string.h>
 #include <filesystem>
+#include <memory>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 namespace aeon::web::http
 {
@@ -41,8 +46,26 @@ struct static_route_settings final
 
     // Files that should not be displayed when listing a directory.
     std::vector<common::string> hidden_files = detail::hidden_files;
+
+    // Files up to this size are kept in memory together with their response headers. Larger files are sent from disk.
+    std::uint64_t max_cached_file_size = detail::default_max_cached_file_size;
+
+    // The maximum total size of the files that are kept in memory.
+    std::size_t max_file_cache_size = detail::default_max_file_cache_size;
+
+    // Compressible files that are kept in memory are also kept gzip compressed, for clients that accept it. Since they
+    // are only compressed once, the best compression is used.
+    compression_settings compression{.mode = compression::zlib_compression_mode::best};
 };
 
+/*!
+ * Serves the files in a directory.
+ *
+ * Files are served from a static_file_cache (see there), and support conditional requests (If-None-Match,
+ * If-Modified-Since) and single range requests. The gzip compressed variant of a file is served to clients that accept
+ * it, except for range requests.
+ */
+
 class static_route final : public route
 {
 public:
@@ -70,8 +93,8 @@ private:
 
     [[nodiscard]] auto get_path_for_default_files(const std::filesystem::path &path) const -> std::filesystem::path;
 
-    void reply_file(http_server_socket &source, routable_http_server_session &session,
-                    const std::filesystem::path &file) const;
+    void reply_file(http_server_socket &source, routable_http_server_session &session, const request &request,
+                    const std::filesystem::path &path) const;
     void reply_folder(http_server_socket &source, routable_http_server_session &session,
                       const std::filesystem::path &path) const;
 
@@ -85,6 +108,7 @@ private:
 
     std::filesystem::path base_path_;
     static_route_settings settings_;
+    std::unique_ptr<static_file_cache> file_cache_;
 };
 
 } // namespace aeon::web::http
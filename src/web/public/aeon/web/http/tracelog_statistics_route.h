@@ -0,0 +1,39 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#pragma once
+
+#include <aeon/web/http/route.h>
+#include <aeon/tracelog/statistics.h>
+#include <aeon/ptree/ptree.h>
+#include <aeon/common/string.h>
+#include <vector>
+
+namespace aeon::web::http
+{
+
+/*!
+ * Serves a snapshot of the trace log statistics (see aeon/tracelog/statistics.h) as JSON, so that the timings of a
+ * running process can be monitored. All durations are in nanoseconds. Statistics must be enabled through
+ * tracelog::settings::collect_statistics.
+ */
+class tracelog_statistics_route final : public route
+{
+public:
+    explicit tracelog_statistics_route(const common::string &mount_point);
+    ~tracelog_statistics_route() final;
+
+    tracelog_statistics_route(tracelog_statistics_route &&) = delete;
+    auto operator=(tracelog_statistics_route &&) -> tracelog_statistics_route & = delete;
+
+    tracelog_statistics_route(const tracelog_statistics_route &) = delete;
+    auto operator=(const tracelog_statistics_route &) -> tracelog_statistics_route & = delete;
+
+    [[nodiscard]] static auto to_ptree(const std::vector<tracelog::scope_statistics> &statistics)
+        -> ptree::property_tree;
+
+private:
+    void on_http_request(http_server_socket &source, routable_http_server_session &session,
+                         const request &request) override;
+};
+
+} // namespace aeon::web::http
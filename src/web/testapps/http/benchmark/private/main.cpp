@@ -0,0 +1,154 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/http_server_socket.h>
+#include <aeon/sockets/sharded_tcp_server.h>
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/read_until.hpp>
+#include <asio/write.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+using namespace aeon;
+
+/*
+ * Benchmark for the request handling of http_server_socket. A local server that answers every request with a small
+ * text is started, after which client threads send small GET requests over connections that are kept open, with 1 to 16
+ * requests pipelined at a time, and the amount of requests/s is measured.
+ *
+ * Usage: aeon_web_http_benchmark [duration in seconds per measurement] [client threads] [server threads]
+ */
+
+static constexpr std::string_view request_data = "GET /hello HTTP/1.1\r\nHost: localhost\r\nAccept: */*\r\n\r\n";
+
+class hello_socket final : public web::http::http_server_socket
+{
+public:
+    explicit hello_socket(asio::ip::tcp::socket socket)
+        : http_server_socket{std::move(socket)}
+    {
+    }
+
+    void on_http_request([[maybe_unused]] const web::http::request &request) final
+    {
+        respond("text/plain", "Hello!");
+    }
+};
+
+/*!
+ * Send a single request and return the size of the response, so that the responses to pipelined requests can be read
+ * without having to parse them.
+ */
+[[nodiscard]] static auto measure_response_size(const asio::ip::tcp::endpoint &endpoint) -> std::size_t
+{
+    asio::io_context context;
+    asio::ip::tcp::socket socket{context};
+    socket.connect(endpoint);
+    asio::write(socket, asio::buffer(std::data(request_data), std::size(request_data)));
+
+    std::string response;
+    const auto head_size = asio::read_until(socket, asio::dynamic_buffer(response), "\r\n\r\n");
+
+    constexpr std::string_view content_length_key = "Content-Length: ";
+    const auto content_length_offset = response.find(content_length_key) + std::size(content_length_key);
+    return head_size + static_cast<std::size_t>(std::atoi(response.c_str() + content_length_offset));
+}
+
+static auto measure(const asio::ip::tcp::endpoint &endpoint, const std::size_t response_size,
+                    const std::size_t pipeline_depth, const std::size_t client_threads,
+                    const std::chrono::seconds duration) -> double
+{
+    std::string requests;
+
+    for (std::size_t i = 0; i < pipeline_depth; ++i)
+        requests += request_data;
+
+    std::atomic<std::uint64_t> count{0};
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + duration;
+
+    std::vector<std::thread> threads;
+    threads.reserve(client_threads);
+
+    for (std::size_t i = 0; i < client_threads; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                try
+                {
+                    asio::io_context context;
+                    asio::ip::tcp::socket socket{context};
+                    socket.connect(endpoint);
+                    socket.set_option(asio::ip::tcp::no_delay{true});
+
+                    std::vector<char> responses(response_size * pipeline_depth);
+                    std::uint64_t thread_count = 0;
+
+                    while (std::chrono::steady_clock::now() < end)
+                    {
+                        asio::write(socket, asio::buffer(requests));
+                        asio::read(socket, asio::buffer(responses));
+                        thread_count += pipeline_depth;
+                    }
+
+                    count.fetch_add(thread_count, std::memory_order_relaxed);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Client error: " << e.what() << '\n';
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    return static_cast<double>(count.load()) / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    const auto duration = std::chrono::seconds{(argc > 1) ? std::atoi(argv[1]) : 2};
+    const auto client_threads =
+        (argc > 2) ? static_cast<std::size_t>(std::atoi(argv[2])) : std::size_t{std::thread::hardware_concurrency()};
+
+    sockets::sharded_tcp_server_settings settings;
+    settings.thread_count = (argc > 3) ? static_cast<std::size_t>(std::atoi(argv[3])) : 1;
+
+    sockets::sharded_tcp_server<hello_socket> server{settings};
+    const asio::ip::tcp::endpoint endpoint{asio::ip::address_v4::loopback(), server.port()};
+
+    std::thread server_thread{[&server]() { server.run(); }};
+
+    const auto response_size = measure_response_size(endpoint);
+
+    std::cout << "Client threads: " << client_threads << ", server threads: " << server.thread_count() << ", "
+              << duration.count() << "s per measurement.\n\n";
+    std::cout << std::left << std::setw(16) << "Pipelined" << std::right << std::setw(16) << "Requests/s" << '\n';
+
+    for (const auto pipeline_depth : {1, 4, 16})
+    {
+        const auto requests_per_second =
+            measure(endpoint, response_size, static_cast<std::size_t>(pipeline_depth), client_threads, duration);
+
+        std::cout << std::left << std::setw(16) << pipeline_depth << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << requests_per_second << std::endl;
+    }
+
+    server.stop();
+    server_thread.join();
+
+    return 0;
+}
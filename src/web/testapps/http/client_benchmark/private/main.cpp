@@ -0,0 +1,173 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/http_client.h>
+#include <aeon/web/http/http_server_socket.h>
+#include <aeon/sockets/sharded_tcp_server.h>
+#include <asio/io_context.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string_view>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+using namespace aeon;
+
+/*
+ * Benchmark for http_client. A fixed amount of GET requests is kept in flight for a while, and the amount of requests/s
+ * is measured: with a new connection for every request, with a pool of connections that are kept open, and with a pool
+ * of connections on which requests are pipelined.
+ *
+ * By default a local server that answers every request with a small text is started. Give a port (and optionally a
+ * uri) to use a server that is already running instead; for example the aeon_web_http_server testapp on port 8080.
+ *
+ * Usage: aeon_web_http_client_benchmark [duration in seconds per measurement] [requests in flight] [port] [uri]
+ */
+
+class hello_socket final : public web::http::http_server_socket
+{
+public:
+    explicit hello_socket(asio::ip::tcp::socket socket)
+        : http_server_socket{std::move(socket)}
+    {
+    }
+
+    void on_http_request([[maybe_unused]] const web::http::request &request) final
+    {
+        respond("text/plain", "Hello!");
+    }
+};
+
+struct measurement final
+{
+    std::uint64_t replies = 0;
+    std::uint64_t errors = 0;
+    double requests_per_second = 0.0;
+};
+
+class benchmark final
+{
+public:
+    explicit benchmark(const std::uint16_t port, const common::string &uri,
+                       const web::http::http_client_settings &settings)
+        : context_{}
+        , client_{context_, settings}
+        , port_{port}
+        , uri_{uri}
+        , end_{}
+        , in_flight_{0}
+        , result_{}
+    {
+    }
+
+    [[nodiscard]] auto run(const std::size_t in_flight, const std::chrono::seconds duration) -> measurement
+    {
+        const auto start = std::chrono::steady_clock::now();
+        end_ = start + duration;
+
+        for (std::size_t i = 0; i < in_flight; ++i)
+            request();
+
+        context_.run();
+
+        const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+        result_.requests_per_second = static_cast<double>(result_.replies) / elapsed.count();
+        return result_;
+    }
+
+private:
+    void request()
+    {
+        ++in_flight_;
+        client_.request_async("127.0.0.1", port_, {.uri = uri_},
+                              [this](const std::error_code &ec, [[maybe_unused]] web::http::reply &reply)
+                              { on_reply(ec); });
+    }
+
+    void on_reply(const std::error_code &ec)
+    {
+        --in_flight_;
+
+        if (ec)
+            ++result_.errors;
+        else
+            ++result_.replies;
+
+        if (std::chrono::steady_clock::now() < end_)
+        {
+            request();
+            return;
+        }
+
+        if (in_flight_ == 0)
+        {
+            client_.close();
+            context_.stop();
+        }
+    }
+
+    asio::io_context context_;
+    web::http::http_client client_;
+    std::uint16_t port_;
+    common::string uri_;
+    std::chrono::steady_clock::time_point end_;
+    std::size_t in_flight_;
+    measurement result_;
+};
+
+int main(int argc, char *argv[])
+{
+    const auto duration = std::chrono::seconds{(argc > 1) ? std::atoi(argv[1]) : 1};
+    const auto in_flight = (argc > 2) ? static_cast<std::size_t>(std::atoi(argv[2])) : std::size_t{64};
+    const common::string uri = (argc > 4) ? argv[4] : "/hello";
+
+    std::unique_ptr<sockets::sharded_tcp_server<hello_socket>> server;
+    std::thread server_thread;
+    auto port = (argc > 3) ? static_cast<std::uint16_t>(std::atoi(argv[3])) : std::uint16_t{0};
+
+    if (port == 0)
+    {
+        sockets::sharded_tcp_server_settings settings;
+        settings.thread_count = 1;
+
+        server = std::make_unique<sockets::sharded_tcp_server<hello_socket>>(settings);
+        port = server->port();
+        server_thread = std::thread{[&server]() { server->run(); }};
+    }
+
+    std::cout << "Port: " << port << ", uri: " << uri.str() << ", requests in flight: " << in_flight << ", "
+              << duration.count() << "s per measurement.\n\n";
+    std::cout << std::left << std::setw(32) << "Connections" << std::right << std::setw(16) << "Requests/s"
+              << std::setw(12) << "Errors" << '\n';
+
+    const struct
+    {
+        std::string_view name;
+        web::http::http_client_settings settings;
+    } configurations[] = {
+        {"New connection per request", {.max_connections_per_host = 8, .max_pipeline_depth = 1, .keep_alive = false}},
+        {"Pooled (8)", {.max_connections_per_host = 8, .max_pipeline_depth = 1}},
+        {"Pooled (8), pipelined (8)", {.max_connections_per_host = 8, .max_pipeline_depth = 8}},
+    };
+
+    for (const auto &configuration : configurations)
+    {
+        benchmark benchmark{port, uri, configuration.settings};
+        const auto result = benchmark.run(in_flight, duration);
+
+        std::cout << std::left << std::setw(32) << configuration.name << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(16) << result.requests_per_second << std::setw(12)
+                  << result.errors << std::endl;
+    }
+
+    if (server)
+    {
+        server->stop();
+        server_thread.join();
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <aeon/web/http/routable_http_server.h>
 #include <aeon/web/http/http_jsonrpc_route.h>
 #include <aeon/web/http/static_route.h>
+#include <aeon/web/http/tracelog_statistics_route.h>
 #include <asio/io_context.hpp>
 #include "http_server_settings.h"
 
@@ -26,6 +27,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
                             }});
 
     handler.get_session().add_route(std::move(route));
+    handler.get_session().add_route(std::make_unique<web::http::tracelog_statistics_route>("/statistics"));
     handler.get_session().add_route(std::make_unique<web::http::static_route>("/", AEON_HTTP_SERVER_WWWROOT_PATH));
 
     service.run();
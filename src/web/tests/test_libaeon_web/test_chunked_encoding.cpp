@@ -0,0 +1,103 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/chunked_encoding.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+using namespace aeon;
+
+static auto as_bytes(const std::string_view str) -> std::span<const std::byte>
+{
+    return std::as_bytes(std::span{std::data(str), std::size(str)});
+}
+
+static auto as_string(const std::span<const std::byte> data) -> std::string
+{
+    return {reinterpret_cast<const char *>(std::data(data)), std::size(data)};
+}
+
+/*!
+ * Decode all given data in parts of at most the given size. Returns the decoded content and the amount of data that
+ * was used.
+ */
+static auto decode(web::http::chunked_decoder &decoder, const std::string_view data, const std::size_t part_size)
+    -> std::pair<std::string, std::size_t>
+{
+    std::string content;
+    std::size_t offset = 0;
+
+    while (offset < std::size(data) && !decoder.complete() && !decoder.failed())
+    {
+        auto part = as_bytes(data.substr(offset, part_size));
+
+        while (!std::empty(part) && !decoder.complete() && !decoder.failed())
+        {
+            std::span<const std::byte> decoded;
+            const auto size = decoder.decode(part, decoded);
+            content += as_string(decoded);
+            part = part.subspan(size);
+            offset += size;
+        }
+    }
+
+    return {content, offset};
+}
+
+TEST(test_chunked_encoding, decode)
+{
+    const std::string_view data = "5\r\nHello\r\n7;name=value\r\n, world\r\n0\r\n\r\nGET / HTTP/1.1\r\n";
+
+    for (std::size_t part_size = 1; part_size <= std::size(data); ++part_size)
+    {
+        web::http::chunked_decoder decoder;
+        const auto [content, size] = decode(decoder, data, part_size);
+
+        ASSERT_TRUE(decoder.complete());
+        EXPECT_EQ("Hello, world", content);
+
+        // The data after the content is not used.
+        EXPECT_EQ(std::size(data) - std::size("GET / HTTP/1.1\r\n") + 1, size);
+    }
+}
+
+TEST(test_chunked_encoding, decode_trailers)
+{
+    const std::string_view data = "A\r\n0123456789\r\n0\r\nChecksum: 1234\r\nOther: value\r\n\r\n";
+
+    for (std::size_t part_size = 1; part_size <= std::size(data); ++part_size)
+    {
+        web::http::chunked_decoder decoder;
+        const auto [content, size] = decode(decoder, data, part_size);
+
+        ASSERT_TRUE(decoder.complete());
+        EXPECT_EQ("0123456789", content);
+        EXPECT_EQ(std::size(data), size);
+    }
+}
+
+TEST(test_chunked_encoding, decode_invalid)
+{
+    for (const auto data : {"\r\n", "x\r\n", "5\r\nHello0\r\n\r\n", "5\nHello\r\n0\r\n\r\n", "ffffffffffffffff\r\n",
+                            "0\r\n\r\r"})
+    {
+        web::http::chunked_decoder decoder;
+        decode(decoder, data, std::size(std::string_view{data}));
+        EXPECT_TRUE(decoder.failed()) << data;
+    }
+}
+
+TEST(test_chunked_encoding, encode)
+{
+    const std::string content(300, 'x');
+    const auto chunk = web::http::encode_chunk(as_bytes(content));
+    EXPECT_EQ("12c\r\n" + content + "\r\n", as_string(chunk));
+
+    EXPECT_TRUE(std::empty(web::http::encode_chunk({})));
+    EXPECT_EQ("0\r\n\r\n", as_string(web::http::encode_last_chunk()));
+
+    web::http::chunked_decoder decoder;
+    const auto [decoded, size] = decode(decoder, as_string(chunk) + as_string(web::http::encode_last_chunk()), 64);
+    EXPECT_TRUE(decoder.complete());
+    EXPECT_EQ(content, decoded);
+}
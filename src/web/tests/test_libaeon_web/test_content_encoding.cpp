@@ -0,0 +1,93 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/content_encoding.h>
+#include <aeon/compression/zlib.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+
+using namespace aeon;
+
+static auto decompress(const std::vector<std::byte> &data, const compression::zlib_format format) -> std::string
+{
+    std::size_t offset = 0;
+    const auto read = [&data, &offset](std::byte *buffer, const std::streamsize size)
+    {
+        const auto read_size = std::min(static_cast<std::size_t>(size), std::size(data) - offset);
+        std::copy_n(std::data(data) + offset, read_size, buffer);
+        offset += read_size;
+        return static_cast<std::streamsize>(read_size);
+    };
+
+    std::string result(64 * 1024, '\0');
+    compression::zlib_decompress decompress{256, format};
+    result.resize(static_cast<std::size_t>(
+        decompress.read(reinterpret_cast<std::byte *>(std::data(result)), std::size(result), read)));
+    return result;
+}
+
+TEST(test_content_encoding, content_coding_quality)
+{
+    using web::http::content_coding;
+
+    EXPECT_EQ(1000, web::http::content_coding_quality("gzip, deflate, br", content_coding::gzip));
+    EXPECT_EQ(500, web::http::content_coding_quality("deflate, gzip;q=0.5", content_coding::gzip));
+    EXPECT_EQ(500, web::http::content_coding_quality("deflate, GZIP ; q=0.500", content_coding::gzip));
+    EXPECT_EQ(0, web::http::content_coding_quality("gzip;q=0", content_coding::gzip));
+    EXPECT_EQ(0, web::http::content_coding_quality("deflate", content_coding::gzip));
+    EXPECT_EQ(1000, web::http::content_coding_quality("x-gzip", content_coding::gzip));
+    EXPECT_EQ(200, web::http::content_coding_quality("br, *;q=0.2", content_coding::gzip));
+    EXPECT_EQ(0, web::http::content_coding_quality("gzip;q=2", content_coding::gzip));
+
+    EXPECT_EQ(1000, web::http::content_coding_quality("gzip", content_coding::identity));
+    EXPECT_EQ(0, web::http::content_coding_quality("identity;q=0", content_coding::identity));
+    EXPECT_EQ(0, web::http::content_coding_quality("*;q=0", content_coding::identity));
+}
+
+TEST(test_content_encoding, negotiate_content_coding)
+{
+    using web::http::content_coding;
+
+    EXPECT_EQ(content_coding::gzip, web::http::negotiate_content_coding("gzip, deflate, br"));
+    EXPECT_EQ(content_coding::gzip, web::http::negotiate_content_coding("deflate, gzip"));
+    EXPECT_EQ(content_coding::deflate, web::http::negotiate_content_coding("gzip;q=0.5, deflate"));
+    EXPECT_EQ(content_coding::deflate, web::http::negotiate_content_coding("deflate"));
+    EXPECT_EQ(content_coding::gzip, web::http::negotiate_content_coding("*"));
+    EXPECT_EQ(content_coding::identity, web::http::negotiate_content_coding("br"));
+    EXPECT_EQ(content_coding::identity, web::http::negotiate_content_coding("gzip;q=0, deflate;q=0"));
+    EXPECT_EQ(content_coding::identity, web::http::negotiate_content_coding(""));
+}
+
+TEST(test_content_encoding, is_compressible_content_type)
+{
+    EXPECT_TRUE(web::http::is_compressible_content_type("text/html"));
+    EXPECT_TRUE(web::http::is_compressible_content_type("text/plain; charset=utf-8"));
+    EXPECT_TRUE(web::http::is_compressible_content_type("application/json"));
+    EXPECT_TRUE(web::http::is_compressible_content_type("application/ld+json"));
+    EXPECT_TRUE(web::http::is_compressible_content_type("image/svg+xml"));
+    EXPECT_TRUE(web::http::is_compressible_content_type("application/javascript"));
+
+    EXPECT_FALSE(web::http::is_compressible_content_type("image/png"));
+    EXPECT_FALSE(web::http::is_compressible_content_type("application/octet-stream"));
+    EXPECT_FALSE(web::http::is_compressible_content_type("text/"));
+    EXPECT_FALSE(web::http::is_compressible_content_type(""));
+}
+
+TEST(test_content_encoding, compress_content)
+{
+    std::string text;
+
+    for (auto i = 0; i < 100; ++i)
+        text += "{\"jsonrpc\": \"2.0\", \"result\": " + std::to_string(i) + ", \"id\": 1}";
+
+    const auto content = std::as_bytes(std::span{std::data(text), std::size(text)});
+
+    const auto gzip = web::http::compress_content(content, web::http::content_coding::gzip,
+                                                  compression::zlib_compression_mode::balanced);
+    EXPECT_LT(std::size(gzip), std::size(text) / 4);
+    EXPECT_EQ(text, decompress(gzip, compression::zlib_format::gzip));
+
+    const auto deflate = web::http::compress_content(content, web::http::content_coding::deflate,
+                                                     compression::zlib_compression_mode::fastest);
+    EXPECT_EQ(text, decompress(deflate, compression::zlib_format::zlib));
+}
@@ -0,0 +1,258 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/http_client.h>
+#include <aeon/web/http/routable_http_server.h>
+#include <aeon/web/http/request.h>
+#include <aeon/web/http/route.h>
+#include <aeon/web/http/method.h>
+#include <asio/io_context.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace aeon;
+
+namespace internal
+{
+
+/*!
+ * Responds with the method and content of the request; with chunked transfer encoding for "/echo/chunked".
+ */
+class echo_route final : public web::http::route
+{
+public:
+    explicit echo_route(common::string mount_point)
+        : route{std::move(mount_point)}
+    {
+    }
+
+    void on_http_request(web::http::http_server_socket &source,
+                         [[maybe_unused]] web::http::routable_http_server_session &session,
+                         const web::http::request &request) final
+    {
+        const auto text =
+            std::string{web::http::method_to_string(request.get_method())} + ":" + request.get_content_string().str();
+
+        if (request.get_uri() != "/chunked")
+        {
+            source.respond("text/plain", common::string{text});
+            return;
+        }
+
+        const auto content = std::as_bytes(std::span{std::data(text), std::size(text)});
+        source.begin_response("text/plain");
+        source.write_response_content(content.first(1));
+        source.write_response_content(content.subspan(1));
+        source.end_response();
+    }
+};
+
+/*!
+ * Never responds.
+ */
+class silent_route final : public web::http::route
+{
+public:
+    explicit silent_route(common::string mount_point)
+        : route{std::move(mount_point)}
+    {
+    }
+
+    void on_http_request([[maybe_unused]] web::http::http_server_socket &source,
+                         [[maybe_unused]] web::http::routable_http_server_session &session,
+                         [[maybe_unused]] const web::http::request &request) final
+    {
+    }
+};
+
+struct result final
+{
+    std::error_code ec;
+    web::http::status_code code = web::http::status_code::internal_server_error;
+    std::string content;
+};
+
+class test_http_client : public ::testing::Test
+{
+protected:
+    test_http_client()
+        : context{}
+        , server{context, 0}
+    {
+        server.get_session().add_route(std::make_unique<echo_route>("/echo"));
+        server.get_session().add_route(std::make_unique<silent_route>("/silent"));
+    }
+
+    void request(web::http::http_client &client, web::http::client_request request,
+                 const common::string &host = "127.0.0.1")
+    {
+        const auto index = std::size(results);
+        results.emplace_back();
+
+        client.request_async(host, server.port(), std::move(request),
+                             [this, index](const std::error_code &ec, web::http::reply &reply)
+                             {
+                                 auto &result = results[index];
+                                 result.ec = ec;
+                                 result.code = reply.get_status_code();
+
+                                 const auto content = reply.get_content();
+                                 result.content.assign(reinterpret_cast<const char *>(std::data(content)),
+                                                       std::size(content));
+                                 ++completed;
+                             });
+    }
+
+    void run(const std::size_t count)
+    {
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+        while (completed < count && std::chrono::steady_clock::now() < end)
+            context.run_one_for(std::chrono::milliseconds{100});
+    }
+
+    asio::io_context context;
+    web::http::routable_http_server server;
+    std::vector<result> results;
+    std::size_t completed = 0;
+};
+
+} // namespace internal
+
+using internal::test_http_client;
+
+TEST_F(test_http_client, methods_and_content)
+{
+    web::http::http_client client{context};
+
+    request(client, {.uri = "/echo"});
+    request(client, {.method = web::http::http_method::post,
+                     .uri = "/echo",
+                     .content_type = "text/plain",
+                     .content = {std::byte{'a'}, std::byte{'b'}}});
+    request(client, {.method = web::http::http_method::put, .uri = "/echo/chunked", .content_type = "text/plain"});
+    request(client, {.method = web::http::http_method::head, .uri = "/echo"});
+    request(client, {.uri = "/unknown"});
+    run(5);
+
+    ASSERT_EQ(5u, completed);
+
+    for (const auto &result : results)
+        EXPECT_FALSE(result.ec) << result.ec.message();
+
+    EXPECT_EQ(web::http::status_code::ok, results[0].code);
+    EXPECT_EQ("GET:", results[0].content);
+    EXPECT_EQ("POST:ab", results[1].content);
+    EXPECT_EQ("PUT:", results[2].content);
+    EXPECT_EQ(web::http::status_code::ok, results[3].code);
+    EXPECT_EQ("", results[3].content);
+    EXPECT_EQ(web::http::status_code::not_found, results[4].code);
+}
+
+TEST_F(test_http_client, pipelines_requests_on_a_single_connection)
+{
+    web::http::http_client client{context, {.max_connections_per_host = 1, .max_pipeline_depth = 8}};
+
+    for (auto i = 0; i < 32; ++i)
+        request(client, {.uri = "/echo"});
+
+    run(32);
+
+    ASSERT_EQ(32u, completed);
+
+    for (const auto &result : results)
+    {
+        EXPECT_FALSE(result.ec);
+        EXPECT_EQ("GET:", result.content);
+    }
+
+    EXPECT_EQ(1u, client.connection_count());
+}
+
+TEST_F(test_http_client, times_out)
+{
+    web::http::http_client client{context, {.request_timeout = std::chrono::milliseconds{100}}};
+
+    request(client, {.uri = "/silent"});
+    run(1);
+
+    ASSERT_EQ(1u, completed);
+    EXPECT_EQ(std::make_error_code(std::errc::timed_out), results[0].ec);
+}
+
+TEST_F(test_http_client, unreachable_host)
+{
+    // Find a port that nothing listens on.
+    std::uint16_t port = 0;
+
+    {
+        asio::ip::tcp::acceptor acceptor{context, asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), 0}};
+        port = acceptor.local_endpoint().port();
+    }
+
+    web::http::http_client client{context};
+    client.request_async("127.0.0.1", port, {.uri = "/"},
+                         [this](const std::error_code &ec, [[maybe_unused]] web::http::reply &reply)
+                         {
+                             results.emplace_back().ec = ec;
+                             ++completed;
+                         });
+    run(1);
+
+    ASSERT_EQ(1u, completed);
+    EXPECT_TRUE(results[0].ec);
+    EXPECT_EQ(0u, client.connection_count());
+}
+
+TEST_F(test_http_client, without_keep_alive)
+{
+    web::http::http_client client{context, {.keep_alive = false}};
+
+    for (auto i = 0; i < 4; ++i)
+        request(client, {.uri = "/echo"});
+
+    run(4);
+
+    ASSERT_EQ(4u, completed);
+
+    for (const auto &result : results)
+        EXPECT_EQ("GET:", result.content);
+}
+
+TEST_F(test_http_client, resolves_host_names)
+{
+    web::http::http_client client{context};
+
+    // All requests wait for the same lookup.
+    for (auto i = 0; i < 3; ++i)
+        request(client, {.uri = "/echo"}, "localhost");
+
+    run(3);
+
+    ASSERT_EQ(3u, completed);
+
+    for (const auto &result : results)
+    {
+        ASSERT_FALSE(result.ec) << result.ec.message();
+        EXPECT_EQ("GET:", result.content);
+    }
+}
+
+TEST_F(test_http_client, close_while_resolving)
+{
+    web::http::http_client client{context};
+    request(client, {.uri = "/echo"}, "localhost");
+
+    // Let the request be queued, but not the lookup complete.
+    context.poll_one();
+    client.close();
+
+    ASSERT_EQ(1u, completed);
+    EXPECT_EQ(std::make_error_code(std::errc::operation_canceled), results[0].ec);
+    EXPECT_EQ(0u, client.connection_count());
+
+    // The canceled lookup does not report to the client anymore.
+    context.run_for(std::chrono::milliseconds{100});
+    EXPECT_EQ(1u, completed);
+}
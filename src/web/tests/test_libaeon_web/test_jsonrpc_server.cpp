@@ -0,0 +1,76 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/jsonrpc/server.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+#include <gtest/gtest.h>
+
+using namespace aeon;
+
+namespace internal
+{
+
+[[nodiscard]] static auto create_server() -> web::jsonrpc::server
+{
+    web::jsonrpc::server server;
+    server.register_method({"subtract",
+                            [](const ptree::property_tree &params)
+                            {
+                                return web::jsonrpc::result{ptree::property_tree{
+                                    params.at("a").integer_value() - params.at("b").integer_value()}};
+                            }});
+    return server;
+}
+
+[[nodiscard]] static auto request(const web::jsonrpc::server &server, const common::string &json)
+    -> ptree::property_tree
+{
+    return server.request(ptree::serialization::from_json(json));
+}
+
+} // namespace internal
+
+TEST(test_jsonrpc_server, calls_method)
+{
+    const auto server = internal::create_server();
+    const auto response =
+        internal::request(server, R"({"jsonrpc": "2.0", "method": "subtract", "params": {"a": 42, "b": 23}, "id": 1})");
+
+    ASSERT_TRUE(response.contains("result")) << ptree::serialization::to_json(response).str();
+    EXPECT_EQ(19, response.at("result").integer_value());
+    EXPECT_EQ(1, response.at("id").integer_value());
+    EXPECT_EQ("2.0", response.at("jsonrpc").string_value());
+
+    EXPECT_EQ(R"({"jsonrpc":"2.0","result":19,"id":2})",
+              server.request(
+                  common::string{R"({"jsonrpc": "2.0", "method": "subtract", "params": {"a": 42, "b": 23}, "id": 2})"}));
+}
+
+TEST(test_jsonrpc_server, batch_request)
+{
+    const auto server = internal::create_server();
+    const auto response =
+        internal::request(server, R"([{"jsonrpc": "2.0", "method": "subtract", "params": {"a": 1, "b": 2}, "id": 1},
+                                      {"jsonrpc": "2.0", "method": "subtract", "params": {"a": 5, "b": 2}, "id": 2}])");
+
+    ASSERT_TRUE(response.is_array());
+    ASSERT_EQ(2u, std::size(response.array_value()));
+    EXPECT_EQ(-1, response.array_value()[0].at("result").integer_value());
+    EXPECT_EQ(3, response.array_value()[1].at("result").integer_value());
+}
+
+TEST(test_jsonrpc_server, errors)
+{
+    const auto server = internal::create_server();
+
+    const auto missing_method = internal::request(server, R"({"jsonrpc": "2.0", "id": 1})");
+    EXPECT_EQ(web::jsonrpc::json_rpc_error::invalid_request, missing_method.at("error").at("code").integer_value());
+
+    const auto unknown_method = internal::request(server, R"({"jsonrpc": "2.0", "method": "add", "id": 1})");
+    EXPECT_EQ(web::jsonrpc::json_rpc_error::method_not_found, unknown_method.at("error").at("code").integer_value());
+
+    const auto wrong_version = internal::request(server, R"({"jsonrpc": "1.0", "method": "subtract", "id": 1})");
+    EXPECT_EQ(web::jsonrpc::json_rpc_error::invalid_request, wrong_version.at("error").at("code").integer_value());
+
+    const auto not_an_object = internal::request(server, "[1]");
+    EXPECT_EQ(web::jsonrpc::json_rpc_error::invalid_request, not_an_object.at("error").at("code").integer_value());
+}
@@ -0,0 +1,153 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/request_parser.h>
+#include <gtest/gtest.h>
+#include <string_view>
+
+using namespace aeon;
+
+static auto as_bytes(const std::string_view str) -> std::span<const std::byte>
+{
+    return std::as_bytes(std::span{str});
+}
+
+TEST(test_request_parser, parse_simple_get)
+{
+    const std::string_view data = "GET /index.html HTTP/1.1\r\nHost: localhost\r\nAccept:  */* \r\n\r\n";
+
+    web::http::request_head head;
+    ASSERT_EQ(web::http::request_parse_result::complete, web::http::parse_request_head(as_bytes(data), head));
+
+    EXPECT_EQ("GET", head.method);
+    EXPECT_EQ("/index.html", head.uri);
+    EXPECT_EQ("HTTP/1.1", head.version);
+    EXPECT_EQ(std::size(data), head.size);
+
+    ASSERT_EQ(2u, head.header_count);
+    EXPECT_EQ("Host", head.headers[0].name);
+    EXPECT_EQ("localhost", head.headers[0].value);
+    EXPECT_EQ("Accept", head.headers[1].name);
+    EXPECT_EQ("*/*", head.headers[1].value);
+
+    const auto host = head.find_header("host");
+    ASSERT_NE(nullptr, host);
+    EXPECT_EQ("localhost", host->value);
+    EXPECT_EQ(nullptr, head.find_header("content-length"));
+}
+
+TEST(test_request_parser, parse_bare_line_feeds)
+{
+    const std::string_view data = "\r\nGET / HTTP/1.1\nHost: localhost\n\n";
+
+    web::http::request_head head;
+    ASSERT_EQ(web::http::request_parse_result::complete, web::http::parse_request_head(as_bytes(data), head));
+    EXPECT_EQ("/", head.uri);
+    EXPECT_EQ(1u, head.header_count);
+    EXPECT_EQ(std::size(data), head.size);
+}
+
+TEST(test_request_parser, parse_pipelined)
+{
+    const std::string_view data = "GET /a HTTP/1.1\r\n\r\nGET /b HTTP/1.1\r\n\r\n";
+
+    web::http::request_head head;
+    ASSERT_EQ(web::http::request_parse_result::complete, web::http::parse_request_head(as_bytes(data), head));
+    EXPECT_EQ("/a", head.uri);
+
+    ASSERT_EQ(web::http::request_parse_result::complete,
+              web::http::parse_request_head(as_bytes(data.substr(head.size)), head));
+    EXPECT_EQ("/b", head.uri);
+    EXPECT_EQ(std::size(data) / 2, head.size);
+}
+
+TEST(test_request_parser, parse_incrementally)
+{
+    const std::string_view data = "GET /some/long/path/to/a/file.html HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+    web::http::request_head head;
+    std::size_t previous_size = 0;
+
+    for (std::size_t size = 1; size < std::size(data); ++size)
+    {
+        ASSERT_EQ(web::http::request_parse_result::incomplete,
+                  web::http::parse_request_head(as_bytes(data.substr(0, size)), head, previous_size));
+        previous_size = size;
+    }
+
+    ASSERT_EQ(web::http::request_parse_result::complete,
+              web::http::parse_request_head(as_bytes(data), head, previous_size));
+    EXPECT_EQ("/some/long/path/to/a/file.html", head.uri);
+    EXPECT_EQ("localhost", head.headers[0].value);
+}
+
+TEST(test_request_parser, parse_invalid)
+{
+    web::http::request_head head;
+
+    for (const auto data : {"GET\r\n\r\n", "GET  / HTTP/1.1\r\n\r\n", "GET / HTTP/1.1 \r\n\r\n",
+                            "GET / HTTP/1.1\r\nHost localhost\r\n\r\n", "GET / HTTP/1.1\r\n: value\r\n\r\n",
+                            "GET / HTTP/1.1\r\nHo st: localhost\r\n\r\n", "GET /\x7f HTTP/1.1\r\n\r\n",
+                            "GET / HTTP/1.1\r\nHost: local\rhost\r\n\r\n"})
+    {
+        EXPECT_EQ(web::http::request_parse_result::invalid, web::http::parse_request_head(as_bytes(data), head))
+            << data;
+    }
+}
+
+TEST(test_request_parser, too_many_headers)
+{
+    std::string data = "GET / HTTP/1.1\r\n";
+
+    for (std::size_t i = 0; i <= web::http::request_head::max_headers; ++i)
+        data += "X-Header: value\r\n";
+
+    data += "\r\n";
+
+    web::http::request_head head;
+    EXPECT_EQ(web::http::request_parse_result::too_many_headers, web::http::parse_request_head(as_bytes(data), head));
+}
+
+TEST(test_request_parser, parse_content_length)
+{
+    std::size_t length = 0;
+    EXPECT_TRUE(web::http::parse_content_length("1234", length));
+    EXPECT_EQ(1234u, length);
+
+    EXPECT_FALSE(web::http::parse_content_length("", length));
+    EXPECT_FALSE(web::http::parse_content_length("-1", length));
+    EXPECT_FALSE(web::http::parse_content_length("12a", length));
+    EXPECT_FALSE(web::http::parse_content_length("99999999999999999999999", length));
+}
+
+TEST(test_request_parser, parse_response)
+{
+    const std::string_view data = "HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nNot found";
+
+    web::http::response_head head;
+    ASSERT_EQ(web::http::request_parse_result::complete, web::http::parse_response_head(as_bytes(data), head));
+
+    EXPECT_EQ("HTTP/1.1", head.version);
+    EXPECT_EQ(404, head.status_code);
+    EXPECT_EQ("Not Found", head.reason);
+    EXPECT_EQ(std::size(data) - 9, head.size);
+
+    const auto content_length = head.find_header("content-length");
+    ASSERT_NE(nullptr, content_length);
+    EXPECT_EQ("9", content_length->value);
+
+    // The reason phrase may be empty.
+    ASSERT_EQ(web::http::request_parse_result::complete,
+              web::http::parse_response_head(as_bytes("HTTP/1.1 200\r\n\r\n"), head));
+    EXPECT_EQ(200, head.status_code);
+    EXPECT_EQ("", head.reason);
+
+    for (const auto invalid : {"HTTP/1.1\r\n\r\n", "HTTP/1.1 20\r\n\r\n", "HTTP/1.1 2000 OK\r\n\r\n",
+                               "HTTP/1.1 abc OK\r\n\r\n", "HTTP/1.1 099 OK\r\n\r\n"})
+    {
+        EXPECT_EQ(web::http::request_parse_result::invalid, web::http::parse_response_head(as_bytes(invalid), head))
+            << invalid;
+    }
+
+    EXPECT_EQ(web::http::request_parse_result::incomplete,
+              web::http::parse_response_head(as_bytes("HTTP/1.1 200 OK\r\n"), head));
+}
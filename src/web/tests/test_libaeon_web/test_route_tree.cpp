@@ -0,0 +1,167 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/route_tree.h>
+#include <aeon/web/http/route.h>
+#include <gtest/gtest.h>
+
+using namespace aeon;
+
+namespace internal
+{
+
+class test_route final : public web::http::route
+{
+public:
+    explicit test_route(common::string mount_point)
+        : route{std::move(mount_point)}
+    {
+    }
+
+    void on_http_request([[maybe_unused]] web::http::http_server_socket &source,
+                         [[maybe_unused]] web::http::routable_http_server_session &session,
+                         [[maybe_unused]] const web::http::request &request) final
+    {
+    }
+};
+
+} // namespace internal
+
+TEST(test_route_tree, match_static)
+{
+    internal::test_route users{"/users"};
+    internal::test_route user_list{"/users/list"};
+    internal::test_route root{"/"};
+
+    web::http::route_tree tree;
+    tree.add("/users", users);
+    tree.add("/users/list", user_list);
+    tree.add("/", root);
+
+    web::http::route_match match;
+    ASSERT_TRUE(tree.match("/users", web::http::http_method::get, match));
+    EXPECT_EQ(&users, match.matched_route);
+
+    ASSERT_TRUE(tree.match("/users/list?page=2", web::http::http_method::get, match));
+    EXPECT_EQ(&user_list, match.matched_route);
+    EXPECT_EQ("?page=2", match.remainder);
+
+    ASSERT_TRUE(tree.match("/", web::http::http_method::get, match));
+    EXPECT_EQ(&root, match.matched_route);
+
+    EXPECT_FALSE(tree.match("/user", web::http::http_method::get, match));
+    EXPECT_FALSE(tree.match("/users/", web::http::http_method::get, match));
+    EXPECT_FALSE(tree.match("/users/lists", web::http::http_method::get, match));
+}
+
+TEST(test_route_tree, match_parameters)
+{
+    internal::test_route user{"/users/:id"};
+    internal::test_route me{"/users/me"};
+    internal::test_route post{"/users/:id/posts/:post_id"};
+
+    web::http::route_tree tree;
+    tree.add("/users/:id", user);
+    tree.add("/users/me", me);
+    tree.add("/users/:id/posts/:post_id", post);
+
+    web::http::route_match match;
+    ASSERT_TRUE(tree.match("/users/42", web::http::http_method::get, match));
+    EXPECT_EQ(&user, match.matched_route);
+    ASSERT_EQ(1u, match.parameter_count);
+    EXPECT_EQ("id", match.parameters[0].name);
+    EXPECT_EQ("42", match.parameters[0].value);
+
+    // Static text takes precedence over a parameter.
+    ASSERT_TRUE(tree.match("/users/me", web::http::http_method::get, match));
+    EXPECT_EQ(&me, match.matched_route);
+    EXPECT_EQ(0u, match.parameter_count);
+
+    ASSERT_TRUE(tree.match("/users/me/posts/7", web::http::http_method::get, match));
+    EXPECT_EQ(&post, match.matched_route);
+    ASSERT_EQ(2u, match.parameter_count);
+    EXPECT_EQ("me", match.find_parameter("id")->value);
+    EXPECT_EQ("7", match.find_parameter("post_id")->value);
+    EXPECT_EQ(nullptr, match.find_parameter("name"));
+
+    EXPECT_FALSE(tree.match("/users//posts/7", web::http::http_method::get, match));
+}
+
+TEST(test_route_tree, match_wildcards)
+{
+    internal::test_route root{"/"};
+    internal::test_route api{"/api"};
+    internal::test_route files{"/users/:id/files"};
+
+    web::http::route_tree tree;
+    tree.add("/*", root);
+    tree.add("/api*", api);
+    tree.add("/users/:id/files/*", files);
+
+    web::http::route_match match;
+    ASSERT_TRUE(tree.match("/api/call?x=1", web::http::http_method::post, match));
+    EXPECT_EQ(&api, match.matched_route);
+    EXPECT_EQ("/call?x=1", match.remainder);
+
+    ASSERT_TRUE(tree.match("/api", web::http::http_method::post, match));
+    EXPECT_EQ(&api, match.matched_route);
+    EXPECT_EQ("", match.remainder);
+
+    ASSERT_TRUE(tree.match("/users/1/files/a/b.txt", web::http::http_method::get, match));
+    EXPECT_EQ(&files, match.matched_route);
+    EXPECT_EQ("a/b.txt", match.remainder);
+    EXPECT_EQ("1", match.find_parameter("id")->value);
+
+    // Falls back to the most specific wildcard when nothing else matches.
+    ASSERT_TRUE(tree.match("/users/1/other", web::http::http_method::get, match));
+    EXPECT_EQ(&root, match.matched_route);
+    EXPECT_EQ("users/1/other", match.remainder);
+    EXPECT_EQ(0u, match.parameter_count);
+
+    ASSERT_TRUE(tree.match("index.html", web::http::http_method::get, match));
+    EXPECT_EQ(&root, match.matched_route);
+    EXPECT_EQ("index.html", match.remainder);
+}
+
+TEST(test_route_tree, match_methods)
+{
+    internal::test_route get_item{"/items/:id"};
+    internal::test_route delete_item{"/items/:id"};
+    internal::test_route any_item{"/items/:id"};
+
+    web::http::route_tree tree;
+    tree.add("/items/:id", get_item, web::http::http_method::get);
+    tree.add("/items/:id", delete_item, web::http::http_method::delete_method);
+
+    web::http::route_match match;
+    ASSERT_TRUE(tree.match("/items/1", web::http::http_method::get, match));
+    EXPECT_EQ(&get_item, match.matched_route);
+
+    ASSERT_TRUE(tree.match("/items/1", web::http::http_method::delete_method, match));
+    EXPECT_EQ(&delete_item, match.matched_route);
+
+    EXPECT_FALSE(tree.match("/items/1", web::http::http_method::post, match));
+
+    tree.add("/items/:id", any_item);
+    ASSERT_TRUE(tree.match("/items/1", web::http::http_method::post, match));
+    EXPECT_EQ(&any_item, match.matched_route);
+
+    EXPECT_TRUE(tree.remove("/items/:id", web::http::http_method::get));
+    EXPECT_FALSE(tree.remove("/items/:id", web::http::http_method::get));
+    ASSERT_TRUE(tree.match("/items/1", web::http::http_method::get, match));
+    EXPECT_EQ(&any_item, match.matched_route);
+}
+
+TEST(test_route_tree, invalid_patterns)
+{
+    internal::test_route route{"/"};
+
+    web::http::route_tree tree;
+    tree.add("/users/:id", route);
+
+    EXPECT_THROW(tree.add("/users/:id", route), web::http::route_pattern_exception);
+    EXPECT_THROW(tree.add("/users/:name/posts", route), web::http::route_pattern_exception);
+    EXPECT_THROW(tree.add("/files/*/all", route), web::http::route_pattern_exception);
+    EXPECT_THROW(tree.add("/files/a:id", route), web::http::route_pattern_exception);
+    EXPECT_THROW(tree.add("/files/:", route), web::http::route_pattern_exception);
+    EXPECT_THROW(tree.add("/:a/:b/:c/:d/:e/:f/:g/:h/:i", route), web::http::route_pattern_exception);
+}
@@ -0,0 +1,164 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/static_file_cache.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <chrono>
+
+using namespace aeon;
+
+static void write_file(const std::filesystem::path &path, const std::string_view content)
+{
+    std::ofstream file{path, std::ios::binary};
+    file << content;
+}
+
+static auto as_string(const std::span<const std::byte> data) -> std::string_view
+{
+    return {reinterpret_cast<const char *>(std::data(data)), std::size(data)};
+}
+
+TEST(test_static_file_cache, format_http_date)
+{
+    const auto time = std::chrono::file_clock::from_sys(std::chrono::sys_days{std::chrono::year{1994} /
+                                                                              std::chrono::November / 6} +
+                                                        std::chrono::hours{8} + std::chrono::minutes{49} +
+                                                        std::chrono::seconds{37});
+    EXPECT_EQ("Sun, 06 Nov 1994 08:49:37 GMT", web::http::detail::format_http_date(time));
+}
+
+TEST(test_static_file_cache, etag_matches)
+{
+    EXPECT_TRUE(web::http::detail::etag_matches("\"abc\"", "\"abc\""));
+    EXPECT_TRUE(web::http::detail::etag_matches("\"x\", W/\"abc\"", "\"abc\""));
+    EXPECT_TRUE(web::http::detail::etag_matches("*", "\"abc\""));
+    EXPECT_FALSE(web::http::detail::etag_matches("\"abcd\"", "\"abc\""));
+}
+
+TEST(test_static_file_cache, parse_byte_range)
+{
+    using web::http::detail::byte_range_result;
+
+    web::http::detail::byte_range range;
+    ASSERT_EQ(byte_range_result::satisfiable, web::http::detail::parse_byte_range("bytes=10-19", 100, range));
+    EXPECT_EQ(10u, range.offset);
+    EXPECT_EQ(10u, range.length);
+
+    ASSERT_EQ(byte_range_result::satisfiable, web::http::detail::parse_byte_range("bytes=90-", 100, range));
+    EXPECT_EQ(90u, range.offset);
+    EXPECT_EQ(10u, range.length);
+
+    ASSERT_EQ(byte_range_result::satisfiable, web::http::detail::parse_byte_range("bytes=90-200", 100, range));
+    EXPECT_EQ(10u, range.length);
+
+    ASSERT_EQ(byte_range_result::satisfiable, web::http::detail::parse_byte_range("bytes=-30", 100, range));
+    EXPECT_EQ(70u, range.offset);
+    EXPECT_EQ(30u, range.length);
+
+    EXPECT_EQ(byte_range_result::unsatisfiable, web::http::detail::parse_byte_range("bytes=100-", 100, range));
+    EXPECT_EQ(byte_range_result::unsatisfiable, web::http::detail::parse_byte_range("bytes=-0", 100, range));
+    EXPECT_EQ(byte_range_result::ignored, web::http::detail::parse_byte_range("bytes=0-1,5-6", 100, range));
+    EXPECT_EQ(byte_range_result::ignored, web::http::detail::parse_byte_range("bytes=20-10", 100, range));
+    EXPECT_EQ(byte_range_result::ignored, web::http::detail::parse_byte_range("items=0-1", 100, range));
+}
+
+TEST(test_static_file_cache, caches_small_files_in_memory)
+{
+    const auto path = std::filesystem::temp_directory_path() / "aeon_test_static_file_cache.txt";
+    write_file(path, "Hello world");
+
+    {
+        web::http::static_file_cache cache{64, 1024};
+        const auto file = cache.get(path, "text/plain");
+
+        ASSERT_TRUE(file->response);
+        EXPECT_EQ(11u, file->size);
+        EXPECT_EQ("Hello world", as_string(file->content()));
+        EXPECT_EQ(11u, cache.size());
+
+        const auto response = as_string(*file->response);
+        EXPECT_TRUE(response.starts_with("HTTP/1.1 200 "));
+        EXPECT_NE(std::string_view::npos, response.find("Content-Length: 11\r\n"));
+        EXPECT_NE(std::string_view::npos, response.find("ETag: " + file->etag.str()));
+
+        EXPECT_EQ(file, cache.get(path, "text/plain"));
+
+        // A modified file is loaded again.
+        write_file(path, "Hello again");
+        std::filesystem::last_write_time(path, file->last_write_time + std::chrono::seconds{1});
+
+        const auto modified_file = cache.get(path, "text/plain");
+        EXPECT_NE(file, modified_file);
+        EXPECT_EQ("Hello again", as_string(modified_file->content()));
+        EXPECT_NE(file->etag, modified_file->etag);
+        EXPECT_EQ(11u, cache.size());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_static_file_cache, sends_large_files_from_disk)
+{
+    const auto path = std::filesystem::temp_directory_path() / "aeon_test_static_file_cache_large.txt";
+    write_file(path, std::string(100, 'x'));
+
+    {
+        web::http::static_file_cache cache{64, 1024};
+        const auto file = cache.get(path, "text/plain");
+
+        EXPECT_FALSE(file->response);
+        ASSERT_TRUE(file->file);
+        EXPECT_EQ(100u, file->file->size());
+        EXPECT_TRUE(as_string(file->head).ends_with("Content-Length: 100\r\n\r\n"));
+        EXPECT_EQ(0u, cache.size());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(test_static_file_cache, precompresses_compressible_files)
+{
+    const auto path = std::filesystem::temp_directory_path() / "aeon_test_static_file_cache_compressed.html";
+
+    std::string html;
+
+    for (auto i = 0; i < 100; ++i)
+        html += "<p>Hello world</p>\n";
+
+    write_file(path, html);
+
+    {
+        web::http::static_file_cache cache{64 * 1024, 1024 * 1024};
+        const auto file = cache.get(path, "text/html");
+
+        ASSERT_TRUE(file->response);
+        ASSERT_TRUE(file->gzip_response);
+        EXPECT_LT(std::size(file->gzip_content()), std::size(html));
+        EXPECT_EQ(std::size(file->content()) + std::size(file->gzip_content()), cache.size());
+        EXPECT_NE(file->etag, file->gzip_etag);
+
+        const auto response = as_string(*file->response);
+        EXPECT_NE(std::string_view::npos, response.find("Vary: Accept-Encoding\r\n"));
+        EXPECT_EQ(std::string_view::npos, response.find("Content-Encoding"));
+
+        const auto gzip_response = as_string(*file->gzip_response);
+        EXPECT_NE(std::string_view::npos, gzip_response.find("Content-Encoding: gzip\r\n"));
+        EXPECT_NE(std::string_view::npos, gzip_response.find("ETag: " + file->gzip_etag.str()));
+        EXPECT_NE(std::string_view::npos,
+                  gzip_response.find("Content-Length: " + std::to_string(std::size(file->gzip_content())) + "\r\n"));
+
+        // Not compressible.
+        const auto image = cache.get(path, "image/png");
+        EXPECT_FALSE(image->gzip_response);
+        EXPECT_EQ(std::string_view::npos, as_string(*image->response).find("Vary"));
+    }
+
+    {
+        web::http::static_file_cache cache{64 * 1024, 1024 * 1024, {.enabled = false}};
+        EXPECT_FALSE(cache.get(path, "text/html")->gzip_response);
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,120 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include <aeon/web/http/tracelog_statistics_route.h>
+#include <aeon/web/http/http_client.h>
+#include <aeon/web/http/routable_http_server.h>
+#include <aeon/tracelog/tracelog.h>
+#include <aeon/ptree/serialization/serialization_json.h>
+#include <asio/io_context.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <chrono>
+
+using namespace aeon;
+
+namespace internal
+{
+
+static void traced_function()
+{
+    aeon_tracelog_scoped();
+}
+
+[[nodiscard]] static auto find_scope(const ptree::property_tree &pt, const common::string_view name)
+    -> const ptree::property_tree *
+{
+    for (const auto &scope : pt.at("scopes").array_value())
+    {
+        if (scope.at("name").string_value() == name)
+            return &scope;
+    }
+
+    return nullptr;
+}
+
+} // namespace internal
+
+TEST(test_tracelog_statistics_route, to_ptree)
+{
+    tracelog::scope_statistics statistics;
+    statistics.name = "scope";
+    statistics.count = 4;
+    statistics.total = std::chrono::nanoseconds{400};
+    statistics.min = std::chrono::nanoseconds{10};
+    statistics.max = std::chrono::nanoseconds{250};
+    statistics.p50 = std::chrono::nanoseconds{50};
+    statistics.p90 = std::chrono::nanoseconds{90};
+    statistics.p99 = std::chrono::nanoseconds{99};
+    statistics.p999 = std::chrono::nanoseconds{249};
+
+    const auto pt = web::http::tracelog_statistics_route::to_ptree({statistics});
+    const auto scope = internal::find_scope(pt, "scope");
+    ASSERT_NE(nullptr, scope);
+
+    EXPECT_EQ(4, scope->at("count").integer_value());
+    EXPECT_EQ(400, scope->at("total").integer_value());
+    EXPECT_EQ(100, scope->at("mean").integer_value());
+    EXPECT_EQ(10, scope->at("min").integer_value());
+    EXPECT_EQ(250, scope->at("max").integer_value());
+    EXPECT_EQ(50, scope->at("p50").integer_value());
+    EXPECT_EQ(90, scope->at("p90").integer_value());
+    EXPECT_EQ(99, scope->at("p99").integer_value());
+    EXPECT_EQ(249, scope->at("p999").integer_value());
+
+    EXPECT_TRUE(web::http::tracelog_statistics_route::to_ptree({}).at("scopes").array_value().empty());
+}
+
+TEST(test_tracelog_statistics_route, serves_statistics_as_json)
+{
+    tracelog::settings settings;
+    settings.record_events = false;
+    settings.collect_statistics = true;
+    tracelog::configure(settings);
+    tracelog::reset_statistics();
+
+    for (auto i = 0; i < 10; ++i)
+        internal::traced_function();
+
+    asio::io_context context;
+    web::http::routable_http_server server{context, 0};
+    server.get_session().add_route(std::make_unique<web::http::tracelog_statistics_route>("/statistics"));
+
+    web::http::http_client client{context};
+    std::error_code result;
+    std::string content_type;
+    std::string content;
+    auto completed = false;
+
+    client.request_async("127.0.0.1", server.port(), {.uri = "/statistics"},
+                         [&](const std::error_code &ec, web::http::reply &reply)
+                         {
+                             result = ec;
+
+                             if (const auto type = reply.find_header("Content-Type"); type)
+                                 content_type = std::string{type->as_std_string_view()};
+
+                             const auto data = reply.get_content();
+                             content.assign(reinterpret_cast<const char *>(std::data(data)), std::size(data));
+                             completed = true;
+                         });
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+    while (!completed && std::chrono::steady_clock::now() < end)
+        context.run_one_for(std::chrono::milliseconds{100});
+
+    tracelog::configure({});
+
+    ASSERT_TRUE(completed);
+    ASSERT_FALSE(result) << result.message();
+    EXPECT_EQ("application/json", content_type);
+
+    const auto pt = ptree::serialization::from_json(common::string{content});
+    const auto scope = internal::find_scope(pt, "traced_function");
+    ASSERT_NE(nullptr, scope);
+
+    EXPECT_EQ(10, scope->at("count").integer_value());
+    EXPECT_LE(scope->at("min").integer_value(), scope->at("max").integer_value());
+    EXPECT_LE(scope->at("p50").integer_value(), scope->at("p999").integer_value());
+    EXPECT_GE(scope->at("total").integer_value(), scope->at("max").integer_value());
+}
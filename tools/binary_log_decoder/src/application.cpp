@@ -0,0 +1,98 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "application.h"
+#include <aeon/logger/binary_log_reader.h>
+#include <aeon/logger/exception.h>
+#include <aeon/logger/log_level.h>
+#include <aeon/streams/devices/file_device.h>
+#include <aeon/streams/dynamic_stream.h>
+#include <aeon/common/commandline_parser.h>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+namespace aeon::binary_log_decoder
+{
+
+constexpr auto exe_name = "aeon_binary_log_decoder";
+
+[[nodiscard]] auto parse_arguments(common::commandline_parser &parser, int argc, char *argv[])
+{
+    parser.add_positional("source_file", "The binary log file to decode.");
+    parser.add_option("s", "Show the source location of deferred log messages.");
+    parser.add_option("h", "Show help text.");
+
+    return parser.parse(argc, argv);
+}
+
+void print_timestamp(const std::chrono::system_clock::time_point timestamp)
+{
+    const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch());
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    const auto nanoseconds = since_epoch - seconds;
+
+    std::cout << '[' << seconds.count() << '.' << std::setw(9) << std::setfill('0') << nanoseconds.count() << "] ";
+}
+
+void decode(const std::filesystem::path &source, const bool show_source_location)
+{
+    auto stream = streams::make_dynamic_stream(streams::file_source_device{source});
+    logger::binary_log_reader reader{stream};
+
+    logger::binary_log_entry entry;
+
+    while (reader.read(entry))
+    {
+        print_timestamp(entry.timestamp);
+
+        std::cout << '[' << entry.module << "] [" << logger::log_level_str[static_cast<int>(entry.level)] << "]: ";
+        std::cout << entry.message;
+
+        if (show_source_location && !std::empty(entry.file))
+            std::cout << " (" << entry.file << ':' << entry.line << ')';
+
+        std::cout << '\n';
+    }
+}
+
+auto application::main(const int argc, char *argv[]) noexcept -> int // NOLINT(bugprone-exception-escape)
+{
+    common::commandline_parser commandline_parser;
+    auto args = parse_arguments(commandline_parser, argc, argv);
+
+    if (!args)
+    {
+        std::cerr << "Invalid arguments.\n";
+        commandline_parser.print_help_text(exe_name);
+        return 1;
+    }
+
+    if (args.has_option("h"))
+    {
+        commandline_parser.print_help_text(exe_name);
+        return 0;
+    }
+
+    const auto source_file = std::filesystem::path{args.positional(0).as_std_string_view()};
+
+    if (!std::filesystem::exists(source_file))
+    {
+        std::cerr << "Source file does not exist.\n";
+        return 1;
+    }
+
+    try
+    {
+        decode(source_file, args.has_option("s"));
+    }
+    catch (const logger::binary_log_exception &)
+    {
+        std::cerr << "The source file is not a valid binary log, or it is truncated.\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+} // namespace aeon::binary_log_decoder
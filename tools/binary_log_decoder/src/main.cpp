@@ -0,0 +1,9 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "application.h"
+
+int main(int argc, char *argv[])
+{
+    aeon::binary_log_decoder::application app;
+    return app.main(argc, argv);
+}
@@ -0,0 +1,64 @@
+// Distributed under the BSD 2-Clause License - Copyright 2012-2023 Robin Degen
+
+#include "application.h"
+#include <aeon/tracelog/converter.h>
+#include <aeon/tracelog/exception.h>
+#include <aeon/common/commandline_parser.h>
+#include <filesystem>
+#include <iostream>
+
+namespace aeon::trace_converter
+{
+
+constexpr auto exe_name = "aeon_trace_converter";
+
+[[nodiscard]] auto parse_arguments(common::commandline_parser &parser, int argc, char *argv[])
+{
+    parser.add_positional("source_file", "The binary trace file to convert.");
+    parser.add_positional("destination_file", "The JSON file to write.");
+    parser.add_option("h", "Show help text.");
+
+    return parser.parse(argc, argv);
+}
+
+auto application::main(const int argc, char *argv[]) noexcept -> int // NOLINT(bugprone-exception-escape)
+{
+    common::commandline_parser commandline_parser;
+    auto args = parse_arguments(commandline_parser, argc, argv);
+
+    if (!args)
+    {
+        std::cerr << "Invalid arguments.\n";
+        commandline_parser.print_help_text(exe_name);
+        return 1;
+    }
+
+    if (args.has_option("h"))
+    {
+        commandline_parser.print_help_text(exe_name);
+        return 0;
+    }
+
+    const auto source_file = std::filesystem::path{args.positional(0).as_std_string_view()};
+    const auto destination_file = std::filesystem::path{args.positional(1).as_std_string_view()};
+
+    if (!std::filesystem::exists(source_file))
+    {
+        std::cerr << "Source file does not exist.\n";
+        return 1;
+    }
+
+    try
+    {
+        tracelog::convert_to_json(source_file, destination_file);
+    }
+    catch (const tracelog::tracelog_exception &)
+    {
+        std::cerr << "The source file is not a valid binary trace, or it is truncated.\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+} // namespace aeon::trace_converter